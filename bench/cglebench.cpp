@@ -0,0 +1,239 @@
+/*
+ * FILE:
+ * cglebench.cpp
+ *
+ * FUNCTION:
+ * Headless benchmark for the C++ class library (libcgle).  For each
+ * of the extrusion classes, times Draw() against the corresponding
+ * call into the C core, on identical inputs: the same path, contour,
+ * colors, radii, twists, number of sides and join style.  Reports the
+ * number of calls per second for each, and the ratio between them.
+ * Then Build() is timed, which generates the same geometry into a
+ * mesh rather than into GL.  Once the object is built, Draw() is timed
+ * again; it now only checks that its inputs haven't changed, and
+ * submits the stored mesh.
+ *
+ * No window is opened; without a current GL context, the GL entry
+ * points are no-ops, so what gets measured is the geometry work done
+ * on the CPU, which is what the two libraries differ in.
+ *
+ * Usage: cglebench [iterations]
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "ExtrusionLib.h"
+#include "cglebench.h"
+
+/* ============================================================ */
+/* The objects under test.  They are constructed once, as the class
+ * library intends, so that only Draw() gets timed. */
+
+/* The screw hides LoadContourPoint(); dig it back out, so that the
+ * screw gets the same contour as everything else. */
+class BenchScrew : public CgleScrew
+{
+public:
+	BenchScrew(int Points, int ContourPoints, double Radius, double Twist) :
+		CgleScrew(Points, ContourPoints, Radius, Twist) {}
+	using CgleTwistExtrusion::LoadContourPoint;
+};
+
+static CgleCylinderExtrusion *cylinder;
+static CgleConeExtrusion *cone;
+static CgleExtrusion *extrusion;
+static CgleTwistExtrusion *twist;
+static BenchScrew *screw;
+static CgleTaperExtrusion *tapered;
+static CgleIBeam *ibeam;
+static CgleSimpleBeam *simplebeam;
+static CgleTwistedIBeam *twistbeam;
+static CgleSimpleTwistedBeam *simpletwist;
+static CgleSpiralExtrusion *spiral;
+static CgleLatheExtrusion *lathe;
+static CgleHelicoidExtrusion *helicoid;
+static CgleToroidExtrusion *toroid;
+
+static void
+build (void)
+{
+   int j;
+
+   cylinder = new CgleCylinderExtrusion (NPTS, NSIDES);
+   cone = new CgleConeExtrusion (NPTS, NSIDES);
+
+   extrusion = new CgleExtrusion (NPTS, NCP, 1.0);
+   twist = new CgleTwistExtrusion (NPTS, NCP, 1.0);
+   screw = new BenchScrew (bench_nscrew, NCP, 1.0, TWIST);
+   tapered = new CgleTaperExtrusion (NPTS, NCP, 1.0, TWIST);
+   spiral = new CgleSpiralExtrusion (bench_nhelix, NULL, NCP, SWEEP, 1.0);
+   lathe = new CgleLatheExtrusion (bench_nhelix, NULL, NCP, SWEEP, 1.0);
+   for (j=0; j<=NCP; j++) {
+      extrusion->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+      twist->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+      screw->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+      tapered->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+      spiral->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+      lathe->LoadContourPoint (j, bench_contour[j][0], bench_contour[j][1]);
+   }
+
+   ibeam = new CgleIBeam (NPTS, 0.3);
+   simplebeam = new CgleSimpleBeam (NPTS, 0.3);
+   twistbeam = new CgleTwistedIBeam (NPTS, 0.3);
+   simpletwist = new CgleSimpleTwistedBeam (NPTS, 0.3);
+
+   helicoid = new CgleHelicoidExtrusion (bench_nhelix, NULL, SWEEP, NSIDES);
+   toroid = new CgleToroidExtrusion (bench_nhelix, NULL, SWEEP, NSIDES);
+}
+
+static void
+destroy (void)
+{
+   delete cylinder;
+   delete cone;
+   delete extrusion;
+   delete twist;
+   delete screw;
+   delete tapered;
+   delete ibeam;
+   delete simplebeam;
+   delete twistbeam;
+   delete simpletwist;
+   delete spiral;
+   delete lathe;
+   delete helicoid;
+   delete toroid;
+}
+
+/* ============================================================ */
+/* One Draw() call per class; the C core equivalents are in cglecore.c */
+
+#define STYLE_TUBE (GLE_NORM_EDGE | GLE_JN_ROUND | GLE_JN_CAP | GLE_CONTOUR_CLOSED)
+#define STYLE_FACET (GLE_NORM_FACET | GLE_JN_ANGLE | GLE_JN_CAP | GLE_CONTOUR_CLOSED)
+#define STYLE_TAPER (GLE_NORM_FACET | GLE_JN_ROUND | GLE_JN_CAP | GLE_CONTOUR_CLOSED)
+#define STYLE_HELIX (GLE_NORM_PATH_EDGE | GLE_JN_ROUND | GLE_JN_CAP | GLE_CONTOUR_CLOSED)
+
+typedef struct {
+   const char *name;
+   int style;           /* the join style the class draws with */
+   void (*cxx) (void);
+   void (*core) (void);
+   void (*build) (void);
+} benchCase;
+
+static void cxx_cylinder (void) { cylinder->Draw (bench_pts, bench_colors, 0.3); }
+static void cxx_cone (void) { cone->Draw (bench_pts, bench_colors, bench_radii); }
+static void cxx_extrusion (void) { extrusion->Draw (bench_pts, bench_colors); }
+static void cxx_twist (void) { twist->Draw (bench_pts, bench_colors, bench_twists); }
+static void cxx_screw (void) { screw->Draw (LENGTH, NULL); }
+static void cxx_taper (void) { tapered->Draw (LENGTH, 1.0, NULL); }
+static void cxx_ibeam (void) { ibeam->Draw (bench_pts, bench_colors); }
+static void cxx_simplebeam (void) { simplebeam->Draw (bench_colors, LENGTH); }
+static void cxx_twistbeam (void) { twistbeam->Draw (bench_pts, bench_colors, bench_twists); }
+static void cxx_simpletwist (void) { simpletwist->Draw (bench_colors, bench_twists, LENGTH); }
+static void cxx_spiral (void) { spiral->Draw (1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void cxx_lathe (void) { lathe->Draw (1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void cxx_helicoid (void) { helicoid->Draw (0.2, 1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void cxx_toroid (void) { toroid->Draw (0.2, 1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+
+/* and the same, built */
+static void build_cylinder (void) { cylinder->Build (bench_pts, bench_colors, 0.3); }
+static void build_cone (void) { cone->Build (bench_pts, bench_colors, bench_radii); }
+static void build_extrusion (void) { extrusion->Build (bench_pts, bench_colors); }
+static void build_twist (void) { twist->Build (bench_pts, bench_colors, bench_twists); }
+static void build_screw (void) { screw->Build (LENGTH, NULL); }
+static void build_taper (void) { tapered->Build (LENGTH, 1.0, NULL); }
+static void build_ibeam (void) { ibeam->Build (bench_pts, bench_colors); }
+static void build_simplebeam (void) { simplebeam->Build (bench_colors, LENGTH); }
+static void build_twistbeam (void) { twistbeam->Build (bench_pts, bench_colors, bench_twists); }
+static void build_simpletwist (void) { simpletwist->Build (bench_colors, bench_twists, LENGTH); }
+static void build_spiral (void) { spiral->Build (1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void build_lathe (void) { lathe->Build (1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void build_helicoid (void) { helicoid->Build (0.2, 1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+static void build_toroid (void) { toroid->Build (0.2, 1.0, 0.2, 0.0, 0.5, 0.0, NULL); }
+
+static benchCase cases[] = {
+   { "Cylinder",      STYLE_TUBE,  cxx_cylinder,    core_cylinder,    build_cylinder },
+   { "Cone",          STYLE_TUBE,  cxx_cone,        core_cone,        build_cone },
+   { "Extrusion",     STYLE_FACET, cxx_extrusion,   core_extrusion,   build_extrusion },
+   { "Twist",         STYLE_TAPER, cxx_twist,       core_twist,       build_twist },
+   { "Screw",         STYLE_FACET, cxx_screw,       core_screw,       build_screw },
+   { "Taper",         STYLE_TAPER, cxx_taper,       core_taper,       build_taper },
+   { "IBeam",         STYLE_FACET, cxx_ibeam,       core_ibeam,       build_ibeam },
+   { "SimpleBeam",    STYLE_FACET, cxx_simplebeam,  core_simplebeam,  build_simplebeam },
+   { "TwistedIBeam",  STYLE_FACET, cxx_twistbeam,   core_twistbeam,   build_twistbeam },
+   { "SimpleTwisted", STYLE_FACET, cxx_simpletwist, core_simpletwist, build_simpletwist },
+   { "Spiral",        STYLE_HELIX, cxx_spiral,      core_spiral,      build_spiral },
+   { "Lathe",         STYLE_HELIX, cxx_lathe,       core_lathe,       build_lathe },
+   { "Helicoid",      STYLE_HELIX, cxx_helicoid,    core_helicoid,    build_helicoid },
+   { "Toroid",        STYLE_HELIX, cxx_toroid,      core_toroid,      build_toroid },
+};
+
+/* ============================================================ */
+
+static double
+run (void (*draw) (void), int iters)
+{
+   clock_t start;
+   double secs;
+   int i;
+
+   start = clock();
+   for (i=0; i<iters; i++) (*draw) ();
+   secs = ((double) (clock() - start)) / ((double) CLOCKS_PER_SEC);
+   if (0.0 >= secs) secs = 1.0e-6;
+   return secs;
+}
+
+/* ============================================================ */
+
+int
+main (int argc, char * argv[])
+{
+   int iters = 2000;
+   int c;
+   double tcxx, tcore, tbuild, tbuilt;
+
+   if (1 < argc) iters = atoi (argv[1]);
+
+   bench_setup ();
+   InitializeExtrusionLib ();
+   build ();
+
+   printf ("%-14s %12s %12s %8s %12s %12s %8s\n", "class", "C++ calls/s",
+           "C calls/s", "C++/C", "builds/s", "built/s", "built/C");
+
+   for (c=0; c<(int)(sizeof(cases)/sizeof(benchCase)); c++) {
+      core_join_style (cases[c].style);
+
+      /* warm up both, so that neither pays for first-touch */
+      (*cases[c].cxx) ();
+      (*cases[c].core) ();
+
+      tcxx = run (cases[c].cxx, iters);
+      tcore = run (cases[c].core, iters);
+
+      tbuild = run (cases[c].build, iters);
+      tbuilt = run (cases[c].cxx, iters);
+
+      printf ("%-14s %12.0f %12.0f %7.2fx %12.0f %12.0f %7.2fx\n", cases[c].name,
+              (double) iters / tcxx, (double) iters / tcore, tcore / tcxx,
+              (double) iters / tbuild, (double) iters / tbuilt, tcore / tbuilt);
+   }
+
+   destroy ();
+   ReleaseExtrusionLib ();
+   return 0;
+}
+
+/* ===================== END OF FILE ======================== */
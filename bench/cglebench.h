@@ -0,0 +1,68 @@
+/*
+ * FILE:
+ * cglebench.h
+ *
+ * FUNCTION:
+ * The inputs shared between the two halves of cglebench, and the C
+ * core side of it.  The C and C++ public headers cannot both be
+ * included in one file (they define the same texture-mode names, one
+ * as macros, the other as an enum), so the C core calls live in
+ * cglecore.c, and the C++ ones in cglebench.cpp.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#ifndef CGLEBENCH_H
+#define CGLEBENCH_H
+
+#define NPTS    32      /* points along the path */
+#define NCP     16      /* points on the contour */
+#define NSIDES  20      /* sides on cylinders, cones and toroids */
+#define NBEAM   12      /* points on the I-beam contour */
+
+#define SWEEP   720.0   /* degrees swept out by the helical shapes */
+#define TWIST   540.0   /* degrees of twist along the screw and taper */
+#define LENGTH  6.0     /* length of the screw, taper and beams */
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+extern double bench_pts[NPTS][3];
+extern float bench_colors[NPTS][3];
+extern double bench_radii[NPTS];
+extern double bench_twists[NPTS];
+
+/* closed contour, last point repeats the first */
+extern double bench_contour[NCP+1][2];
+
+/* number of points the C core puts on a helical path, and on a screw */
+extern int bench_nhelix;
+extern int bench_nscrew;
+
+extern void bench_setup (void);
+extern void core_join_style (int style);
+
+extern void core_cylinder (void);
+extern void core_cone (void);
+extern void core_extrusion (void);
+extern void core_twist (void);
+extern void core_screw (void);
+extern void core_taper (void);
+extern void core_ibeam (void);
+extern void core_simplebeam (void);
+extern void core_twistbeam (void);
+extern void core_simpletwist (void);
+extern void core_spiral (void);
+extern void core_lathe (void);
+extern void core_helicoid (void);
+extern void core_toroid (void);
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+#endif /* CGLEBENCH_H */
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,258 @@
+/*
+ * FILE:
+ * cglecore.c
+ *
+ * FUNCTION:
+ * The C core half of cglebench: the inputs shared with the C++ half,
+ * and, for each of the C++ extrusion classes, the call (or calls) into
+ * the C library that draws the same shape.  Where a class builds its
+ * own path or transforms (the screw, the taper, the simple beams), the
+ * same arrays are built here, the same way, once, up front.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "gle.h"
+#include "cglebench.h"
+
+double bench_pts[NPTS][3];
+float bench_colors[NPTS][3];
+double bench_radii[NPTS];
+double bench_twists[NPTS];
+double bench_contour[NCP+1][2];
+int bench_nhelix;
+int bench_nscrew;
+
+static gleDouble up[3] = { 0.0, 0.0, 1.0 };
+static gleDouble cont_normal[NCP+1][2];
+
+static gleDouble beam[NBEAM+1][2];
+static gleDouble beam_normal[NBEAM+1][2];
+
+/* the straight spine that the simple beams build for themselves, and
+ * the path and transforms that the taper builds.  The classes repeat
+ * the first and last points; the C core complains about a zero-length
+ * first segment, so here those points are stepped out by one segment
+ * instead.  They only give the direction of the end caps, which is the
+ * same either way, so the same shape gets drawn. */
+static gleDouble spine[NPTS][3];
+static gleDouble taper_path[NPTS][3];
+static gleAffine taper_xform[NPTS];
+
+/* ============================================================ */
+/* Contour normals, computed exactly as LoadContourPoint() does. */
+
+static void
+contour_normals (int n, gleDouble cont[][2], gleDouble norm[][2])
+{
+   int j;
+   double ax, ay, alen;
+
+   for (j=1; j<=n; j++) {
+      ax = cont[j][0] - cont[j-1][0];
+      ay = cont[j][1] - cont[j-1][1];
+      alen = 0.0;
+      if (!((ax == 0.0) && (ay == 0.0))) alen = sqrt (ax*ax + ay*ay);
+      if (alen != 0.0) alen = 1.0 / alen;
+      norm[j-1][0] = ay * alen;
+      norm[j-1][1] = - ax * alen;
+   }
+   norm[n][0] = norm[0][0];
+   norm[n][1] = norm[0][1];
+}
+
+/* ============================================================ */
+
+void
+bench_setup (void)
+{
+   static const double ibeam[NBEAM+1][2] = {
+      { 1.0, 1.0 }, { -1.0, 1.0 }, { -1.0, 0.9 }, { -0.15, 0.9 },
+      { -0.15, -0.9 }, { -1.0, -0.9 }, { -1.0, -1.0 }, { 1.0, -1.0 },
+      { 1.0, -0.9 }, { 0.15, -0.9 }, { 0.15, 0.9 }, { 1.0, 0.9 },
+      { 1.0, 1.0 } };
+   double interval, end, taper, taper_z, taper_step, ang, delang;
+   int i, j;
+
+   for (i=0; i<NPTS; i++) {
+      bench_pts[i][0] = 2.0 * cos (0.3 * (double) i);
+      bench_pts[i][1] = 2.0 * sin (0.3 * (double) i);
+      bench_pts[i][2] = 0.25 * (double) i;
+      bench_colors[i][0] = (float) i / (float) NPTS;
+      bench_colors[i][1] = 0.5f;
+      bench_colors[i][2] = 1.0f - (float) i / (float) NPTS;
+      bench_radii[i] = 0.3 + 0.1 * sin (0.5 * (double) i);
+      bench_twists[i] = 10.0 * (double) i;
+   }
+
+   /* a slightly squashed circle */
+   for (j=0; j<NCP; j++) {
+      bench_contour[j][0] = 0.4 * cos (2.0 * M_PI * (double) j / (double) NCP);
+      bench_contour[j][1] = 0.3 * sin (2.0 * M_PI * (double) j / (double) NCP);
+   }
+   bench_contour[NCP][0] = bench_contour[0][0];
+   bench_contour[NCP][1] = bench_contour[0][1];
+   contour_normals (NCP, bench_contour, cont_normal);
+
+   /* the I-beam, at the radius the beams are built with */
+   for (j=0; j<=NBEAM; j++) {
+      beam[j][0] = 0.3 * ibeam[j][0];
+      beam[j][1] = 0.3 * ibeam[j][1];
+   }
+   contour_normals (NBEAM, beam, beam_normal);
+
+   /* as in CgleSimpleBeam::Draw() */
+   interval = LENGTH / (double) (NPTS - 3);
+   end = LENGTH / 2.0;
+   for (i=0; i<NPTS; i++) {
+      spine[i][0] = 0.0;
+      spine[i][1] = 0.0;
+      spine[i][2] = -end + interval * (double) (i - 1);
+   }
+   spine[1][2] = -end;
+   spine[NPTS-2][2] = end;
+
+   /* as in CgleTaperExtrusion::Draw(), with a distortion of one */
+   taper_z = -0.9999;
+   taper_step = 1.9998 / (double) (NPTS - 3);
+   delang = 2.0 * (TWIST / (double) (NPTS - 3));
+   ang = -delang;
+   for (i=1; i<NPTS-1; i++) {
+      taper_path[i][0] = 0.0;
+      taper_path[i][1] = 0.0;
+      taper_path[i][2] = -end + interval * (double) (i - 2);
+      taper = 1.0 - fabs (taper_z);
+      taper_z += taper_step;
+      taper_xform[i][0][0] = taper * cos (ang);
+      taper_xform[i][0][1] = - taper * sin (ang);
+      taper_xform[i][0][2] = 0.0;
+      taper_xform[i][1][0] = taper * sin (ang);
+      taper_xform[i][1][1] = taper * cos (ang);
+      taper_xform[i][1][2] = 0.0;
+      ang += delang;
+   }
+   taper_path[0][0] = taper_path[0][1] = 0.0;
+   taper_path[0][2] = taper_path[1][2] - interval;
+   taper_path[NPTS-1][0] = taper_path[NPTS-1][1] = 0.0;
+   taper_path[NPTS-1][2] = taper_path[NPTS-2][2] + interval;
+   for (j=0; j<3; j++) {
+      taper_xform[0][0][j] = taper_xform[1][0][j];
+      taper_xform[0][1][j] = taper_xform[1][1][j];
+      taper_xform[NPTS-1][0][j] = taper_xform[NPTS-2][0][j];
+      taper_xform[NPTS-1][1][j] = taper_xform[NPTS-2][1][j];
+   }
+
+   /* the same number of points that gleSpiral() and gleScrew() use */
+   bench_nhelix = (int) ((((double) NSIDES) / 360.0) * SWEEP) + 4;
+   bench_nscrew = (int) fabs (TWIST / 18.0) + 4;
+
+   gleSetNumSides (NSIDES);
+}
+
+/* ============================================================ */
+
+void
+core_join_style (int style)
+{
+   gleSetJoinStyle (style);
+}
+
+void
+core_cylinder (void)
+{
+   glePolyCylinder (NPTS, bench_pts, bench_colors, 0.3);
+}
+
+void
+core_cone (void)
+{
+   glePolyCone (NPTS, bench_pts, bench_colors, bench_radii);
+}
+
+void
+core_extrusion (void)
+{
+   gleExtrusion (NCP, bench_contour, cont_normal, NULL,
+                 NPTS, bench_pts, bench_colors);
+}
+
+void
+core_twist (void)
+{
+   gleTwistExtrusion (NCP, bench_contour, cont_normal, NULL,
+                      NPTS, bench_pts, bench_colors, bench_twists);
+}
+
+void
+core_screw (void)
+{
+   gleScrew (NCP, bench_contour, cont_normal, NULL, 0.0, LENGTH, TWIST);
+}
+
+void
+core_taper (void)
+{
+   gleSuperExtrusion (NCP, bench_contour, cont_normal, NULL,
+                      NPTS, taper_path, NULL, taper_xform);
+}
+
+void
+core_ibeam (void)
+{
+   gleExtrusion (NBEAM, beam, beam_normal, NULL,
+                 NPTS, bench_pts, bench_colors);
+}
+
+void
+core_simplebeam (void)
+{
+   gleExtrusion (NBEAM, beam, beam_normal, NULL,
+                 NPTS, spine, bench_colors);
+}
+
+void
+core_twistbeam (void)
+{
+   gleTwistExtrusion (NBEAM, beam, beam_normal, NULL,
+                      NPTS, bench_pts, bench_colors, bench_twists);
+}
+
+void
+core_simpletwist (void)
+{
+   gleTwistExtrusion (NBEAM, beam, beam_normal, NULL,
+                      NPTS, spine, bench_colors, bench_twists);
+}
+
+void
+core_spiral (void)
+{
+   gleSpiral (NCP, bench_contour, cont_normal, up, 1.0, 0.2, 0.0, 0.5,
+              NULL, NULL, 0.0, SWEEP);
+}
+
+void
+core_lathe (void)
+{
+   gleLathe (NCP, bench_contour, cont_normal, up, 1.0, 0.2, 0.0, 0.5,
+             NULL, NULL, 0.0, SWEEP);
+}
+
+void
+core_helicoid (void)
+{
+   gleHelicoid (0.2, 1.0, 0.2, 0.0, 0.5, NULL, NULL, 0.0, SWEEP);
+}
+
+void
+core_toroid (void)
+{
+   gleToroid (0.2, 1.0, 0.2, 0.0, 0.5, NULL, NULL, 0.0, SWEEP);
+}
+
+/* ===================== END OF FILE ======================== */
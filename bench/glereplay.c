@@ -0,0 +1,636 @@
+/*
+ * FILE:
+ * glereplay.c
+ *
+ * FUNCTION:
+ * Headless replay of a call trace written by gleTraceOpen(), for
+ * profiling a production workload away from the application that
+ * produced it.  The trace is read, and decoded, in full before
+ * anything is timed; then the calls are made again, in the order they
+ * were recorded, each one timed on its own.  Reported are the time of
+ * each kind of call, and with -v the time of each call, as the mean
+ * over the iterations and the best of them.
+ *
+ * Without a GL context the GL calls are no-ops, so this measures the
+ * geometry work only.  Lighting is one thing GL can't then report:
+ * the polycylinder, polycone, helicoid and toroid skip their normals
+ * when lighting is off, and calls recorded with lighting on will do
+ * less work here than they did in the application.  A warning is
+ * printed when that is so.
+ *
+ * Usage: glereplay [-n iterations] [-v] [-s] tracefile
+ *
+ *    -n  play the trace this many times (default 1)
+ *    -v  report each call, not just each kind of call
+ *    -s  print the library's run-time statistics; see gleGetStats()
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gle.h"
+#include "port.h"
+#include "trace.h"
+
+#define NUM_OPS 32
+
+static const char * op_name[NUM_OPS] = {
+   0x0, "join_style", "num_sides", "texture_mode", "origin",
+   0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+   "polycylinder", "polycone", "extrusion", "twist_extrusion",
+   "super_extrusion", "spiral", "lathe", "helicoid", "toroid", "screw",
+};
+
+/* one decoded call */
+typedef struct {
+   int op;
+   int flags;
+   int value;                     /* the settings */
+   int ncp;
+   gleDouble (*contour)[2];
+   gleDouble (*cont_normal)[2];
+   gleDouble *up;
+   int npoints;
+   gleDouble (*points)[3];
+   float *colors;
+   gleDouble *scalars;            /* radii, or twists */
+   gleAffine *xforms;
+   gleAffine *start_xform;
+   gleAffine *delta_xform;
+   gleDouble arg[8];              /* radius, origin, helix or screw */
+
+   double seconds;                /* summed over the iterations */
+   double best;
+} Call;
+
+/* ============================================================ */
+/* a monotonic clock, in seconds; as in src/stats.c */
+
+static double
+now (void)
+{
+#if defined(WIN32)
+   LARGE_INTEGER t, freq;
+
+   QueryPerformanceCounter (&t);
+   QueryPerformanceFrequency (&freq);
+   return ((double) t.QuadPart) / ((double) freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+   struct timespec t;
+
+   clock_gettime (CLOCK_MONOTONIC, &t);
+   return ((double) t.tv_sec) + 1.0e-9 * ((double) t.tv_nsec);
+#else
+   return ((double) clock ()) / ((double) CLOCKS_PER_SEC);
+#endif
+}
+
+/* ============================================================ */
+/* Decoding.  The reader is bounded by the end of the record; reading
+ * past it marks the record bad, and yields zeros. */
+
+typedef struct {
+   const unsigned char *p;
+   const unsigned char *end;
+   int bad;
+} Reader;
+
+static const unsigned char *
+take (Reader *r, size_t n)
+{
+   const unsigned char *p = r->p;
+
+   if (r->bad || ((size_t) (r->end - r->p) < n)) {
+      r->bad = 1;
+      return 0x0;
+   }
+   r->p += n;
+   return p;
+}
+
+static int
+get_u8 (Reader *r)
+{
+   const unsigned char *p = take (r, 1);
+   return p ? p[0] : 0;
+}
+
+static unsigned long
+get_u32 (Reader *r)
+{
+   const unsigned char *p = take (r, 4);
+
+   if (!p) return 0;
+   return ((unsigned long) p[0]) | (((unsigned long) p[1]) << 8) |
+          (((unsigned long) p[2]) << 16) | (((unsigned long) p[3]) << 24);
+}
+
+static int
+get_i32 (Reader *r)
+{
+   unsigned long v = get_u32 (r);
+
+   if (v & 0x80000000UL) return - (int) (0xffffffffUL - v) - 1;
+   return (int) v;
+}
+
+/* copy n little-endian bytes into the host's order */
+static void
+get_swapped (Reader *r, void *value, size_t n)
+{
+   unsigned int one = 1;
+   const unsigned char *p = take (r, n);
+   size_t i;
+
+   if (!p) {
+      memset (value, 0, n);
+   } else if (0 == *((unsigned char *) &one)) {
+      for (i=0; i<n; i++) ((unsigned char *) value)[i] = p[n-1-i];
+   } else {
+      memcpy (value, p, n);
+   }
+}
+
+static gleDouble
+get_f64 (Reader *r)
+{
+   double v;
+   get_swapped (r, &v, sizeof (double));
+   return (gleDouble) v;
+}
+
+/* An array of n doubles; NULL for an empty one.  The
+ * count is checked against what is left of the record before any
+ * memory is asked for. */
+static gleDouble *
+get_f64s (Reader *r, int n)
+{
+   gleDouble *v;
+   int i;
+
+   if ((0 > n) || ((size_t) (r->end - r->p) / 8 < (size_t) n)) {
+      r->bad = 1;
+      return 0x0;
+   }
+   if (0 == n) return 0x0;
+   v = (gleDouble *) malloc ((size_t) n * sizeof (gleDouble));
+   for (i=0; i<n; i++) v[i] = get_f64 (r);
+   return v;
+}
+
+static gleDouble *
+get_opt_f64s (Reader *r, int n)
+{
+   return get_u8 (r) ? get_f64s (r, n) : 0x0;
+}
+
+static float *
+get_opt_f32s (Reader *r, int n)
+{
+   float *v;
+   int i;
+
+   if (!get_u8 (r)) return 0x0;
+   if ((0 >= n) || ((size_t) (r->end - r->p) / 4 < (size_t) n)) {
+      r->bad = 1;
+      return 0x0;
+   }
+   v = (float *) malloc ((size_t) n * sizeof (float));
+   for (i=0; i<n; i++) get_swapped (r, &v[i], sizeof (float));
+   return v;
+}
+
+static void
+get_contour (Reader *r, Call *c)
+{
+   c->ncp = get_i32 (r);
+   c->contour = (gleDouble (*)[2]) get_f64s (r, 2*c->ncp);
+   c->cont_normal = (gleDouble (*)[2]) get_opt_f64s (r, 2*c->ncp);
+   c->up = get_opt_f64s (r, 3);
+}
+
+static void
+get_path (Reader *r, Call *c)
+{
+   c->npoints = get_i32 (r);
+   c->points = (gleDouble (*)[3]) get_f64s (r, 3*c->npoints);
+   c->colors = get_opt_f32s (r,
+                  ((c->flags & GLE_TRACE_C4F) ? 4 : 3) * c->npoints);
+}
+
+static void
+get_helix (Reader *r, Call *c)
+{
+   int i;
+
+   for (i=1; i<5; i++) c->arg[i] = get_f64 (r);
+   c->start_xform = (gleAffine *) get_opt_f64s (r, 6);
+   c->delta_xform = (gleAffine *) get_opt_f64s (r, 6);
+   c->arg[5] = get_f64 (r);
+   c->arg[6] = get_f64 (r);
+}
+
+/* returns 0 if the record is malformed */
+static int
+decode (Reader *r, Call *c)
+{
+   switch (c->op) {
+      case GLE_TRACE_JOIN_STYLE:
+      case GLE_TRACE_NUM_SIDES:
+      case GLE_TRACE_TEXTURE_MODE:
+         c->value = get_i32 (r);
+         break;
+
+      case GLE_TRACE_ORIGIN:
+         c->arg[0] = get_f64 (r);
+         c->arg[1] = get_f64 (r);
+         c->arg[2] = get_f64 (r);
+         break;
+
+      case GLE_TRACE_POLYCYLINDER:
+         c->flags = get_u8 (r);
+         get_path (r, c);
+         c->arg[0] = get_f64 (r);
+         break;
+
+      case GLE_TRACE_POLYCONE:
+         c->flags = get_u8 (r);
+         get_path (r, c);
+         c->scalars = get_opt_f64s (r, c->npoints);
+         break;
+
+      case GLE_TRACE_EXTRUSION:
+      case GLE_TRACE_TWIST_EXTRUSION:
+      case GLE_TRACE_SUPER_EXTRUSION:
+         c->flags = get_u8 (r);
+         get_contour (r, c);
+         get_path (r, c);
+         if (GLE_TRACE_TWIST_EXTRUSION == c->op) {
+            c->scalars = get_opt_f64s (r, c->npoints);
+         }
+         if (GLE_TRACE_SUPER_EXTRUSION == c->op) {
+            c->xforms = (gleAffine *) get_opt_f64s (r, 6*c->npoints);
+         }
+         break;
+
+      case GLE_TRACE_SPIRAL:
+      case GLE_TRACE_LATHE:
+         c->flags = get_u8 (r);
+         get_contour (r, c);
+         get_helix (r, c);
+         break;
+
+      case GLE_TRACE_HELICOID:
+      case GLE_TRACE_TOROID:
+         c->flags = get_u8 (r);
+         c->arg[0] = get_f64 (r);
+         get_helix (r, c);
+         break;
+
+      case GLE_TRACE_SCREW:
+         c->flags = get_u8 (r);
+         get_contour (r, c);
+         c->arg[0] = get_f64 (r);
+         c->arg[1] = get_f64 (r);
+         c->arg[2] = get_f64 (r);
+         break;
+
+      default:
+         return 0;
+   }
+   return !r->bad;
+}
+
+/* Reads the whole trace.  Records of a kind this tool doesn't know are
+ * skipped, with a warning; a truncated or malformed one ends the
+ * trace there. */
+static Call *
+load (const char *filename, int *ncalls)
+{
+   FILE *file;
+   unsigned char *data;
+   long size;
+   Reader r, rec;
+   Call *calls;
+   int n, skipped;
+   unsigned long len;
+
+   file = fopen (filename, "rb");
+   if (!file) {
+      perror (filename);
+      return 0x0;
+   }
+   fseek (file, 0, SEEK_END);
+   size = ftell (file);
+   fseek (file, 0, SEEK_SET);
+   data = (unsigned char *) malloc ((size_t) size + 1);
+   if (!data || ((size_t) size != fread (data, 1, (size_t) size, file))) {
+      fprintf (stderr, "%s: could not be read\n", filename);
+      fclose (file);
+      return 0x0;
+   }
+   fclose (file);
+
+   r.p = data + 8;
+   r.end = data + size;
+   r.bad = 0;
+   if ((12 > size) || memcmp (data, GLE_TRACE_MAGIC, 8) ||
+       (GLE_TRACE_VERSION != get_u32 (&r))) {
+      fprintf (stderr, "%s: not a version %d GLE trace\n",
+               filename, GLE_TRACE_VERSION);
+      return 0x0;
+   }
+
+   /* a record is at least five bytes; that bounds the count */
+   calls = (Call *) calloc ((size_t) size / 5 + 1, sizeof (Call));
+   n = 0;
+   skipped = 0;
+   while (r.p < r.end) {
+      calls[n].op = get_u8 (&r);
+      len = get_u32 (&r);
+      if (r.bad || ((unsigned long) (r.end - r.p) < len)) {
+         fprintf (stderr, "%s: truncated after %d calls\n", filename, n);
+         break;
+      }
+      rec.p = r.p;
+      rec.end = r.p + len;
+      rec.bad = 0;
+      r.p += len;
+
+      if ((NUM_OPS <= calls[n].op) || !op_name[calls[n].op]) {
+         skipped ++;
+         continue;
+      }
+      if (!decode (&rec, &calls[n])) {
+         fprintf (stderr, "%s: malformed %s after %d calls\n",
+                  filename, op_name[calls[n].op], n);
+         break;
+      }
+      n ++;
+   }
+   if (skipped) {
+      fprintf (stderr, "%s: skipped %d records of unknown kinds\n",
+               filename, skipped);
+   }
+
+   free (data);
+   *ncalls = n;
+   return calls;
+}
+
+/* ============================================================ */
+
+static void
+play (Call *c)
+{
+   int c4f = c->flags & GLE_TRACE_C4F;
+
+   switch (c->op) {
+      case GLE_TRACE_JOIN_STYLE:
+         gleSetJoinStyle (c->value);
+         break;
+
+      case GLE_TRACE_NUM_SIDES:
+         gleSetNumSides (c->value);
+         break;
+
+      case GLE_TRACE_TEXTURE_MODE:
+         gleTextureMode (c->value);
+         break;
+
+      case GLE_TRACE_ORIGIN:
+         gleSetOrigin (c->arg);
+         break;
+
+      case GLE_TRACE_POLYCYLINDER:
+         if (c4f) {
+            glePolyCylinder_c4f (c->npoints, c->points,
+                     (gleColor4f *) c->colors, c->arg[0]);
+         } else {
+            glePolyCylinder (c->npoints, c->points,
+                     (gleColor *) c->colors, c->arg[0]);
+         }
+         break;
+
+      case GLE_TRACE_POLYCONE:
+         if (c4f) {
+            glePolyCone_c4f (c->npoints, c->points,
+                     (gleColor4f *) c->colors, c->scalars);
+         } else {
+            glePolyCone (c->npoints, c->points,
+                     (gleColor *) c->colors, c->scalars);
+         }
+         break;
+
+      case GLE_TRACE_EXTRUSION:
+         if (c4f) {
+            gleExtrusion_c4f (c->ncp, c->contour, c->cont_normal, c->up,
+                     c->npoints, c->points, (gleColor4f *) c->colors);
+         } else {
+            gleExtrusion (c->ncp, c->contour, c->cont_normal, c->up,
+                     c->npoints, c->points, (gleColor *) c->colors);
+         }
+         break;
+
+      case GLE_TRACE_TWIST_EXTRUSION:
+         if (c4f) {
+            gleTwistExtrusion_c4f (c->ncp, c->contour, c->cont_normal,
+                     c->up, c->npoints, c->points,
+                     (gleColor4f *) c->colors, c->scalars);
+         } else {
+            gleTwistExtrusion (c->ncp, c->contour, c->cont_normal,
+                     c->up, c->npoints, c->points,
+                     (gleColor *) c->colors, c->scalars);
+         }
+         break;
+
+      case GLE_TRACE_SUPER_EXTRUSION:
+         if (c4f) {
+            gleSuperExtrusion_c4f (c->ncp, c->contour, c->cont_normal,
+                     c->up, c->npoints, c->points,
+                     (gleColor4f *) c->colors, c->xforms);
+         } else {
+            gleSuperExtrusion (c->ncp, c->contour, c->cont_normal,
+                     c->up, c->npoints, c->points,
+                     (gleColor *) c->colors, c->xforms);
+         }
+         break;
+
+      case GLE_TRACE_SPIRAL:
+         gleSpiral (c->ncp, c->contour, c->cont_normal, c->up,
+                  c->arg[1], c->arg[2], c->arg[3], c->arg[4],
+                  c->start_xform ? *c->start_xform : 0x0,
+                  c->delta_xform ? *c->delta_xform : 0x0,
+                  c->arg[5], c->arg[6]);
+         break;
+
+      case GLE_TRACE_LATHE:
+         gleLathe (c->ncp, c->contour, c->cont_normal, c->up,
+                  c->arg[1], c->arg[2], c->arg[3], c->arg[4],
+                  c->start_xform ? *c->start_xform : 0x0,
+                  c->delta_xform ? *c->delta_xform : 0x0,
+                  c->arg[5], c->arg[6]);
+         break;
+
+      case GLE_TRACE_HELICOID:
+         gleHelicoid (c->arg[0],
+                  c->arg[1], c->arg[2], c->arg[3], c->arg[4],
+                  c->start_xform ? *c->start_xform : 0x0,
+                  c->delta_xform ? *c->delta_xform : 0x0,
+                  c->arg[5], c->arg[6]);
+         break;
+
+      case GLE_TRACE_TOROID:
+         gleToroid (c->arg[0],
+                  c->arg[1], c->arg[2], c->arg[3], c->arg[4],
+                  c->start_xform ? *c->start_xform : 0x0,
+                  c->delta_xform ? *c->delta_xform : 0x0,
+                  c->arg[5], c->arg[6]);
+         break;
+
+      case GLE_TRACE_SCREW:
+         gleScrew (c->ncp, c->contour, c->cont_normal, c->up,
+                  c->arg[0], c->arg[1], c->arg[2]);
+         break;
+
+      default:
+         break;
+   }
+}
+
+/* ============================================================ */
+
+static void
+usage (void)
+{
+   fprintf (stderr, "usage: glereplay [-n iterations] [-v] [-s] "
+                    "tracefile\n");
+   exit (1);
+}
+
+int
+main (int argc, char * argv[])
+{
+   Call *calls;
+   int ncalls, iters, verbose, stats;
+   int i, k, count, lit;
+   double start, t, total, best, sum;
+   gleStats s;
+   const char *filename;
+
+   iters = 1;
+   verbose = 0;
+   stats = 0;
+   filename = 0x0;
+   for (i=1; i<argc; i++) {
+      if (0 == strcmp (argv[i], "-n") && (i+1 < argc)) {
+         iters = atoi (argv[++i]);
+         if (1 > iters) usage ();
+      } else if (0 == strcmp (argv[i], "-v")) {
+         verbose = 1;
+      } else if (0 == strcmp (argv[i], "-s")) {
+         stats = 1;
+      } else if (('-' != argv[i][0]) && !filename) {
+         filename = argv[i];
+      } else {
+         usage ();
+      }
+   }
+   if (!filename) usage ();
+
+   calls = load (filename, &ncalls);
+   if (!calls) return 1;
+
+   lit = 0;
+   for (i=0; i<ncalls; i++) {
+      if (calls[i].flags & GLE_TRACE_LIGHTING) lit ++;
+      calls[i].best = 1.0e30;
+   }
+   if (lit) {
+      /* see whether GL can tell us lighting is on */
+      glEnable (GL_LIGHTING);
+      if (!glIsEnabled (GL_LIGHTING)) {
+         fprintf (stderr, "glereplay: warning: %d calls were recorded "
+                  "with lighting on; without a GL context, they are "
+                  "replayed without normals\n", lit);
+      }
+   }
+
+   if (stats) gleEnableStats (1);
+
+   for (k=0; k<iters; k++) {
+      for (i=0; i<ncalls; i++) {
+         if (GLE_TRACE_POLYCYLINDER <= calls[i].op) {
+            if (calls[i].flags & GLE_TRACE_LIGHTING) {
+               glEnable (GL_LIGHTING);
+            } else {
+               glDisable (GL_LIGHTING);
+            }
+         }
+         start = now ();
+         play (&calls[i]);
+         t = now () - start;
+         calls[i].seconds += t;
+         if (t < calls[i].best) calls[i].best = t;
+      }
+   }
+
+   printf ("%s: %d calls, %d iterations\n", filename, ncalls, iters);
+
+   if (verbose) {
+      printf ("\n%6s  %-16s %8s %8s %12s %12s\n", "call", "kind",
+              "points", "contour", "mean usec", "best usec");
+      for (i=0; i<ncalls; i++) {
+         printf ("%6d  %-16s %8d %8d %12.2f %12.2f\n", i,
+                 op_name[calls[i].op], calls[i].npoints, calls[i].ncp,
+                 1.0e6 * calls[i].seconds / (double) iters,
+                 1.0e6 * calls[i].best);
+      }
+   }
+
+   printf ("\n%-16s %8s %12s %12s %12s\n", "kind", "calls",
+           "msec/iter", "mean usec", "best usec");
+   total = 0.0;
+   for (k=0; k<NUM_OPS; k++) {
+      count = 0;
+      sum = 0.0;
+      best = 0.0;
+      for (i=0; i<ncalls; i++) {
+         if (calls[i].op != k) continue;
+         count ++;
+         sum += calls[i].seconds;
+         best += calls[i].best;
+      }
+      if (0 == count) continue;
+      total += sum;
+      printf ("%-16s %8d %12.3f %12.2f %12.2f\n", op_name[k], count,
+              1.0e3 * sum / (double) iters,
+              1.0e6 * sum / (double) (iters * count),
+              1.0e6 * best / (double) count);
+   }
+   printf ("%-16s %8d %12.3f\n", "total", ncalls,
+           1.0e3 * total / (double) iters);
+
+   if (stats) {
+      gleGetStats (&s);
+      printf ("\nsegments %lu, vertices %lu, normals %lu, colors %lu, "
+              "tessellations %lu, mallocs %lu (%lu bytes)\n",
+              (unsigned long) s.segments, (unsigned long) s.vertices,
+              (unsigned long) s.normals, (unsigned long) s.colors,
+              (unsigned long) s.tessellations, (unsigned long) s.mallocs,
+              (unsigned long) s.malloc_bytes);
+      printf ("seconds: setup %.4f, join %.4f, cap %.4f, emit %.4f\n",
+              s.seconds[GLE_STATS_SETUP], s.seconds[GLE_STATS_JOIN],
+              s.seconds[GLE_STATS_CAP], s.seconds[GLE_STATS_EMIT]);
+   }
+
+   return 0;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,181 @@
+/*
+ * FILE:
+ * poolstress.cpp
+ *
+ * FUNCTION:
+ * Stress test for CgleThreadPool, the work-stealing pool that the
+ * BuildAsync functions run on.  Each round submits a handful of root
+ * tasks from outside the pool, and each task submits more from
+ * inside it, down to a fixed depth, so that the workers' own queues,
+ * the stealing between them and the outside queueing are all busy
+ * at once.  A second thread submits plain tasks from outside while
+ * the trees unfold.  Some of the leaves build a small cylinder, to
+ * have the per-thread scratch of the extrusion code in play as well.
+ *
+ * After each round's Wait() returns, every task submitted must have
+ * finished; a count short of that means Wait() returned early.  The
+ * last round destroys the pool with the trees still unfolding, which
+ * must run them all to the end.
+ *
+ * The point is to run it under ThreadSanitizer; build it with
+ * -fsanitize=thread (see README).  Exits non-zero on any failure.
+ *
+ * Usage: poolstress [rounds] [workers]
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <thread>
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "ExtrusionLib.h"
+
+#define ROOTS		8
+#define FANOUT		3
+#define DEPTH		5	/* each tree is 1 + 3 + ... + 3^5 = 364 tasks */
+#define OUTSIDE		500	/* plain tasks from the second thread, per round */
+#define BUILD_EVERY	16	/* a leaf in so many builds a cylinder */
+
+static std::atomic<int> finished;	/* tasks that have run to the end */
+static std::atomic<int> bad_meshes;
+static int vertices;			/* in each cylinder */
+
+/* ============================================================ */
+
+static void
+build_cylinder (CgleMesh &mesh)
+{
+   double path[4][3] = { {0.0, 0.0, -1.0}, {0.0, 0.0, 0.0},
+                         {0.0, 0.0, 1.0}, {0.0, 0.0, 2.0} };
+
+   CgleCylinderExtrusion cylinder (4, 6);
+   cylinder.Build (path, NULL, 0.5);
+   mesh = cylinder.TakeMesh ();
+}
+
+/* A task submits its children before it finishes, so a child can
+ * run, and finish, on another worker before its parent does. */
+static void
+task (CgleThreadPool *pool, int depth, int serial)
+{
+   int i;
+
+   if (depth < DEPTH) {
+      for (i=0; i<FANOUT; i++) {
+         int child = serial * FANOUT + i;
+         pool->Submit ([pool, depth, child] () { task (pool, depth + 1, child); });
+      }
+   } else if (0 == serial % BUILD_EVERY) {
+      CgleMesh mesh;
+      build_cylinder (mesh);
+      if (mesh.GetVertexCount () != vertices) bad_meshes.fetch_add (1);
+   }
+
+   finished.fetch_add (1);
+}
+
+static int
+tree_size (void)
+{
+   int n = 0, level = 1, d;
+
+   for (d=0; d<=DEPTH; d++) {
+      n += level;
+      level *= FANOUT;
+   }
+   return n;
+}
+
+/* Submits the roots from this thread, and plain tasks from another */
+static void
+start_round (CgleThreadPool *pool, std::thread *outside)
+{
+   int r;
+
+   *outside = std::thread ([pool] () {
+      int i;
+      for (i=0; i<OUTSIDE; i++) {
+         pool->Submit ([] () { finished.fetch_add (1); });
+      }
+   });
+
+   for (r=0; r<ROOTS; r++) {
+      pool->Submit ([pool, r] () { task (pool, 0, r); });
+   }
+}
+
+/* ============================================================ */
+
+int
+main (int argc, char * argv[])
+{
+   int rounds = 50;
+   int workers = 4;
+   int round, expected, failures = 0;
+   std::thread outside;
+
+   if (1 < argc) rounds = atoi (argv[1]);
+   if (2 < argc) workers = atoi (argv[2]);
+   if (0 >= rounds) rounds = 1;
+
+   InitializeExtrusionLib ();
+
+   CgleMesh reference;
+   build_cylinder (reference);
+   vertices = reference.GetVertexCount ();
+
+   expected = ROOTS * tree_size () + OUTSIDE;
+
+   {
+      CgleThreadPool pool (workers);
+
+      for (round=0; round<rounds; round++) {
+         finished.store (0);
+         start_round (&pool, &outside);
+
+         /* Wait() only covers what has been submitted when it is called,
+          * so the outside thread has to be done submitting first */
+         outside.join ();
+         pool.Wait ();
+
+         if (finished.load () != expected) {
+            printf ("round %d: Wait() returned with %d of %d tasks finished\n",
+                    round, finished.load (), expected);
+            failures ++;
+         }
+      }
+
+      printf ("%d workers, %d rounds of %d tasks\n", pool.GetThreadCount (),
+              rounds, expected);
+
+      /* and once more, leaving the destructor to finish the round */
+      finished.store (0);
+      start_round (&pool, &outside);
+      outside.join ();
+   }
+
+   if (finished.load () != expected) {
+      printf ("destroying the pool ran %d of %d tasks\n", finished.load (),
+              expected);
+      failures ++;
+   }
+   if (0 != bad_meshes.load ()) {
+      printf ("%d cylinders came out wrong\n", bad_meshes.load ());
+      failures += bad_meshes.load ();
+   }
+
+   printf ("%s: %d failures\n", failures ? "FAILED" : "passed", failures);
+
+   ReleaseExtrusionLib ();
+   return failures ? 1 : 0;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,197 @@
+/*
+ * FILE:
+ * queuestress.cpp
+ *
+ * FUNCTION:
+ * Stress test for CgleMeshQueue, the lock-free ring that carries
+ * built meshes from the threads that build them to the one thread
+ * that may call GL.  Four producer threads each build a run of small
+ * cylinders and submit them, while the main thread, standing in for
+ * the GL thread, drains the queue a few meshes at a time and, now
+ * and then, dawdles, so that the ring fills and the producers stall.
+ *
+ * Every mesh is checked on the way out: the meshes from any one
+ * producer must arrive in the order it submitted them, and each must
+ * be the one its tag says it is.  One of the producers uses
+ * TrySubmit, spinning when the ring is full, the others Submit.
+ *
+ * The point is to run it under ThreadSanitizer; build it with
+ * -fsanitize=thread (see README).  Exits non-zero if any mesh was
+ * lost, duplicated, reordered or mangled.
+ *
+ * Usage: queuestress [meshes per producer]
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "ExtrusionLib.h"
+
+#define NPRODUCERS	4
+#define CAPACITY	8	/* small, so that the ring fills often */
+#define NSIDES		5
+#define RADIUS		0.25
+
+/* ============================================================ */
+/* Each mesh is a short cylinder standing at x = tag, so the
+ * consumer can tell from the vertices alone which one it got. */
+
+static void
+build_mesh (int tag, CgleMesh &mesh)
+{
+   double path[4][3];
+   int i;
+
+   for (i=0; i<4; i++) {
+      path[i][0] = (double) tag;
+      path[i][1] = 0.0;
+      path[i][2] = (double) (i - 1);
+   }
+
+   CgleCylinderExtrusion cylinder (4, NSIDES);
+   cylinder.Build (path, NULL, RADIUS);
+   mesh = cylinder.TakeMesh ();
+}
+
+static int
+mesh_tag (const CgleMesh &mesh)
+{
+   const float *v = mesh.GetVertices ();
+   double sum = 0.0;
+   int i, n = mesh.GetVertexCount ();
+
+   if (0 == n) return -1;
+   for (i=0; i<n; i++) sum += v[3*i];
+   return (int) floor (sum / (double) n + 0.5);
+}
+
+/* ============================================================ */
+
+static void
+produce (CgleMeshQueue *queue, int producer, int count, bool spin,
+         std::atomic<int> *refused)
+{
+   int i, tag;
+
+   for (i=0; i<count; i++) {
+      CgleMesh mesh;
+
+      tag = producer * count + i;
+      build_mesh (tag, mesh);
+
+      if (spin) {
+         while (!queue->TrySubmit (tag, std::move (mesh))) {
+            refused->fetch_add (1, std::memory_order_relaxed);
+            std::this_thread::yield ();
+         }
+      } else {
+         queue->Submit (tag, std::move (mesh));
+      }
+   }
+}
+
+/* ============================================================ */
+
+int
+main (int argc, char * argv[])
+{
+   int count = 5000;
+   int p, tag, got, batch, failures;
+   int vertices;
+   int last[NPRODUCERS];
+   std::atomic<int> refused (0);
+   std::vector<std::thread> producers;
+
+   if (1 < argc) count = atoi (argv[1]);
+   if (0 >= count) count = 1;
+
+   InitializeExtrusionLib ();
+
+   /* every mesh should have as many vertices as this one */
+   CgleMesh reference;
+   build_mesh (0, reference);
+   vertices = reference.GetVertexCount ();
+
+   CgleMeshQueue queue (CAPACITY);
+
+   for (p=0; p<NPRODUCERS; p++) {
+      last[p] = -1;
+      producers.push_back (std::thread (produce, &queue, p, count,
+                                        (0 == p), &refused));
+   }
+
+   got = 0;
+   failures = 0;
+   batch = 0;
+   while (got < NPRODUCERS * count) {
+
+      got += queue.Drain ([&] (int Tag, CgleMesh &Mesh) {
+         int producer = Tag / count;
+         int index = Tag % count;
+
+         if ((0 > Tag) || (NPRODUCERS <= producer)) {
+            printf ("tag %d out of range\n", Tag);
+            failures ++;
+            return;
+         }
+         if (index != last[producer] + 1) {
+            printf ("producer %d: mesh %d after mesh %d\n", producer, index,
+                    last[producer]);
+            failures ++;
+         }
+         last[producer] = index;
+
+         if ((Mesh.GetVertexCount () != vertices) || (mesh_tag (Mesh) != Tag)) {
+            printf ("mesh %d: %d vertices, looks like mesh %d\n", Tag,
+                    Mesh.GetVertexCount (), mesh_tag (Mesh));
+            failures ++;
+         }
+      }, 1 + (batch % 3));
+
+      /* an uploading GL thread would take a while now and then */
+      batch ++;
+      if (0 == batch % 64) {
+         std::this_thread::sleep_for (std::chrono::microseconds (500));
+      } else {
+         std::this_thread::yield ();
+      }
+   }
+
+   for (p=0; p<NPRODUCERS; p++) producers[p].join ();
+
+   CgleMesh extra;
+   if (queue.TryTake (tag, extra)) {
+      printf ("queue not empty at the end: mesh %d\n", tag);
+      failures ++;
+   }
+   for (p=0; p<NPRODUCERS; p++) {
+      if (count - 1 != last[p]) {
+         printf ("producer %d: last mesh %d of %d\n", p, last[p], count);
+         failures ++;
+      }
+   }
+
+   printf ("%d producers, %d meshes each, capacity %d\n", NPRODUCERS, count,
+           queue.GetCapacity ());
+   printf ("received %d, stalls in Submit %d, refusals by TrySubmit %d\n", got,
+           queue.GetStalls (), refused.load ());
+   printf ("%s: %d failures\n", failures ? "FAILED" : "passed", failures);
+
+   ReleaseExtrusionLib ();
+   return failures ? 1 : 0;
+}
+
+/* ===================== END OF FILE ======================== */
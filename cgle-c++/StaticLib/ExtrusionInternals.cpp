@@ -11,43 +11,53 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusionlib.h"
-#include "extrusioninternals.h"
+#include "ExtrusionLib.h"
+#include "ExtrusionInternals.h"
 
-gleGC *_gle_gc = 0x0;
-float Color[3], ambmat[4], difmat[4], emismat[4];// static vars for
-bool StatUseLitMat;                         // glColor / Tess routines
+thread_local gleGC *_cgle_gc = 0x0;
 
 //----------------------------------------------------------------------------
 void CreateGC()
 {
-	if (_gle_gc == 0x0)
+	if (_cgle_gc == 0x0)
 	{
-		_gle_gc =  (gleGC*) malloc (sizeof (gleGC));
-
-	   _gle_gc -> bgn_gen_texture = 0x0;
-	   _gle_gc -> n3f_gen_texture = 0x0;
-	   _gle_gc -> n3d_gen_texture = 0x0;
-	   _gle_gc -> v3f_gen_texture = 0x0;
-	   _gle_gc -> v3d_gen_texture = 0x0;
-	   _gle_gc -> end_gen_texture = 0x0;
-
-	   _gle_gc -> num_vert = 0;
-	   _gle_gc -> segment_number = 0;
-	   _gle_gc -> segment_length = 0.0;
-	   _gle_gc -> accum_seg_len = 0.0;
-	   _gle_gc -> prev_x = 0.0;
-	   _gle_gc -> prev_y = 0.0;
-
-	   ambmat[3] = difmat[3] = emismat[3] = 1.0;
+		_cgle_gc =  (gleGC*) malloc (sizeof (gleGC));
+		InitGC(_cgle_gc);
 	}
 }
 //----------------------------------------------------------------------------
+void InitGC(gleGC *gc)
+{
+   gc -> bgn_gen_texture = 0x0;
+   gc -> n3f_gen_texture = 0x0;
+   gc -> n3d_gen_texture = 0x0;
+   gc -> v3f_gen_texture = 0x0;
+   gc -> v3d_gen_texture = 0x0;
+   gc -> end_gen_texture = 0x0;
+
+   gc -> num_vert = 0;
+   gc -> segment_number = 0;
+   gc -> segment_length = 0.0;
+   gc -> accum_seg_len = 0.0;
+   gc -> prev_x = 0.0;
+   gc -> prev_y = 0.0;
+
+   gc -> mesh = 0x0;
+
+   gc -> use_lit_mat = true;
+   gc -> color[0] = gc -> color[1] = gc -> color[2] = 1.0;
+   gc -> difmat[3] = gc -> emismat[3] = 1.0;
+
+   gc -> save_nx = 0.0;
+   gc -> save_ny = 0.0;
+   gc -> save_nz = 0.0;
+}
+//----------------------------------------------------------------------------
 void DestroyGC()
 {
-	if (_gle_gc != 0x0)
-		free (_gle_gc);
-	_gle_gc = 0x0;
+	if (_cgle_gc != 0x0)
+		free (_cgle_gc);
+	_cgle_gc = 0x0;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -59,11 +69,20 @@ void DestroyGC()
 void SetColor(float color[3])
 {
 
+   float *Color = _cgle_gc -> color;
+   float *difmat = _cgle_gc -> difmat;
+   float *emismat = _cgle_gc -> emismat;
+
    for (int i = 0;i < 3;i++)
       Color[i] = color[i];
 
+   if (_cgle_gc -> mesh)
+   {
+      _cgle_gc -> mesh -> Color(Color);
+      return;
+   }
 
-   if (StatUseLitMat)
+   if (_cgle_gc -> use_lit_mat)
    {
       difmat[0] = 0.4f * Color[0];
       difmat[1] = 0.4f * Color[1];
@@ -83,17 +102,15 @@ void SetColor(float color[3])
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
-#define segment_number (_gle_gc -> segment_number)
-#define segment_length (_gle_gc -> segment_length)
-#define accum_seg_len (_gle_gc -> accum_seg_len)
-#define num_vert  (_gle_gc -> num_vert)
-#define prev_x  (_gle_gc -> prev_x)
-#define prev_y  (_gle_gc -> prev_y)
-
-
-static double save_nx = 0.0;
-static double save_ny = 0.0;
-static double save_nz = 0.0;
+#define segment_number (_cgle_gc -> segment_number)
+#define segment_length (_cgle_gc -> segment_length)
+#define accum_seg_len (_cgle_gc -> accum_seg_len)
+#define num_vert  (_cgle_gc -> num_vert)
+#define prev_x  (_cgle_gc -> prev_x)
+#define prev_y  (_cgle_gc -> prev_y)
+#define save_nx  (_cgle_gc -> save_nx)
+#define save_ny  (_cgle_gc -> save_ny)
+#define save_nz  (_cgle_gc -> save_nz)
 
 //----------------------------------------------------------------------------
 void save_normal (double *v)
@@ -187,8 +204,8 @@ void normal_sphere_texgen_v (double *v, int jcnt, int which_end)
 //----------------------------------------------------------------------------
 void vertex_sphere_model_v (double *v, int jcnt, int which_end)
 {
-   double x = _gle_gc->contour[jcnt][0];
-   double y = _gle_gc->contour[jcnt][1];
+   double x = _cgle_gc->contour[jcnt][0];
+   double y = _cgle_gc->contour[jcnt][1];
    double z = v[2];
    double r;
 
@@ -201,10 +218,10 @@ void vertex_sphere_model_v (double *v, int jcnt, int which_end)
 //----------------------------------------------------------------------------
 void normal_sphere_model_v (double *v, int jcnt, int which_end)
 {
-   if (!(_gle_gc -> cont_normal))
+   if (!(_cgle_gc -> cont_normal))
       return;
-   sphere_texgen (_gle_gc->cont_normal[jcnt][0], 
-                _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
+   sphere_texgen (_cgle_gc->cont_normal[jcnt][0], 
+                _cgle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
 }
 //----------------------------------------------------------------------------
 void bgn_z_texgen (int inext, double len)
@@ -283,8 +300,8 @@ void normal_cylinder_texgen_v (double *v, int jcnt, int which_end)
 //----------------------------------------------------------------------------
 void vertex_cylinder_model_v (double *v, int jcnt, int which_end)
 {
-   double x = _gle_gc->contour[jcnt][0];
-   double y = _gle_gc->contour[jcnt][1];
+   double x = _cgle_gc->contour[jcnt][0];
+   double y = _cgle_gc->contour[jcnt][1];
    double z = v[2];
    double r;
 
@@ -296,11 +313,11 @@ void vertex_cylinder_model_v (double *v, int jcnt, int which_end)
 //----------------------------------------------------------------------------
 void normal_cylinder_model_v (double *v, int jcnt, int which_end)
 {
-   if (!(_gle_gc -> cont_normal))
+   if (!(_cgle_gc -> cont_normal))
       return;
 
-   cylinder_texgen (_gle_gc->cont_normal[jcnt][0],
-                _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
+   cylinder_texgen (_cgle_gc->cont_normal[jcnt][0],
+                _cgle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -328,15 +345,15 @@ void normal_flat_texgen_v (double *v, int jcnt, int which_end)
 //----------------------------------------------------------------------------
 void vertex_flat_model_v (double *v, int jcnt, int which_end)
 {
-   flat_texgen (_gle_gc->contour[jcnt][0],
-                _gle_gc->contour[jcnt][1], v[2], jcnt, which_end);
+   flat_texgen (_cgle_gc->contour[jcnt][0],
+                _cgle_gc->contour[jcnt][1], v[2], jcnt, which_end);
 }
 //----------------------------------------------------------------------------
 void normal_flat_model_v (double *v, int jcnt, int which_end)
 {
-   if (!(_gle_gc -> cont_normal)) return;
-   flat_texgen (_gle_gc->cont_normal[jcnt][0],
-                _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
+   if (!(_cgle_gc -> cont_normal)) return;
+   flat_texgen (_cgle_gc->cont_normal[jcnt][0],
+                _cgle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
 }
 //----------------------------------------------------------------------------
 
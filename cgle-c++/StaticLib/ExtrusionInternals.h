@@ -27,6 +27,7 @@ using gleTwoVec =  double[2];
 
 void CreateGC();
 void DestroyGC();
+void InitGC(gleGC *gc);
 
 void SetColor(float color[3]);
 
@@ -47,7 +48,7 @@ void vertex_sphere_model_v (double *v, int jcnt, int which_end);
 void normal_sphere_model_v (double *v, int jcnt, int which_end);
 
 
-using gleGC = struct
+struct gleGC
 {
 
    void (*bgn_gen_texture) (int, double);
@@ -77,8 +78,27 @@ using gleGC = struct
    double prev_x;
    double prev_y;
 
+   // when set, geometry is captured here instead of being sent to GL
+   CgleMesh *mesh;
+
+   //  current color, and the material made from it; see SetColor()
+   bool use_lit_mat;
+   float color[3];
+   float difmat[4];
+   float emismat[4];
+
+   //  last normal, for the normal texgen modes
+   double save_nx;
+   double save_ny;
+   double save_nz;
+
 };
 
+// Each extrusion object has a GC of its own, which is made current on the
+// calling thread while it generates its geometry, so that objects can be
+// generated on several threads at once.
+extern thread_local gleGC *_cgle_gc;
+
 
 // These are used to convey info about topography to the
  // texture mapping routines
@@ -93,50 +113,62 @@ using gleGC = struct
 
 
 
-#define	T2F_D(x,y)	glTexCoord2d(x,y);
+// All of the geometry goes out through these, so that it can be captured
+// into a CgleMesh (see CgleBaseExtrusion::Build) rather than drawn.
+
+#define GLE_BEGIN(mode)	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> Begin(mode) : glBegin(mode))
+#define GLE_END()		(_cgle_gc -> mesh ? _cgle_gc -> mesh -> End() : glEnd())
+#define GLE_NORMAL3DV(x)	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> Normal(x) : glNormal3dv(x))
+#define GLE_VERTEX3DV(x)	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> Vertex(x) : glVertex3dv(x))
+
+#define PUSHMATRIX()	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> PushMatrix() : glPushMatrix())
+#define MULTMATRIX_D(m)	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> MultMatrix(m) : glMultMatrixd(m))
+#define POPMATRIX()		(_cgle_gc -> mesh ? _cgle_gc -> mesh -> PopMatrix() : glPopMatrix())
+
+#define	T2F_D(x,y)	(_cgle_gc -> mesh ? _cgle_gc -> mesh -> TexCoord(x,y) : glTexCoord2d(x,y));
 
 
 
 #define BGNTMESH(i,len)                                                \
 { 					                                                      \
-	if(_gle_gc -> bgn_gen_texture)                                       \
-     (*(_gle_gc -> bgn_gen_texture))(i,len);                           \
-	glBegin (GL_TRIANGLE_STRIP); 			                                 \
+	if(_cgle_gc -> bgn_gen_texture)                                       \
+     (*(_cgle_gc -> bgn_gen_texture))(i,len);                           \
+	GLE_BEGIN (GL_TRIANGLE_STRIP); 			                                 \
 }
 
 #define BGNPOLYGON()                                                  \
 { 					                                                     \
-	if(_gle_gc -> bgn_gen_texture)                                      \
-     (*(_gle_gc -> bgn_gen_texture))();                               \
-	glBegin (GL_POLYGON);                                               \
+	if(_cgle_gc -> bgn_gen_texture)                                      \
+     (*(_cgle_gc -> bgn_gen_texture))();                               \
+	GLE_BEGIN (GL_POLYGON);                                               \
 }
 
 #define N3D(x)                                               \
 { 					                                              \
-	if(_gle_gc -> n3d_gen_texture)                               \
-     (*(_gle_gc -> n3d_gen_texture))(x);                       \
-	glNormal3dv(x); 				                                  \
+	if(_cgle_gc -> n3d_gen_texture)                               \
+     (*(_cgle_gc -> n3d_gen_texture))(x);                       \
+	GLE_NORMAL3DV(x); 				                                  \
 }
 
 #define V3D(x,j,id)                                                       \
 { 					                                                         \
-	if(_gle_gc -> v3d_gen_texture)                                          \
-     (*(_gle_gc -> v3d_gen_texture))(x,j,id);                             \
-	glVertex3dv(x); 			  	                                             \
+	if(_cgle_gc -> v3d_gen_texture)                                          \
+     (*(_cgle_gc -> v3d_gen_texture))(x,j,id);                             \
+	GLE_VERTEX3DV(x); 			  	                                             \
 }
 
 #define ENDTMESH()                                                  \
 {					                                                      \
-	if(_gle_gc -> end_gen_texture)                                    \
-     (*(_gle_gc -> end_gen_texture))();                             \
-	glEnd ();					                                          \
+	if(_cgle_gc -> end_gen_texture)                                    \
+     (*(_cgle_gc -> end_gen_texture))();                             \
+	GLE_END ();					                                          \
 }
 
 #define ENDPOLYGON()                                                \
 {					                                                      \
-	if(_gle_gc -> end_gen_texture)                                    \
-     (*(_gle_gc -> end_gen_texture))();                             \
-	glEnd ();					                                          \
+	if(_cgle_gc -> end_gen_texture)                                    \
+     (*(_cgle_gc -> end_gen_texture))();                             \
+	GLE_END ();					                                          \
 }
 
 																													  
@@ -1745,6 +1777,9 @@ extern void uviewpoint_f (float m[4][4],		// returned
    deno += (v1[2] - v2[2]) * n[2];			\
    							\
    if (deno == 0.0) {					\
+      /* the line lies in the plane; as in the C library, */ \
+      /* the intersection comes back as the origin */	\
+      VEC_ZERO (sect);					\
       VEC_COPY (n, v1);					\
       /* printf ("Intersect: Warning: line is coplanar with plane \n"); */ \
    } else {						\
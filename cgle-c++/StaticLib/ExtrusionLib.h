@@ -168,10 +168,18 @@ using CapCallBack = void(*)(int iloop,
 								int frontwards,
 								void* Owner);
 
+struct gleGC;
+
 /// @endcond
 
 
 
+#include "gleMesh.h"
+#include "gleThreadPool.h"
+#include "gleMeshCache.h"
+#include "gleBuildScheduler.h"
+#include "gleAnimatedMesh.h"
+#include "gleMeshQueue.h"
 #include "gleBaseExtrusion.h"
 #include "gleExtrusion.h"
 #include "gleConeExtrusion.h"
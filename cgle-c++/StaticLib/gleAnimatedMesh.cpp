@@ -0,0 +1,110 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+#include <thread>
+#include <chrono>
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleAnimatedMesh
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+// Set in FMiddle, with the index, while the mesh there is a finished frame
+// that Flip hasn't taken yet.
+#define NEW_FRAME	4
+
+CgleAnimatedMesh::CgleAnimatedMesh(BuildFunction Build)
+	: FBuild(std::move(Build)), FMiddle(1), FStop(false)
+{
+	FFrames[0] = FFrames[1] = FFrames[2] = -1;
+	FFront = 0;
+	FBack = 2;
+	FLate = 0;
+
+	FThread = std::thread(&CgleAnimatedMesh::Run, this);
+}
+//----------------------------------------------------------------------------
+CgleAnimatedMesh::~CgleAnimatedMesh()
+{
+	FStop.store(true, std::memory_order_relaxed);
+	FThread.join();
+}
+//----------------------------------------------------------------------------
+// The exchange hands the drawn mesh to the worker, releasing it, and takes
+// the new one, acquiring what the worker built into it.
+bool CgleAnimatedMesh::Flip()
+{
+	if (!(FMiddle.load(std::memory_order_relaxed) & NEW_FRAME))
+	{
+		if (FFrames[FFront] >= 0)
+			FLate++;
+		return(false);
+	}
+
+	// only the worker sets NEW_FRAME, so it is still set
+	FFront = FMiddle.exchange(FFront, std::memory_order_acq_rel) & ~NEW_FRAME;
+
+	return(true);
+}
+//----------------------------------------------------------------------------
+const CgleMesh &CgleAnimatedMesh::GetFront() const
+{
+	return(FMeshes[FFront]);
+}
+//----------------------------------------------------------------------------
+int CgleAnimatedMesh::GetFrame() const
+{
+	return(FFrames[FFront]);
+}
+//----------------------------------------------------------------------------
+void CgleAnimatedMesh::Draw(bool UseLitMaterial)
+{
+	Flip();
+	GetFront().Submit(UseLitMaterial);
+}
+//----------------------------------------------------------------------------
+int CgleAnimatedMesh::GetLateFrames() const
+{
+	return(FLate);
+}
+//----------------------------------------------------------------------------
+// With a frame done and the one before it not yet taken, the worker spins
+// briefly, then sleeps between tries, as CgleMeshQueue::Submit does; Flip
+// comes once a frame, and so has nothing to wake.
+void CgleAnimatedMesh::Run()
+{
+	for (int frame = 0; !FStop.load(std::memory_order_relaxed); frame++)
+	{
+		FMeshes[FBack].Clear();
+		FBuild(frame, FMeshes[FBack]);
+		FFrames[FBack] = frame;
+
+		for (int tries = 0; FMiddle.load(std::memory_order_acquire) & NEW_FRAME; tries++)
+		{
+			if (FStop.load(std::memory_order_relaxed))
+				return;
+
+			if (tries < 64)
+				std::this_thread::yield();
+			else
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		FBack = FMiddle.exchange(FBack | NEW_FRAME, std::memory_order_acq_rel);
+	}
+}
+//----------------------------------------------------------------------------
@@ -11,13 +11,39 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "ExtrusionInternals.h"
 #include "gleBaseExtrusion.h"
 
-/// @cond
-extern gleGC *_gle_gc;
-extern bool StatUseLitMat;                         // glColor / Tess routines
-/// @endcond
+//----------------------------------------------------------------------------
+// Point the tessellator at GL, or, when geometry is being captured, at the
+// mesh, which it gets handed as the polygon data. The _DATA callbacks take
+// precedence over the plain ones, so they're cleared when not in use.
+static void Set_Tess_Callbacks (GLUtesselator *tess)
+{
+	if (_cgle_gc -> mesh)
+	{
+		gluTessCallback (tess, GLU_TESS_BEGIN_DATA, (void(APIENTRY*)())CgleMesh::TessBegin);
+		gluTessCallback (tess, GLU_TESS_VERTEX_DATA, (void(APIENTRY*)())CgleMesh::TessVertex);
+		gluTessCallback (tess, GLU_TESS_END_DATA, (void(APIENTRY*)())CgleMesh::TessEnd);
+	}
+	else
+	{
+		gluTessCallback (tess, GLU_TESS_BEGIN_DATA, NULL);
+		gluTessCallback (tess, GLU_TESS_VERTEX_DATA, NULL);
+		gluTessCallback (tess, GLU_TESS_END_DATA, NULL);
+
+		gluTessCallback (tess, GLU_TESS_BEGIN, (void(APIENTRY*)())glBegin);
+		gluTessCallback (tess, GLU_TESS_VERTEX, (void(APIENTRY*)())glVertex3dv);
+		gluTessCallback (tess, GLU_TESS_END, (void(APIENTRY*)())glEnd);
+	}
+}
 
 
 							
@@ -38,7 +64,7 @@ CgleBaseExtrusion::CgleBaseExtrusion(int Points, int ContourPoints, double Radiu
 	m_iPoints = Points;
 	m_iContourPoints = ContourPoints;
 
-	if (Radius == NULL)
+	if (Radius == 0.0)
 		m_dRadius = 1.0;
 	else
 		m_dRadius = Radius;
@@ -46,24 +72,45 @@ CgleBaseExtrusion::CgleBaseExtrusion(int Points, int ContourPoints, double Radiu
 
 	m_ptrUp = NULL;
 	m_ptrXforms = NULL;
-	m_ptrPath = NULL;
-	m_ptrTwarr = NULL;
 	m_bTexEnabled = false;
 
 	m_bUseLitMaterial = true;
+	FEmitSegment = FEmitBinormSegment = NULL;
+
+	m_ptrGC = new gleGC;
+	InitGC(m_ptrGC);
+
+	m_bRetained = false;
+	m_bMeshValid = false;
+	m_bBuildOnly = false;
+	FKeyTaken = false;
+	FMeshCache = NULL;
+
+	FStraightAxis = false;
+	FAxis.Start = FAxis.End = 0.0;
+	FAxis.Twisted = false;
+	FAxis.TwistStart = FAxis.TwistEnd = 0.0;
 
-	m_ptrCont_Norms = new gleContourVector[m_iContourPoints + 1];
-	m_ptrContours = new gleContourVector[m_iContourPoints + 1];
+	FSplitPool = NULL;
+	FRun = NULL;
 
+	// The contour and its normals are all the object keeps that depends on
+	// the number of contour points; the work areas are the thread's, and
+	// are only attached while generating (see AttachScratch).
+	int ncp = m_iContourPoints;
 
-	FMemAnchor = new char[96 * m_iContourPoints];
-	FXAJMemAnchor = new char[96 * m_iContourPoints];
-	FROCJMemAnchor = new char[152 * m_iContourPoints];
+	FContour.reset(new double[4 * (ncp + 1)], std::default_delete<double[]>());
+	FContourShared = false;
 
+	m_ptrCont_Norms = (gleContourVector *)FContour.get();
+	m_ptrContours = m_ptrCont_Norms + (ncp + 1);
 
-	m_objTess = gluNewTess();
+	FUpVector[0] = FUpVector[1] = FUpVector[2] = 0.0;
 
-	FCapLoop = new double[(m_iContourPoints + 3) * 3];
+	FMemAnchor = FXAJMemAnchor = FROCJMemAnchor = FMallocedArea = NULL;
+	FCapLoop = FNNormCapLoop = FNNormLoop = NULL;
+
+	m_objTess = NULL;
 
 	m_iExtrusionMode = GLE_JN_ANGLE | GLE_JN_CAP | GLE_NORM_FACET |
 																GLE_CONTOUR_CLOSED;
@@ -75,23 +122,165 @@ CgleBaseExtrusion::CgleBaseExtrusion(int Points, int ContourPoints, double Radiu
 //----------------------------------------------------------------------------
 CgleBaseExtrusion::~CgleBaseExtrusion()
 {
+	// a moved-from object has none of this
+	delete m_ptrGC;
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Creates a CgleBaseExtrusion object from another, which is left empty.</summary>
+/// \details Nothing is copied: the scratch memory, tessellator and any built mesh
+/// are handed over, so this is cheap whatever the size of the object.
+///
+/// @param	Other The object to move from. It can afterwards only be destroyed, or
+/// moved to.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+CgleBaseExtrusion::CgleBaseExtrusion(CgleBaseExtrusion &&Other)
+{
+	m_iPoints = 0;
+	m_iContourPoints = 0;
+	m_dRadius = 1.0;
+
+	m_ptrCont_Norms = m_ptrContours = NULL;
+	m_ptrPointArray = NULL;
+	m_ptrColorArray = NULL;
+	m_ptrUp = NULL;
+	m_ptrXforms = NULL;
+
+	m_bUseLitMaterial = true;
+	FEmitSegment = FEmitBinormSegment = NULL;
+	m_iExtrusionMode = 0;
+	m_TexMode = gleTexMode::GLE_TEXTURE_VERTEX_CYL;
+	m_bTexEnabled = false;
+	m_iINext = 0;
+	m_dLen = 0.0;
 
-	delete[] FMemAnchor;
-	delete[] FXAJMemAnchor;
-	delete[] FROCJMemAnchor;
+	FContourShared = false;
+	FUpVector[0] = FUpVector[1] = FUpVector[2] = 0.0;
+	FMemAnchor = FXAJMemAnchor = FROCJMemAnchor = FMallocedArea = NULL;
+	FCapLoop = FNNormCapLoop = FNNormLoop = NULL;
 
-	gluDeleteTess(m_objTess);
+	m_objTess = NULL;
+	m_ptrGC = NULL;
 
-	delete[] FCapLoop;
+	m_bRetained = m_bMeshValid = m_bBuildOnly = FKeyTaken = false;
+	FMeshCache = NULL;
 
-	delete[] m_ptrContours;
-	delete[] m_ptrCont_Norms;
+	FStraightAxis = false;
+	FAxis.Start = FAxis.End = 0.0;
+	FAxis.Twisted = false;
+	FAxis.TwistStart = FAxis.TwistEnd = 0.0;
 
-	if (m_ptrUp != NULL)
+	FSplitPool = NULL;
+	FRun = NULL;
+
+	Swap(Other);
+}
+//----------------------------------------------------------------------------
+// An object that builds one run of another's path, on whichever thread gets
+// to it: it has the other's settings, contour and arrays, as they are while
+// it generates, and a GC of its own, a copy of the other's.
+CgleBaseExtrusion::CgleBaseExtrusion(const CgleBaseExtrusion &Whole, const gleJoinRun &Run)
+	: CgleBaseExtrusion(Whole.m_iPoints, 0, Whole.m_dRadius)
+{
+	m_iContourPoints = Whole.m_iContourPoints;
+	FContour = Whole.FContour;
+	FContourShared = true;
+	m_ptrCont_Norms = Whole.m_ptrCont_Norms;
+	m_ptrContours = Whole.m_ptrContours;
+
+	if (Whole.m_ptrUp != NULL)
 	{
-		delete[] m_ptrUp;
-		m_ptrUp = NULL;
+		VEC_COPY (FUpVector, Whole.m_ptrUp);
+		m_ptrUp = FUpVector;
 	}
+
+	m_ptrPointArray = Whole.m_ptrPointArray;
+	m_ptrColorArray = Whole.m_ptrColorArray;
+	m_ptrXforms = Whole.m_ptrXforms;
+
+	m_bUseLitMaterial = Whole.m_bUseLitMaterial;
+	m_iExtrusionMode = Whole.m_iExtrusionMode;
+	m_TexMode = Whole.m_TexMode;
+	m_bTexEnabled = Whole.m_bTexEnabled;
+	FEmitSegment = Whole.FEmitSegment;
+	FEmitBinormSegment = Whole.FEmitBinormSegment;
+
+	*m_ptrGC = *Whole.m_ptrGC;
+	FRun = &Run;
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Moves another CgleBaseExtrusion object into this one.</summary>
+/// \details The two trade places; what this object held is released when Other is
+/// destroyed.
+///
+/// @param	Other The object to move from.
+///
+/// \retval		CgleBaseExtrusion&
+///
+/////////////////////////////////////////////////////////////////////////////////////
+CgleBaseExtrusion &CgleBaseExtrusion::operator=(CgleBaseExtrusion &&Other)
+{
+	if (this != &Other)
+		Swap(Other);
+
+	return(*this);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::Swap(CgleBaseExtrusion &Other)
+{
+	std::swap(m_ptrCont_Norms, Other.m_ptrCont_Norms);
+	std::swap(m_ptrContours, Other.m_ptrContours);
+	std::swap(m_ptrPointArray, Other.m_ptrPointArray);
+	std::swap(m_ptrColorArray, Other.m_ptrColorArray);
+	std::swap(m_dRadius, Other.m_dRadius);
+	std::swap(m_iPoints, Other.m_iPoints);
+	std::swap(m_iContourPoints, Other.m_iContourPoints);
+	std::swap(m_bUseLitMaterial, Other.m_bUseLitMaterial);
+	std::swap(m_iExtrusionMode, Other.m_iExtrusionMode);
+	std::swap(m_TexMode, Other.m_TexMode);
+	std::swap(m_bTexEnabled, Other.m_bTexEnabled);
+	std::swap(m_iINext, Other.m_iINext);
+	std::swap(m_dLen, Other.m_dLen);
+	std::swap(m_ptrXforms, Other.m_ptrXforms);
+
+	std::swap(FContour, Other.FContour);
+	std::swap(FContourShared, Other.FContourShared);
+
+	// the up vector stays where it is; only its value moves
+	bool has_up = (m_ptrUp != NULL);
+
+	std::swap(FUpVector, Other.FUpVector);
+	m_ptrUp = (Other.m_ptrUp != NULL) ? FUpVector : NULL;
+	Other.m_ptrUp = has_up ? Other.FUpVector : NULL;
+
+	std::swap(FMemAnchor, Other.FMemAnchor);
+	std::swap(FXAJMemAnchor, Other.FXAJMemAnchor);
+	std::swap(FROCJMemAnchor, Other.FROCJMemAnchor);
+	std::swap(FMallocedArea, Other.FMallocedArea);
+	std::swap(FCapLoop, Other.FCapLoop);
+	std::swap(FNNormCapLoop, Other.FNNormCapLoop);
+	std::swap(FNNormLoop, Other.FNNormLoop);
+
+	std::swap(m_objTess, Other.m_objTess);
+	std::swap(m_ptrGC, Other.m_ptrGC);
+
+	std::swap(m_objMesh, Other.m_objMesh);
+	std::swap(FMappedMesh, Other.FMappedMesh);
+	std::swap(m_bRetained, Other.m_bRetained);
+	std::swap(m_bMeshValid, Other.m_bMeshValid);
+	std::swap(m_bBuildOnly, Other.m_bBuildOnly);
+	std::swap(FKeyTaken, Other.FKeyTaken);
+	std::swap(FKeyValues, Other.FKeyValues);
+	std::swap(FKeyArrays, Other.FKeyArrays);
+	std::swap(FCacheInputs, Other.FCacheInputs);
+	std::swap(FMeshCache, Other.FMeshCache);
+	std::swap(FSegmentSink, Other.FSegmentSink);
+	std::swap(FStraightAxis, Other.FStraightAxis);
+	std::swap(FAxis, Other.FAxis);
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -127,7 +316,11 @@ CgleBaseExtrusion::~CgleBaseExtrusion()
 /////////////////////////////////////////////////////////////////////////////////////
 void CgleBaseExtrusion::SetExtrusionMode(int mode)
 {
-	m_iExtrusionMode = mode;
+	if (mode != m_iExtrusionMode)
+	{
+		m_iExtrusionMode = mode;
+		Invalidate();
+	}
 }
 //----------------------------------------------------------------------------
 /////////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +349,7 @@ int CgleBaseExtrusion::GetExtrusionMode()  const
 void CgleBaseExtrusion::SetTextureMode(gleTexMode mode)
 {
 	m_TexMode = mode;
+	Invalidate();
 }
 //----------------------------------------------------------------------------
 /////////////////////////////////////////////////////////////////////////////////////
@@ -216,10 +410,12 @@ bool CgleBaseExtrusion::IsUsingLitMaterial()  const
 void CgleBaseExtrusion::LoadUpVector(double Up[3])
 {
 	if (m_ptrUp == NULL)
-		m_ptrUp = new double[3];
+		m_ptrUp = FUpVector;
 
 	for (int i = 0; i < 3; i++)
 		m_ptrUp[i] = Up[i];
+
+	Invalidate();
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -237,6 +433,21 @@ void CgleBaseExtrusion::LoadContourPoint(int Index, double dX, double dY)
 {
 
 	double alen, ax, ay;
+
+	// a shared contour is read only; take a copy of it first
+	if (FContourShared)
+	{
+		int n = 4 * (m_iContourPoints + 1);
+		std::shared_ptr<double> mine(new double[n], std::default_delete<double[]>());
+
+		memcpy(mine.get(), FContour.get(), n * sizeof(double));
+		FContour = mine;
+		FContourShared = false;
+
+		m_ptrCont_Norms = (gleContourVector *)FContour.get();
+		m_ptrContours = m_ptrCont_Norms + (m_iContourPoints + 1);
+	}
+
 	m_ptrContours[Index][0] = m_dRadius * (dX);
 	m_ptrContours[Index][1] = m_dRadius * (dY);
 	if (Index != 0)
@@ -254,6 +465,104 @@ void CgleBaseExtrusion::LoadContourPoint(int Index, double dX, double dY)
 		m_ptrCont_Norms[Index - 1][1] = -(ax *= alen);
 
 	}
+	Invalidate();
+}
+//--------------------------------------------------------------------------
+// The published contours, by profile, contour point count and radius. Only
+// weak references are kept, so a contour goes once the last object using it
+// does.
+typedef std::map<std::pair<std::string, std::pair<int, double> >,
+	std::weak_ptr<double> > gleContourMap;
+
+static std::mutex _cgle_contour_lock;
+static gleContourMap _cgle_contours;
+
+bool CgleBaseExtrusion::AdoptContour(const char *Profile)
+{
+	std::lock_guard<std::mutex> lock(_cgle_contour_lock);
+	gleContourMap::iterator i = _cgle_contours.find(std::make_pair(std::string(Profile),
+		std::make_pair(m_iContourPoints, m_dRadius)));
+
+	if (i == _cgle_contours.end())
+		return(false);
+
+	std::shared_ptr<double> shared = i->second.lock();
+
+	if (!shared)
+	{
+		_cgle_contours.erase(i);
+		return(false);
+	}
+
+	FContour = shared;
+	FContourShared = true;
+
+	m_ptrCont_Norms = (gleContourVector *)FContour.get();
+	m_ptrContours = m_ptrCont_Norms + (m_iContourPoints + 1);
+
+	Invalidate();
+	return(true);
+}
+//--------------------------------------------------------------------------
+void CgleBaseExtrusion::PublishContour(const char *Profile)
+{
+	std::lock_guard<std::mutex> lock(_cgle_contour_lock);
+
+	_cgle_contours[std::make_pair(std::string(Profile),
+		std::make_pair(m_iContourPoints, m_dRadius))] = FContour;
+	FContourShared = true;
+}
+//--------------------------------------------------------------------------
+// The work areas of the join and cap code, and the tessellator, are only
+// needed while an extrusion is being generated, so rather than each object
+// having its own, each thread has one set, grown to fit the largest contour
+// it has been asked to draw.
+struct gleScratch
+{
+	std::vector<double> Work;
+	std::vector<double> Axis;	// a straight axis made into a path; see Unroll_Straight_Axis
+	GLUtesselator *Tess;
+
+	gleScratch() : Tess(NULL) {}
+	~gleScratch()
+	{
+		if (Tess != NULL)
+			gluDeleteTess(Tess);
+	}
+};
+
+static thread_local gleScratch _cgle_scratch;
+
+void CgleBaseExtrusion::AttachScratch()
+{
+	// the work areas of the three join styles, and those of the end caps;
+	// a cap loop has at most ncp + 3 points
+	int ncp = m_iContourPoints;
+	size_t size = (12 + 12 + 19) * ncp + (13 + 3 + 6) * (ncp + 3);
+	double *mem;
+
+	if (_cgle_scratch.Work.size() < size)
+		_cgle_scratch.Work.resize(size);
+	if (_cgle_scratch.Tess == NULL)
+		_cgle_scratch.Tess = gluNewTess();
+
+	mem = &_cgle_scratch.Work[0];
+
+	FMemAnchor = (char *)mem;			// 96 bytes per contour point
+	mem += 12 * ncp;
+	FXAJMemAnchor = (char *)mem;		// 96
+	mem += 12 * ncp;
+	FROCJMemAnchor = (char *)mem;		// 152
+	mem += 19 * ncp;
+
+	FMallocedArea = (char *)mem;		// 104 bytes per cap loop point
+	mem += 13 * (ncp + 3);
+	FCapLoop = mem;
+	mem += 3 * (ncp + 3);
+	FNNormCapLoop = mem;
+	FNNormLoop = FNNormCapLoop + 3 * (ncp + 3);
+
+	m_objTess = _cgle_scratch.Tess;
 }
 //--------------------------------------------------------------------------
 void  CgleBaseExtrusion::PrepareGC()
@@ -261,88 +570,88 @@ void  CgleBaseExtrusion::PrepareGC()
 	if (m_bTexEnabled)
 	{
 
-		_gle_gc->ncp = m_iContourPoints;
-		_gle_gc->contour = m_ptrContours;
-		_gle_gc->cont_normal = m_ptrCont_Norms;
-		_gle_gc->up = m_ptrUp;
-		_gle_gc->npoints = m_iPoints;
-		_gle_gc->point_array = (double(*)[3])m_ptrPointArray;
-		_gle_gc->color_array = (float(*)[3])m_ptrColorArray;
-		_gle_gc->xform_array = m_ptrXforms;
+		_cgle_gc->ncp = m_iContourPoints;
+		_cgle_gc->contour = m_ptrContours;
+		_cgle_gc->cont_normal = m_ptrCont_Norms;
+		_cgle_gc->up = m_ptrUp;
+		_cgle_gc->npoints = m_iPoints;
+		_cgle_gc->point_array = (double(*)[3])m_ptrPointArray;
+		_cgle_gc->color_array = (float(*)[3])m_ptrColorArray;
+		_cgle_gc->xform_array = m_ptrXforms;
 
 		switch (m_TexMode)
 		{
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_FLAT:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = vertex_flat_texgen_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_flat_texgen_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_FLAT:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = normal_flat_texgen_v;
-				_gle_gc->n3d_gen_texture = save_normal;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = normal_flat_texgen_v;
+				_cgle_gc->n3d_gen_texture = save_normal;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_MODEL_FLAT:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = vertex_flat_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_flat_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_MODEL_FLAT:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = normal_flat_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = normal_flat_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_CYL:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = vertex_cylinder_texgen_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_cylinder_texgen_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_CYL:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = normal_cylinder_texgen_v;
-				_gle_gc->n3d_gen_texture = save_normal;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = normal_cylinder_texgen_v;
+				_cgle_gc->n3d_gen_texture = save_normal;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_MODEL_CYL:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = vertex_cylinder_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_cylinder_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_MODEL_CYL:
-				_gle_gc->bgn_gen_texture = bgn_z_texgen;
-				_gle_gc->v3d_gen_texture = normal_cylinder_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_z_texgen;
+				_cgle_gc->v3d_gen_texture = normal_cylinder_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_SPH:
-				_gle_gc->bgn_gen_texture = bgn_sphere_texgen;
-				_gle_gc->v3d_gen_texture = vertex_sphere_texgen_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_sphere_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_sphere_texgen_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_SPH:
-				_gle_gc->bgn_gen_texture = bgn_sphere_texgen;
-				_gle_gc->v3d_gen_texture = normal_sphere_texgen_v;
-				_gle_gc->n3d_gen_texture = save_normal;
+				_cgle_gc->bgn_gen_texture = bgn_sphere_texgen;
+				_cgle_gc->v3d_gen_texture = normal_sphere_texgen_v;
+				_cgle_gc->n3d_gen_texture = save_normal;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_VERTEX_MODEL_SPH:
-				_gle_gc->bgn_gen_texture = bgn_sphere_texgen;
-				_gle_gc->v3d_gen_texture = vertex_sphere_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_sphere_texgen;
+				_cgle_gc->v3d_gen_texture = vertex_sphere_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 			case gleTexMode::GLE_TEXTURE_NORMAL_MODEL_SPH:
-				_gle_gc->bgn_gen_texture = bgn_sphere_texgen;
-				_gle_gc->v3d_gen_texture = normal_sphere_model_v;
-				_gle_gc->n3d_gen_texture = 0x0;
+				_cgle_gc->bgn_gen_texture = bgn_sphere_texgen;
+				_cgle_gc->v3d_gen_texture = normal_sphere_model_v;
+				_cgle_gc->n3d_gen_texture = 0x0;
 				break;
 
 		}
@@ -350,21 +659,21 @@ void  CgleBaseExtrusion::PrepareGC()
 	else
 	{
 
-		_gle_gc->ncp = -1;
-		_gle_gc->contour = NULL;
-		_gle_gc->cont_normal = NULL;
-		_gle_gc->up = NULL;
-		_gle_gc->npoints = -1;
-		_gle_gc->point_array = NULL;
-		_gle_gc->color_array = NULL;
-		_gle_gc->xform_array = NULL;
+		_cgle_gc->ncp = -1;
+		_cgle_gc->contour = NULL;
+		_cgle_gc->cont_normal = NULL;
+		_cgle_gc->up = NULL;
+		_cgle_gc->npoints = -1;
+		_cgle_gc->point_array = NULL;
+		_cgle_gc->color_array = NULL;
+		_cgle_gc->xform_array = NULL;
 
-		_gle_gc->bgn_gen_texture = 0x0;
-		_gle_gc->n3f_gen_texture = 0x0;
-		_gle_gc->n3d_gen_texture = 0x0;
-		_gle_gc->v3f_gen_texture = 0x0;
-		_gle_gc->v3d_gen_texture = 0x0;
-		_gle_gc->end_gen_texture = 0x0;
+		_cgle_gc->bgn_gen_texture = 0x0;
+		_cgle_gc->n3f_gen_texture = 0x0;
+		_cgle_gc->n3d_gen_texture = 0x0;
+		_cgle_gc->v3f_gen_texture = 0x0;
+		_cgle_gc->v3d_gen_texture = 0x0;
+		_cgle_gc->end_gen_texture = 0x0;
 	}
 }
 
@@ -372,750 +681,871 @@ void  CgleBaseExtrusion::PrepareGC()
 void CgleBaseExtrusion::DrawExtrusion(double Point_Array[][3],
 	float Color_Array[][3], bool bTextured)
 {
+	if (!m_bRetained)
+	{
+		GenerateExtrusion(Point_Array, Color_Array, bTextured);
+		return;
+	}
+
+	// a descendant's Draw has usually made this check already, with its own
+	// arguments, and only got here because the mesh needs building
+	if (SubmitIfBuilt({ bTextured ? 1.0 : 0.0 }, { Point_Array, Color_Array }))
+		return;
+
+	BuildExtrusion(Point_Array, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::DrawStraightExtrusion(const gleStraightAxis &Axis,
+	float Color_Array[][3], bool bTextured)
+{
+	FAxis = Axis;
+	FStraightAxis = true;
+
+	if (!m_bRetained)
+		GenerateExtrusion(NULL, Color_Array, bTextured);
+
+	else if (!SubmitIfBuilt({ Axis.Start, Axis.End, Axis.Twisted ? 1.0 : 0.0,
+		Axis.TwistStart, Axis.TwistEnd, (double)m_iPoints, bTextured ? 1.0 : 0.0 },
+		{ Color_Array }))
+		BuildExtrusion(NULL, Color_Array, bTextured);
+
+	FStraightAxis = false;
+}
+//----------------------------------------------------------------------------
+// Generates the mesh, or fetches it from the cache, and submits it, for
+// DrawExtrusion and DrawStraightExtrusion.
+void CgleBaseExtrusion::BuildExtrusion(double Point_Array[][3],
+	float Color_Array[][3], bool bTextured)
+{
+	// the key is recorded; from here on nothing can leave it half taken
+	FKeyTaken = false;
+
+	// the cache is keyed by the inputs themselves, as a later run has nothing
+	// else to go on, so they're only gathered when there's a cache to look in
+	if (FMeshCache != NULL)
+		SaveInputs(FCacheInputs, Point_Array, Color_Array, bTextured);
+
+	// a hit is drawn from the mapped file; the mesh is only filled if asked for
+	m_objMesh.Clear();
+
+	if ((FMeshCache == NULL) || !FMeshCache->Fetch(FCacheInputs, FMappedMesh))
+	{
+		FMappedMesh.Clear();
+		m_ptrGC->mesh = &m_objMesh;
+		m_objMesh.SetSink(FSegmentSink ? &FSegmentSink : NULL);
+		GenerateExtrusion(Point_Array, Color_Array, bTextured);
+		m_objMesh.SetSink(NULL);
+		m_ptrGC->mesh = NULL;
+
+		if (FMeshCache != NULL)
+			(void)FMeshCache->Store(FCacheInputs, m_objMesh);
+	}
+	else if (FSegmentSink)
+	{
+		// a hit has nothing to generate; the sink gets the segments all at once
+		for (const CgleMeshSegment &segment : FMappedMesh.GetSegments())
+			FSegmentSink(segment);
+	}
+
+	m_bMeshValid = true;
+
+	if (!m_bBuildOnly)
+		SubmitMesh();
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::SubmitMesh() const
+{
+	if (!FMappedMesh.IsEmpty())
+		FMappedMesh.Submit(m_bUseLitMaterial);
+	else
+		m_objMesh.Submit(m_bUseLitMaterial);
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Submits the built mesh, and returns true, if it was built from the same
+/// arguments; otherwise notes them, for the mesh about to be built, and returns
+/// false.</summary>
+/// \details Called first thing by the Draw functions of the descendant classes, with
+/// their scalar arguments and the addresses of their arrays, so that drawing a built
+/// object costs a comparison of a few numbers and the submit, with nothing worked out
+/// beforehand. The contents of the arrays aren't looked at; a caller that changes them
+/// in place calls Invalidate, as it would after changing any other setting.
+///
+/// Where one Draw calls another, the outermost one's arguments are the ones kept. An
+/// object in immediate mode always returns false.
+///
+/// @param	Values The scalar arguments.
+/// @param	Arrays The array arguments; NULL for one that wasn't given.
+///
+/// \retval		bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+bool CgleBaseExtrusion::SubmitIfBuilt(std::initializer_list<double> Values,
+	std::initializer_list<const void *> Arrays)
+{
+	if (!m_bRetained)
+		return(false);
+
+	if (m_bMeshValid)
+	{
+		if ((Values.size() == FKeyValues.size()) && (Arrays.size() == FKeyArrays.size()) &&
+			std::equal(Values.begin(), Values.end(), FKeyValues.begin()) &&
+			std::equal(Arrays.begin(), Arrays.end(), FKeyArrays.begin()))
+		{
+			if (!m_bBuildOnly)
+				SubmitMesh();
+			return(true);
+		}
+
+		Invalidate();
+	}
+
+	if (!FKeyTaken)
+	{
+		FKeyValues.assign(Values.begin(), Values.end());
+		FKeyArrays.assign(Arrays.begin(), Arrays.end());
+		FKeyTaken = true;
+	}
+
+	return(false);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::GenerateExtrusion(double Point_Array[][3],
+	float Color_Array[][3], bool bTextured)
+{
+	// this object's GC is the current one until it's done
+	gleGC *saved_gc = _cgle_gc;
+	_cgle_gc = m_ptrGC;
+
+	AttachScratch();
+
 	m_ptrPointArray = NULL;
 	m_ptrColorArray = NULL;
 
 	if (bTextured == true)
 		m_bTexEnabled = true;
 
-	StatUseLitMat = m_bUseLitMaterial;
+	_cgle_gc->use_lit_mat = m_bUseLitMaterial;
 
 	if (Color_Array != NULL)
-		(float(*)[3])m_ptrColorArray = Color_Array;
+		m_ptrColorArray = Color_Array;
 
-	m_ptrPointArray = &Point_Array[0][0];
+	if (Point_Array != NULL)
+		m_ptrPointArray = &Point_Array[0][0];
 
 	PrepareGC();
 
+	FEmitSegment = Select_Segment_Emitter(m_ptrColorArray != NULL, false);
+	FEmitBinormSegment = Select_Segment_Emitter(m_ptrColorArray != NULL, true);
+
+	gleAffine *xforms = m_ptrXforms;
+
 	switch (m_iExtrusionMode & GLE_JN_MASK)
 	{
 		case GLE_JN_RAW:
-			(void)Extrusion_Raw_Join();
+			if (FStraightAxis)
+				Unroll_Straight_Axis();
+			if (!Split_Join(&CgleBaseExtrusion::Extrusion_Raw_Join, true))
+				(void)Extrusion_Raw_Join();
 			break;
 
 		case GLE_JN_ANGLE:
-			(void)Extrusion_Angle_Join();
+			if (FStraightAxis)
+				(void)Extrusion_Straight_Axis(false);
+			else if (!Split_Join(&CgleBaseExtrusion::Extrusion_Angle_Join, false))
+				(void)Extrusion_Angle_Join();
 			break;
 
-		case GLE_JN_CUT:
 		case GLE_JN_ROUND:
+			// along a straight line, the capped round join is a ring per path
+			// point too; uncapped, though, the round join code still fills in
+			// the far end
+			if (FStraightAxis && (m_iExtrusionMode & GLE_JN_CAP))
+			{
+				(void)Extrusion_Straight_Axis(true);
+				break;
+			}
+			// fall through
+		case GLE_JN_CUT:
 			// This routine used for both cut and round styles
-			(void)Extrusion_Round_Or_Cut_Join();
+			if (FStraightAxis)
+				Unroll_Straight_Axis();
+			if (!Split_Join(&CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join, false))
+				(void)Extrusion_Round_Or_Cut_Join();
 			break;
 
 		default:
 			break;
 	}
 	m_bTexEnabled = false;
+
+	// an unrolled axis lived in the thread's scratch
+	if (FStraightAxis)
+	{
+		m_ptrPointArray = NULL;
+		m_ptrXforms = xforms;
+	}
+
+	_cgle_gc = saved_gc;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
-void CgleBaseExtrusion::DrawWireExtrusion(double Point_Array[][3],
+// Flatten everything the geometry depends on into one array, the mesh
+// cache's key.
+void CgleBaseExtrusion::SaveInputs(std::vector<double> &Inputs, double Point_Array[][3],
 	float Color_Array[][3], bool bTextured)
 {
-	glPushAttrib(GL_POLYGON_BIT);
-	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	DrawExtrusion(Point_Array, Color_Array, bTextured);
-	glPopAttrib();
-}
-//----------------------------------------------------------------------------
+	int i;
 
-//----------------------------------------------------------------------------
-void CgleBaseExtrusion::Draw_Fillet_Triangle_N_Norms (double va[3],
-													  double vb[3],
-													  double vc[3],
-													  int face,
-													  float front_color[3],
-													  double na[3],
-													  double nb[3])
-{
+	Inputs.clear();
 
-	if (front_color != NULL)
-		SetColor (front_color);
+	Inputs.push_back((double)m_iExtrusionMode);
+	Inputs.push_back((double)m_TexMode);
+	Inputs.push_back(bTextured ? 1.0 : 0.0);
 
-	if (!m_bTexEnabled)
+	for (i = 0; i < m_iContourPoints; i++)
 	{
-		glBegin (GL_TRIANGLE_STRIP);
-		if (m_iExtrusionMode & GLE_NORM_FACET)
-		{
-			glNormal3dv(na);
-			if (face)
-			{
-				glVertex3dv(va);
-				glVertex3dv(vb);
-			}
-			else
-			{
-				glVertex3dv(vb);
-				glVertex3dv(va);
-			}
-			glVertex3dv(vc);
-		}
-		else
-		{
-			if (face)
-			{
-				glNormal3dv(na);
-				glVertex3dv(va);
-				glNormal3dv(nb);
-				glVertex3dv(vb);
-			}
-			else
-			{
-				glNormal3dv(nb);
-				glVertex3dv(vb);
-				glNormal3dv(na);
-				glVertex3dv(va);
-				glNormal3dv(nb);
-			}
-			glVertex3dv(vc);
-		}
-		glEnd();
+		Inputs.push_back(m_ptrContours[i][0]);
+		Inputs.push_back(m_ptrContours[i][1]);
+		Inputs.push_back(m_ptrCont_Norms[i][0]);
+		Inputs.push_back(m_ptrCont_Norms[i][1]);
+	}
 
+	if (m_ptrUp != NULL)
+		Inputs.insert(Inputs.end(), m_ptrUp, m_ptrUp + 3);
 
+	// a straight axis is described, not stored; the description will do
+	if (FStraightAxis)
+	{
+		Inputs.push_back((double)m_iPoints);
+		Inputs.push_back(FAxis.Start);
+		Inputs.push_back(FAxis.End);
+		if (FAxis.Twisted)
+		{
+			Inputs.push_back(FAxis.TwistStart);
+			Inputs.push_back(FAxis.TwistEnd);
+		}
 	}
 	else
+		Inputs.insert(Inputs.end(), &Point_Array[0][0], &Point_Array[0][0] + 3 * m_iPoints);
+
+	if (Color_Array != NULL)
 	{
-		BGNTMESH (-5, 0.0);
+		for (i = 0; i < 3 * m_iPoints; i++)
+			Inputs.push_back((&Color_Array[0][0])[i]);
+	}
 
-		if (m_iExtrusionMode & GLE_NORM_FACET)
-		{
-			N3D (na);
+	if (m_ptrXforms != NULL)
+		Inputs.insert(Inputs.end(), &m_ptrXforms[0][0][0], &m_ptrXforms[0][0][0] + 6 * m_iPoints);
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Puts the object in retained mode, with its geometry about to be built.</summary>
+/// \details Called by the Build member functions of the descendant classes, which then run
+/// their Draw function, and EndBuild. DrawExtrusion generates the geometry into the
+/// object's mesh, and, until EndBuild is called, doesn't submit it.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void CgleBaseExtrusion::BeginBuild()
+{
+	m_bRetained = true;
+	m_bBuildOnly = true;
+	Invalidate();
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::EndBuild()
+{
+	m_bBuildOnly = false;
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleBaseExtrusion::QueueBuild(CgleThreadPool &Pool,
+	std::function<void()> Build)
+{
+	CgleThreadPool *pool = &Pool;
 
-			if (face)
-			{
-				V3D (va, -1, FILLET);
-				V3D (vb, -1, FILLET);
-			}
-			else
-			{
-				V3D (vb, -1, FILLET);
-				V3D (va, -1, FILLET);
-			}
-			V3D (vc, -1, FILLET);
-		}
-		else
+	// a std::function must be copyable, and a packaged_task isn't
+	std::shared_ptr<std::packaged_task<const CgleMesh &()> > task(
+		new std::packaged_task<const CgleMesh &()>([this, pool, Build]() -> const CgleMesh &
 		{
-			if (face)
+			// a long path is split up on the same pool; see Split_Join
+			FSplitPool = pool;
+			try
 			{
-				N3D (na);
-				V3D (va, -1, FILLET);
-				N3D (nb);
-				V3D (vb, -1, FILLET);
+				Build();
 			}
-			else
+			catch (...)
 			{
-				N3D (nb);
-				V3D (vb, -1, FILLET);
-				N3D (na);
-				V3D (va, -1, FILLET);
-				N3D (nb);
+				FSplitPool = NULL;
+				throw;
 			}
-			V3D (vc, -1, FILLET);
-		}
-		ENDTMESH ();
-	}
+			FSplitPool = NULL;
 
+			return(GetMesh());
+		}));
 
-}			  
+	std::future<const CgleMesh &> mesh = task -> get_future();
+	Pool.Submit([task]() { (*task)(); });
+	return(mesh);
+}
+//----------------------------------------------------------------------------
+// The segments, at the least, in a run of a split path: enough that the
+// run's task and mesh come to little next to building it.
+#define SPLIT_SEGMENTS	128
+
+struct CgleBaseExtrusion::gleSplitBuild
+{
+	JoinFunction Join;
+	std::vector<gleJoinRun> Runs;
+	std::vector<CgleMesh> Meshes;		// one for each run
+	std::atomic<int> Next;			// the next run for someone to build
+
+	std::mutex Lock;
+	std::condition_variable Built;
+	int Left;				// runs not yet built
+	std::exception_ptr Error;
+};
 //----------------------------------------------------------------------------
-void CgleBaseExtrusion::Draw_Segment_Edge_N (double front_contour[][3],
-											 double back_contour[][3],
-											 double norm_cont[][3])
+// Builds a long path in runs, on the pool QueueBuild's task is running on,
+// into the mesh being built, and returns true; or returns false, and does
+// nothing, if the path isn't being built on a pool, or isn't long enough to
+// be worth it.
+//
+// The join loop hands on the up vector, the plane between segments and the
+// texture length from each segment to the next, so a run can't start until
+// they're known where it does: one pass down the path, going through the
+// same motions as the loop, finds them. Each run is then built by an object
+// of its own (see above), starting from what the pass found, and stopping
+// where the next run starts; only the first and last runs are capped. The
+// runs are taken in turn by the workers and by this thread, which, rather
+// than wait for runs still queued behind it, builds them itself, so that a
+// pool busy with other splits can't stall.
+//
+// A round or cut join whose texture goes by the length of the path isn't
+// split: each fillet it draws starts the length over (BGNTMESH (-5, 0.0)),
+// and whether it draws one is only known once the join has cut the ends.
+bool CgleBaseExtrusion::Split_Join(JoinFunction Join, bool Raw)
 {
+	if ((FSplitPool == NULL) || (_cgle_gc->mesh == NULL) || (m_iPoints - 3 < 2 * SPLIT_SEGMENTS))
+		return(false);
 
-	if (!m_bTexEnabled)
-	{
-		// draw the tube segment
-		glBegin (GL_TRIANGLE_STRIP);
+	if ((Join == &CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join) &&
+		(_cgle_gc->bgn_gen_texture == bgn_z_texgen))
+		return(false);
 
-		for (int j = 0; j < m_iContourPoints; j++)
-		{
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(front_contour[j]);
-			glVertex3dv(back_contour[j]);
-		}
+	int per = std::max(SPLIT_SEGMENTS, (m_iPoints - 3) / (4 * FSplitPool->GetThreadCount()) + 1);
+	std::shared_ptr<gleSplitBuild> split(new gleSplitBuild);
+	gleJoinRun run;
+	int segments = 0;
 
-		if  (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+	Join_Start(run, Raw);
+	split->Runs.push_back(run);
 
-		{
-			// connect back up to first point of contour
-			glNormal3dv(norm_cont[0]);
-			glVertex3dv(front_contour[0]);
-			glVertex3dv(back_contour[0]);
-		}
-		glEnd();
-	}
-	else
+	while (run.Next < m_iPoints - 1)
 	{
-		// draw the tube segment
-		BGNTMESH (m_iINext,m_dLen);
-		for (int j=0; j<m_iContourPoints; j++)
-		{
-			N3D (norm_cont[j]);
-			V3D (front_contour[j], j, FRONT);
-			V3D (back_contour[j], j, BACK);
-		}
+		Join_Step(run, Raw);
 
-		if  (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+		if ((++segments % per == 0) && (run.Next < m_iPoints - 1))
 		{
-			// connect back up to first point of contour
-			N3D (norm_cont[0]);
-			V3D (front_contour[0], 0, FRONT);
-			V3D (back_contour[0], 0, BACK);
+			split->Runs.back().Stop = run.First;
+			split->Runs.push_back(run);
 		}
-		ENDTMESH ();
 	}
 
-}
+	int runs = (int)split->Runs.size();
 
-// ============================================================
+	if (runs < 2)
+		return(false);
 
-void CgleBaseExtrusion::Draw_Segment_C_And_Edge_N (double front_contour[][3],
-												   double back_contour[][3],
-												   double norm_cont[][3])
-{
+	split->Join = Join;
+	split->Meshes.resize(runs);
+	split->Next = 0;
+	split->Left = runs;
+
+	for (int k = 1; k < runs; k++)
+		FSplitPool->Submit([this, split]() { (void)Build_Run(*split); });
+
+	while (Build_Run(*split))
+		;
 
-	if (!m_bTexEnabled)
 	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j<m_iContourPoints; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(front_contour[j]);
+		std::unique_lock<std::mutex> lock(split->Lock);
+		split->Built.wait(lock, [&split]() { return(split->Left == 0); });
+	}
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(back_contour[j]);
-		}
+	if (split->Error)
+		std::rethrow_exception(split->Error);
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+	CgleMesh &mesh = *_cgle_gc->mesh;
+	int vertices = 0, indices = 0, primitives = 0;
 
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[0]);
-			glVertex3dv(front_contour[0]);
+	for (int k = 0; k < runs; k++)
+	{
+		vertices += split->Meshes[k].GetVertexCount();
+		indices += split->Meshes[k].GetIndexCount();
+		primitives += split->Meshes[k].GetSegmentCount();
+	}
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm_cont[0]);
-			glVertex3dv(back_contour[0]);
-		}
-		glEnd();
+	// the first run's mesh is taken over as it stands, unless a sink is
+	// waiting for its segments; they reach it, in order, as they're appended
+	int k = 0;
+
+	if (!mesh.HasSink())
+		std::swap(mesh, split->Meshes[k++]);
+	mesh.Reserve(vertices, indices, primitives);
+	for (; k < runs; k++)
+		mesh.Append(split->Meshes[k]);
+
+	return(true);
+}
+//----------------------------------------------------------------------------
+// Builds the next run of a split path that nobody has taken yet, and returns
+// true; false if none is left. A task that comes to this after the path is
+// done finds none, and touches neither the object nor the path.
+bool CgleBaseExtrusion::Build_Run(gleSplitBuild &Split) const
+{
+	int k = Split.Next.fetch_add(1);
+
+	if (k >= (int)Split.Runs.size())
+		return(false);
+
+	try
+	{
+		CgleBaseExtrusion run(*this, Split.Runs[k]);
+		run.Generate_Run(Split.Meshes[k], Split.Join);
 	}
-	else
+	catch (...)
 	{
+		std::lock_guard<std::mutex> lock(Split.Lock);
+		if (!Split.Error)
+			Split.Error = std::current_exception();
+	}
 
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j < m_iContourPoints; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[j]);
-			V3D (front_contour[j], j, FRONT);
+	std::lock_guard<std::mutex> lock(Split.Lock);
+	if (--Split.Left == 0)
+		Split.Built.notify_all();
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm_cont[j]);
-			V3D (back_contour[j], j, BACK);
-		}
+	return(true);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::Generate_Run(CgleMesh &Mesh, JoinFunction Join)
+{
+	gleGC *saved_gc = _cgle_gc;
+	_cgle_gc = m_ptrGC;
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[0]);
-			V3D (front_contour[0], 0, FRONT);
+	_cgle_gc->mesh = &Mesh;
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm_cont[0]);
-			V3D (back_contour[0], 0, BACK);
-		}
-		ENDTMESH ();
-	}
+	// the texture length is taken up where the run starts; see bgn_z_texgen
+	_cgle_gc->accum_seg_len = FRun->Accum;
+	_cgle_gc->segment_length = 0.0;
+
+	AttachScratch();
+	(this->*Join)();
+
+	_cgle_gc = saved_gc;
 }
-// ============================================================
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::UseMeshCache(CgleMeshCache *Cache)
+{
+	FMeshCache = Cache;
+}
+//----------------------------------------------------------------------------
+CgleMeshCache *CgleBaseExtrusion::GetMeshCache() const
+{
+	return(FMeshCache);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::SetSegmentSink(CgleSegmentSink Sink)
+{
+	FSegmentSink = std::move(Sink);
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Marks the built geometry as stale.</summary>
+/// \details The next call to Draw regenerates it. LoadContourPoint, LoadUpVector,
+/// SetExtrusionMode, SetTextureMode and SetTForm call this; Draw also regenerates when
+/// it is given different arguments, or different arrays, from those the geometry was
+/// built with. Arrays are told apart by their address alone, so a caller that changes
+/// the contents of a path, color, radius, twist or transform array in place must call
+/// this itself. Has no effect on an object that hasn't been built.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void CgleBaseExtrusion::Invalidate()
+{
+	m_bMeshValid = false;
+	FKeyTaken = false;
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the object to immediate mode, freeing the built geometry.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void CgleBaseExtrusion::DiscardBuild()
+{
+	m_bRetained = false;
+	m_bMeshValid = false;
+	m_objMesh.Clear();
+	FMappedMesh.Clear();
+	std::vector<double>().swap(FCacheInputs);
+}
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns true if the object has been built, and its geometry is up to date.</summary>
+///
+/// \retval	bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+bool CgleBaseExtrusion::IsBuilt() const
+{
+	return(m_bRetained && m_bMeshValid);
+}
+//----------------------------------------------------------------------------
+// A mapped mesh is copied out the first time it's asked for.
+const CgleMesh &CgleBaseExtrusion::GetMesh() const
+{
+	if (!FMappedMesh.IsEmpty() && m_objMesh.IsEmpty())
+		FMappedMesh.CopyTo(m_objMesh);
+
+	return(m_objMesh);
+}
+//----------------------------------------------------------------------------
+const CgleMappedMesh *CgleBaseExtrusion::GetMappedMesh() const
+{
+	return(FMappedMesh.IsEmpty() ? NULL : &FMappedMesh);
+}
+//----------------------------------------------------------------------------
+CgleMeshSegments CgleBaseExtrusion::GetSegments() const
+{
+	if (!FMappedMesh.IsEmpty())
+		return(FMappedMesh.GetSegments());
+
+	return(m_objMesh.GetSegments());
+}
+//----------------------------------------------------------------------------
+CgleMesh CgleBaseExtrusion::TakeMesh()
+{
+	(void)GetMesh();
+	CgleMesh mesh(std::move(m_objMesh));
+
+	DiscardBuild();
+	return(mesh);
+}
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::DrawWireExtrusion(double Point_Array[][3],
+	float Color_Array[][3], bool bTextured)
+{
+	glPushAttrib(GL_POLYGON_BIT);
+	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	DrawExtrusion(Point_Array, Color_Array, bTextured);
+	glPopAttrib();
+}
+//----------------------------------------------------------------------------
 
-void CgleBaseExtrusion::Draw_Segment_Facet_N (double front_contour[][3],
-											  double back_contour[][3],
-											  double norm_cont[][3])
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::Draw_Fillet_Triangle_N_Norms (double va[3],
+													  double vb[3],
+													  double vc[3],
+													  int face,
+													  float front_color[3],
+													  double na[3],
+													  double nb[3])
 {
+
+	if (front_color != NULL)
+		SetColor (front_color);
+
 	if (!m_bTexEnabled)
 	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j<m_iContourPoints-1; j++)
+		GLE_BEGIN (GL_TRIANGLE_STRIP);
+		if (m_iExtrusionMode & GLE_NORM_FACET)
 		{
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(front_contour[j]);
-			glVertex3dv(back_contour[j]);
-			glVertex3dv(front_contour[j+1]);
-			glVertex3dv(back_contour[j+1]);
+			GLE_NORMAL3DV(na);
+			if (face)
+			{
+				GLE_VERTEX3DV(va);
+				GLE_VERTEX3DV(vb);
+			}
+			else
+			{
+				GLE_VERTEX3DV(vb);
+				GLE_VERTEX3DV(va);
+			}
+			GLE_VERTEX3DV(vc);
 		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+		else
 		{
-			// connect back up to first point of contour
-			glNormal3dv(norm_cont[m_iContourPoints-1]);
-			glVertex3dv(front_contour[m_iContourPoints-1]);
-			glVertex3dv(back_contour[m_iContourPoints-1]);
-			glVertex3dv(front_contour[0]);
-			glVertex3dv(back_contour[0]);
+			if (face)
+			{
+				GLE_NORMAL3DV(na);
+				GLE_VERTEX3DV(va);
+				GLE_NORMAL3DV(nb);
+				GLE_VERTEX3DV(vb);
+			}
+			else
+			{
+				GLE_NORMAL3DV(nb);
+				GLE_VERTEX3DV(vb);
+				GLE_NORMAL3DV(na);
+				GLE_VERTEX3DV(va);
+				GLE_NORMAL3DV(nb);
+			}
+			GLE_VERTEX3DV(vc);
 		}
+		GLE_END();
+
 
-		glEnd();
 	}
 	else
 	{
+		BGNTMESH (-5, 0.0);
 
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j=0; j<m_iContourPoints-1; j++)
+		if (m_iExtrusionMode & GLE_NORM_FACET)
 		{
-			N3D (norm_cont[j]);
-			V3D (front_contour[j], j, FRONT);
-			V3D (back_contour[j], j, BACK);
-			V3D (front_contour[j+1], j+1, FRONT);
-			V3D (back_contour[j+1], j+1, BACK);
-		}
+			N3D (na);
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+			if (face)
+			{
+				V3D (va, -1, FILLET);
+				V3D (vb, -1, FILLET);
+			}
+			else
+			{
+				V3D (vb, -1, FILLET);
+				V3D (va, -1, FILLET);
+			}
+			V3D (vc, -1, FILLET);
+		}
+		else
 		{
-			// connect back up to first point of contour
-			N3D (norm_cont[m_iContourPoints-1]);
-			V3D (front_contour[m_iContourPoints-1], m_iContourPoints-1, FRONT);
-			V3D (back_contour[m_iContourPoints-1], m_iContourPoints-1, BACK);
-			V3D (front_contour[0], 0, FRONT);
-			V3D (back_contour[0], 0, BACK);
+			if (face)
+			{
+				N3D (na);
+				V3D (va, -1, FILLET);
+				N3D (nb);
+				V3D (vb, -1, FILLET);
+			}
+			else
+			{
+				N3D (nb);
+				V3D (vb, -1, FILLET);
+				N3D (na);
+				V3D (va, -1, FILLET);
+				N3D (nb);
+			}
+			V3D (vc, -1, FILLET);
 		}
-
 		ENDTMESH ();
 	}
 
-}
 
+}			  
+//----------------------------------------------------------------------------
 // ============================================================
-
-void CgleBaseExtrusion::Draw_Segment_C_And_Facet_N(double front_contour[][3],
-												   double back_contour[][3],
-												   double norm_cont[][3])
-{
-	// Note about this code:
-	// At first, when looking at this code, it appears to be a bit bizarre:
-	// the N3F() call appears to be repeated multiple times, for no
-	// apparent purpose.  It would seem that a performance improvement
-	// would be gained by stripping it out. !DONT DO IT!
-	// When there are no local lights or viewers, the V3F() subroutine
-	// does not trigger a recalculation of the lighting equations.
-	// However, we MUST trigger lighting, since otherwise colors come out
-	// wrong.  Trigger lighting by doing an N3F call.
-	//
-
-	if (!m_bTexEnabled)
+//
+// The tube segments all come out of Emit_Segment(), which is compiled once
+// for each combination of: colors or none, facet or edge normals, one set of
+// normals or separate front and back ones, texture generation or none, and
+// mesh capture or GL.  Select_Segment_Emitter() picks the one wanted, once
+// per draw, so that the loops below need not test any of these per vertex.
+// There is no choice for xforms: every join applies them to its loops, once
+// per segment, before handing the loops over, and the raw join, without
+// xforms, hands over the contour itself.
+//
+// The pieces Emit_Segment() is made of.  With the flags known at compile
+// time, these come down to straight calls into the mesh or into GL.
+//
+template <bool ToMesh>
+static inline void Emit_Color(gleGC *gc, float color[3])
+{
+	if (ToMesh)
 	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j<m_iContourPoints-1; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(front_contour[j]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(back_contour[j]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(front_contour[j+1]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(norm_cont[j]);
-			glVertex3dv(back_contour[j+1]);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[m_iContourPoints-1]);
-			glVertex3dv(front_contour[m_iContourPoints-1]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(norm_cont[m_iContourPoints-1]);
-			glVertex3dv(back_contour[m_iContourPoints-1]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(norm_cont[m_iContourPoints-1]);
-			glVertex3dv(front_contour[0]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(norm_cont[m_iContourPoints-1]);
-			glVertex3dv(back_contour[0]);
-		}
-
-		glEnd();
+		// as SetColor() does
+		VEC_COPY (gc -> color, color);
+		gc -> mesh -> Color(color);
 	}
 	else
-	{
-		// draw the tube segment
-
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j=0; j<m_iContourPoints-1; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[j]);
-			V3D (front_contour[j], j, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (norm_cont[j]);
-			V3D (back_contour[j], j, BACK);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[j]);
-			V3D (front_contour[j+1], j+1, FRONT);
+		SetColor(color);
+}
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (norm_cont[j]);
-			V3D (back_contour[j+1], j+1, BACK);
-		}
+template <bool HasTexgen, bool ToMesh>
+static inline void Emit_Normal(gleGC *gc, double n[3])
+{
+	if (HasTexgen && gc -> n3d_gen_texture)
+		(*(gc -> n3d_gen_texture))(n);
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[m_iContourPoints-1]);
-			V3D (front_contour[m_iContourPoints-1], m_iContourPoints-1, FRONT);
+	if (ToMesh)
+		gc -> mesh -> Normal(n);
+	else
+		glNormal3dv(n);
+}
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (norm_cont[m_iContourPoints-1]);
-			V3D (back_contour[m_iContourPoints-1], m_iContourPoints-1, BACK);
+template <bool HasTexgen, bool ToMesh>
+static inline void Emit_Vertex(gleGC *gc, double v[3], int j, int id)
+{
+	if (HasTexgen && gc -> v3d_gen_texture)
+		(*(gc -> v3d_gen_texture))(v, j, id);
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (norm_cont[m_iContourPoints-1]);
-			V3D (front_contour[0], 0, FRONT);
+	if (ToMesh)
+		gc -> mesh -> Vertex(v);
+	else
+		glVertex3dv(v);
+}
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (norm_cont[m_iContourPoints-1]);
-			V3D (back_contour[0], 0, BACK);
-		}
+// One vertex of the strip: its color if there are colors, its normal unless
+// that is NULL, then the vertex itself.
+template <bool HasColor, bool HasTexgen, bool ToMesh>
+static inline void Emit_Point(gleGC *gc, float color[3], double n[3],
+							  double v[3], int j, int id)
+{
+	if (HasColor)
+		Emit_Color<ToMesh> (gc, color);
+	if (n != NULL)
+		Emit_Normal<HasTexgen, ToMesh> (gc, n);
+	Emit_Vertex<HasTexgen, ToMesh> (gc, v, j, id);
+}
 
-		ENDTMESH ();
-	}
-}		  
-// ============================================================
 // ============================================================
 //
-// This routine draws a segment with normals specified at each end.
+// This routine draws one segment of tubing, from the front contour to the
+// back one.  With edge normals there is a normal per contour point; with
+// facet normals, one per contour edge, given at each of its four vertices.
+// Without BiNorm, the front normals serve for the back as well, and
+// back_norm is ignored.
 //
-void CgleBaseExtrusion::Draw_Binorm_Segment_Edge_N (double front_contour[][3],
-													double back_contour[][3],
-													double front_norm[][3],
-													double back_norm[][3])
+// Note that, with colors, the normal is given again at each vertex, even
+// where it has not changed.  The color changes the material, and without a
+// normal the lighting would not be recomputed, so the colors would come
+// out wrong.  The same goes for separate front and back normals.
+//
+template <bool HasColor, int NormalMode, bool BiNorm, bool HasTexgen, bool ToMesh>
+void CgleBaseExtrusion::Emit_Segment(double front_contour[][3],
+									 double back_contour[][3],
+									 double front_norm[][3],
+									 double back_norm[][3])
 {
+	const bool renorm = HasColor || BiNorm;
+	gleGC *gc = _cgle_gc;
+	float *front_color = NULL;
+	float *back_color = NULL;
+	int ncp = m_iContourPoints;
+	int j;
 
-	if (!m_bTexEnabled)
+	if (HasColor)
 	{
-		// draw the tube segment
+		front_color = m_ptrColorArray[m_iINext - 1];
+		back_color = m_ptrColorArray[m_iINext];
+	}
+
+	if (!BiNorm)
+		back_norm = front_norm;
+
+	// draw the tube segment
+	if (HasTexgen && gc -> bgn_gen_texture)
+		(*(gc -> bgn_gen_texture))(m_iINext, m_dLen);
+
+	if (ToMesh)
+		gc -> mesh -> Begin(GL_TRIANGLE_STRIP);
+	else
 		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j< m_iContourPoints ; j++)
+
+	if (NormalMode == GLE_NORM_FACET)
+	{
+		for (j = 0; j < ncp - 1; j++)
 		{
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j]);
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j]);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				front_norm[j], front_contour[j], j, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[j] : NULL, back_contour[j], j, BACK);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				renorm ? front_norm[j] : NULL, front_contour[j+1], j+1, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[j] : NULL, back_contour[j+1], j+1, BACK);
 		}
 
 		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-
 		{
 			// connect back up to first point of contour
-			glNormal3dv(front_norm[0]);
-			glVertex3dv(front_contour[0]);
-			glNormal3dv(back_norm[0]);
-			glVertex3dv(back_contour[0]);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				front_norm[ncp-1], front_contour[ncp-1], ncp-1, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[ncp-1] : NULL, back_contour[ncp-1], ncp-1, BACK);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				renorm ? front_norm[ncp-1] : NULL, front_contour[0], 0, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[ncp-1] : NULL, back_contour[0], 0, BACK);
 		}
-		glEnd();
 	}
 	else
 	{
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j < m_iContourPoints; j++)
+		for (j = 0; j < ncp; j++)
 		{
-			N3D (front_norm[j]);
-			V3D (front_contour[j], j, FRONT);
-			N3D (back_norm[j]);
-			V3D (back_contour[j], j, BACK);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				front_norm[j], front_contour[j], j, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[j] : NULL, back_contour[j], j, BACK);
 		}
 
 		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
 		{
 			// connect back up to first point of contour
-			N3D (front_norm[0]);
-			V3D (front_contour[0], 0, FRONT);
-			N3D (back_norm[0]);
-			V3D (back_contour[0], 0, BACK);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, front_color,
+				front_norm[0], front_contour[0], 0, FRONT);
+			Emit_Point<HasColor, HasTexgen, ToMesh> (gc, back_color,
+				renorm ? back_norm[0] : NULL, back_contour[0], 0, BACK);
 		}
-		ENDTMESH ();
 	}
+
+	if (HasTexgen && gc -> end_gen_texture)
+		(*(gc -> end_gen_texture))();
+
+	if (ToMesh)
+		gc -> mesh -> End();
+	else
+		glEnd();
 }
-// ============================================================
-void CgleBaseExtrusion::Draw_Binorm_Segment_C_And_Edge_N(double front_contour[][3],
-														 double back_contour[][3],
-														 double front_norm[][3],
-														 double back_norm[][3])
-{
-	if (!m_bTexEnabled)
-	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j<m_iContourPoints; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j]);
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j]);
-		}
+// ============================================================
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+#define EMITTER(c,f,b,t,m)	\
+	&CgleBaseExtrusion::Emit_Segment<c, (f) ? GLE_NORM_FACET : GLE_NORM_EDGE, b, t, m>
 
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[0]);
-			glVertex3dv(front_contour[0]);
+#define EMITTERS(c,f,b)		\
+	EMITTER(c,f,b,false,false), EMITTER(c,f,b,false,true),	\
+	EMITTER(c,f,b,true,false), EMITTER(c,f,b,true,true)
 
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[0]);
-			glVertex3dv(back_contour[0]);
-		}
-		glEnd();
-	}
-	else
-	{
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j < m_iContourPoints; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[j]);
-			V3D (front_contour[j], j, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (back_norm[j]);
-			V3D (back_contour[j], j, BACK);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[0]);
-			V3D (front_contour[0], 0, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (back_norm[0]);
-			V3D (back_contour[0], 0, BACK);
-		}
-		ENDTMESH ();
-	}
-}
-// ============================================================
-//
-// This routine draws a piece of the round segment with psuedo-facet
-// normals.  I say "psuedo-facet" because the resulting object looks
-// much, much better than real facet normals, and is what the  round
-// join style was meant to accomplish for face normals.
-//
-void CgleBaseExtrusion::Draw_Binorm_Segment_Facet_N (double front_contour[][3],
-													 double back_contour[][3],
-													 double front_norm[][3],
-													 double back_norm[][3])
+CgleBaseExtrusion::SegmentEmitter CgleBaseExtrusion::Select_Segment_Emitter(
+	bool HasColor, bool BiNorm)
 {
-	if (!m_bTexEnabled)
-	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j=0; j<m_iContourPoints-1; j++)
-		{
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j]);
-
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j]);
-
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j+1]);
-
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j+1]);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-
-		{
-			// connect back up to first point of contour
-			glNormal3dv(front_norm[m_iContourPoints-1]);
-			glVertex3dv(front_contour[m_iContourPoints-1]);
-
-			glNormal3dv(back_norm[m_iContourPoints-1]);
-			glVertex3dv(back_contour[m_iContourPoints-1]);
-
-			glNormal3dv(front_norm[m_iContourPoints-1]);
-			glVertex3dv(front_contour[0]);
-
-			glNormal3dv(back_norm[m_iContourPoints-1]);
-			glVertex3dv(back_contour[0]);
-		}
-		glEnd();
-	}
-	else
-	{
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j< m_iContourPoints - 1; j++)
-		{
-			N3D (front_norm[j]);
-			V3D (front_contour[j], j, FRONT);
-
-			N3D (back_norm[j]);
-			V3D (back_contour[j], j, BACK);
-
-			N3D (front_norm[j]);
-			V3D (front_contour[j+1], j+1, FRONT);
-
-			N3D (back_norm[j]);
-			V3D (back_contour[j+1], j+1, BACK);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			N3D (front_norm[m_iContourPoints-1]);
-			V3D (front_contour[m_iContourPoints-1], m_iContourPoints-1, FRONT);
-
-			N3D (back_norm[m_iContourPoints-1]);
-			V3D (back_contour[m_iContourPoints-1], m_iContourPoints-1, BACK);
-
-			N3D (front_norm[m_iContourPoints-1]);
-			V3D (front_contour[0], 0, FRONT);
-
-			N3D (back_norm[m_iContourPoints-1]);
-			V3D (back_contour[0], 0, BACK);
-		}
-		ENDTMESH ();
-	}
+	static const SegmentEmitter emitters[32] =
+	{
+		EMITTERS(false, false, false), EMITTERS(false, false, true),
+		EMITTERS(false, true, false), EMITTERS(false, true, true),
+		EMITTERS(true, false, false), EMITTERS(true, false, true),
+		EMITTERS(true, true, false), EMITTERS(true, true, true)
+	};
+
+	int k = 0;
+
+	if (HasColor)
+		k |= 16;
+	if (m_iExtrusionMode & GLE_NORM_FACET)
+		k |= 8;
+	if (BiNorm)
+		k |= 4;
+	if (m_bTexEnabled)
+		k |= 2;
+	if (_cgle_gc -> mesh != NULL)
+		k |= 1;
 
+	return(emitters[k]);
 }
 
-// ============================================================
-
-void CgleBaseExtrusion::Draw_Binorm_Segment_C_And_Facet_N(
-	double front_contour[][3],
-	double back_contour[][3],
-	double front_norm[][3],
-	double back_norm[][3])
-{
-
-	if (!m_bTexEnabled)
-	{
-		// draw the tube segment
-		glBegin(GL_TRIANGLE_STRIP);
-
-		for (int j=0; j<m_iContourPoints-1; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[j]);
-			glVertex3dv(front_contour[j+1]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[j]);
-			glVertex3dv(back_contour[j+1]);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[m_iContourPoints-1]);
-			glVertex3dv(front_contour[m_iContourPoints-1]);
-
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[m_iContourPoints-1]);
-			glVertex3dv(back_contour[m_iContourPoints-1]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			glNormal3dv(front_norm[m_iContourPoints-1]);
-			glVertex3dv(front_contour[0]);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			glNormal3dv(back_norm[m_iContourPoints-1]);
-			glVertex3dv(back_contour[0]);
-		}
-		glEnd();
-	}
-	else
-	{
-		// draw the tube segment
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j=0; j<m_iContourPoints-1; j++)
-		{
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[j]);
-			V3D (front_contour[j], j, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (back_norm[j]);
-			V3D (back_contour[j], j, BACK);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[j]);
-			V3D (front_contour[j+1], j+1, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (back_norm[j]);
-			V3D (back_contour[j+1], j+1, BACK);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[m_iContourPoints-1]);
-			V3D (front_contour[m_iContourPoints-1], m_iContourPoints-1, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (back_norm[m_iContourPoints-1]);
-			V3D (back_contour[m_iContourPoints-1], m_iContourPoints-1, BACK);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-			N3D (front_norm[m_iContourPoints-1]);
-			V3D (front_contour[0], 0, FRONT);
-
-			SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext ][0]);
-			N3D (back_norm[m_iContourPoints-1]);
-			V3D (back_contour[0], 0, BACK);
-		}
-
-		ENDTMESH ();
-	}
-
-}
+#undef EMITTERS
+#undef EMITTER
 
 // ============================================================
 
@@ -1140,10 +1570,6 @@ void CgleBaseExtrusion::Draw_Fillets_And_Join_N_Norms( int ncp,
 	int was_trimmed = FALSE;
 
 
-	FNNormCapLoop = new double[(ncp + 3)*6];
-
-	FNNormLoop =  FNNormCapLoop + (ncp+3)*3;
-
 	// if the first point on the contour isn't trimmed, go ahead and
 	// drop an edge down to the bisecting plane, (thus starting the
 	// join).  (Only need to do this for cut join, its bad if done for
@@ -1205,8 +1631,9 @@ void CgleBaseExtrusion::Draw_Fillets_And_Join_N_Norms( int ncp,
 
 	// save the join style, and disable a closed contour.
 	// Need to do this so partial contours don't close up.
+	// (set directly, as this is no change to the geometry being built)
 	save_style = GetExtrusionMode ();
-	SetExtrusionMode (save_style & ~GLE_CONTOUR_CLOSED);
+	m_iExtrusionMode = save_style & ~GLE_CONTOUR_CLOSED;
 
 	for (; icnt_prev < istop; icnt_prev ++, icnt ++, icnt %= ncp)
 	{
@@ -1351,7 +1778,7 @@ void CgleBaseExtrusion::Draw_Fillets_And_Join_N_Norms( int ncp,
 		//
 		if (!was_trimmed)
 		{
-			SetExtrusionMode (save_style);
+			m_iExtrusionMode = save_style;
 		}
 
 		// draw cap
@@ -1365,8 +1792,7 @@ void CgleBaseExtrusion::Draw_Fillets_And_Join_N_Norms( int ncp,
 	}
 
 	// rest to the saved style
-	SetExtrusionMode (save_style);
-	delete[] FNNormCapLoop;
+	m_iExtrusionMode = save_style;
 }													   
 //---------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -1442,956 +1868,233 @@ void CgleBaseExtrusion::Draw_Round_Style_Cap_Callback (int ncp,double cap[][3],
 
 	// ------------ done setting up rotation matrix -------------
 
-	((CgleBaseExtrusion*)clOwner)->FMallocedArea = new char[104*ncp];
 	last_contour = (double *) ((CgleBaseExtrusion*)clOwner)->FMallocedArea;
 	next_contour = last_contour +  3*ncp;
 	cap_z = next_contour + 3*ncp;
-	last_norm = cap_z + ncp;
-	next_norm = last_norm + 3*ncp;
-
-	// make first copy of contour
-	if (frontwards)
-	{
-		for (j=0; j<ncp; j++)
-		{
-			last_contour[3*j] = cap[j][0];
-			last_contour[3*j+1] = cap[j][1];
-			last_contour[3*j+2] = cap_z[j] = cap[j][2];
-		}
-
-		if (norms != NULL)
-		{
-			for (j=0; j<ncp; j++)
-			{
-				VEC_COPY ((&last_norm[3*j]), norms[j]);
-			}
-		}
-	}
-	else
-	{
-		// in order for backfacing polygon removal to work correctly, have
-		// to have the sense in which the joins are drawn to be reversed
-		// for the back cap.  This can be done by reversing the order of
-		// the contour points.  Normals are a bit trickier, since the
-		// reversal is off-by-one for facet normals as compared to edge
-		// normals.
-		for (j=0; j<ncp; j++)
-		{
-			k = ncp - j - 1;
-			last_contour[3*k] = cap[j][0];
-			last_contour[3*k+1] = cap[j][1];
-			last_contour[3*k+2] = cap_z[k] = cap[j][2];
-		}
-
-		if (norms != NULL)
-		{
-			if (((CgleBaseExtrusion*)clOwner)->m_iExtrusionMode & GLE_NORM_FACET)
-
-			{
-				for (j=0; j<ncp-1; j++)
-				{
-					k = ncp - j - 2;
-					VEC_COPY ((&last_norm[3*k]), norms[j]);
-				}
-			}
-			else
-			{
-				for (j=0; j<ncp; j++)
-				{
-					k = ncp - j - 1;
-					VEC_COPY ((&last_norm[3*k]), norms[j]);
-				}
-			}
-		}
-	}
-
-	// &&&&&&&&&&&&&& start drawing cap &&&&&&&&&&&&&
-
-	for (i=0; i<__ROUND_TESS_PIECES; i++)
-	{
-		for (j=0; j<ncp; j++)
-		{
-			next_contour [3*j+2] -= cap_z[j];
-			last_contour [3*j+2] -= cap_z[j];
-			MAT_DOT_VEC_3X3 ( (&next_contour[3*j]), m, (&last_contour[3*j]));
-			next_contour [3*j+2] += cap_z[j];
-			last_contour [3*j+2] += cap_z[j];
-		}
-
-		if (norms != NULL)
-		{
-			for (j=0; j<ncp; j++)
-			{
-				MAT_DOT_VEC_3X3 ( (&next_norm[3*j]), m, (&last_norm[3*j]));
-			}
-		}
-
-		int temp = ((CgleBaseExtrusion*)clOwner)->m_iINext;     // fucked up! need to buffer m_dLen too!
-		((CgleBaseExtrusion*)clOwner)->m_iINext = 0;        // have to buffer these two values. Everywhere else
-		int tempcp = ((CgleBaseExtrusion*)clOwner)->m_iContourPoints;// ncp and inext equal the globals, but
-		((CgleBaseExtrusion*)clOwner)->m_iContourPoints = ncp;             // not here.
-		double templen = ((CgleBaseExtrusion*)clOwner)->m_dLen;
-		((CgleBaseExtrusion*)clOwner)->m_dLen = 0.0;
-
-		// OK, now render it all
-
-		if (((CgleBaseExtrusion*)clOwner)->m_iExtrusionMode & GLE_NORM_FACET)
-		{
-
-			((CgleBaseExtrusion*)clOwner)->Draw_Binorm_Segment_Facet_N ((gleVector *) next_contour,
-				(gleVector *) last_contour,
-				(gleVector *) next_norm,
-				(gleVector *) last_norm);
-		}
-		else
-		{
-			((CgleBaseExtrusion*)clOwner)->Draw_Binorm_Segment_Edge_N ((gleVector *) next_contour,
-				(gleVector *) last_contour,
-				(gleVector *) next_norm,
-				(gleVector *) last_norm);
-		}
-		((CgleBaseExtrusion*)clOwner)->m_iINext = temp;
-		((CgleBaseExtrusion*)clOwner)->m_iContourPoints = tempcp;
-		((CgleBaseExtrusion*)clOwner)->m_dLen = templen;
-
-
-		// swap contours
-		tmp = next_contour;
-		next_contour = last_contour;
-		last_contour = tmp;
-
-		tmp = next_norm;
-		next_norm = last_norm;
-		last_norm = tmp;
-	}
-	delete[] ((CgleBaseExtrusion*)clOwner)->FMallocedArea;
-	// &&&&&&&&&&&&&& end drawing cap &&&&&&&&&&&&&
-}
-//----------------------------------------------------------------------------
-//----------------------------------------------------------------------------
-void CgleBaseExtrusion::Draw_Cut_Style_Cap_Callback (int iloop,double cap[][3],
-													 float face_color[3], double cut_vector[3],
-													 double bisect_vector[3], double norms[][3],
-													 int frontwards, void* clOwner)
-{
-
-	int i;
-
-
-	gluTessCallback (((CgleBaseExtrusion*)clOwner)->m_objTess, 
-		GLU_TESS_BEGIN, (void(__stdcall*)())glBegin);
-
-	gluTessCallback (((CgleBaseExtrusion*)clOwner)->m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
-
-	gluTessCallback (((CgleBaseExtrusion*)clOwner)->m_objTess, GLU_TESS_END, 
-		(void(__stdcall*)())glEnd);
-
-	if (face_color != NULL)
-		SetColor (face_color);
-
-	if (frontwards)
-	{
-		// if lighting is on, specify the endcap normal
-		if (cut_vector != NULL)
-		{
-			// if normal pointing in wrong direction, flip it.
-			if (cut_vector[2] < 0.0)
-				VEC_SCALE (cut_vector, -1.0, cut_vector);
-
-			N3D (cut_vector);
-		}
-		gluTessBeginPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess,NULL);
-		gluTessBeginContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
-
-		for (i=0; i<iloop; i++)
-		{
-			gluTessVertex (((CgleBaseExtrusion*)clOwner)->m_objTess, cap[i], cap[i]);
-		}
-		gluTessEndContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
-		gluTessEndPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess);
-	}
-	else
-	{
-		// if lighting is on, specify the endcap normal
-
-		if (cut_vector != NULL)
-		{
-			// if normal pointing in wrong direction, flip it.
-			if (cut_vector[2] > 0.0)
-			{
-				VEC_SCALE (cut_vector, -1.0, cut_vector);
-			}
-			N3D (cut_vector);
-		}
-		// the sense of the loop is reversed for backfacing culling
-		gluTessBeginPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess,NULL);
-		gluTessBeginContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
-		for (i=iloop-1; i>-1; i--)
-		{
-			gluTessVertex (((CgleBaseExtrusion*)clOwner)->m_objTess, cap[i], cap[i]);
-		}
-		gluTessEndContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
-		gluTessEndPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess);
-	}
-}			   
-//----------------------------------------------------------------------------
-void CgleBaseExtrusion::Draw_Angle_Style_Back_Cap ( double bi[3],
-												   double point_array[][3])
-{
-	int j;
-
-	if (bi[2] > 0.0)
-	{
-		VEC_SCALE (bi, -1.0, bi);
-	}
-
-	N3D(bi);
-
-	gluTessCallback (m_objTess, GLU_TESS_BEGIN, (void(__stdcall*)())glBegin);
-
-	gluTessCallback (m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
-
-	gluTessCallback (m_objTess, GLU_TESS_END, (void(__stdcall*)())glEnd);
-
-	gluTessBeginPolygon (m_objTess,NULL);
-	gluTessBeginContour (m_objTess);
-
-	for (j=m_iContourPoints-1; j>=0; j--)
-	{
-		gluTessVertex (m_objTess, point_array[j], point_array[j]);
-	}
-	gluTessEndContour (m_objTess);
-	gluTessEndPolygon (m_objTess);
-}
-
-//----------------------------------------------------------------------------
-// ============================================================
-void CgleBaseExtrusion::Draw_Angle_Style_Front_Cap (double bi[3],// biscetor
-													double point_array[][3])
-{
-
-	if (bi[2] < 0.0)
-		VEC_SCALE (bi, -1.0, bi);
-
-
-	N3D(bi);
-
-	gluTessCallback (m_objTess, GLU_TESS_BEGIN,(void(__stdcall*)()) glBegin);
-
-	gluTessCallback (m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
-
-	gluTessCallback (m_objTess, GLU_TESS_END, (void(__stdcall*)())glEnd);
-
-	gluTessBeginPolygon (m_objTess,NULL);
-	gluTessBeginContour (m_objTess);
-
-	for (int j=0; j<m_iContourPoints; j++)
-	{
-		gluTessVertex (m_objTess, point_array[j], point_array[j]);
-	}
-	gluTessEndContour (m_objTess);
-	gluTessEndPolygon (m_objTess);
-}			   
-//----------------------------------------------------------------------------
-// ============================================================
-// This routine draws a segment of raw-join-style tubing.
-// Essentially, we assume that the proper transformations have already
-// been performed to properly orient the tube segment -- our only task
-// left is to render
-// C_AND_FACET_N -- DRAW FACET NORMALS AND COLORS
-
-void CgleBaseExtrusion::Draw_Raw_Segment_C_And_Facet_N ()
-
-{
-
-	if (!m_bTexEnabled)
-	{
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j = 0; j < m_iContourPoints-1; j++)
-		{
-			// facet normals require one normal per four vertices;
-			// However, we have to respecify normal each time at each vertex
-			// so that the lighting equation gets triggered.  (V3F does NOT
-			// automatically trigger the lighting equations -- it only
-			// triggers when there is a local light)
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm);
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-
-
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[j+1][0];
-			point [1] = m_ptrContours[j+1][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm);
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-
-		{
-			// connect back up to first point of m_ptrContours
-			point [0] = m_ptrContours[m_iContourPoints-1][0];
-			point [1] = m_ptrContours[m_iContourPoints-1][1];
-			point [2] = 0.0;
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[m_iContourPoints-1][0];
-			norm [1] = m_ptrCont_Norms[m_iContourPoints-1][1];
-			glNormal3dv(norm);
-			glVertex3dv(point);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
-
-		glEnd();
-
-		// draw the endcaps, if the join style calls for it
-
-		if (m_iExtrusionMode & GLE_JN_CAP)
-
-		{
-
-			// draw the front cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap ( m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [2] = -1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
-		}
-
-	}
-	else
-	{
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j < m_iContourPoints-1; j++)
-		{
-			// facet normals require one normal per four vertices;
-			// However, we have to respecify normal each time at each vertex
-			// so that the lighting equation gets triggered.  (V3F does NOT
-			// automatically trigger the lighting equations -- it only
-			// triggers when there is a local light)
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			V3D (point, j, FRONT);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm);
-			point [2] = - m_dLen;
-			V3D (point, j, BACK);
-
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			N3D (norm);
-
-			point [0] = m_ptrContours[j+1][0];
-			point [1] = m_ptrContours[j+1][1];
-			point [2] = 0.0;
-			V3D (point, j+1, FRONT);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm);
-			point [2] = - m_dLen;
-			V3D (point, j+1, BACK);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of contour
-			point [0] = m_ptrContours[m_iContourPoints-1][0];
-			point [1] = m_ptrContours[m_iContourPoints-1][1];
-			point [2] = 0.0;
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[m_iContourPoints-1][0];
-			norm [1] = m_ptrCont_Norms[m_iContourPoints-1][1];
-			N3D (norm);
-			V3D (point, m_iContourPoints-1, FRONT);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm);
-
-			point [2] = - m_dLen;
-			V3D (point, m_iContourPoints-1, BACK);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			V3D (point, 0, FRONT);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm);
-
-			point [2] = - m_dLen;
-			V3D (point, 0, BACK);
-		}
-
-		ENDTMESH ();
-
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
-		{
-
-			// draw the front cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [2] = -1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
-		}
-	}
-}
-//----------------------------------------------------------------------------
-// ============================================================
-// This routine draws a segment of raw-join-style tubing.
-// Essentially, we assume that the proper transformations have already
-// been performed to properly orient the tube segment -- our only task
-// left is to render
-// FACET_N -- DRAW ONLY FACET NORMALS
-
-void CgleBaseExtrusion::Draw_Raw_Segment_Facet_N ()
-
-{
-
-	if (!m_bTexEnabled)
-	{
-
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j = 0; j < m_iContourPoints-1; j++)
-		{
-			// facet normals require one normal per four vertices
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-
-			point [0] = m_ptrContours[j+1][0];
-			point [1] = m_ptrContours[j+1][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+	last_norm = cap_z + ncp;
+	next_norm = last_norm + 3*ncp;
 
+	// make first copy of contour
+	if (frontwards)
+	{
+		for (j=0; j<ncp; j++)
 		{
-			// connect back up to first point of m_ptrContours
-			norm [0] = m_ptrCont_Norms[m_iContourPoints-1][0];
-			norm [1] = m_ptrCont_Norms[m_iContourPoints-1][1];
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[m_iContourPoints-1][0];
-			point [1] = m_ptrContours[m_iContourPoints-1][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
+			last_contour[3*j] = cap[j][0];
+			last_contour[3*j+1] = cap[j][1];
+			last_contour[3*j+2] = cap_z[j] = cap[j][2];
 		}
 
-		glEnd();
-
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
-
+		if (norms != NULL)
 		{
-
-			// draw the front cap
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap ( m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			norm [2] = -1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
+			for (j=0; j<ncp; j++)
+			{
+				VEC_COPY ((&last_norm[3*j]), norms[j]);
+			}
 		}
 	}
 	else
 	{
-
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		BGNTMESH (m_iINext, m_dLen);
-
-		for (int j = 0; j < m_iContourPoints-1; j++)
+		// in order for backfacing polygon removal to work correctly, have
+		// to have the sense in which the joins are drawn to be reversed
+		// for the back cap.  This can be done by reversing the order of
+		// the contour points.  Normals are a bit trickier, since the
+		// reversal is off-by-one for facet normals as compared to edge
+		// normals.
+		for (j=0; j<ncp; j++)
 		{
-			// facet normals require one normal per four vertices
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			V3D (point, j, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, j, BACK);
-
-			point [0] = m_ptrContours[j+1][0];
-			point [1] = m_ptrContours[j+1][1];
-			point [2] = 0.0;
-			V3D (point, j+1, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, j+1, BACK);
+			k = ncp - j - 1;
+			last_contour[3*k] = cap[j][0];
+			last_contour[3*k+1] = cap[j][1];
+			last_contour[3*k+2] = cap_z[k] = cap[j][2];
 		}
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+		if (norms != NULL)
 		{
-			//connect back up to first point of m_ptrContours
-			norm [0] = m_ptrCont_Norms[m_iContourPoints-1][0];
-			norm [1] = m_ptrCont_Norms[m_iContourPoints-1][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[m_iContourPoints-1][0];
-			point [1] = m_ptrContours[m_iContourPoints-1][1];
-			point [2] = 0.0;
-			V3D (point, m_iContourPoints-1, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, m_iContourPoints-1, BACK);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			V3D (point, 0, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, 0, BACK);
-		}
-
-		ENDTMESH ();
+			if (((CgleBaseExtrusion*)clOwner)->m_iExtrusionMode & GLE_NORM_FACET)
 
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
-		{
-			// draw the front cap
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			norm [2] = -1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
+			{
+				for (j=0; j<ncp-1; j++)
+				{
+					k = ncp - j - 2;
+					VEC_COPY ((&last_norm[3*k]), norms[j]);
+				}
+			}
+			else
+			{
+				for (j=0; j<ncp; j++)
+				{
+					k = ncp - j - 1;
+					VEC_COPY ((&last_norm[3*k]), norms[j]);
+				}
+			}
 		}
 	}
-}
-//----------------------------------------------------------------------------
 
-// ============================================================
-// This routine draws a segment of raw-join-style tubing.
-// Essentially, we assume that the proper transformations have already
-// been performed to properly orient the tube segment -- our only task
-// left is to render
-// C_AND_EDGE_N -- DRAW EDGE NORMALS AND COLORS
+	// &&&&&&&&&&&&&& start drawing cap &&&&&&&&&&&&&
 
-void CgleBaseExtrusion::Draw_Raw_Segment_C_And_Edge_N ()
-{
-	if (!m_bTexEnabled)
+	for (i=0; i<__ROUND_TESS_PIECES; i++)
 	{
-
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j = 0; j < m_iContourPoints; j++)
+		for (j=0; j<ncp; j++)
 		{
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
+			next_contour [3*j+2] -= cap_z[j];
+			last_contour [3*j+2] -= cap_z[j];
+			MAT_DOT_VEC_3X3 ( (&next_contour[3*j]), m, (&last_contour[3*j]));
+			next_contour [3*j+2] += cap_z[j];
+			last_contour [3*j+2] += cap_z[j];
+		}
 
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			glNormal3dv(norm);
+		if (norms != NULL)
+		{
+			for (j=0; j<ncp; j++)
+			{
+				MAT_DOT_VEC_3X3 ( (&next_norm[3*j]), m, (&last_norm[3*j]));
+			}
+		}
 
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
+		int temp = ((CgleBaseExtrusion*)clOwner)->m_iINext;     // fucked up! need to buffer m_dLen too!
+		((CgleBaseExtrusion*)clOwner)->m_iINext = 0;        // have to buffer these two values. Everywhere else
+		int tempcp = ((CgleBaseExtrusion*)clOwner)->m_iContourPoints;// ncp and inext equal the globals, but
+		((CgleBaseExtrusion*)clOwner)->m_iContourPoints = ncp;             // not here.
+		double templen = ((CgleBaseExtrusion*)clOwner)->m_dLen;
+		((CgleBaseExtrusion*)clOwner)->m_dLen = 0.0;
 
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			glNormal3dv(norm);
+		// OK, now render it all
 
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
+		// the face color, if any, was set above
+		SegmentEmitter emit = ((CgleBaseExtrusion*)clOwner)->Select_Segment_Emitter(false, true);
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+		(((CgleBaseExtrusion*)clOwner)->*emit) ((gleVector *) next_contour,
+			(gleVector *) last_contour,
+			(gleVector *) next_norm,
+			(gleVector *) last_norm);
 
-		{
-			// connect back up to first point of m_ptrContours
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
+		((CgleBaseExtrusion*)clOwner)->m_iINext = temp;
+		((CgleBaseExtrusion*)clOwner)->m_iContourPoints = tempcp;
+		((CgleBaseExtrusion*)clOwner)->m_dLen = templen;
 
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			glNormal3dv(norm);
 
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
+		// swap contours
+		tmp = next_contour;
+		next_contour = last_contour;
+		last_contour = tmp;
 
+		tmp = next_norm;
+		next_norm = last_norm;
+		last_norm = tmp;
+	}
+	// &&&&&&&&&&&&&& end drawing cap &&&&&&&&&&&&&
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::Draw_Cut_Style_Cap_Callback (int iloop,double cap[][3],
+													 float face_color[3], double cut_vector[3],
+													 double bisect_vector[3], double norms[][3],
+													 int frontwards, void* clOwner)
+{
 
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			glNormal3dv(norm);
+	int i;
 
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
 
-		glEnd();
+	Set_Tess_Callbacks (((CgleBaseExtrusion*)clOwner)->m_objTess);
 
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
+	if (face_color != NULL)
+		SetColor (face_color);
 
+	if (frontwards)
+	{
+		// if lighting is on, specify the endcap normal
+		if (cut_vector != NULL)
 		{
-			// draw the front cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [2] = -1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
+			// if normal pointing in wrong direction, flip it.
+			if (cut_vector[2] < 0.0)
+				VEC_SCALE (cut_vector, -1.0, cut_vector);
+
+			N3D (cut_vector);
 		}
+		gluTessBeginPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess, _cgle_gc -> mesh);
+		gluTessBeginContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
 
+		for (i=0; i<iloop; i++)
+		{
+			gluTessVertex (((CgleBaseExtrusion*)clOwner)->m_objTess, cap[i], cap[i]);
+		}
+		gluTessEndContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
+		gluTessEndPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess);
 	}
 	else
 	{
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		BGNTMESH (m_iINext, m_dLen);
+		// if lighting is on, specify the endcap normal
 
-		for (int j = 0; j < m_iContourPoints; j++)
+		if (cut_vector != NULL)
 		{
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			V3D (point, j, FRONT);
-
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			N3D (norm);
-
-			point [2] = - m_dLen;
-			V3D (point, j, BACK);
+			// if normal pointing in wrong direction, flip it.
+			if (cut_vector[2] > 0.0)
+			{
+				VEC_SCALE (cut_vector, -1.0, cut_vector);
+			}
+			N3D (cut_vector);
 		}
-
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
+		// the sense of the loop is reversed for backfacing culling
+		gluTessBeginPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess, _cgle_gc -> mesh);
+		gluTessBeginContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
+		for (i=iloop-1; i>-1; i--)
 		{
-			// connect back up to first point of m_ptrContours
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			V3D (point, 0, FRONT);
+			gluTessVertex (((CgleBaseExtrusion*)clOwner)->m_objTess, cap[i], cap[i]);
+		}
+		gluTessEndContour (((CgleBaseExtrusion*)clOwner)->m_objTess);
+		gluTessEndPolygon (((CgleBaseExtrusion*)clOwner)->m_objTess);
+	}
+}			   
+//----------------------------------------------------------------------------
+void CgleBaseExtrusion::Draw_Angle_Style_Back_Cap ( double bi[3],
+												   double point_array[][3])
+{
+	int j;
 
+	if (bi[2] > 0.0)
+	{
+		VEC_SCALE (bi, -1.0, bi);
+	}
 
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			N3D (norm);
+	N3D(bi);
 
-			point [2] = - m_dLen;
-			V3D (point, 0, BACK);
-		}
+	Set_Tess_Callbacks (m_objTess);
 
-		ENDTMESH ();
+	gluTessBeginPolygon (m_objTess, _cgle_gc -> mesh);
+	gluTessBeginContour (m_objTess);
 
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
-		{
-			// draw the front cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-			norm [2] = -1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
-		}
+	for (j=m_iContourPoints-1; j>=0; j--)
+	{
+		gluTessVertex (m_objTess, point_array[j], point_array[j]);
 	}
+	gluTessEndContour (m_objTess);
+	gluTessEndPolygon (m_objTess);
 }
 
 //----------------------------------------------------------------------------
 // ============================================================
-// This routine draws a segment of raw-join-style tubing.
-// Essentially, we assume that the proper transformations have already
-// been performed to properly orient the tube segment -- our only task
-// left is to render
-// EDGE_N -- DRAW ONLY EDGE NORMALS
-
-void CgleBaseExtrusion::Draw_Raw_Segment_Edge_N()
-
+void CgleBaseExtrusion::Draw_Angle_Style_Front_Cap (double bi[3],// biscetor
+													double point_array[][3])
 {
-	if (!m_bTexEnabled)
-	{
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		glBegin(GL_TRIANGLE_STRIP);
-		for (int j = 0; j < m_iContourPoints; j++)
-		{
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			glNormal3dv(norm);
 
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
+	if (bi[2] < 0.0)
+		VEC_SCALE (bi, -1.0, bi);
 
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
 
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of m_ptrContours
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			norm [2] = 0.0;
-			glNormal3dv(norm);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			glVertex3dv(point);
-
-			point [2] = - m_dLen;
-			glVertex3dv(point);
-		}
+	N3D(bi);
 
-		glEnd();
+	Set_Tess_Callbacks (m_objTess);
 
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
+	gluTessBeginPolygon (m_objTess, _cgle_gc -> mesh);
+	gluTessBeginContour (m_objTess);
 
-		{
-			// draw the front cap
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			norm [2] = -1.0;
-			glNormal3dv(norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
-		}
-	}
-	else
+	for (int j=0; j<m_iContourPoints; j++)
 	{
-
-		double point[3];
-		double norm[3];
-
-		// draw the tube segment
-		norm [2] = 0.0;
-		BGNTMESH (m_iINext, m_dLen);
-		for (int j = 0; j < m_iContourPoints; j++)
-		{
-			norm [0] = m_ptrCont_Norms[j][0];
-			norm [1] = m_ptrCont_Norms[j][1];
-			N3D (norm);
-
-			point [0] = m_ptrContours[j][0];
-			point [1] = m_ptrContours[j][1];
-			point [2] = 0.0;
-			V3D (point, j, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, j, BACK);
-		}
-		if (m_iExtrusionMode & GLE_CONTOUR_CLOSED)
-		{
-			// connect back up to first point of m_ptrContours
-			norm [0] = m_ptrCont_Norms[0][0];
-			norm [1] = m_ptrCont_Norms[0][1];
-			norm [2] = 0.0;
-			N3D (norm);
-
-			point [0] = m_ptrContours[0][0];
-			point [1] = m_ptrContours[0][1];
-			point [2] = 0.0;
-			V3D (point, 0, FRONT);
-
-			point [2] = - m_dLen;
-			V3D (point, 0, BACK);
-		}
-
-		ENDTMESH ();
-
-		// draw the endcaps, if the join style calls for it
-		if (m_iExtrusionMode & GLE_JN_CAP)
-		{
-
-			// draw the front cap
-			norm [0] = norm [1] = 0.0;
-			norm [2] = 1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				0.0, TRUE);
-
-			// draw the back cap
-			norm [2] = -1.0;
-			N3D (norm);
-			Draw_Raw_Style_End_Cap (m_ptrContours,
-				-m_dLen, FALSE);
-		}
+		gluTessVertex (m_objTess, point_array[j], point_array[j]);
 	}
-}
+	gluTessEndContour (m_objTess);
+	gluTessEndPolygon (m_objTess);
+}			   
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // ============================================================
@@ -2400,14 +2103,9 @@ void CgleBaseExtrusion::Draw_Raw_Segment_Edge_N()
 //
 void CgleBaseExtrusion::Draw_Back_Contour_Cap (double contour[][3])
 {
-	gluTessCallback (m_objTess, GLU_TESS_BEGIN, (void(__stdcall*)())glBegin);
-
-	gluTessCallback (m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
-
-	gluTessCallback (m_objTess, GLU_TESS_END, (void(__stdcall*)())glEnd);
+	Set_Tess_Callbacks (m_objTess);
 
-	gluTessBeginPolygon (m_objTess,NULL);
+	gluTessBeginPolygon (m_objTess, _cgle_gc -> mesh);
 	gluTessBeginContour (m_objTess);
 
 	// draw the end cap
@@ -2430,14 +2128,9 @@ void CgleBaseExtrusion::Draw_Front_Contour_Cap ( double contour[][3])
 {
 
 
-	gluTessCallback (m_objTess, GLU_TESS_BEGIN, (void(__stdcall*)())glBegin);
+	Set_Tess_Callbacks (m_objTess);
 
-	gluTessCallback (m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
-
-	gluTessCallback (m_objTess, GLU_TESS_END, (void(__stdcall*)())glEnd);
-
-	gluTessBeginPolygon (m_objTess,NULL);
+	gluTessBeginPolygon (m_objTess, _cgle_gc -> mesh);
 	gluTessBeginContour (m_objTess);
 
 
@@ -2499,52 +2192,81 @@ void CgleBaseExtrusion::Up_Sanity_Check (double up[3])
 
 }
 //----------------------------------------------------------------------------
-void CgleBaseExtrusion::Draw_Raw_Style_End_Cap (double contour[][2],
-												double zval,// where to draw cap
-												int frontwards)// front or back cap
+// Where the join loops start: the first segment that isn't of zero length,
+// and the up vector, as the loop has it at the top. The raw join reflects
+// the up vector at the top of the loop, in the plane to the segment before;
+// the others at the bottom, in the plane to the next, and once up front.
+void CgleBaseExtrusion::Join_Start(gleJoinRun &Run, bool Raw)
 {
+	double diff[3], bi[3];
 
-	FDRSECPoints = new double[3*m_iContourPoints];
-
-	gluTessCallback (m_objTess, GLU_TESS_BEGIN, (void(__stdcall*)())glBegin);
+	// By definition, the contour passed in has its up vector pointing in
+	// the y direction
+	if (m_ptrUp == NULL)
+	{
+		Run.Up[0] = 0.0;
+		Run.Up[1] = 1.0;
+		Run.Up[2] = 0.0;
+	}
+	else
+		VEC_COPY (Run.Up, m_ptrUp);
 
-	gluTessCallback (m_objTess, GLU_TESS_VERTEX,
-		(void(__stdcall*)()) glVertex3dv);
+	// ========== "up" vector sanity check ==========
+	(void) Up_Sanity_Check (Run.Up);
+	VEC_COPY (Run.LastUp, Run.Up);
 
-	gluTessCallback (m_objTess, GLU_TESS_END, (void(__stdcall*)())glEnd);
+	// ignore all segments of zero length
+	Run.Before = 0;
+	Run.First = 1;
+	Run.Next = 1;
+	FIND_NON_DEGENERATE_POINT (Run.Next, m_iPoints, Run.Length, diff,
+		((double(*)[3])m_ptrPointArray));
 
-	gluTessBeginPolygon (m_objTess, NULL);
-	gluTessBeginContour (m_objTess);
+	Run.Stop = m_iPoints;
+	Run.Accum = 0.0;
 
-	// draw the loop counter clockwise for the front cap
-	if (frontwards)
+	if (!Raw)
 	{
-		for (int j=0; j<m_iContourPoints; j++)
-		{
-			FDRSECPoints [3*j] = contour[j][0];
-			FDRSECPoints [3*j+1] = contour[j][1];
-			FDRSECPoints [3*j+2] = zval;
-			gluTessVertex (m_objTess, &FDRSECPoints[3*j], &FDRSECPoints[3*j]);
-		}
+		bisecting_plane (bi, ((double(*)[3])m_ptrPointArray)[0],
+			((double(*)[3])m_ptrPointArray)[1],
+			((double(*)[3])m_ptrPointArray)[Run.Next]);
+		VEC_REFLECT (Run.Up, Run.Up, bi);
+	}
+}
+//----------------------------------------------------------------------------
+// Moves Run on to the next segment, working out what the join loop would
+// have by then, in the same way; for Split_Join, which walks a path with it
+// to find where to start each run. There must be a next segment.
+void CgleBaseExtrusion::Join_Step(gleJoinRun &Run, bool Raw)
+{
+	double diff[3], bi[3];
+	double len;
+	int next = Run.Next;
+
+	// ignore all segments of zero length
+	FIND_NON_DEGENERATE_POINT (next, m_iPoints, len, diff,
+		((double(*)[3])m_ptrPointArray));
 
-	}
+	if (Raw)
+		bisecting_plane (bi, ((double(*)[3])m_ptrPointArray)[Run.First - 1],
+			((double(*)[3])m_ptrPointArray)[Run.First],
+			((double(*)[3])m_ptrPointArray)[Run.Next]);
 	else
-	{
-		// the sense of the loop is reversed for backfacing culling
-		for (int j=m_iContourPoints-1; j>-1; j--)
-		{
-			FDRSECPoints [3*j] = contour[j][0];
-			FDRSECPoints [3*j+1] = contour[j][1];
-			FDRSECPoints [3*j+2] = zval;
-			gluTessVertex (m_objTess, &FDRSECPoints[3*j], &FDRSECPoints[3*j]);
-		}
-	}
+		bisecting_plane (bi, ((double(*)[3])m_ptrPointArray)[Run.First],
+			((double(*)[3])m_ptrPointArray)[Run.Next],
+			((double(*)[3])m_ptrPointArray)[next]);
 
-	gluTessEndContour (m_objTess);
-	gluTessEndPolygon (m_objTess);
+	VEC_COPY (Run.LastUp, Run.Up);
+	VEC_REFLECT (Run.Up, Run.Up, bi);
 
-	delete[] FDRSECPoints;	   
-}										  
+	// as bgn_z_texgen adds it up
+	Run.Accum += Run.Length;
+
+	Run.Before = Run.First;
+	Run.First = Run.Next;
+	Run.Next = next;
+	Run.Length = len;
+}
 //----------------------------------------------------------------------------
 // This routine draws "cut" style extrusions.
 void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
@@ -2577,8 +2299,10 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 
 	int join_style_is_cut;      // TRUE if join style is cut
 	double dot;                  // partial dot product
-	int first_time = TRUE;
+	int first_time;
 	double *cut_vec;
+	int front;
+	gleJoinRun run;
 
 	// create a local, block scope copy of of the join style.
 	// this will alleviate wasted cycles and register write-backs
@@ -2594,21 +2318,12 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 		cap_callback =  Draw_Round_Style_Cap_Callback;
 	}
 
-	// By definition, the contour passed in has its up vector pointing in
-	// the y direction
-	if (m_ptrUp == NULL)
-	{
-		yup[0] = 0.0;
-		yup[1] = 1.0;
-		yup[2] = 0.0;
-	} 
-	else 
-	{
-		VEC_COPY (yup, m_ptrUp);
-	}
-
-	// ========== "up" vector sanity check ==========
-	(void) Up_Sanity_Check (yup);
+	// the first segment, and the up vector there; or, for a run of a split
+	// path, wherever the run starts
+	if (FRun == NULL)
+		Join_Start (run, false);
+	else
+		run = *FRun;
 
 	// the origin is at the origin
 	origin [0] = 0.0;
@@ -2633,13 +2348,14 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 
 	// |-|-|-|-|-|-|-|-| SET UP FOR FIRST SEGMENT |-|-|-|-|-|-|-|
 
-	// ignore all segments of zero length
-	i = 1;
-	m_iINext = i;
+	i = run.First;
+	m_iINext = run.Next;
+	GLE_len = run.Length;
+	VEC_COPY (yup, run.Up);
 
-	FIND_NON_DEGENERATE_POINT (m_iINext, m_iPoints, seg_len, diff,
-		((double(*)[3])m_ptrPointArray));
-	GLE_len = seg_len;	// store for later use
+	// the front of the first segment is at the point before the next; further
+	// on, at the back of the segment before
+	front = (i == 1) ? m_iINext - 1 : i;
 
 	// may as well get the normals set up now
 	if (m_ptrXforms == NULL)
@@ -2658,30 +2374,31 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 		for (j=0; j<m_iContourPoints; j++)
 		{
 			NORM_XFORM_2X2 ( (&front_norm[3*j]),
-				m_ptrXforms[m_iINext-1],
+				m_ptrXforms[front],
 				m_ptrCont_Norms [j]);
 			front_norm[3*j+2] = 0.0;
 			back_norm[3*j+2] = 0.0;
 		}
 	}
 
-	// get the bisecting plane
-	bisecting_plane (bi_0, ((double(*)[3])m_ptrPointArray)[i-1],
+	// get the bisecting plane; the up vector has been reflected in it
+	bisecting_plane (bi_0, ((double(*)[3])m_ptrPointArray)[run.Before],
 		((double(*)[3])m_ptrPointArray)[i],
 		((double(*)[3])m_ptrPointArray)[m_iINext]);
 
 	//compute cutting plane
-	CUTTING_PLANE (valid_cut_0, cut_0,((double(*)[3])m_ptrPointArray)[i-1],
+	CUTTING_PLANE (valid_cut_0, cut_0,((double(*)[3])m_ptrPointArray)[run.Before],
 		((double(*)[3])m_ptrPointArray)[i],
 		((double(*)[3])m_ptrPointArray)[m_iINext]);
 
-	// reflect the up vector in the bisecting plane
-	VEC_REFLECT (yup, yup, bi_0);
+	// only the path's first segment goes without a join at the front
+	first_time = (i == 1);
+	tmp_cap_callback = cap_callback;
 
 	// |-|-|-|-|-|-|-|-| START LOOP OVER SEGMENTS |-|-|-|-|-|-|-|
 
 	// draw tubing, not doing the first segment
-	while (m_iINext<m_iPoints-1)
+	while ((m_iINext < m_iPoints-1) && (i < run.Stop))
 	{
 
 		inextnext = m_iINext;
@@ -2705,8 +2422,8 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 		// and so that origen is at v1
 		uviewpoint (m, ((double(*)[3])m_ptrPointArray)[i],
 			((double(*)[3])m_ptrPointArray)[m_iINext], yup);
-		glPushMatrix ();
-		glMultMatrixd ((double*)m);
+		PUSHMATRIX ();
+		MULTMATRIX_D ((double*)m);
 		//      MULTMATRIX (m);
 
 		// rotate the cutting planes into the local coordinate system
@@ -2897,70 +2614,22 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 
 		// --------- END OF TMESH GENERATION --------------
 
-		/// |||||||||||||||||| START SEGMENT DRAW ||||||||||||||||||||
-		/// There are six different cases we can have for presence and/or
-		// absecnce of colors and normals, and for interpretation of
-		// normals. The blechy set of nested if statements below
-		// branch to each of the six cases
+		// |||||||||||||||||| START SEGMENT DRAW ||||||||||||||||||||
+		// The colors, normal style and so on were settled on when the
+		// emitters were picked; all that is left is whether there are
+		// separate front and back normals.
 
 		m_dLen = GLE_len;
 
 		if (m_ptrXforms == NULL)
-		{
-			if (m_ptrColorArray == NULL)
-			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Segment_Facet_N (  (gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-				else
-					Draw_Segment_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-			}
-			else
-			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Segment_C_And_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-				else
-					Draw_Segment_C_And_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-			}
-		}
-
+			(this->*FEmitSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) norm_loop, NULL);
 		else
-		{
-			if ((float*)m_ptrColorArray == NULL)
-			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_Facet_N ( (gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-
-				else
-					Draw_Binorm_Segment_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-			}
-			else
-			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_C_And_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-				else
-					Draw_Binorm_Segment_C_And_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-			}
-		}
+			(this->*FEmitBinormSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) front_norm,
+				(gleVector *) back_norm);
 		// |||||||||||||||||| END SEGMENT DRAW ||||||||||||||||||||
 
 		// v^v^v^v^v^v^v^v^v  BEGIN END CAPS v^v^v^v^v^v^v^v^v^v^v^v
@@ -3058,7 +2727,7 @@ void CgleBaseExtrusion::Extrusion_Round_Or_Cut_Join()
 		// $$$$$$$$$$$$$$$$ END FILLET & JOIN DRAW $$$$$$$$$$$$$$$$$
 
 		// pop this matrix, do the next set
-		glPopMatrix ();
+		POPMATRIX ();
 
 		// slosh stuff over to next vertex
 		tmp = front_norm;
@@ -3097,21 +2766,20 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 	double *norm_loop;
 	double *front_norm, *back_norm, *tmp; // contour normals in 3D
 	int first_time;
+	int front;
+	gleJoinRun run;
 
-	// By definition, the contour passed in has its up vector pointing in
-	// the y direction
-	if (m_ptrUp == NULL)
-	{
-		yup[0] = 0.0;
-		yup[1] = 1.0;
-		yup[2] = 0.0;
-	}
+	// the first segment, and the up vector there; or, for a run of a split
+	// path, wherever the run starts
+	if (FRun == NULL)
+		Join_Start (run, false);
 	else
-		VEC_COPY (yup, m_ptrUp);
-
+		run = *FRun;
 
-	// ========== "up" vector sanity check ==========
-	(void) Up_Sanity_Check (yup);
+	i = run.First;
+	m_iINext = run.Next;
+	len_seg = run.Length;
+	VEC_COPY (yup, run.Up);
 
 	// the origin is at the origin
 	origin [0] = 0.0;
@@ -3123,19 +2791,10 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 	neg_z[1] = 0.0;
 	neg_z[2] = 1.0;
 
-	// ignore all segments of zero length
-	i = 1;
-	m_iINext = i;
-	FIND_NON_DEGENERATE_POINT (m_iINext, m_iPoints, len, diff,
-		((double(*)[3])m_ptrPointArray));
-	len_seg = len;	// store for later use
-
-	// get the bisecting plane
-	bisecting_plane (bi_0, ((double(*)[3])m_ptrPointArray)[0],
-		((double(*)[3])m_ptrPointArray)[1],
+	// get the bisecting plane; the up vector has been reflected in it
+	bisecting_plane (bi_0, ((double(*)[3])m_ptrPointArray)[run.Before],
+		((double(*)[3])m_ptrPointArray)[i],
 		((double(*)[3])m_ptrPointArray)[m_iINext]);
-	// reflect the up vector in the bisecting plane
-	VEC_REFLECT (yup, yup, bi_0);
 
 	// malloc the storage we'll need for relaying changed contours to the
 	// drawing routines.
@@ -3146,6 +2805,10 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 	back_norm = front_norm + 3 * m_iContourPoints;
 	norm_loop = front_norm;
 
+	// the front of the first segment is at the point before the next; further
+	// on, at the back of the segment before
+	front = (i == 1) ? m_iINext - 1 : i;
+
 	// may as well get the normals set up now
 	if (m_ptrXforms == NULL)
 	{
@@ -3161,16 +2824,37 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 		for (j=0; j<m_iContourPoints; j++)
 		{
 			NORM_XFORM_2X2((&front_norm[3*j]),
-				((double(*)[2][3])m_ptrXforms)[m_iINext - 1],
+				((double(*)[2][3])m_ptrXforms)[front],
 				m_ptrCont_Norms [j]);
 			front_norm[3*j+2] = 0.0;
 			back_norm[3*j+2] = 0.0;
 		}
 	}
 
-	first_time = TRUE;
+	// a run starting further on takes over the front normals as the segment
+	// before would have left them, projected into its far bisecting plane
+	if ((i > 1) && (m_iExtrusionMode & GLE_NORM_PATH_EDGE))
+	{
+		uviewpoint (m, ((double(*)[3])m_ptrPointArray)[run.Before],
+			((double(*)[3])m_ptrPointArray)[i], run.LastUp);
+		MAT_DOT_VEC_3X3 (bisector_1, m, bi_0);
+
+		for (j=0; j<m_iContourPoints; j++)
+		{
+			if (m_ptrXforms == NULL)
+			{
+				front_norm[3*j] = m_ptrCont_Norms[j][0];
+				front_norm[3*j+1] = m_ptrCont_Norms[j][1];
+			}
+			front_norm[3*j+2] = 0.0;
+			VEC_PERP ((&front_norm[3*j]), (&front_norm[3*j]), bisector_1);
+			VEC_NORMALIZE ((&front_norm[3*j]));
+		}
+	}
+
+	first_time = (i == 1);
 	// draw tubing, not doing the first segment
-	while (m_iINext<m_iPoints-1)
+	while ((m_iINext < m_iPoints-1) && (i < run.Stop))
 	{
 
 		inextnext = m_iINext;
@@ -3186,8 +2870,8 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 		// and so that origen is at v1
 		uviewpoint (m, ((double(*)[3])m_ptrPointArray)[i],
 			((double(*)[3])m_ptrPointArray)[m_iINext], yup);
-		glPushMatrix ();
-		glMultMatrixd ((const double *)m);
+		PUSHMATRIX ();
+		MULTMATRIX_D ((const double *)m);
 
 		// rotate the bisecting planes into the local coordinate system
 		MAT_DOT_VEC_3X3 (bisector_0, m, bi_0);
@@ -3342,92 +3026,320 @@ void CgleBaseExtrusion::Extrusion_Angle_Join ()
 		// v^v^v^v^v^v^v^v^v  END END CAPS v^v^v^v^v^v^v^v^v^v^v^v
 
 		// |||||||||||||||||| START SEGMENT DRAW ||||||||||||||||||||
-		// There are six different cases we can have for presence and/or
-		// absecnce of colors and normals, and for interpretation of
-		// normals. The blechy set of nested if statements below
-		// branch to each of the six cases
+		// The colors, normal style and so on were settled on when the
+		// emitters were picked; all that is left is whether there are
+		// separate front and back normals.
 
 		m_dLen = len_seg;
 
 		if ((m_ptrXforms == NULL) && (!(m_iExtrusionMode & GLE_NORM_PATH_EDGE)))
+			(this->*FEmitSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) norm_loop, NULL);
+		else
+			(this->*FEmitBinormSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) front_norm,
+				(gleVector *) back_norm);
+		// |||||||||||||||||| END SEGMENT DRAW ||||||||||||||||||||
+
+		// pop this matrix, do the next set
+		POPMATRIX ();
+
+		// bump everything to the next vertex
+		len_seg = len;
+		i = m_iINext;
+		m_iINext = inextnext;
+		VEC_COPY (bi_0, bi_1);
+
+		// trade norm loops
+		tmp = front_norm;
+		front_norm = back_norm;
+		back_norm = tmp;
+
+		// reflect the up vector in the bisecting plane
+		VEC_REFLECT (yup, yup, bi_0);
+	}
+}
+
+//----------------------------------------------------------------------------
+
+// ============================================================
+// This routine draws extrusions whose path runs straight up the z axis, as
+// those of the screw, the taper and the simple beams do.  Every segment
+// then has the same orientation, the bisecting planes are all square to
+// the axis, and the angle join, like the capped round join, comes down to
+// plain rings of contour, one per path point.  So there is no path to
+// walk: each ring is made from its place along the axis, and its turn if
+// the contour twists, the view matrix is computed once and only its origin
+// moved, and each ring is transformed just once, serving as the back of
+// one segment and the front of the next.  What gets drawn is what
+// Extrusion_Angle_Join(), or for bRound Extrusion_Round_Or_Cut_Join(),
+// would draw, in the same order.
+//
+void CgleBaseExtrusion::Extrusion_Straight_Axis(bool bRound)
+{
+	int i, j;
+	double m[4][4];
+	double step, len;
+	double origin[3], toward[3];
+	double yup[3];		// alternate up vector
+	double front_cap_n[3], back_cap_n[3];
+	double *front_loop, *back_loop;   // contours in 3D
+	double *norm_loop;
+	double *front_norm, *back_norm, *tmp; // contour normals in 3D
+	gleAffine xform;
+	bool has_xform;
+	bool project_norms;	// the angle join's path edge normals
+
+	if (m_iPoints < 4)
+		return;
+
+	// every point on top of the last: as with any other path, nothing is drawn
+	step = (FAxis.End - FAxis.Start) / (double)(m_iPoints - 3);
+	if (step == 0.0)
+		return;
+	len = fabs(step);
+
+	// By definition, the contour passed in has its up vector pointing in
+	// the y direction
+	if (m_ptrUp == NULL)
+	{
+		yup[0] = 0.0;
+		yup[1] = 1.0;
+		yup[2] = 0.0;
+	}
+	else
+		VEC_COPY (yup, m_ptrUp);
+
+	// only the part square to the axis counts; see Up_Sanity_Check
+	yup[2] = 0.0;
+	if ((yup[0] == 0.0) && (yup[1] == 0.0))
+		yup[2] = (step > 0.0) ? 1.0 : -1.0;
+
+	// the one orientation every segment has
+	origin[0] = origin[1] = 0.0;
+	origin[2] = FAxis.Start;
+	toward[0] = toward[1] = 0.0;
+	toward[2] = FAxis.Start + step;
+	uviewpoint (m, origin, toward, yup);
+
+	// the caps face out along the axis
+	front_cap_n[0] = front_cap_n[1] = 0.0;
+	front_cap_n[2] = 1.0;
+	back_cap_n[0] = back_cap_n[1] = 0.0;
+	back_cap_n[2] = -1.0;
+
+	front_loop = (double *) FXAJMemAnchor;
+	back_loop = front_loop + 3 * m_iContourPoints;
+	front_norm = (double *) (back_loop + 3 * m_iContourPoints);
+	back_norm = front_norm + 3 * m_iContourPoints;
+	norm_loop = front_norm;
+
+	project_norms = !bRound && (m_iExtrusionMode & GLE_NORM_PATH_EDGE);
+
+	// the first ring, and its normals
+	has_xform = Straight_Axis_Xform (1, xform);
+	for (j=0; j<m_iContourPoints; j++)
+	{
+		if (!has_xform)
+		{
+			front_loop[3*j] = m_ptrContours[j][0];
+			front_loop[3*j+1] = m_ptrContours[j][1];
+
+			norm_loop[3*j] = m_ptrCont_Norms[j][0];
+			norm_loop[3*j+1] = m_ptrCont_Norms[j][1];
+			norm_loop[3*j+2] = 0.0;
+		}
+		else
+		{
+			MAT_DOT_VEC_2X3 ((&front_loop[3*j]), xform, m_ptrContours[j]);
+			NORM_XFORM_2X2 ((&front_norm[3*j]), xform, m_ptrCont_Norms[j]);
+			front_norm[3*j+2] = 0.0;
+			back_norm[3*j+2] = 0.0;
+		}
+		front_loop[3*j+2] = 0.0;
+	}
 
+	// draw tubing, from path point 1 to path point m_iPoints - 2
+	for (i=1; i<m_iPoints-2; i++)
+	{
+		m_iINext = i + 1;
+
+		// only the origin moves along the axis
+		m[3][2] = FAxis.Start + (double)(i - 1) * step;
+		PUSHMATRIX ();
+		MULTMATRIX_D ((const double *)m);
+
+		// the next ring, len along
+		(void) Straight_Axis_Xform (m_iINext, xform);
+		for (j=0; j<m_iContourPoints; j++)
 		{
-			if (m_ptrColorArray == NULL)
+			if (!has_xform)
 			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Segment_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-				else
-					Draw_Segment_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop );
+				back_loop[3*j] = m_ptrContours[j][0];
+				back_loop[3*j+1] = m_ptrContours[j][1];
 			}
 			else
 			{
+				MAT_DOT_VEC_2X3 ((&back_loop[3*j]), xform, m_ptrContours[j]);
+				NORM_XFORM_2X2 ((&back_norm[3*j]), xform, m_ptrCont_Norms[j]);
+			}
+			back_loop[3*j+2] = - len;
+
+			// projected onto a plane square to the axis, the normals
+			// only need renormalizing
+			if (project_norms)
+			{
+				if (!has_xform)
+				{
+					back_norm[3*j] = m_ptrCont_Norms[j][0];
+					back_norm[3*j+1] = m_ptrCont_Norms[j][1];
+				}
+				front_norm[3*j+2] = 0.0;
+				VEC_NORMALIZE ((&front_norm[3*j]));
+				back_norm[3*j+2] = 0.0;
+				VEC_NORMALIZE ((&back_norm[3*j]));
+			}
+		}
+
+		// the angle join draws its caps ahead of the segment
+		if (!bRound && (m_iExtrusionMode & GLE_JN_CAP))
+		{
+			if (i == 1)
+			{
+				if (m_ptrColorArray != NULL)
+					SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
+
+				Draw_Angle_Style_Front_Cap (front_cap_n, (gleVector *) front_loop);
+			}
+			if (m_iINext == m_iPoints-2)
+			{
+				if (m_ptrColorArray != NULL)
+					SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
 
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Segment_C_And_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
-				else
-					Draw_Segment_C_And_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) norm_loop);
+				Draw_Angle_Style_Back_Cap (back_cap_n, (gleVector *) back_loop);
 			}
 		}
+
+		m_dLen = len;
+
+		if (!has_xform && !project_norms)
+			(this->*FEmitSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) norm_loop, NULL);
 		else
+			(this->*FEmitBinormSegment) ((gleVector *) front_loop,
+				(gleVector *) back_loop,
+				(gleVector *) front_norm,
+				(gleVector *) back_norm);
+
+		// and the round join after it
+		if (bRound)
 		{
-			if (m_ptrColorArray == NULL)
+			if (i == 1)
 			{
+				if (m_ptrColorArray != NULL)
+					SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext-1][0]);
 
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-				else
-					Draw_Binorm_Segment_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
+				Draw_Angle_Style_Front_Cap (front_cap_n, (gleVector *) front_loop);
 			}
-			else
+			if (m_iINext == m_iPoints-2)
 			{
+				if (m_ptrColorArray != NULL)
+					SetColor (&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
 
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_C_And_Facet_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
-				else
-					Draw_Binorm_Segment_C_And_Edge_N ((gleVector *) front_loop,
-					(gleVector *) back_loop,
-					(gleVector *) front_norm,
-					(gleVector *) back_norm);
+				Draw_Angle_Style_Back_Cap (back_cap_n, (gleVector *) back_loop);
 			}
 		}
-		// |||||||||||||||||| END SEGMENT DRAW ||||||||||||||||||||
 
-		// pop this matrix, do the next set
-		glPopMatrix ();
+		POPMATRIX ();
 
-		// bump everything to the next vertex
-		len_seg = len;
-		i = m_iINext;
-		m_iINext = inextnext;
-		VEC_COPY (bi_0, bi_1);
+		// the back ring becomes the front of the next segment
+		tmp = front_loop;
+		front_loop = back_loop;
+		back_loop = tmp;
+
+		for (j=0; j<m_iContourPoints; j++)
+			front_loop[3*j+2] = 0.0;
 
 		// trade norm loops
 		tmp = front_norm;
 		front_norm = back_norm;
 		back_norm = tmp;
+	}
+}
+//----------------------------------------------------------------------------
+// The contour transform at path point Point of the straight axis: its even
+// turn, if the contour twists, or else its entry in m_ptrXforms.  Returns
+// false if the contour isn't transformed.
+bool CgleBaseExtrusion::Straight_Axis_Xform(int Point, gleAffine Xform)
+{
+	double angle;
+	double si, co;
 
-		// reflect the up vector in the bisecting plane
-		VEC_REFLECT (yup, yup, bi_0);
+	if (FAxis.Twisted)
+	{
+		angle = FAxis.TwistStart + (double)(Point - 1) *
+			(FAxis.TwistEnd - FAxis.TwistStart) / (double)(m_iPoints - 3);
+		angle *= M_PI / 180.0;
+		si = sin(angle);
+		co = cos(angle);
+
+		Xform[0][0] = co;
+		Xform[0][1] = -si;
+		Xform[0][2] = 0.0;
+		Xform[1][0] = si;
+		Xform[1][1] = co;
+		Xform[1][2] = 0.0;
+		return(true);
 	}
+
+	if (m_ptrXforms == NULL)
+		return(false);
+
+	memcpy(Xform, m_ptrXforms[Point], sizeof(gleAffine));
+	return(true);
 }
+//----------------------------------------------------------------------------
+// The cut and raw joins, and the uncapped round join, walk a polyline, so for
+// them the straight axis is made into one, in the thread's scratch, together
+// with the twists if the contour turns. GenerateExtrusion puts m_ptrPointArray
+// and m_ptrXforms back once the join is drawn.
+void CgleBaseExtrusion::Unroll_Straight_Axis()
+{
+	int i, k;
+	double step = 0.0;
+	double (*points)[3];
+	gleAffine *xforms;
+	size_t size = (FAxis.Twisted ? 9 : 3) * (size_t)m_iPoints;
+
+	if (_cgle_scratch.Axis.size() < size)
+		_cgle_scratch.Axis.resize(size);
+
+	points = (double(*)[3])&_cgle_scratch.Axis[0];
+	xforms = (gleAffine *)(points + m_iPoints);
+
+	if (m_iPoints > 3)
+		step = (FAxis.End - FAxis.Start) / (double)(m_iPoints - 3);
+
+	for (i = 0; i < m_iPoints; i++)
+	{
+		// the end points are repeated
+		k = std::max(1, std::min(i, m_iPoints - 2));
 
+		points[i][0] = 0.0;
+		points[i][1] = 0.0;
+		points[i][2] = FAxis.Start + (double)(k - 1) * step;
+
+		if (FAxis.Twisted)
+			(void)Straight_Axis_Xform(k, xforms[i]);
+	}
+
+	m_ptrPointArray = &points[0][0];
+	if (FAxis.Twisted)
+		m_ptrXforms = xforms;
+}
 //----------------------------------------------------------------------------
 
 // ============================================================
@@ -3449,6 +3361,8 @@ void CgleBaseExtrusion::Extrusion_Raw_Join()
 	double *front_loop = NULL, *back_loop = NULL;  // countour loops
 	double *front_norm = NULL, *back_norm = NULL;  // countour loops
 	double *tmp;
+	int front;
+	gleJoinRun run;
 
 	nrmv[0] = nrmv[1] = 0.0;   // used for drawing end caps
 					   // use some local variables for needed booleans
@@ -3456,49 +3370,55 @@ void CgleBaseExtrusion::Extrusion_Raw_Join()
 	no_cols = (m_ptrColorArray == NULL);
 	no_xform = (m_ptrXforms == NULL);
 
-	// alloc loop arrays if needed
-	if (!no_xform)
-	{
-		front_loop = (double *)FMemAnchor;
-		back_loop = front_loop + 3 * m_iContourPoints;
-		front_norm = back_loop + 3 * m_iContourPoints;
-		back_norm = front_norm + 3 * m_iContourPoints;
-	}
+	// the loop arrays
+	front_loop = (double *)FMemAnchor;
+	back_loop = front_loop + 3 * m_iContourPoints;
+	front_norm = back_loop + 3 * m_iContourPoints;
+	back_norm = front_norm + 3 * m_iContourPoints;
 
-	// By definition, the contour passed in has its up vector pointing in
-	// the y direction
-	if (m_ptrUp == NULL)
-	{
-		yup[0] = 0.0;
-		yup[1] = 1.0;
-		yup[2] = 0.0;
-	}
+	// the first segment, and the up vector there; or, for a run of a split
+	// path, wherever the run starts
+	if (FRun == NULL)
+		Join_Start(run, true);
 	else
-		VEC_COPY(yup, m_ptrUp);
+		run = *FRun;
 
-	// ========== "up" vector sanity check ==========
-	(void)Up_Sanity_Check(yup);
+	i = run.First;
+	m_iINext = run.Next;
+	len = run.Length;
+	VEC_COPY(yup, run.Up);
 
-	// ignore all segments of zero length
-	i = 1;
-	m_iINext = i;
-	FIND_NON_DEGENERATE_POINT(m_iINext, m_iPoints, len, diff,
-		((double(*)[3])m_ptrPointArray));
+	// the front of the first segment is at the point before the next; further
+	// on, at the back of the segment before
+	front = (i == 1) ? m_iINext - 1 : i;
 
-	// first time through, get the loops
-	if (!no_xform)
+	// first time through, get the loops; without xforms, these are the
+	// contour itself, the same at the front and back of every segment, and
+	// only the depth of the back loop changes
+	if (no_xform)
+	{
+		for (j = 0; j<m_iContourPoints; j++)
+		{
+			front_loop[3 * j] = back_loop[3 * j] = m_ptrContours[j][0];
+			front_loop[3 * j + 1] = back_loop[3 * j + 1] = m_ptrContours[j][1];
+			front_norm[3 * j] = back_norm[3 * j] = m_ptrCont_Norms[j][0];
+			front_norm[3 * j + 1] = back_norm[3 * j + 1] = m_ptrCont_Norms[j][1];
+			front_norm[3 * j + 2] = back_norm[3 * j + 2] = 0.0;
+		}
+	}
+	else
 	{
 		for (j = 0; j<m_iContourPoints; j++)
 		{
 			MAT_DOT_VEC_2X3((&front_loop[3 * j]),
-				((double(*)[2][3])m_ptrXforms)[m_iINext - 1],
+				((double(*)[2][3])m_ptrXforms)[front],
 				m_ptrContours[j]);
 			front_loop[3 * j + 2] = 0.0;
 		}
 		for (j = 0; j<m_iContourPoints; j++)
 		{
 			NORM_XFORM_2X2((&front_norm[3 * j]),
-				((double(*)[2][3])m_ptrXforms)[m_iINext - 1],
+				((double(*)[2][3])m_ptrXforms)[front],
 				m_ptrCont_Norms[j]);
 			front_norm[3 * j + 2] = 0.0;
 			back_norm[3 * j + 2] = 0.0;
@@ -3506,7 +3426,7 @@ void CgleBaseExtrusion::Extrusion_Raw_Join()
 	}
 
 	// draw tubing, not doing the first segment
-	while (m_iINext<m_iPoints - 1)
+	while ((m_iINext < m_iPoints - 1) && (i < run.Stop))
 	{
 
 		// get the two bisecting planes
@@ -3521,33 +3441,27 @@ void CgleBaseExtrusion::Extrusion_Raw_Join()
 		// and so that origen is at v1
 		uviewpoint(m, ((double(*)[3])m_ptrPointArray)[i],
 			((double(*)[3])m_ptrPointArray)[m_iINext], yup);
-		glPushMatrix();
-		glMultMatrixd((const double *)m);
+		PUSHMATRIX();
+		MULTMATRIX_D((const double *)m);
 
-		// There are six different cases we can have for presence and/or
-		// absecnce of colors and normals, and for interpretation of
-		// normals. The blechy set of nested if statements below
-		// branch to each of the six cases
+		// The cases of colors or none, and of facet or edge normals, are
+		// taken care of by the emitters (see Emit_Segment). Without xforms,
+		// the front normals serve for the back as well, as the contour is
+		// the same at both ends.
 
 		m_dLen = len;
 		if (no_xform)
 		{
-			if (no_cols)
+			for (j = 0; j<m_iContourPoints; j++)
 			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Raw_Segment_Facet_N();
-
-				else
-					Draw_Raw_Segment_Edge_N();
+				front_loop[3 * j + 2] = 0.0;
+				back_loop[3 * j + 2] = -len;
 			}
-			else
-			{
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Raw_Segment_C_And_Facet_N();
 
-				else
-					Draw_Raw_Segment_C_And_Edge_N();
-			}
+			(this->*FEmitSegment) ((double(*)[3]) front_loop,
+				(double(*)[3]) back_loop,
+				(double(*)[3]) front_norm,
+				(double(*)[3]) back_norm);
 		}
 		else
 		{
@@ -3568,62 +3482,30 @@ void CgleBaseExtrusion::Extrusion_Raw_Join()
 					m_ptrCont_Norms[j]);
 			}
 
-			if (no_cols)
-			{
-
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_Facet_N((double(*)[3]) front_loop,
-					(double(*)[3]) back_loop,
-						(double(*)[3]) front_norm,
-						(double(*)[3]) back_norm);
-				else
-					Draw_Binorm_Segment_Edge_N((double(*)[3]) front_loop,
-					(double(*)[3]) back_loop,
-						(double(*)[3]) front_norm,
-						(double(*)[3]) back_norm);
-				if (m_iExtrusionMode & GLE_JN_CAP)
-
-				{
-					nrmv[2] = 1.0;
-					N3D(nrmv);
-					Draw_Front_Contour_Cap((gleVector *)front_loop);
-					nrmv[2] = -1.0;
-					N3D(nrmv);
-					Draw_Back_Contour_Cap((gleVector *)back_loop);
-				}
-			}
-			else
-			{
-
-				if (m_iExtrusionMode & GLE_NORM_FACET)
-					Draw_Binorm_Segment_C_And_Facet_N((double(*)[3]) front_loop,
-					(double(*)[3]) back_loop,
-						(double(*)[3]) front_norm,
-						(double(*)[3]) back_norm);
-				else
-					Draw_Binorm_Segment_C_And_Edge_N((double(*)[3]) front_loop,
-					(double(*)[3]) back_loop,
-						(double(*)[3]) front_norm,
-						(double(*)[3]) back_norm);
+			(this->*FEmitBinormSegment) ((double(*)[3]) front_loop,
+				(double(*)[3]) back_loop,
+				(double(*)[3]) front_norm,
+				(double(*)[3]) back_norm);
+		}
 
-				if (m_iExtrusionMode & GLE_JN_CAP)
+		// draw the endcaps, if the join style calls for it
+		if (m_iExtrusionMode & GLE_JN_CAP)
+		{
+			if (!no_cols)
+				SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
+			nrmv[2] = 1.0;
+			N3D(nrmv);
+			Draw_Front_Contour_Cap((gleVector *)front_loop);
 
-				{
-					SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext - 1][0]);
-					nrmv[2] = 1.0;
-					N3D(nrmv);
-					Draw_Front_Contour_Cap((gleVector *)front_loop);
-
-					SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
-					nrmv[2] = -1.0;
-					N3D(nrmv);
-					Draw_Back_Contour_Cap((gleVector *)back_loop);
-				}
-			}
+			if (!no_cols)
+				SetColor(&((float(*)[3])m_ptrColorArray)[m_iINext][0]);
+			nrmv[2] = -1.0;
+			N3D(nrmv);
+			Draw_Back_Contour_Cap((gleVector *)back_loop);
 		}
 
 		// pop this matrix, do the next set
-		glPopMatrix();
+		POPMATRIX();
 
 		// flop over transformed loops
 		tmp = front_loop;
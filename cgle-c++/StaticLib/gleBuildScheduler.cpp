@@ -0,0 +1,365 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+#include <algorithm>
+#include <chrono>
+
+typedef std::chrono::steady_clock SchedulerClock;
+
+//----------------------------------------------------------------------------
+static double ElapsedMicroseconds(SchedulerClock::time_point Since)
+{
+	return(std::chrono::duration<double, std::micro>(SchedulerClock::now() - Since).count());
+}
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleBuildScheduler
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleBuildScheduler::CgleBuildScheduler(int CoarseFacets)
+{
+	FCoarse = (CoarseFacets < 3) ? 3 : CoarseFacets;
+	FCompleteCount = 0;
+	FPerFacet = 0.0;
+	FPerSegment = 0.0;
+	FPartial.Job = -1;
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::Add(int Facets, BuildFunction Build)
+{
+	JobState job;
+
+	job.Build = std::move(Build);
+	job.Segments = 1;
+
+	return(AddJob(job, Facets));
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::Add(int Facets, int Segments, RangeBuildFunction Build)
+{
+	JobState job;
+
+	job.BuildRange = std::move(Build);
+	job.Segments = (Segments < 1) ? 1 : Segments;
+
+	return(AddJob(job, Facets));
+}
+//----------------------------------------------------------------------------
+void CgleBuildScheduler::Restart(int Job, BuildFunction Build)
+{
+	if (Build)
+	{
+		FJobs[Job].Build = std::move(Build);
+		FJobs[Job].BuildRange = nullptr;
+		FJobs[Job].Segments = 1;
+	}
+	RestartJob(Job);
+}
+//----------------------------------------------------------------------------
+void CgleBuildScheduler::Restart(int Job, int Segments, RangeBuildFunction Build)
+{
+	FJobs[Job].BuildRange = std::move(Build);
+	FJobs[Job].Build = nullptr;
+	FJobs[Job].Segments = (Segments < 1) ? 1 : Segments;
+	RestartJob(Job);
+}
+//----------------------------------------------------------------------------
+void CgleBuildScheduler::Clear()
+{
+	FJobs.clear();
+	FQueues.clear();
+	FCompleted.clear();
+	FOverrun.clear();
+	FCompleteCount = 0;
+	FPartial.Job = -1;
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::RunFrame(long Microseconds)
+{
+	SchedulerClock::time_point start = SchedulerClock::now();
+	int builds = 0;
+	Entry next;
+
+	FCompleted.clear();
+	FOverrun.clear();
+
+	while (Resume(next) || Peek(next))
+	{
+		JobState &job = FJobs[next.Job];
+		int count = RunLength(job, (double)Microseconds - ElapsedMicroseconds(start));
+
+		if (count == 0)
+		{
+			if (builds > 0)
+				break;
+			count = 1;
+		}
+
+		if (job.Done == 0)
+		{
+			FQueues[Level(job.Next)].pop_front();
+			FScratch.Clear();
+			job.Taken = 0.0;
+		}
+
+		SchedulerClock::time_point began = SchedulerClock::now();
+		if (!job.BuildRange)
+			job.Build(job.Next, FScratch);
+		else if (count == job.Segments)
+			job.BuildRange(job.Next, 0, count, FScratch);
+		else
+		{
+			FRun.Clear();
+			job.BuildRange(job.Next, job.Done, count, FRun);
+
+			// room for the whole build, so that growing the mesh doesn't land
+			// a copy of it on one frame: as much as the first run comes to over
+			// all the segments, or the last build over the facets, and some over
+			if (job.Done == 0)
+			{
+				double runs = 1.25 * job.Segments / count;
+				double facets = (job.Built > 0) ? 1.25 * job.Next / job.Built : 0.0;
+
+				FScratch.Reserve(
+					(int)std::max(runs * FRun.GetVertexCount(), facets * job.Mesh.GetVertexCount()),
+					(int)std::max(runs * FRun.GetIndexCount(), facets * job.Mesh.GetIndexCount()),
+					(int)std::max(runs * FRun.GetSegmentCount(), facets * job.Mesh.GetSegmentCount()));
+			}
+			FScratch.Append(FRun);
+		}
+		double took = ElapsedMicroseconds(began);
+
+		if (job.BuildRange)
+			FPerSegment = (FPerSegment == 0.0) ? took / job.Next / count
+				: 0.75 * FPerSegment + 0.25 * took / job.Next / count;
+		else
+			FPerFacet = (FPerFacet == 0.0) ? took / job.Next
+				: 0.75 * FPerFacet + 0.25 * took / job.Next;
+		job.Done += count;
+		job.Taken += took;
+		builds++;
+
+		if ((ElapsedMicroseconds(start) > (double)Microseconds)
+			&& (FOverrun.empty() || (FOverrun.back() != next.Job)))
+			FOverrun.push_back(next.Job);
+
+		if (job.Done < job.Segments)
+		{
+			FPartial = next;
+			continue;
+		}
+
+		FPartial.Job = -1;
+		std::swap(job.Mesh, FScratch);
+		job.LastMicroseconds = job.Taken;
+		job.Built = job.Next;
+		job.Done = 0;
+
+		if (job.Built >= job.Facets)
+		{
+			job.Next = 0;
+			FCompleteCount++;
+			FCompleted.push_back(next.Job);
+		}
+		else
+		{
+			job.Next = (2 * job.Built < job.Facets) ? 2 * job.Built : job.Facets;
+			Queue(next.Job);
+		}
+	}
+
+	return(builds);
+}
+//----------------------------------------------------------------------------
+bool CgleBuildScheduler::IsDone() const
+{
+	return(FCompleteCount == (int)FJobs.size());
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::GetJobCount() const
+{
+	return((int)FJobs.size());
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::GetCompleteCount() const
+{
+	return(FCompleteCount);
+}
+//----------------------------------------------------------------------------
+const std::vector<int> &CgleBuildScheduler::GetCompleted() const
+{
+	return(FCompleted);
+}
+//----------------------------------------------------------------------------
+const std::vector<int> &CgleBuildScheduler::GetOverrun() const
+{
+	return(FOverrun);
+}
+//----------------------------------------------------------------------------
+bool CgleBuildScheduler::IsComplete(int Job) const
+{
+	return(FJobs[Job].Next == 0);
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::GetFacets(int Job) const
+{
+	return(FJobs[Job].Built);
+}
+//----------------------------------------------------------------------------
+const CgleMesh &CgleBuildScheduler::GetMesh(int Job) const
+{
+	return(FJobs[Job].Mesh);
+}
+//----------------------------------------------------------------------------
+int CgleBuildScheduler::AddJob(JobState &Job, int Facets)
+{
+	Job.Done = 0;
+	Job.Taken = 0.0;
+	Job.Facets = (Facets < 3) ? 3 : Facets;
+	Job.Next = (Job.Facets < FCoarse) ? Job.Facets : FCoarse;
+	Job.Built = 0;
+	Job.Generation = 0;
+	Job.LastMicroseconds = 0.0;
+
+	FJobs.push_back(std::move(Job));
+	Queue((int)FJobs.size() - 1);
+
+	return((int)FJobs.size() - 1);
+}
+//----------------------------------------------------------------------------
+// Starts the job over from the coarse facets; whatever it had built of a
+// build in runs is thrown away.
+void CgleBuildScheduler::RestartJob(int Job)
+{
+	JobState &job = FJobs[Job];
+
+	if (job.Next == 0)
+		FCompleteCount--;
+
+	if (FPartial.Job == Job)
+		FPartial.Job = -1;
+
+	job.Next = (job.Facets < FCoarse) ? job.Facets : FCoarse;
+	job.Done = 0;
+	job.Taken = 0.0;
+	job.Generation++;
+	Queue(Job);
+}
+//----------------------------------------------------------------------------
+// The number of doublings of the coarse facets it takes to reach Facets.
+int CgleBuildScheduler::Level(int Facets) const
+{
+	int level = 0;
+
+	for (int f = FCoarse; f < Facets; f *= 2)
+		level++;
+
+	return(level);
+}
+//----------------------------------------------------------------------------
+void CgleBuildScheduler::Queue(int Job)
+{
+	int level = Level(FJobs[Job].Next);
+	Entry entry;
+
+	if ((int)FQueues.size() <= level)
+		FQueues.resize(level + 1);
+
+	entry.Job = Job;
+	entry.Generation = FJobs[Job].Generation;
+	FQueues[level].push_back(entry);
+}
+//----------------------------------------------------------------------------
+// The next build due, from the coarsest level that has one. Entries left
+// behind by Restart are dropped on the way.
+bool CgleBuildScheduler::Peek(Entry &Next)
+{
+	for (size_t level = 0; level < FQueues.size(); level++)
+	{
+		std::deque<Entry> &queue = FQueues[level];
+
+		while (!queue.empty())
+		{
+			const Entry &entry = queue.front();
+
+			if (entry.Generation == FJobs[entry.Job].Generation)
+			{
+				Next = entry;
+				return(true);
+			}
+			queue.pop_front();
+		}
+	}
+	return(false);
+}
+//----------------------------------------------------------------------------
+// A build in runs is seen through before anything else is started; its entry
+// has come off the queue with the first run.
+bool CgleBuildScheduler::Resume(Entry &Next)
+{
+	if (FPartial.Job < 0)
+		return(false);
+
+	Next = FPartial;
+	return(true);
+}
+//----------------------------------------------------------------------------
+// How much of the job fits in Microseconds: for one built whole, 1 if it
+// does and 0 if it doesn't, and for one built in runs, the segments that do.
+// A job built in runs that nothing is known of yet is tried on one segment.
+int CgleBuildScheduler::RunLength(const JobState &J, double Microseconds) const
+{
+	if (!J.BuildRange)
+		return((Estimate(J) <= Microseconds) ? 1 : 0);
+
+	int left = J.Segments - J.Done;
+	double each = EstimateSegment(J);
+
+	if (each <= 0.0)
+		return(1);
+
+	if (Microseconds < each)
+		return(0);
+
+	return((Microseconds < each * left) ? (int)(Microseconds / each) : left);
+}
+//----------------------------------------------------------------------------
+// A job's builds cost roughly in proportion to its facets; one not yet built
+// is guessed at from the others.
+double CgleBuildScheduler::Estimate(const JobState &J) const
+{
+	if (J.Built > 0)
+		return(J.LastMicroseconds * J.Next / J.Built);
+
+	return(FPerFacet * J.Next);
+}
+//----------------------------------------------------------------------------
+// The time a segment of a build in runs takes: as the runs of the build
+// under way have, or else as the segments of the job's last build did,
+// scaled by the facets, or else as the average for runs.
+double CgleBuildScheduler::EstimateSegment(const JobState &J) const
+{
+	if (J.Done > 0)
+		return(J.Taken / J.Done);
+
+	if (J.Built > 0)
+		return(J.LastMicroseconds * J.Next / J.Built / J.Segments);
+
+	return(FPerSegment * J.Next);
+}
+//----------------------------------------------------------------------------
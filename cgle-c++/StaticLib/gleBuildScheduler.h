@@ -0,0 +1,203 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <functional>
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Builds a set of extrusion objects a little at a time, within a budget of time
+/// per frame, coarse first and then in finer detail, so that a scene that changes all at
+/// once doesn't stall the frame it changes in.</summary>
+/// \details Each job is given the number of facets -- the contour points of a cylinder
+/// or cone, the sides of a helix -- it should end up with, and a function that builds
+/// the object at a given number of facets into a mesh:
+///
+///		scheduler.Add(24, [&](int Facets, CgleMesh &Mesh)
+///		{
+///			CgleCylinderExtrusion tube(Points, Facets);
+///			tube.Build(Point_Array, Color_Array, 0.5);
+///			Mesh = tube.TakeMesh();
+///		});
+///
+/// Each job is built first at the coarse number of facets, then at twice that, and so
+/// on up to its own. Every job gets its coarse mesh before any is refined, so that the
+/// whole scene appears as early as it can. A job's mesh is only replaced once the finer
+/// one is done, so there is always something to draw once a job has been built at all.
+///
+/// RunFrame builds jobs until the budget is spent. A single build can't be broken off,
+/// so the time each will take is estimated from the ones before it -- the last build of
+/// the same job, scaled by the facets, or else the average time per facet -- and a
+/// build that wouldn't fit is left for the next frame. At least one build is done each
+/// frame, so that the scene gets finished whatever the budget, and a frame overruns it
+/// by no more than the estimates are off by, or by one build, if that alone is longer
+/// than the budget; GetOverrun lists the jobs that ran over.
+///
+/// A long path needn't be built all at once. A job added with a range function builds
+/// any run of the path's segments on its own, and is built a run at a time, as many
+/// segments as the budget has room for, over as many frames as it takes:
+///
+///		scheduler.Add(24, Points - 3, [&](int Facets, int First, int Count, CgleMesh &Mesh)
+///		{
+///			// segment k runs from point k + 1 to point k + 2
+///			CgleCylinderExtrusion tube(Count + 3, Facets);
+///			tube.Build(&Point_Array[First], Color_Array ? &Color_Array[First] : NULL, 0.5);
+///			Mesh = tube.TakeMesh();
+///		});
+///
+/// The runs of one build are put together into one mesh, which replaces the job's once
+/// the last run is in, and nothing else is started until then. Where the runs meet, the
+/// joins are those of the whole path, as each run is given the points on either side of
+/// it; with GLE_JN_CAP, though, each run is capped, inside the tube.
+///
+/// Everything happens on the thread that calls RunFrame; building doesn't need a GL
+/// context, so that needn't be the GL thread. Build functions mustn't throw.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleBuildScheduler
+{
+
+public:
+
+	typedef std::function<void(int Facets, CgleMesh &Mesh)> BuildFunction;
+	typedef std::function<void(int Facets, int First, int Count, CgleMesh &Mesh)> RangeBuildFunction;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary></summary>
+///
+/// @param	CoarseFacets The facets of the first, coarsest, build of each job; at least 3.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	explicit CgleBuildScheduler(int CoarseFacets = 4);
+
+	CgleBuildScheduler(const CgleBuildScheduler &) = delete;
+	CgleBuildScheduler &operator=(const CgleBuildScheduler &) = delete;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Adds a job, and returns its number. Jobs are numbered from 0, in the order
+/// they are added.</summary>
+///
+/// @param	Facets The facets the job is complete at.
+/// @param	Build
+///
+/// \retval		int
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int Add(int Facets, BuildFunction Build);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Adds a job that can be built a run of segments at a time, and returns its
+/// number.</summary>
+///
+/// @param	Facets The facets the job is complete at.
+/// @param	Segments The segments of the path; a run is First to First + Count - 1.
+/// @param	Build
+///
+/// \retval		int
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int Add(int Facets, int Segments, RangeBuildFunction Build);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Starts a job over from the coarsest build, as when what it builds has
+/// changed.</summary>
+/// \details The job keeps the mesh it has until the coarse one replaces it.
+///
+/// @param	Job
+/// @param	Build Replaces the job's build function, unless empty.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Restart(int Job, BuildFunction Build = nullptr);
+	void Restart(int Job, int Segments, RangeBuildFunction Build);	// the path's changed length, too
+
+	void Clear();	// removes all the jobs
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Builds what can be built within the budget, and returns the number of builds
+/// done.</summary>
+/// \details The jobs that were completed -- built at their own facets -- in the course
+/// of the call are listed by GetCompleted afterwards.
+///
+/// @param	Microseconds The budget.
+///
+/// \retval		int
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int RunFrame(long Microseconds);
+
+	bool IsDone() const;		// every job is complete
+	int GetJobCount() const;
+	int GetCompleteCount() const;
+	const std::vector<int> &GetCompleted() const;	// by the last RunFrame
+	const std::vector<int> &GetOverrun() const;	// built past the budget, by the last RunFrame
+
+	bool IsComplete(int Job) const;
+	int GetFacets(int Job) const;		// of the mesh it has now; 0 if none yet
+	const CgleMesh &GetMesh(int Job) const;
+
+
+private:
+
+	struct JobState
+	{
+		BuildFunction Build;
+		RangeBuildFunction BuildRange;	// instead of Build, for a job built in runs
+		int Segments;			// of the path; 1 for a job built whole
+		int Done;			// segments of the build under way, so far
+		double Taken;			// microseconds spent on the build under way
+		int Facets;			// when complete
+		int Next;			// the facets of the next build
+		int Built;			// the facets of Mesh
+		unsigned Generation;		// bumped by Restart; stales what is queued
+		double LastMicroseconds;	// the time the last complete build took
+		CgleMesh Mesh;
+	};
+
+	struct Entry
+	{
+		int Job;
+		unsigned Generation;
+	};
+
+	int FCoarse;
+	std::vector<JobState> FJobs;
+	std::vector<std::deque<Entry> > FQueues;	// by level; the coarsest first
+	std::vector<int> FCompleted;
+	std::vector<int> FOverrun;
+	int FCompleteCount;
+	double FPerFacet;		// microseconds, averaged over all builds; 0 until one is done
+	double FPerSegment;		// the same per facet and segment, over the runs
+	CgleMesh FScratch;		// the mesh being built, swapped with a job's when done
+	CgleMesh FRun;			// a run, on its way into FScratch
+	Entry FPartial;			// the job whose runs FScratch holds; Job is -1 if none
+
+	int Level(int Facets) const;
+	void Queue(int Job);
+	bool Peek(Entry &Next);
+	bool Resume(Entry &Next);
+	int RunLength(const JobState &J, double Microseconds) const;
+	double Estimate(const JobState &J) const;
+	double EstimateSegment(const JobState &J) const;
+	int AddJob(JobState &Job, int Facets);
+	void RestartJob(int Job);
+
+};
+//----------------------------------------------------------------------------
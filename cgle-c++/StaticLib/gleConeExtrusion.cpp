@@ -1,6 +1,6 @@
 /***********************************************************
 *									     GLE32 Extrusion Library							*
-*							Copyright 2000 - 2017 by Dave Richards	 			*
+*							Copyright© 2000 - 2017 by Dave Richards	 			*
 *										  All Rights Reserved.							*
 *												Ver 6.0									*
 *																				       		*
@@ -12,7 +12,7 @@
 
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 
 //----------------------------------------------------------------------------
@@ -32,7 +32,10 @@ CgleConeExtrusion::CgleConeExtrusion(int Points, int Facets) :
 		GLE_CONTOUR_CLOSED);
 
 	m_ptrXforms = new gleAffine[m_iPoints];
-	m_ptrUp = new double[3];
+
+	double Up[3] = { 0.0, 1.0, 0.0 };	// Draw points it away from the path
+	LoadUpVector(Up);
+
 	SetTextureMode(gleTexMode::GLE_TEXTURE_VERTEX_CYL);
 }
 //----------------------------------------------------------------------------
@@ -47,6 +50,9 @@ CgleConeExtrusion::~CgleConeExtrusion()
 void CgleConeExtrusion::Draw(double Point_Array[][3], float Color_Array[][3],
 																double Radius_Array[], bool bTextured)
 {
+	if (SubmitIfBuilt({ bTextured ? 1.0 : 0.0 }, { Point_Array, Color_Array, Radius_Array }))
+		return;
+
 	// build 2D affine matrices from radius array
 	for (int j = 0; j<m_iPoints; j++)
 	{
@@ -61,6 +67,24 @@ void CgleConeExtrusion::Draw(double Point_Array[][3], float Color_Array[][3],
 	Gen_PolyCone(Point_Array, Color_Array, 1.0, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleConeExtrusion::Build(double Point_Array[][3], float Color_Array[][3],
+																double Radius_Array[], bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, Radius_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleConeExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], double Radius_Array[],
+	bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, Radius_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void  CgleConeExtrusion::WireDraw(double Point_Array[][3], float Color_Array[][3],
 																double Radius_Array[], bool bTextured)
 {
@@ -116,7 +140,10 @@ void  CgleConeExtrusion::Gen_PolyCone(double point_array[][3], float color_array
 	FIND_NON_DEGENERATE_POINT(p, m_iPoints, len, v21, point_array)
 
 		if (p == m_iPoints)
+		{
+			Invalidate();	// nothing was built from the arguments noted
 			return;
+		}
 
 	// next, check to see if this segment lies along x-axis
 	if ((v21[0] == 0.0) && (v21[2] == 0.0))
@@ -128,14 +155,15 @@ void  CgleConeExtrusion::Gen_PolyCone(double point_array[][3], float color_array
 		m_ptrUp[1] = 1.0;
 	}
 
-	// save the current join style
+	// save the current join style; it's set directly, as the change is only
+	// for this draw and mustn't mark the mesh stale
 	saved_style = m_iExtrusionMode;//extrusion_join_style;
-	SetExtrusionMode(GLE_CONTOUR_CLOSED | saved_style);
+	m_iExtrusionMode = GLE_CONTOUR_CLOSED | saved_style;
 
 	CgleBaseExtrusion::DrawExtrusion(point_array, color_array, bTextured);
 
 	// restore the join style
-	SetExtrusionMode(saved_style);
+	m_iExtrusionMode = saved_style;
 }
 //----------------------------------------------------------------------------
 						 
\ No newline at end of file
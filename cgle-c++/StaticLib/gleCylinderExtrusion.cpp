@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 
 //----------------------------------------------------------------------------
@@ -45,9 +45,29 @@ CgleCylinderExtrusion::~CgleCylinderExtrusion()
 void CgleCylinderExtrusion::Draw(double Point_Array[][3],
 												float Color_Array[][3], double Radius, bool bTextured)
 {
+	if (SubmitIfBuilt({ Radius, bTextured ? 1.0 : 0.0 }, { Point_Array, Color_Array }))
+		return;
+
 	Gen_PolyCone(Point_Array, Color_Array, Radius, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleCylinderExtrusion::Build(double Point_Array[][3],
+												float Color_Array[][3], double Radius, bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, Radius, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleCylinderExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], double Radius, bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, Radius, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void CgleCylinderExtrusion::WireDraw(double Point_Array[][3],
 												float Color_Array[][3], double Radius, bool bTextured)
 {
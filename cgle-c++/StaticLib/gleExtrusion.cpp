@@ -12,7 +12,7 @@
 
 #include "stdafx.h"
 
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 #include "gleExtrusion.h"
 
 
@@ -35,6 +35,7 @@ CgleExtrusion::~CgleExtrusion()
 void CgleExtrusion::SetTForm(double *xform[][2][3])
 {
 	m_ptrXforms = (double(*)[2][3])xform;
+	Invalidate();
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -43,6 +44,22 @@ void CgleExtrusion::Draw(double Point_Array[][3], float Color_Array[][3], bool b
 	DrawExtrusion(Point_Array, Color_Array, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleExtrusion::Build(double Point_Array[][3], float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void CgleExtrusion::WireDraw(double Point_Array[][3], float Color_Array[][3], bool bTextured)
 {
 	DrawWireExtrusion(Point_Array, Color_Array, bTextured);
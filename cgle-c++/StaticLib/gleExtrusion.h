@@ -44,6 +44,9 @@ public:
 	CgleExtrusion(int Points, int ContourPoints, double  Radius);
 	virtual ~CgleExtrusion();
 
+	CgleExtrusion(CgleExtrusion &&Other) = default;
+	CgleExtrusion &operator=(CgleExtrusion &&Other) = default;
+
 /////////////////////////////////////////////////////////////////////////////////////
 /// \public
 /// <summary>hjgj</summary>
@@ -86,6 +89,36 @@ public:
 /////////////////////////////////////////////////////////////////////////////////////
 	void Draw(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
 
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Generates the extrusion once, for later calls to Draw to submit.</summary>
+/// \details See CgleBaseExtrusion::Invalidate.
+///
+/// @param	Point_Array[][3]
+/// @param	Color_Array[][3]
+/// @param	false
+///
+/// \retval		void
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Build(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>As Build, but on a worker of the pool; the future gives the mesh when done.</summary>
+/// \details See CgleBaseExtrusion::QueueBuild for what may be touched meanwhile.
+///
+/// @param	Pool
+/// @param	Point_Array[][3]
+/// @param	Color_Array[][3]
+/// @param	false
+///
+/// \retval		std::future<const CgleMesh &>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
+
 /////////////////////////////////////////////////////////////////////////////////////
 ///
 /// <summary></summary>
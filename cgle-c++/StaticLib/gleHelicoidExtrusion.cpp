@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -23,7 +23,7 @@
 CgleHelicoidExtrusion::CgleHelicoidExtrusion(int Points, double StartXForm[2][3],
 	double Sweep, int Facets) :
 	CgleSpiralExtrusion(Points, StartXForm,
-		Facets, Sweep, NULL)
+		Facets, Sweep, 0.0)
 {
 
 	FFacets = Facets;
@@ -43,6 +43,9 @@ void  CgleHelicoidExtrusion::Draw(double CrossSectionRadius, double StartRadius,
 
 	double c, s;
 
+	if (SubmitIfBuilt({ CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta,
+		StartTheta, bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
 
 	// initialize sine and cosine for circle recursion equations
 	s = sin(2.0*M_PI / ((double)FFacets));
@@ -67,6 +70,27 @@ void  CgleHelicoidExtrusion::Draw(double CrossSectionRadius, double StartRadius,
 										StartTheta, Color_Array, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleHelicoidExtrusion::Build(double CrossSectionRadius, double StartRadius,
+													double dRadiusdTheta, double StartZ,
+													double dZdTheta, double StartTheta,
+													float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleHelicoidExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double CrossSectionRadius, double StartRadius, double dRadiusdTheta, double StartZ,
+	double dZdTheta, double StartTheta, float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta,
+			StartTheta, Color_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void  CgleHelicoidExtrusion::WireDraw(double CrossSectionRadius, double StartRadius,
 													double dRadiusdTheta, double StartZ,
 													double dZdTheta, double StartTheta,
@@ -12,7 +12,7 @@
 
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -29,19 +29,25 @@ CgleIBeam::CgleIBeam(int Points, double Radius) : CgleBaseExtrusion(Points, 12,
 
 	SetTextureMode(gleTexMode::GLE_TEXTURE_NORMAL_MODEL_FLAT);
 
-	LoadContourPoint(0, 1.0, 1.0);
-	LoadContourPoint(1, -1.0, 1.0);
-	LoadContourPoint(2, -1.0, 0.9);
-	LoadContourPoint(3, -0.15, 0.9);
-	LoadContourPoint(4, -0.15, -0.9);
-	LoadContourPoint(5, -1.0, -0.9);
-	LoadContourPoint(6, -1.0, -1.0);
-	LoadContourPoint(7, 1.0, -1.0);
-	LoadContourPoint(8, 1.0, -0.9);
-	LoadContourPoint(9, 0.15, -0.9);
-	LoadContourPoint(10, 0.15, 0.9);
-	LoadContourPoint(11, 1.0, 0.9);
-	LoadContourPoint(12, 1.0, 1.0);
+	// every I-beam of a given radius draws the same contour
+	if (!AdoptContour("I-beam"))
+	{
+		LoadContourPoint(0, 1.0, 1.0);
+		LoadContourPoint(1, -1.0, 1.0);
+		LoadContourPoint(2, -1.0, 0.9);
+		LoadContourPoint(3, -0.15, 0.9);
+		LoadContourPoint(4, -0.15, -0.9);
+		LoadContourPoint(5, -1.0, -0.9);
+		LoadContourPoint(6, -1.0, -1.0);
+		LoadContourPoint(7, 1.0, -1.0);
+		LoadContourPoint(8, 1.0, -0.9);
+		LoadContourPoint(9, 0.15, -0.9);
+		LoadContourPoint(10, 0.15, 0.9);
+		LoadContourPoint(11, 1.0, 0.9);
+		LoadContourPoint(12, 1.0, 1.0);
+
+		PublishContour("I-beam");
+	}
 }
 //----------------------------------------------------------------------------
 CgleIBeam::~CgleIBeam()
@@ -53,6 +59,22 @@ void CgleIBeam::Draw(double Point_Array[][3], float Color_Array[][3], bool bText
 	CgleBaseExtrusion::DrawExtrusion(Point_Array, Color_Array, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleIBeam::Build(double Point_Array[][3], float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleIBeam::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void  CgleIBeam::WireDraw(double Point_Array[][3], float Color_Array[][3], bool bTextured)
 {
 	CgleBaseExtrusion::DrawWireExtrusion(Point_Array, Color_Array, bTextured);
@@ -24,14 +24,33 @@ public:
 	CgleIBeam(int Points, double Radius);
 	virtual ~CgleIBeam();
 
+	CgleIBeam(CgleIBeam &&Other) = default;
+	CgleIBeam &operator=(CgleIBeam &&Other) = default;
+
 	using CgleBaseExtrusion::UseLitMaterial;	   	// redeclare as public
 	using CgleBaseExtrusion::IsUsingLitMaterial;
 
 	using CgleBaseExtrusion::LoadUpVector;
 
+	using CgleBaseExtrusion::Invalidate;
+	using CgleBaseExtrusion::DiscardBuild;
+	using CgleBaseExtrusion::IsBuilt;
+	using CgleBaseExtrusion::GetMesh;
+	using CgleBaseExtrusion::GetMappedMesh;
+	using CgleBaseExtrusion::GetSegments;
+	using CgleBaseExtrusion::SetSegmentSink;
+	using CgleBaseExtrusion::TakeMesh;
+	using CgleBaseExtrusion::UseMeshCache;
+	using CgleBaseExtrusion::GetMeshCache;
+
 
 	void  Draw(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
 
+	void  Build(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
+
 	void  WireDraw(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
 
 };
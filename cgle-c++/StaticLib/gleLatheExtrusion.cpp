@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -48,6 +48,7 @@ void  CgleLatheExtrusion::SetTForm(double xform[2][3])
 			FXForm[i][j] = xform[i][j];
 		}
 	}
+	Invalidate();
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -67,6 +68,10 @@ void  CgleLatheExtrusion::Draw(double StartRadius,
 	double trans[2];
 	double delt[2][3];
 
+	if (SubmitIfBuilt({ StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta,
+		bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
+
 	if (m_ptrUp[1] != 0.0)
 	{
 		localup[0] = m_ptrUp[0];
@@ -107,7 +112,7 @@ void  CgleLatheExtrusion::Draw(double StartRadius,
 	delt[0][2] += trans[0];
 	delt[1][2] += trans[1];
 
-	CgleSpiralExtrusion::SetTForm(delt);
+	LoadTForm(delt);
 
 	CgleSpiralExtrusion::Draw(StartRadius, 0.0, StartZ, 0.0, StartTheta,
 		Color_Array, bTextured);
@@ -24,6 +24,9 @@ public:
 
 	virtual ~CgleLatheExtrusion();
 
+	CgleLatheExtrusion(CgleLatheExtrusion &&Other) = default;
+	CgleLatheExtrusion &operator=(CgleLatheExtrusion &&Other) = default;
+
 
 	// overide next 3 members from CgleSpiralExtrusion;
 
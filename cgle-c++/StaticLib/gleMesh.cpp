@@ -0,0 +1,528 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleMesh
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleMesh::CgleMesh()
+{
+	FMode = GL_TRIANGLES;
+	FFirst = 0;
+	FSink = NULL;
+	Clear();
+}
+//----------------------------------------------------------------------------
+CgleMesh::~CgleMesh()
+{
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Clear()
+{
+	FVertices.clear();
+	FNormals.clear();
+	FColors.clear();
+	FTexCoords.clear();
+	FIndices.clear();
+	FPrimitives.clear();
+
+	FHasNormals = FHasColors = FHasTexCoords = false;
+
+	// the GL defaults for the current normal, color and texture coordinate
+	FNormal[0] = FNormal[1] = 0.0;
+	FNormal[2] = 1.0;
+	FColor[0] = FColor[1] = FColor[2] = 1.0f;
+	FTexCoord[0] = FTexCoord[1] = 0.0f;
+
+	FIdentity = true;
+	IDENTIFY_MATRIX_4X4 (((double(*)[4])FMatrix));
+	FMatrixStack.clear();
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Append(const CgleMesh &Other)
+{
+	GLuint base = (GLuint)(FVertices.size() / 3);
+	int segments = GetSegmentCount();
+	size_t first, i;
+
+	// every vertex has a normal, color and texture coordinate, if only the
+	// defaults, so the arrays stay in step
+	FVertices.insert(FVertices.end(), Other.FVertices.begin(), Other.FVertices.end());
+	FNormals.insert(FNormals.end(), Other.FNormals.begin(), Other.FNormals.end());
+	FColors.insert(FColors.end(), Other.FColors.begin(), Other.FColors.end());
+	FTexCoords.insert(FTexCoords.end(), Other.FTexCoords.begin(), Other.FTexCoords.end());
+
+	// inserted and then offset, rather than reserved to the exact size, so
+	// that a mesh put together from many small ones grows geometrically
+	first = FIndices.size();
+	FIndices.insert(FIndices.end(), Other.FIndices.begin(), Other.FIndices.end());
+	for (i = first; i < FIndices.size(); i++)
+		FIndices[i] += base;
+
+	first = FPrimitives.size();
+	FPrimitives.insert(FPrimitives.end(), Other.FPrimitives.begin(), Other.FPrimitives.end());
+	for (i = first + 1; i < FPrimitives.size(); i += 3)
+		FPrimitives[i] += (GLint)base;
+
+	FHasNormals = FHasNormals || Other.FHasNormals;
+	FHasColors = FHasColors || Other.FHasColors;
+	FHasTexCoords = FHasTexCoords || Other.FHasTexCoords;
+
+	Stream(segments);
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Reserve(int Vertices, int Indices, int Segments)
+{
+	FVertices.reserve(3 * (size_t)Vertices);
+	FNormals.reserve(3 * (size_t)Vertices);
+	FColors.reserve(3 * (size_t)Vertices);
+	FTexCoords.reserve(2 * (size_t)Vertices);
+	FIndices.reserve((size_t)Indices);
+	FPrimitives.reserve(3 * (size_t)Segments);
+}
+//----------------------------------------------------------------------------
+bool CgleMesh::IsEmpty() const
+{
+	return(FIndices.empty());
+}
+//----------------------------------------------------------------------------
+int CgleMesh::GetVertexCount() const
+{
+	return((int)(FVertices.size() / 3));
+}
+//----------------------------------------------------------------------------
+int CgleMesh::GetIndexCount() const
+{
+	return((int)FIndices.size());
+}
+//----------------------------------------------------------------------------
+const float *CgleMesh::GetVertices() const
+{
+	return(FVertices.empty() ? NULL : &FVertices[0]);
+}
+//----------------------------------------------------------------------------
+const float *CgleMesh::GetNormals() const
+{
+	return((FHasNormals && !FNormals.empty()) ? &FNormals[0] : NULL);
+}
+//----------------------------------------------------------------------------
+const float *CgleMesh::GetColors() const
+{
+	return((FHasColors && !FColors.empty()) ? &FColors[0] : NULL);
+}
+//----------------------------------------------------------------------------
+const float *CgleMesh::GetTexCoords() const
+{
+	return((FHasTexCoords && !FTexCoords.empty()) ? &FTexCoords[0] : NULL);
+}
+//----------------------------------------------------------------------------
+const GLuint *CgleMesh::GetIndices() const
+{
+	return(FIndices.empty() ? NULL : &FIndices[0]);
+}
+//----------------------------------------------------------------------------
+CgleMeshArrays CgleMesh::GetArrays() const
+{
+	CgleMeshArrays a;
+
+	a.Vertices = GetVertices();
+	a.Normals = GetNormals();
+	a.Colors = GetColors();
+	a.TexCoords = GetTexCoords();
+	a.Indices = GetIndices();
+	a.Primitives = FPrimitives.empty() ? NULL : &FPrimitives[0];
+	a.VertexCount = GetVertexCount();
+	a.IndexCount = GetIndexCount();
+	a.SegmentCount = GetSegmentCount();
+	return(a);
+}
+//----------------------------------------------------------------------------
+CgleMeshSegments CgleMesh::GetSegments() const
+{
+	return(CgleMeshSegments(GetArrays()));
+}
+//----------------------------------------------------------------------------
+int CgleMesh::GetSegmentCount() const
+{
+	return((int)(FPrimitives.size() / 3));
+}
+//----------------------------------------------------------------------------
+CgleMeshSegment CgleMesh::GetSegment(int Index) const
+{
+	return(CgleMeshSegments::Segment(GetArrays(), Index));
+}
+//----------------------------------------------------------------------------
+void CgleMesh::SetSink(const CgleSegmentSink *Sink)
+{
+	FSink = Sink;
+}
+//----------------------------------------------------------------------------
+bool CgleMesh::HasSink() const
+{
+	return(FSink != NULL);
+}
+//----------------------------------------------------------------------------
+// Hands the segments from First on to the sink, if there is one. The arrays
+// may move as the mesh grows, so the segment is only good for the call.
+void CgleMesh::Stream(int First) const
+{
+	int i, n = GetSegmentCount();
+
+	if (FSink == NULL)
+		return;
+
+	for (i = First; i < n; i++)
+		(*FSink)(GetSegment(i));
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void CgleMesh::Submit(bool UseLitMaterial) const
+{
+	Submit(GetArrays(), UseLitMaterial);
+}
+//----------------------------------------------------------------------------
+// Draws the arrays, wherever they are; for CgleMappedMesh as well.
+void CgleMesh::Submit(const CgleMeshArrays &Arrays, bool UseLitMaterial)
+{
+	if (Arrays.IndexCount == 0)
+		return;
+
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, Arrays.Vertices);
+
+	if (Arrays.Normals != NULL)
+	{
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, 0, Arrays.Normals);
+	}
+	if (Arrays.TexCoords != NULL)
+	{
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, 0, Arrays.TexCoords);
+	}
+
+	if ((Arrays.Colors != NULL) && UseLitMaterial)
+		SubmitLit(Arrays);
+	else
+	{
+		if (Arrays.Colors != NULL)
+		{
+			glEnableClientState(GL_COLOR_ARRAY);
+			glColorPointer(3, GL_FLOAT, 0, Arrays.Colors);
+		}
+		glDrawElements(GL_TRIANGLES, (GLsizei)Arrays.IndexCount, GL_UNSIGNED_INT, Arrays.Indices);
+	}
+
+	glPopClientAttrib();
+}
+//----------------------------------------------------------------------------
+// The material can't come from an array, so the primitives are replayed as
+// they were recorded, changing the material wherever SetColor() did. Those
+// of one color throughout are drawn with glDrawArrays.
+void CgleMesh::SubmitLit(const CgleMeshArrays &Arrays)
+{
+	const float *colors = Arrays.Colors;
+	const float *cur = NULL;
+
+	for (int p = 0; p < 3 * Arrays.SegmentCount; p += 3)
+	{
+		GLenum mode = (GLenum)Arrays.Primitives[p];
+		GLint first = Arrays.Primitives[p + 1];
+		GLsizei count = Arrays.Primitives[p + 2];
+		const float *c = &colors[3 * first];
+		GLsizei k;
+
+		for (k = 1; k < count; k++)
+		{
+			if (!SameColor(c, &colors[3 * (first + k)]))
+				break;
+		}
+
+		if (k == count)
+		{
+			if ((cur == NULL) || !SameColor(c, cur))
+				SetMaterial(c);
+			cur = c;
+			glDrawArrays(mode, first, count);
+			continue;
+		}
+
+		glBegin(mode);
+		for (k = 0; k < count; k++)
+		{
+			c = &colors[3 * (first + k)];
+			if ((cur == NULL) || !SameColor(c, cur))
+				SetMaterial(c);
+			cur = c;
+			glArrayElement(first + k);
+		}
+		glEnd();
+	}
+}
+//----------------------------------------------------------------------------
+bool CgleMesh::SameColor(const float *a, const float *b)
+{
+	return((a[0] == b[0]) && (a[1] == b[1]) && (a[2] == b[2]));
+}
+//----------------------------------------------------------------------------
+// as in SetColor()
+void CgleMesh::SetMaterial(const float c[3])
+{
+	float difmat[4], emismat[4];
+
+	difmat[0] = 0.4f * c[0];
+	difmat[1] = 0.4f * c[1];
+	difmat[2] = 0.4f * c[2];
+	difmat[3] = 1.0f;
+	glMaterialfv(GL_FRONT, GL_AMBIENT_AND_DIFFUSE, difmat);
+
+	emismat[0] = 0.3f * c[0];
+	emismat[1] = 0.3f * c[1];
+	emismat[2] = 0.3f * c[2];
+	emismat[3] = 1.0f;
+	glMaterialfv(GL_FRONT, GL_EMISSION, emismat);
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void CgleMesh::Begin(GLenum mode)
+{
+	FMode = mode;
+	FFirst = FVertices.size() / 3;
+}
+//----------------------------------------------------------------------------
+// Break the primitive just finished into triangles, keeping the winding
+// that GL would have given them.
+void CgleMesh::End()
+{
+	GLuint first = (GLuint)FFirst;
+	GLuint n = (GLuint)(FVertices.size() / 3 - FFirst);
+	GLuint i;
+	int segments = GetSegmentCount();
+
+	switch (FMode)
+	{
+		case GL_TRIANGLES:
+		case GL_TRIANGLE_STRIP:
+		case GL_TRIANGLE_FAN:
+		case GL_POLYGON:
+			FPrimitives.push_back((GLint)FMode);
+			FPrimitives.push_back((GLint)first);
+			FPrimitives.push_back((GLint)n);
+			break;
+	}
+
+	switch (FMode)
+	{
+		case GL_TRIANGLES:
+			for (i = 0; i + 2 < n; i += 3)
+			{
+				FIndices.push_back(first + i);
+				FIndices.push_back(first + i + 1);
+				FIndices.push_back(first + i + 2);
+			}
+			break;
+
+		case GL_TRIANGLE_STRIP:
+			for (i = 0; i + 2 < n; i++)
+			{
+				if (i & 1)
+				{
+					FIndices.push_back(first + i + 1);
+					FIndices.push_back(first + i);
+				}
+				else
+				{
+					FIndices.push_back(first + i);
+					FIndices.push_back(first + i + 1);
+				}
+				FIndices.push_back(first + i + 2);
+			}
+			break;
+
+		case GL_TRIANGLE_FAN:
+		case GL_POLYGON:
+			for (i = 1; i + 1 < n; i++)
+			{
+				FIndices.push_back(first);
+				FIndices.push_back(first + i);
+				FIndices.push_back(first + i + 1);
+			}
+			break;
+
+		default:
+			// nothing else gets drawn filled; drop the vertices
+			FVertices.resize(3 * FFirst);
+			FNormals.resize(3 * FFirst);
+			FColors.resize(3 * FFirst);
+			FTexCoords.resize(2 * FFirst);
+			break;
+	}
+
+	Stream(segments);
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Normal(const double n[3])
+{
+	FHasNormals = true;
+	VEC_COPY (FNormal, n);
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Color(const float c[3])
+{
+	VEC_COPY (FColor, c);
+
+	// vertices recorded before the first color get it as well
+	if (!FHasColors)
+	{
+		FHasColors = true;
+		for (size_t i = 0; i < FColors.size(); i += 3)
+		{
+			VEC_COPY (&FColors[i], c);
+		}
+	}
+}
+//----------------------------------------------------------------------------
+void CgleMesh::TexCoord(double s, double t)
+{
+	FHasTexCoords = true;
+	FTexCoord[0] = (float)s;
+	FTexCoord[1] = (float)t;
+}
+//----------------------------------------------------------------------------
+void CgleMesh::Vertex(const double v[3])
+{
+	double p[3], n[3];
+
+	if (FIdentity)
+	{
+		VEC_COPY (p, v);
+		VEC_COPY (n, FNormal);
+	}
+	else
+	{
+		// column major, as glMultMatrixd has it. The join code only ever
+		// applies rigid motions, so the normals just get the rotation.
+		const double *m = FMatrix;
+
+		p[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+		p[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+		p[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+
+		n[0] = m[0] * FNormal[0] + m[4] * FNormal[1] + m[8] * FNormal[2];
+		n[1] = m[1] * FNormal[0] + m[5] * FNormal[1] + m[9] * FNormal[2];
+		n[2] = m[2] * FNormal[0] + m[6] * FNormal[1] + m[10] * FNormal[2];
+	}
+
+	FVertices.push_back((float)p[0]);
+	FVertices.push_back((float)p[1]);
+	FVertices.push_back((float)p[2]);
+
+	FNormals.push_back((float)n[0]);
+	FNormals.push_back((float)n[1]);
+	FNormals.push_back((float)n[2]);
+
+	FColors.push_back(FColor[0]);
+	FColors.push_back(FColor[1]);
+	FColors.push_back(FColor[2]);
+
+	FTexCoords.push_back(FTexCoord[0]);
+	FTexCoords.push_back(FTexCoord[1]);
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void CgleMesh::PushMatrix()
+{
+	FMatrixStack.insert(FMatrixStack.end(), FMatrix, FMatrix + 16);
+	FMatrixStack.push_back(FIdentity ? 1.0 : 0.0);
+}
+//----------------------------------------------------------------------------
+void CgleMesh::MultMatrix(const double m[16])
+{
+	double prod[4][4];
+
+	// column major: the product of a and b is b * a, as row major arrays
+	MATRIX_PRODUCT_4X4 (prod, ((const double(*)[4])m), ((double(*)[4])FMatrix));
+	COPY_MATRIX_4X4 (((double(*)[4])FMatrix), prod);
+	FIdentity = false;
+}
+//----------------------------------------------------------------------------
+void CgleMesh::PopMatrix()
+{
+	if (FMatrixStack.empty())
+		return;
+
+	size_t top = FMatrixStack.size() - 17;
+	for (int i = 0; i < 16; i++)
+		FMatrix[i] = FMatrixStack[top + i];
+	FIdentity = (FMatrixStack[top + 16] != 0.0);
+	FMatrixStack.resize(top);
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void APIENTRY CgleMesh::TessBegin(GLenum mode, void *mesh)
+{
+	((CgleMesh *)mesh)->Begin(mode);
+}
+//----------------------------------------------------------------------------
+void APIENTRY CgleMesh::TessVertex(void *vertex, void *mesh)
+{
+	((CgleMesh *)mesh)->Vertex((const double *)vertex);
+}
+//----------------------------------------------------------------------------
+void APIENTRY CgleMesh::TessEnd(void *mesh)
+{
+	((CgleMesh *)mesh)->End();
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleMeshSegments
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleMeshSegment CgleMeshSegments::Segment(const CgleMeshArrays &Arrays, int Index)
+{
+	CgleMeshSegment seg;
+	const GLint *prim = &Arrays.Primitives[3 * Index];
+
+	seg.Mode = (GLenum)prim[0];
+	seg.First = prim[1];
+	seg.Count = prim[2];
+
+	seg.Vertices = &Arrays.Vertices[3 * seg.First];
+	seg.Normals = Arrays.Normals ? &Arrays.Normals[3 * seg.First] : NULL;
+	seg.Colors = Arrays.Colors ? &Arrays.Colors[3 * seg.First] : NULL;
+	seg.TexCoords = Arrays.TexCoords ? &Arrays.TexCoords[2 * seg.First] : NULL;
+
+	return(seg);
+}
+//----------------------------------------------------------------------------
+CgleMeshSegment CgleMeshSegments::operator[](int Index) const
+{
+	return(Segment(FArrays, Index));
+}
+//----------------------------------------------------------------------------
+void CgleMeshSegments::const_iterator::Fetch() const
+{
+	FSegment = Segment(FArrays, FIndex);
+}
+//----------------------------------------------------------------------------
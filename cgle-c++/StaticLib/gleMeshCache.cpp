@@ -0,0 +1,508 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+#include <stdio.h>
+#include <limits.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MESH_MAGIC		"GLEMESH"
+#define MESH_BYTE_ORDER	0x01020304u
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleMappedMesh
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleMappedMesh::CgleMappedMesh()
+{
+	FData = NULL;
+	FSize = 0;
+#ifdef _WIN32
+	FFile = INVALID_HANDLE_VALUE;
+	FMapping = NULL;
+#endif
+	memset(&FArrays, 0, sizeof(FArrays));
+}
+//----------------------------------------------------------------------------
+CgleMappedMesh::~CgleMappedMesh()
+{
+	Clear();
+}
+//----------------------------------------------------------------------------
+CgleMappedMesh::CgleMappedMesh(CgleMappedMesh &&Other)
+	: CgleMappedMesh()
+{
+	Swap(Other);
+}
+//----------------------------------------------------------------------------
+CgleMappedMesh &CgleMappedMesh::operator=(CgleMappedMesh &&Other)
+{
+	if (this != &Other)
+	{
+		Clear();
+		Swap(Other);
+	}
+	return(*this);
+}
+//----------------------------------------------------------------------------
+void CgleMappedMesh::Swap(CgleMappedMesh &Other)
+{
+	std::swap(FData, Other.FData);
+	std::swap(FSize, Other.FSize);
+#ifdef _WIN32
+	std::swap(FFile, Other.FFile);
+	std::swap(FMapping, Other.FMapping);
+#endif
+	std::swap(FArrays, Other.FArrays);
+}
+//----------------------------------------------------------------------------
+#ifdef _WIN32
+bool CgleMappedMesh::Map(const std::string &Path)
+{
+	LARGE_INTEGER size;
+
+	Clear();
+
+	FFile = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (FFile == INVALID_HANDLE_VALUE)
+		return(false);
+
+	if (GetFileSizeEx(FFile, &size) && (size.QuadPart > 0))
+		FMapping = CreateFileMappingA(FFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (FMapping != NULL)
+		FData = (const unsigned char *)MapViewOfFile(FMapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (FData == NULL)
+	{
+		Clear();
+		return(false);
+	}
+	FSize = (size_t)size.QuadPart;
+	return(true);
+}
+//----------------------------------------------------------------------------
+void CgleMappedMesh::Clear()
+{
+	if (FData != NULL)
+		UnmapViewOfFile(FData);
+	if (FMapping != NULL)
+		CloseHandle(FMapping);
+	if (FFile != INVALID_HANDLE_VALUE)
+		CloseHandle(FFile);
+
+	FData = NULL;
+	FSize = 0;
+	FFile = INVALID_HANDLE_VALUE;
+	FMapping = NULL;
+	memset(&FArrays, 0, sizeof(FArrays));
+}
+#else
+bool CgleMappedMesh::Map(const std::string &Path)
+{
+	struct stat st;
+	void *addr;
+	int fd;
+
+	Clear();
+
+	fd = open(Path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return(false);
+
+	// the mapping outlives the descriptor
+	if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+	{
+		addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED)
+		{
+			FData = (const unsigned char *)addr;
+			FSize = (size_t)st.st_size;
+		}
+	}
+	close(fd);
+
+	return(FData != NULL);
+}
+//----------------------------------------------------------------------------
+void CgleMappedMesh::Clear()
+{
+	if (FData != NULL)
+		munmap((void *)FData, FSize);
+
+	FData = NULL;
+	FSize = 0;
+	memset(&FArrays, 0, sizeof(FArrays));
+}
+#endif // _WIN32
+//----------------------------------------------------------------------------
+bool CgleMappedMesh::IsEmpty() const
+{
+	return(FArrays.IndexCount == 0);
+}
+//----------------------------------------------------------------------------
+int CgleMappedMesh::GetVertexCount() const
+{
+	return(FArrays.VertexCount);
+}
+//----------------------------------------------------------------------------
+int CgleMappedMesh::GetIndexCount() const
+{
+	return(FArrays.IndexCount);
+}
+//----------------------------------------------------------------------------
+const float *CgleMappedMesh::GetVertices() const
+{
+	return(FArrays.Vertices);
+}
+//----------------------------------------------------------------------------
+const float *CgleMappedMesh::GetNormals() const
+{
+	return(FArrays.Normals);
+}
+//----------------------------------------------------------------------------
+const float *CgleMappedMesh::GetColors() const
+{
+	return(FArrays.Colors);
+}
+//----------------------------------------------------------------------------
+const float *CgleMappedMesh::GetTexCoords() const
+{
+	return(FArrays.TexCoords);
+}
+//----------------------------------------------------------------------------
+const GLuint *CgleMappedMesh::GetIndices() const
+{
+	return(FArrays.Indices);
+}
+//----------------------------------------------------------------------------
+CgleMeshSegments CgleMappedMesh::GetSegments() const
+{
+	return(CgleMeshSegments(FArrays));
+}
+//----------------------------------------------------------------------------
+int CgleMappedMesh::GetSegmentCount() const
+{
+	return(FArrays.SegmentCount);
+}
+//----------------------------------------------------------------------------
+CgleMeshSegment CgleMappedMesh::GetSegment(int Index) const
+{
+	return(CgleMeshSegments::Segment(FArrays, Index));
+}
+//----------------------------------------------------------------------------
+void CgleMappedMesh::Submit(bool UseLitMaterial) const
+{
+	CgleMesh::Submit(FArrays, UseLitMaterial);
+}
+//----------------------------------------------------------------------------
+void CgleMappedMesh::CopyTo(CgleMesh &Mesh) const
+{
+	size_t n = (size_t)FArrays.VertexCount;
+
+	Mesh.Clear();
+	if (FData == NULL)
+		return;
+
+	Mesh.FVertices.assign(FArrays.Vertices, FArrays.Vertices + 3 * n);
+	Mesh.FIndices.assign(FArrays.Indices, FArrays.Indices + FArrays.IndexCount);
+	Mesh.FPrimitives.assign(FArrays.Primitives, FArrays.Primitives + 3 * FArrays.SegmentCount);
+
+	// the arrays are kept in step, with the GL defaults where the mesh had none
+	Mesh.FHasNormals = (FArrays.Normals != NULL);
+	if (Mesh.FHasNormals)
+		Mesh.FNormals.assign(FArrays.Normals, FArrays.Normals + 3 * n);
+	else
+	{
+		Mesh.FNormals.resize(3 * n, 0.0f);
+		for (size_t i = 2; i < 3 * n; i += 3)
+			Mesh.FNormals[i] = 1.0f;
+	}
+
+	Mesh.FHasColors = (FArrays.Colors != NULL);
+	if (Mesh.FHasColors)
+		Mesh.FColors.assign(FArrays.Colors, FArrays.Colors + 3 * n);
+	else
+		Mesh.FColors.assign(3 * n, 1.0f);
+
+	Mesh.FHasTexCoords = (FArrays.TexCoords != NULL);
+	if (Mesh.FHasTexCoords)
+		Mesh.FTexCoords.assign(FArrays.TexCoords, FArrays.TexCoords + 2 * n);
+	else
+		Mesh.FTexCoords.assign(2 * n, 0.0f);
+}
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleMeshCache
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleMeshCache::CgleMeshCache(const std::string &Directory)
+	: FDirectory(Directory), FHits(0), FMisses(0), FSerial(0)
+{
+	if (!FDirectory.empty() && (FDirectory.back() != '/') && (FDirectory.back() != '\\'))
+		FDirectory += '/';
+}
+//----------------------------------------------------------------------------
+// The geometry version is to be bumped with any change to the meshes the
+// extrusion code generates; what was cached before is then regenerated.
+const char *CgleMeshCache::GetVersion()
+{
+	return("GLE32 6.0, geometry 1"
+#ifdef PACKAGE_VERSION
+		", gle " PACKAGE_VERSION
+#endif
+		);
+}
+//----------------------------------------------------------------------------
+// 64 bit FNV-1a
+uint64_t CgleMeshCache::Hash(const void *Data, size_t Size, uint64_t Seed)
+{
+	const unsigned char *p = (const unsigned char *)Data;
+	uint64_t h = Seed;
+
+	for (size_t i = 0; i < Size; i++)
+	{
+		h ^= p[i];
+		h *= 0x100000001b3ull;
+	}
+	return(h);
+}
+//----------------------------------------------------------------------------
+uint64_t CgleMeshCache::VersionHash()
+{
+	const char *version = GetVersion();
+
+	return(Hash(version, strlen(version), 0xcbf29ce484222325ull));
+}
+//----------------------------------------------------------------------------
+uint64_t CgleMeshCache::Key(const std::vector<double> &Inputs)
+{
+	return(Hash(Inputs.data(), Inputs.size() * sizeof(double), VersionHash()));
+}
+//----------------------------------------------------------------------------
+std::string CgleMeshCache::GetPath(const std::vector<double> &Inputs) const
+{
+	char name[32];
+
+	snprintf(name, sizeof(name), "%016llx.mesh", (unsigned long long)Key(Inputs));
+	return(FDirectory + name);
+}
+//----------------------------------------------------------------------------
+const std::string &CgleMeshCache::GetDirectory() const
+{
+	return(FDirectory);
+}
+//----------------------------------------------------------------------------
+int CgleMeshCache::GetHits() const
+{
+	return(FHits);
+}
+//----------------------------------------------------------------------------
+int CgleMeshCache::GetMisses() const
+{
+	return(FMisses);
+}
+//----------------------------------------------------------------------------
+// The array lies within the file, on a multiple of 16 bytes.
+static bool Array_Fits(size_t FileSize, uint64_t Offset, uint64_t Count, uint64_t Width)
+{
+	if (Offset == 0)
+		return(true);
+	return(((Offset & 15) == 0) && (Offset <= FileSize) && (Count * Width <= FileSize - Offset));
+}
+//----------------------------------------------------------------------------
+// Every index names a vertex of the mesh, as does every segment's range of
+// vertices; a file that fits its header but not this is corrupt, and would
+// send GL reading past the arrays.
+static bool Elements_Valid(uint32_t VertexCount, const GLuint *Indices, size_t IndexCount,
+	const GLint *Segments, size_t SegmentCount)
+{
+	if ((IndexCount % 3) != 0)
+		return(false);
+
+	for (size_t i = 0; i < IndexCount; i++)
+		if (Indices[i] >= VertexCount)
+			return(false);
+
+	for (size_t i = 0; i < 3 * SegmentCount; i += 3)
+	{
+		GLint first = Segments[i + 1], count = Segments[i + 2];
+
+		if ((Segments[i] < (GLint)GL_POINTS) || (Segments[i] > (GLint)GL_POLYGON) ||
+			(first < 0) || (count < 0) || ((uint64_t)first + (uint64_t)count > VertexCount))
+			return(false);
+	}
+	return(true);
+}
+//----------------------------------------------------------------------------
+// The offset is into the mapping; zero is an array the mesh hasn't got.
+template <class T> static const T *Mapped_Array(const unsigned char *Data, uint64_t Offset)
+{
+	return((Offset == 0) ? NULL : (const T *)(Data + Offset));
+}
+//----------------------------------------------------------------------------
+bool CgleMeshCache::Fetch(const std::vector<double> &Inputs, CgleMappedMesh &Mesh)
+{
+	// mapped into an object of our own, so that the mesh is left alone on a miss
+	CgleMappedMesh mapped;
+	const CgleMeshFileHeader *h = NULL;
+
+	if (mapped.Map(GetPath(Inputs)) && (mapped.FSize >= sizeof(CgleMeshFileHeader)))
+		h = (const CgleMeshFileHeader *)mapped.FData;
+
+	bool ok = (h != NULL) &&
+		(memcmp(h->Magic, MESH_MAGIC, sizeof(h->Magic)) == 0) &&
+		(h->ByteOrder == MESH_BYTE_ORDER) && (h->Layout == Layout) &&
+		(h->Version == VersionHash()) &&
+		(h->InputCount == Inputs.size()) && (h->Vertices != 0) &&
+		(h->Inputs != 0) && (h->Indices != 0) && (h->Segments != 0) &&
+		(h->IndexCount != 0) && (h->VertexCount <= (uint32_t)INT_MAX) &&
+		(h->IndexCount <= (uint32_t)INT_MAX) && (h->SegmentCount <= (uint32_t)INT_MAX) &&
+		Array_Fits(mapped.FSize, h->Inputs, h->InputCount, sizeof(double)) &&
+		Array_Fits(mapped.FSize, h->Vertices, h->VertexCount, 3 * sizeof(float)) &&
+		Array_Fits(mapped.FSize, h->Normals, h->VertexCount, 3 * sizeof(float)) &&
+		Array_Fits(mapped.FSize, h->Colors, h->VertexCount, 3 * sizeof(float)) &&
+		Array_Fits(mapped.FSize, h->TexCoords, h->VertexCount, 2 * sizeof(float)) &&
+		Array_Fits(mapped.FSize, h->Indices, h->IndexCount, sizeof(GLuint)) &&
+		Array_Fits(mapped.FSize, h->Segments, h->SegmentCount, 3 * sizeof(GLint)) &&
+		(memcmp(mapped.FData + h->Inputs, Inputs.data(), Inputs.size() * sizeof(double)) == 0) &&
+		Elements_Valid(h->VertexCount, Mapped_Array<GLuint>(mapped.FData, h->Indices),
+			h->IndexCount, Mapped_Array<GLint>(mapped.FData, h->Segments), h->SegmentCount);
+
+	if (!ok)
+	{
+		FMisses++;
+		return(false);
+	}
+
+	CgleMeshArrays &a = mapped.FArrays;
+
+	a.Vertices = Mapped_Array<float>(mapped.FData, h->Vertices);
+	a.Normals = Mapped_Array<float>(mapped.FData, h->Normals);
+	a.Colors = Mapped_Array<float>(mapped.FData, h->Colors);
+	a.TexCoords = Mapped_Array<float>(mapped.FData, h->TexCoords);
+	a.Indices = Mapped_Array<GLuint>(mapped.FData, h->Indices);
+	a.Primitives = Mapped_Array<GLint>(mapped.FData, h->Segments);
+	a.VertexCount = (int)h->VertexCount;
+	a.IndexCount = (int)h->IndexCount;
+	a.SegmentCount = (int)h->SegmentCount;
+
+	Mesh = std::move(mapped);
+
+	FHits++;
+	return(true);
+}
+//----------------------------------------------------------------------------
+bool CgleMeshCache::Fetch(const std::vector<double> &Inputs, CgleMesh &Mesh)
+{
+	CgleMappedMesh mapped;
+
+	if (!Fetch(Inputs, mapped))
+		return(false);
+
+	mapped.CopyTo(Mesh);
+	return(true);
+}
+//----------------------------------------------------------------------------
+// Writes the array at the next multiple of 16 bytes, and returns its offset.
+static uint64_t Write_Array(FILE *File, uint64_t &Offset, const void *Data, size_t Size, bool &Ok)
+{
+	static const char zeros[16] = { 0 };
+	size_t pad = (size_t)((16 - (Offset & 15)) & 15);
+
+	if (!Ok || (Data == NULL))
+		return(0);
+
+	if ((fwrite(zeros, 1, pad, File) != pad) || (fwrite(Data, 1, Size, File) != Size))
+		Ok = false;
+
+	uint64_t at = Offset + pad;
+	Offset = at + Size;
+	return(at);
+}
+//----------------------------------------------------------------------------
+bool CgleMeshCache::Store(const std::vector<double> &Inputs, const CgleMesh &Mesh)
+{
+	if (Mesh.FVertices.empty() || Mesh.FIndices.empty())
+		return(false);
+
+	std::string path = GetPath(Inputs);
+	CgleMeshFileHeader h;
+	char temp[64];
+
+	// unique to this process and this call, so that writers never share a file
+#ifdef _WIN32
+	snprintf(temp, sizeof(temp), ".%lu.%u", (unsigned long)GetCurrentProcessId(), FSerial++);
+#else
+	snprintf(temp, sizeof(temp), ".%ld.%u", (long)getpid(), FSerial++);
+#endif
+	std::string temp_path = path + temp;
+
+	FILE *file = fopen(temp_path.c_str(), "wb");
+	if (file == NULL)
+		return(false);
+
+	memset(&h, 0, sizeof(h));
+	memcpy(h.Magic, MESH_MAGIC, sizeof(h.Magic));
+	h.ByteOrder = MESH_BYTE_ORDER;
+	h.Layout = Layout;
+	h.Version = VersionHash();
+	h.VertexCount = (uint32_t)(Mesh.FVertices.size() / 3);
+	h.IndexCount = (uint32_t)Mesh.FIndices.size();
+	h.SegmentCount = (uint32_t)(Mesh.FPrimitives.size() / 3);
+	h.InputCount = (uint32_t)Inputs.size();
+
+	// the header goes first, but its offsets are only known once the arrays
+	// are written; it is written twice
+	bool ok = (fwrite(&h, sizeof(h), 1, file) == 1);
+	uint64_t offset = sizeof(h);
+
+	size_t n = h.VertexCount;
+	h.Inputs = Write_Array(file, offset, Inputs.data(), Inputs.size() * sizeof(double), ok);
+	h.Vertices = Write_Array(file, offset, &Mesh.FVertices[0], 3 * n * sizeof(float), ok);
+	if (Mesh.FHasNormals)
+		h.Normals = Write_Array(file, offset, &Mesh.FNormals[0], 3 * n * sizeof(float), ok);
+	if (Mesh.FHasColors)
+		h.Colors = Write_Array(file, offset, &Mesh.FColors[0], 3 * n * sizeof(float), ok);
+	if (Mesh.FHasTexCoords)
+		h.TexCoords = Write_Array(file, offset, &Mesh.FTexCoords[0], 2 * n * sizeof(float), ok);
+	h.Indices = Write_Array(file, offset, &Mesh.FIndices[0], Mesh.FIndices.size() * sizeof(GLuint), ok);
+	h.Segments = Write_Array(file, offset, Mesh.FPrimitives.data(), Mesh.FPrimitives.size() * sizeof(GLint), ok);
+
+	if (ok)
+		ok = (fseek(file, 0, SEEK_SET) == 0) && (fwrite(&h, sizeof(h), 1, file) == 1);
+	if (fclose(file) != 0)
+		ok = false;
+
+	// another writer may have got there first; its file is as good as ours
+	if (!ok || (rename(temp_path.c_str(), path.c_str()) != 0))
+	{
+		remove(temp_path.c_str());
+		return(false);
+	}
+	return(true);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,137 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+#include <thread>
+#include <chrono>
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleMeshQueue
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleMeshQueue::CgleMeshQueue(int Capacity)
+{
+	size_t size = 2;
+
+	while ((int)size < Capacity)
+		size *= 2;
+
+	FSlots.reset(new Slot[size]);
+	FMask = size - 1;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		FSlots[i].Sequence.store(i, std::memory_order_relaxed);
+		FSlots[i].Tag = 0;
+	}
+
+	FTail.store(0, std::memory_order_relaxed);
+	FHead = 0;
+	FStalls.store(0, std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------
+// A slot whose sequence is the position being claimed is free; one whose
+// sequence is behind it still holds the mesh from a lap ago, so the ring
+// is full.
+bool CgleMeshQueue::TrySubmit(int Tag, CgleMesh &&Mesh)
+{
+	size_t pos = FTail.load(std::memory_order_relaxed);
+	Slot *slot;
+
+	for (;;)
+	{
+		slot = &FSlots[pos & FMask];
+		size_t seq = slot->Sequence.load(std::memory_order_acquire);
+		ptrdiff_t lag = (ptrdiff_t)(seq - pos);
+
+		if (lag == 0)
+		{
+			if (FTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (lag < 0)
+			return(false);
+		else
+			pos = FTail.load(std::memory_order_relaxed);
+	}
+
+	slot->Tag = Tag;
+	slot->Mesh = std::move(Mesh);
+	slot->Sequence.store(pos + 1, std::memory_order_release);
+
+	return(true);
+}
+//----------------------------------------------------------------------------
+// Spins briefly, as the GL thread usually frees a slot within a frame,
+// then sleeps between tries rather than take a core from the builders.
+void CgleMeshQueue::Submit(int Tag, CgleMesh &&Mesh)
+{
+	if (TrySubmit(Tag, std::move(Mesh)))
+		return;
+
+	FStalls.fetch_add(1, std::memory_order_relaxed);
+
+	for (int tries = 0; !TrySubmit(Tag, std::move(Mesh)); tries++)
+	{
+		if (tries < 64)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+}
+//----------------------------------------------------------------------------
+bool CgleMeshQueue::TryTake(int &Tag, CgleMesh &Mesh)
+{
+	Slot &slot = FSlots[FHead & FMask];
+
+	if (slot.Sequence.load(std::memory_order_acquire) != FHead + 1)
+		return(false);
+
+	Tag = slot.Tag;
+	Mesh = std::move(slot.Mesh);
+	slot.Mesh = CgleMesh();		// the queue keeps no storage once drained
+
+	slot.Sequence.store(FHead + FMask + 1, std::memory_order_release);
+	FHead++;
+
+	return(true);
+}
+//----------------------------------------------------------------------------
+int CgleMeshQueue::Drain(std::function<void(int Tag, CgleMesh &Mesh)> Take, int Max)
+{
+	CgleMesh mesh;
+	int tag, taken = 0;
+
+	while (((Max <= 0) || (taken < Max)) && TryTake(tag, mesh))
+	{
+		Take(tag, mesh);
+		taken++;
+	}
+
+	return(taken);
+}
+//----------------------------------------------------------------------------
+int CgleMeshQueue::GetCapacity() const
+{
+	return((int)FMask + 1);
+}
+//----------------------------------------------------------------------------
+int CgleMeshQueue::GetStalls() const
+{
+	return(FStalls.load(std::memory_order_relaxed));
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,137 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <functional>
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>A queue of built meshes, from any number of threads that build extrusions
+/// to the one thread that may call GL.</summary>
+/// \details Workers hand each mesh over with Submit once it is built, tagged with
+/// whatever number the caller uses to tell them apart, and the GL thread takes them off
+/// with Drain, once a frame say, and uploads them:
+///
+///		pool.Submit([&, Tag]()
+///		{
+///			CgleExtrusion tube(Points, ContourPoints, Radius);
+///			tube.Build(Point_Array, Color_Array);
+///			queue.Submit(Tag, tube.TakeMesh());
+///		});
+///
+///		// on the GL thread
+///		queue.Drain([&](int Tag, CgleMesh &Mesh)
+///		{
+///			glBindBuffer(GL_ARRAY_BUFFER, buffers[Tag]);
+///			glBufferData(GL_ARRAY_BUFFER, Mesh.GetVertexCount() * 3 * sizeof(float),
+///				Mesh.GetVertices(), GL_STATIC_DRAW);
+///			...
+///		});
+///
+/// The queue is a ring of a fixed number of slots, so that the meshes waiting in it are
+/// bounded however far the workers get ahead. A mesh is moved into a slot, and out
+/// again, so nothing is copied. Neither side takes a lock: a worker claims a slot with a
+/// compare and swap on the tail, and each slot carries a sequence number that tells the
+/// GL thread when the mesh in it is complete, and the workers when it has been taken.
+///
+/// When the ring is full, TrySubmit returns false, and Submit waits, yielding, until the
+/// GL thread has made room; that is the back pressure that keeps the workers from
+/// running ahead of the uploads. Only one thread may call TryTake and Drain at a time.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleMeshQueue
+{
+
+public:
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary></summary>
+///
+/// @param	Capacity The number of meshes the queue holds at most; rounded up to a power
+/// of two.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	explicit CgleMeshQueue(int Capacity = 64);
+
+	CgleMeshQueue(const CgleMeshQueue &) = delete;
+	CgleMeshQueue &operator=(const CgleMeshQueue &) = delete;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Queues a mesh, unless the queue is full, and returns whether it did.</summary>
+/// \details The mesh is moved from only if it is queued.
+///
+/// @param	Tag
+/// @param	Mesh
+///
+/// \retval		bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	bool TrySubmit(int Tag, CgleMesh &&Mesh);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Queues a mesh, waiting for room if the queue is full.</summary>
+/// \details Mustn't be called on the thread that drains the queue, which would wait
+/// for itself.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Submit(int Tag, CgleMesh &&Mesh);
+
+	bool TryTake(int &Tag, CgleMesh &Mesh);	// the oldest mesh, if any is complete
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Takes the meshes that are complete, oldest first, and hands each to the
+/// given function; returns how many there were.</summary>
+/// \details The function may keep the mesh, by moving from it.
+///
+/// @param	Take
+/// @param	Max The most to take; 0 for no limit.
+///
+/// \retval		int
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int Drain(std::function<void(int Tag, CgleMesh &Mesh)> Take, int Max = 0);
+
+	int GetCapacity() const;
+	int GetStalls() const;		// the calls to Submit that found the queue full
+
+
+private:
+
+	struct Slot
+	{
+		std::atomic<size_t> Sequence;	// its index when free; one more when full
+		int Tag;
+		CgleMesh Mesh;
+	};
+
+	std::unique_ptr<Slot[]> FSlots;
+	size_t FMask;
+
+	// the workers' end and the GL thread's, kept to cache lines of their own
+	char FPad0[64];
+	std::atomic<size_t> FTail;
+	char FPad1[64];
+	size_t FHead;
+	char FPad2[64];
+
+	std::atomic<int> FStalls;
+
+};
+//----------------------------------------------------------------------------
@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -30,58 +30,53 @@ CgleScrew::CgleScrew(int Points, int ContourPoints, double Radius, double Twist)
 
 	SetTextureMode(gleTexMode::GLE_TEXTURE_VERTEX_CYL);
 	FTwist = Twist;
-	m_ptrPath = new gleVector[Points];
-	m_ptrTwarr = new double[Points];
 
+	// the twist of each ring is worked out as it is drawn
+	delete[] m_ptrXforms;
+	m_ptrXforms = NULL;
 }
 //----------------------------------------------------------------------------
 CgleScrew::~CgleScrew()
 {
-	delete[] m_ptrPath;
-	m_ptrPath = NULL;
-
-	delete[] m_ptrTwarr;
-	m_ptrTwarr = NULL;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void CgleScrew::Draw(double Length, float Color_Array[][3], bool bTextured)
 {
+	gleStraightAxis axis;
+	double delta, delang;
 
-	double startz = 0.0;
-	double endz = Length;
-
-	double currz, delta;
-	double currang, delang;
+	if (SubmitIfBuilt({ Length, bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
 
-
-	// fill in the extrusion array and the twist array uniformly
-	delta = (endz - startz) / ((double)(m_iPoints - 3));
-	currz = startz - delta;
+	// the path runs straight up the z axis, a step short of 0 to Length, and
+	// the contour turns evenly along it
+	delta = Length / ((double)(m_iPoints - 3));
 	delang = FTwist / ((double)(m_iPoints - 3));
-	currang = -delang;
 
-	for (int i = 1; i< m_iPoints - 1; i++)
-	{
-		m_ptrPath[i][0] = 0.0;
-		m_ptrPath[i][1] = 0.0;
-		m_ptrPath[i][2] = currz;
-		currz += delta;
-		m_ptrTwarr[i] = currang;
-		currang += delang;
-	}
-	m_ptrPath[0][0] = m_ptrPath[1][0];
-	m_ptrPath[0][1] = m_ptrPath[1][1];
-	m_ptrPath[0][2] = m_ptrPath[1][2];
-	m_ptrTwarr[0] = m_ptrTwarr[1];
+	axis.Start = -delta;
+	axis.End = Length - delta;
+	axis.Twisted = true;
+	axis.TwistStart = -delang;
+	axis.TwistEnd = FTwist - delang;
 
-	m_ptrPath[m_iPoints - 1][0] = m_ptrPath[m_iPoints - 2][0];
-	m_ptrPath[m_iPoints - 1][1] = m_ptrPath[m_iPoints - 2][1];
-	m_ptrPath[m_iPoints - 1][2] = m_ptrPath[m_iPoints - 2][2];
-	m_ptrTwarr[m_iPoints - 1] = m_ptrTwarr[m_iPoints - 2];
-
-
-	CgleTwistExtrusion::Draw(m_ptrPath, Color_Array, m_ptrTwarr, bTextured);
+	DrawStraightExtrusion(axis, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleScrew::Build(double Length, float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(Length, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleScrew::BuildAsync(CgleThreadPool &Pool, double Length,
+	float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Length, Color_Array, bTextured);
+	}));
 }
 //----------------------------------------------------------------------------
 void CgleScrew::WireDraw(double Length, float Color_Array[][3], bool bTextured)
@@ -22,6 +22,9 @@ public:
 	CgleScrew(int Points, int ContourPoints, double Radius, double Twist);
 	virtual ~CgleScrew();
 
+	CgleScrew(CgleScrew &&Other) = default;
+	CgleScrew &operator=(CgleScrew &&Other) = default;
+
 
 	using CgleTwistExtrusion::SetExtrusionMode; 	// redeclare as public
 	using CgleTwistExtrusion::GetExtrusionMode;
@@ -34,11 +37,27 @@ public:
 
 	using CgleTwistExtrusion::LoadUpVector;
 
+	using CgleTwistExtrusion::Invalidate;
+	using CgleTwistExtrusion::DiscardBuild;
+	using CgleTwistExtrusion::IsBuilt;
+	using CgleTwistExtrusion::GetMesh;
+	using CgleTwistExtrusion::GetMappedMesh;
+	using CgleTwistExtrusion::GetSegments;
+	using CgleTwistExtrusion::SetSegmentSink;
+	using CgleTwistExtrusion::TakeMesh;
+	using CgleTwistExtrusion::UseMeshCache;
+	using CgleTwistExtrusion::GetMeshCache;
+
 	using CgleTwistExtrusion::LoadContourPoint;
 
 
 	void  Draw(double Length, float Color_Array[][3], bool bTextured = false);
 
+	void  Build(double Length, float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool, double Length,
+		float Color_Array[][3], bool bTextured = false);
+
 	void  WireDraw(double Length, float Color_Array[][3], bool bTextured = false);
 
 private:
@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -24,44 +24,47 @@ CgleSimpleBeam::CgleSimpleBeam(int Points, double Radius) :
 	CgleIBeam(Points, Radius)
 {
 	m_iPoints = Points;
-	FSpinePoints = new gleVector[m_iPoints];
-
-	for (int i = 0; i < Points; i++)
-	{
-		FSpinePoints[i][0] = 0.0;
-		FSpinePoints[i][1] = 0.0;
-	}
 }
 //----------------------------------------------------------------------------
 CgleSimpleBeam::~CgleSimpleBeam()
 {
-	delete[] FSpinePoints;
-	FSpinePoints = NULL;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void CgleSimpleBeam::Draw(float Color_Array[][3], double Length, bool bTextured)
 {
-	double interval = 0;
-
-	if (m_iPoints > 4)
-		interval = Length / (double)(m_iPoints - 3);
+	gleStraightAxis axis;
 
-	double end = Length / 2.0;
+	if (SubmitIfBuilt({ Length, bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
 
-	for (int i = 2; i < m_iPoints - 2; i++)
-		FSpinePoints[i][2] = -end + (interval * ((double)(i - 1)));
-
-	FSpinePoints[0][2] = -end;
-	FSpinePoints[1][2] = -end;
-	FSpinePoints[m_iPoints - 2][2] = end;
-	FSpinePoints[m_iPoints - 1][2] = end;
+	// the path runs straight up the z axis, from -Length / 2 to Length / 2
+	axis.Start = -(Length / 2.0);
+	axis.End = Length / 2.0;
+	axis.Twisted = false;
+	axis.TwistStart = axis.TwistEnd = 0.0;
 
+	// set directly, as the change is only for this draw
 	int style = GetExtrusionMode();
-	int newstyle = style | GLE_JN_CAP;
-	SetExtrusionMode(newstyle);
-	CgleIBeam::Draw(FSpinePoints, Color_Array, bTextured);
-	SetExtrusionMode(style);
+	m_iExtrusionMode = style | GLE_JN_CAP;
+	DrawStraightExtrusion(axis, Color_Array, bTextured);
+	m_iExtrusionMode = style;
+}
+//----------------------------------------------------------------------------
+void CgleSimpleBeam::Build(float Color_Array[][3], double Length, bool bTextured)
+{
+	BeginBuild();
+	Draw(Color_Array, Length, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleSimpleBeam::BuildAsync(CgleThreadPool &Pool,
+	float Color_Array[][3], double Length, bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Color_Array, Length, bTextured);
+	}));
 }
 //----------------------------------------------------------------------------
 void  CgleSimpleBeam::WireDraw(float Color_Array[][3], double Length, bool bTextured)
@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -24,48 +24,55 @@ CgleSimpleTwistedBeam::CgleSimpleTwistedBeam(int Points,
 	double Radius) : CgleTwistedIBeam(Points, Radius)
 {
 	m_iPrivatePoints = Points;
-	FSpinePoints = new gleVector[Points];
-
-	for (int i = 0; i < Points; i++)
-	{
-		FSpinePoints[i][0] = 0.0;
-		FSpinePoints[i][1] = 0.0;
-	}
 }
 //----------------------------------------------------------------------------
 CgleSimpleTwistedBeam::~CgleSimpleTwistedBeam()
 {
-	delete[] FSpinePoints;
-	FSpinePoints = NULL;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void CgleSimpleTwistedBeam::Draw(float Color_Array[][3],
 	double Twist_Array[], double Length, bool bTextured)
 {
-	double interval = 0;
-
-	if (m_iPrivatePoints > 4)
-		interval = Length / (m_iPrivatePoints - 3);
+	gleStraightAxis axis;
 
-	double end = Length / 2.0;
+	if (SubmitIfBuilt({ Length, bTextured ? 1.0 : 0.0 }, { Color_Array, Twist_Array }))
+		return;
 
-	for (int i = 2; i < m_iPrivatePoints - 2; i++)
-		FSpinePoints[i][2] = -end + (interval * (i - 1));
+	// the path runs straight up the z axis, from -Length / 2 to Length / 2;
+	// the twists are the caller's
+	axis.Start = -(Length / 2.0);
+	axis.End = Length / 2.0;
+	axis.Twisted = false;
+	axis.TwistStart = axis.TwistEnd = 0.0;
 
-	FSpinePoints[0][2] = -end;
-	FSpinePoints[1][2] = -end;
-	FSpinePoints[m_iPrivatePoints - 2][2] = end;
-	FSpinePoints[m_iPrivatePoints - 1][2] = end;
+	LoadTwists(Twist_Array);
 
+	// set directly, as the change is only for this draw
 	int style = CgleBaseExtrusion::GetExtrusionMode();
-	int newstyle = style | GLE_JN_CAP;
-	SetExtrusionMode(newstyle);
-	CgleTwistedIBeam::Draw(FSpinePoints, Color_Array, Twist_Array, bTextured);
-	SetExtrusionMode(style);
+	m_iExtrusionMode = style | GLE_JN_CAP;
+	DrawStraightExtrusion(axis, Color_Array, bTextured);
+	m_iExtrusionMode = style;
 
 }
 //----------------------------------------------------------------------------
+void CgleSimpleTwistedBeam::Build(float Color_Array[][3],
+	double Twist_Array[], double Length, bool bTextured)
+{
+	BeginBuild();
+	Draw(Color_Array, Twist_Array, Length, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleSimpleTwistedBeam::BuildAsync(CgleThreadPool &Pool,
+	float Color_Array[][3], double Twist_Array[], double Length, bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Color_Array, Twist_Array, Length, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void  CgleSimpleTwistedBeam::WireDraw(float Color_Array[][3],
 	double Twist_Array[], double Length, bool bTextured)
 {
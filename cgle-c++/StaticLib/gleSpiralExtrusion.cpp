@@ -11,7 +11,8 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include <utility>
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -91,8 +92,50 @@ CgleSpiralExtrusion::~CgleSpiralExtrusion()
 	FSpiralMem_Anchor = NULL;
 }
 //----------------------------------------------------------------------------
+// m_ptrXforms may point into FSpiralMem_Anchor; it goes along with the base.
+CgleSpiralExtrusion::CgleSpiralExtrusion(CgleSpiralExtrusion &&Other) :
+	CgleBaseExtrusion(std::move(Other))
+{
+	FSpiralMem_Anchor = Other.FSpiralMem_Anchor;
+	FPts = Other.FPts;
+	Other.FSpiralMem_Anchor = NULL;
+	Other.FPts = NULL;
+
+	FDeltaAngle = Other.FDeltaAngle;
+	FSweep = Other.FSweep;
+	for (int i = 0; i < 2; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			FStartXForm[i][j] = Other.FStartXForm[i][j];
+		}
+	}
+}
+//----------------------------------------------------------------------------
+CgleSpiralExtrusion &CgleSpiralExtrusion::operator=(CgleSpiralExtrusion &&Other)
+{
+	if (this != &Other)
+	{
+		CgleBaseExtrusion::operator=(std::move(Other));
+		std::swap(FSpiralMem_Anchor, Other.FSpiralMem_Anchor);
+		std::swap(FPts, Other.FPts);
+		std::swap(FDeltaAngle, Other.FDeltaAngle);
+		std::swap(FSweep, Other.FSweep);
+		std::swap(FStartXForm, Other.FStartXForm);
+	}
+	return(*this);
+}
+//----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void  CgleSpiralExtrusion::SetTForm(double dXFormdTheta[2][3])
+{
+	LoadTForm(dXFormdTheta);
+	Invalidate();
+}
+//----------------------------------------------------------------------------
+// Fills in the xforms without marking the mesh stale, for the lathe, which
+// works out its own each time it's drawn.
+void  CgleSpiralExtrusion::LoadTForm(double dXFormdTheta[2][3])
 {
 	double mA[2][2], mB[2][2];
 	double run[2][2];
@@ -196,6 +239,10 @@ void CgleSpiralExtrusion::Draw(double StartRadius,
 	int saved_style;
 	double delta, cprev, sprev, cdelta, sdelta, ccurr, scurr;
 
+	if (SubmitIfBuilt({ StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta,
+		bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
+
 	StartTheta *= M_PI / 180.0;
 	StartTheta -= FDeltaAngle;
 
@@ -244,12 +291,33 @@ void CgleSpiralExtrusion::Draw(double StartRadius,
 	int style = saved_style & ~GLE_JN_MASK;
 	style |= GLE_JN_ANGLE;
 
-	CgleBaseExtrusion::SetExtrusionMode(style);
+	m_iExtrusionMode = style;	// the spiral's own doing; no change to the mesh
 
 	CgleBaseExtrusion::DrawExtrusion((double(*)[3])FPts, Color_Array, bTextured);
 
 }
 //----------------------------------------------------------------------------
+void CgleSpiralExtrusion::Build(double StartRadius,
+												double dRadiusdTheta, double StartZ,
+												double dZdTheta, double StartTheta,
+												float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleSpiralExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double StartRadius, double dRadiusdTheta, double StartZ, double dZdTheta,
+	double StartTheta, float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta, Color_Array,
+			bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void CgleSpiralExtrusion::WireDraw(double StartRadius,
 											double dRadiusdTheta, double StartZ,
 											double dZdTheta, double StartTheta,
@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -32,31 +32,56 @@ CgleTaperExtrusion::CgleTaperExtrusion(int Points,
 	SetTextureMode(gleTexMode::GLE_TEXTURE_NORMAL_MODEL_CYL);
 
 	FTwist = Twist;
-	m_ptrPath = new gleVector[Points];
 	m_ptrXforms = new gleAffine[m_iPoints];
+
+	FProfileValid = false;
+	FProfileDistortion = FProfileTwist = 0.0;
 }
 //----------------------------------------------------------------------------
 CgleTaperExtrusion::~CgleTaperExtrusion()
 {
 	delete[] m_ptrXforms;
 	m_ptrXforms = NULL;
-
-	delete[] m_ptrPath;
-	m_ptrPath = NULL;
 }
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 void CgleTaperExtrusion::Draw(double Length, double Distortion,
 											float Color_Array[][3], bool bTextured)
 {
+	gleStraightAxis axis;
+	double delta;
 
-	double startz = -(Length / 2.0);
-	double endz = Length / 2.0;
-	double si, co, taper, aponent;
-	double taper_step, taper_z;
+	if (SubmitIfBuilt({ Length, Distortion, bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
+
+	// The xforms depend on nothing else, so the pow(), sin() and
+	// cos() calls are only made again when one of these changes.
+	if (!FProfileValid || (Distortion != FProfileDistortion) ||
+		(FTwist != FProfileTwist))
+	{
+		ComputeProfile(Distortion);
+
+		FProfileDistortion = Distortion;
+		FProfileTwist = FTwist;
+		FProfileValid = true;
+	}
+
+	// the path runs straight up the z axis, a step short of -Length / 2 to
+	// Length / 2
+	delta = Length / ((double)(m_iPoints - 3));
 
+	axis.Start = -(Length / 2.0) - delta;
+	axis.End = (Length / 2.0) - delta;
+	axis.Twisted = false;
+	axis.TwistStart = axis.TwistEnd = 0.0;
 
-	double currz, delta;
+	DrawStraightExtrusion(axis, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleTaperExtrusion::ComputeProfile(double Distortion)
+{
+	double si, co, taper, aponent;
+	double taper_step, taper_z;
 	double currang, delang;
 	aponent = fabs(Distortion);
 
@@ -65,17 +90,11 @@ void CgleTaperExtrusion::Draw(double Length, double Distortion,
 	taper_z = -.9999;
 	taper_step = 1.9998 / (m_iPoints - 3);
 
-	delta = (endz - startz) / ((double)(m_iPoints - 3));
-	currz = startz - delta;
 	delang = 2.0 * (FTwist / ((double)(m_iPoints - 3)));
 	currang = -delang;
 
 	for (int i = 1; i< m_iPoints - 1; i++)
 	{
-		m_ptrPath[i][0] = 0.0;
-		m_ptrPath[i][1] = 0.0;
-		m_ptrPath[i][2] = currz;
-
 		si = sin(currang);
 		co = cos(currang);
 		taper = pow((1.0 - pow(fabs(taper_z), 1.0 / aponent)), aponent);
@@ -88,18 +107,9 @@ void CgleTaperExtrusion::Draw(double Length, double Distortion,
 		m_ptrXforms[i][1][1] = taper * co;
 		m_ptrXforms[i][1][2] = 0.0;
 
-		currz += delta;
 		currang += delang;
 	}
 
-	m_ptrPath[0][0] = m_ptrPath[1][0];
-	m_ptrPath[0][1] = m_ptrPath[1][1];
-	m_ptrPath[0][2] = m_ptrPath[1][2];
-
-	m_ptrPath[m_iPoints - 1][0] = m_ptrPath[m_iPoints - 2][0];
-	m_ptrPath[m_iPoints - 1][1] = m_ptrPath[m_iPoints - 2][1];
-	m_ptrPath[m_iPoints - 1][2] = m_ptrPath[m_iPoints - 2][2];
-
 	m_ptrXforms[0][0][0] = m_ptrXforms[1][0][0];
 	m_ptrXforms[0][0][1] = m_ptrXforms[1][0][1];
 	m_ptrXforms[0][0][2] = m_ptrXforms[1][0][2];
@@ -113,8 +123,23 @@ void CgleTaperExtrusion::Draw(double Length, double Distortion,
 	m_ptrXforms[m_iPoints - 1][1][0] = m_ptrXforms[m_iPoints - 2][1][0];
 	m_ptrXforms[m_iPoints - 1][1][1] = m_ptrXforms[m_iPoints - 2][1][1];
 	m_ptrXforms[m_iPoints - 1][1][2] = m_ptrXforms[m_iPoints - 2][1][0];
-
-	CgleBaseExtrusion::DrawExtrusion(m_ptrPath, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleTaperExtrusion::Build(double Length, double Distortion,
+											float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(Length, Distortion, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleTaperExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double Length, double Distortion, float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Length, Distortion, Color_Array, bTextured);
+	}));
 }
 //----------------------------------------------------------------------------
 void CgleTaperExtrusion::WireDraw(double Length, double Distortion,
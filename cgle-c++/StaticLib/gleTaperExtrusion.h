@@ -24,12 +24,20 @@ public:
 	CgleTaperExtrusion(int Points, int ContourPoints, double Radius, double Twist);
 	virtual ~CgleTaperExtrusion();
 
+	CgleTaperExtrusion(CgleTaperExtrusion &&Other) = default;
+	CgleTaperExtrusion &operator=(CgleTaperExtrusion &&Other) = default;
+
 
 	using CgleBaseExtrusion::LoadContourPoint;	// redeclare as public
 
 
 	void   Draw(double Length, double Distortion, float Color_Array[][3], bool bTextured = false);
 
+	void   Build(double Length, double Distortion, float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool, double Length,
+		double Distortion, float Color_Array[][3], bool bTextured = false);
+
 	void   WireDraw(double Length, double Distortion, float Color_Array[][3], bool bTextured = false);
 
 
@@ -37,5 +45,11 @@ private:
 
 	double FTwist;
 
+	// what the xforms were last computed from
+	bool FProfileValid;
+	double FProfileDistortion, FProfileTwist;
+
+	void ComputeProfile(double Distortion);
+
 };
 //----------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#include "stdafx.h"
+#include "ExtrusionInternals.h"
+
+// the pool, and the queue, of the worker running on this thread, if any
+static thread_local CgleThreadPool *_cgle_pool = NULL;
+static thread_local int _cgle_worker = -1;
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+//
+//												 CgleThreadPool
+//
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+CgleThreadPool::CgleThreadPool(int Threads)
+{
+	if (Threads <= 0)
+		Threads = (int)std::thread::hardware_concurrency();
+	if (Threads <= 0)
+		Threads = 1;
+
+	FQueued = FPending = 0;
+	FNext = 0;
+	FStop = false;
+
+	for (int i = 0; i < Threads; i++)
+		FQueues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+
+	for (int i = 0; i < Threads; i++)
+		FThreads.push_back(std::thread(&CgleThreadPool::Run, this, i));
+}
+//----------------------------------------------------------------------------
+CgleThreadPool::~CgleThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(FLock);
+		FStop = true;
+	}
+	FWake.notify_all();
+
+	for (size_t i = 0; i < FThreads.size(); i++)
+		FThreads[i].join();
+}
+//----------------------------------------------------------------------------
+// The task is counted before it is queued. Counted afterwards, a worker
+// could take it, and finish it, first; the pending count would touch zero
+// while the task that submitted it was still running, and let Wait() go.
+void CgleThreadPool::Submit(std::function<void()> Task)
+{
+	unsigned q = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(FLock);
+		FQueued++;
+		FPending++;
+		if (_cgle_pool != this)
+			q = FNext++ % (unsigned)FQueues.size();
+	}
+
+	if (_cgle_pool == this)
+	{
+		TaskQueue &own = *FQueues[_cgle_worker];
+		std::lock_guard<std::mutex> lock(own.Lock);
+		own.Tasks.push_front(std::move(Task));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(FQueues[q]->Lock);
+		FQueues[q]->Tasks.push_back(std::move(Task));
+	}
+
+	FWake.notify_one();
+}
+//----------------------------------------------------------------------------
+void CgleThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(FLock);
+	FIdle.wait(lock, [this]() { return(FPending == 0); });
+}
+//----------------------------------------------------------------------------
+int CgleThreadPool::GetThreadCount() const
+{
+	return((int)FThreads.size());
+}
+//----------------------------------------------------------------------------
+CgleThreadPool &CgleThreadPool::GetDefault()
+{
+	static CgleThreadPool pool;
+	return(pool);
+}
+//----------------------------------------------------------------------------
+// The worker's own queue first, newest first; then the oldest task of
+// each of the others.
+bool CgleThreadPool::Take(int Worker, std::function<void()> &Task)
+{
+	int n = (int)FQueues.size();
+
+	for (int i = 0; i < n; i++)
+	{
+		TaskQueue &q = *FQueues[(Worker + i) % n];
+		std::lock_guard<std::mutex> lock(q.Lock);
+
+		if (q.Tasks.empty())
+			continue;
+
+		if (i == 0)
+		{
+			Task = std::move(q.Tasks.front());
+			q.Tasks.pop_front();
+		}
+		else
+		{
+			Task = std::move(q.Tasks.back());
+			q.Tasks.pop_back();
+		}
+		return(true);
+	}
+	return(false);
+}
+//----------------------------------------------------------------------------
+void CgleThreadPool::Run(int Worker)
+{
+	_cgle_pool = this;
+	_cgle_worker = Worker;
+
+	for (;;)
+	{
+		std::function<void()> task;
+
+		if (Take(Worker, task))
+		{
+			{
+				std::lock_guard<std::mutex> lock(FLock);
+				FQueued--;
+			}
+
+			task();
+			task = nullptr;
+
+			std::lock_guard<std::mutex> lock(FLock);
+			if (--FPending == 0)
+				FIdle.notify_all();
+			continue;
+		}
+
+		// FQueued is kept apart from the queues, so for a moment it can
+		// count a task that isn't queued yet, or has already been taken;
+		// Take() just comes up empty, and is tried again.
+		std::unique_lock<std::mutex> lock(FLock);
+		FWake.wait(lock, [this]() { return(FStop || (FQueued > 0)); });
+		if (FStop && (FQueued <= 0))
+			break;
+	}
+
+	_cgle_pool = NULL;
+	_cgle_worker = -1;
+}
+//----------------------------------------------------------------------------
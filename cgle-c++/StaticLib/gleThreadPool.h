@@ -0,0 +1,105 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>A pool of worker threads, for building extrusion objects off the GL thread;
+/// see the BuildAsync functions of the extrusion classes.</summary>
+/// \details Each worker has a queue of its own. A task submitted from outside the pool
+/// goes to the queues in turn; one submitted by a task goes to the front of its own
+/// worker's queue. A worker runs its own queue from the front, and, when that is empty,
+/// steals from the back of the others, so that a few long extrusions don't hold up the
+/// short ones queued behind them.
+///
+/// Tasks mustn't throw; BuildAsync passes any exception on through its future.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleThreadPool
+{
+
+public:
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary></summary>
+/// \details
+///
+/// @param	Threads The number of workers; 0 for one per hardware thread.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	explicit CgleThreadPool(int Threads = 0);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Runs whatever is still queued, then stops the workers.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	~CgleThreadPool();
+
+	CgleThreadPool(const CgleThreadPool &) = delete;
+	CgleThreadPool &operator=(const CgleThreadPool &) = delete;
+
+	void Submit(std::function<void()> Task);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Waits until every task submitted so far has run.</summary>
+/// \details Mustn't be called from a task.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Wait();
+
+	int GetThreadCount() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns a pool, shared by the whole program, with one worker per hardware
+/// thread. It is started on first use.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	static CgleThreadPool &GetDefault();
+
+
+private:
+
+	struct TaskQueue
+	{
+		std::mutex Lock;
+		std::deque<std::function<void()> > Tasks;
+	};
+
+	std::vector<std::unique_ptr<TaskQueue> > FQueues;
+	std::vector<std::thread> FThreads;
+
+	std::mutex FLock;
+	std::condition_variable FWake, FIdle;
+	int FQueued, FPending;		// waiting, and waiting or running
+	unsigned FNext;			// the queue the next outside task goes to
+	bool FStop;
+
+	bool Take(int Worker, std::function<void()> &Task);
+	void Run(int Worker);
+
+};
+//----------------------------------------------------------------------------
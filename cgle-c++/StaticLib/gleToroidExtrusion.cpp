@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -22,7 +22,7 @@
 //----------------------------------------------------------------------------
 CgleToroidExtrusion::CgleToroidExtrusion(int Points, double StartXForm[2][3], double Sweep,
 												int Facets) : CgleLatheExtrusion(Points, StartXForm,
-																							Facets, Sweep, NULL)
+																							Facets, Sweep, 0.0)
 {
 	FFacets = Facets;
 }
@@ -40,6 +40,9 @@ void CgleToroidExtrusion::Draw(double CrossSectionRadius, double StartRadius,
 
 	double c, s;
 
+	if (SubmitIfBuilt({ CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta,
+		StartTheta, bTextured ? 1.0 : 0.0 }, { Color_Array }))
+		return;
 
 	// initialize sine and cosine for circle recusrion equations
 	s = sin(2.0*M_PI / ((double)FFacets));
@@ -64,6 +67,27 @@ void CgleToroidExtrusion::Draw(double CrossSectionRadius, double StartRadius,
 		StartTheta, Color_Array, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleToroidExtrusion::Build(double CrossSectionRadius, double StartRadius,
+											double dRadiusdTheta, double StartZ,
+											double dZdTheta, double StartTheta,
+											float Color_Array[][3], bool bTextured)
+{
+	BeginBuild();
+	Draw(CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta, StartTheta, Color_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleToroidExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double CrossSectionRadius, double StartRadius, double dRadiusdTheta, double StartZ,
+	double dZdTheta, double StartTheta, float Color_Array[][3], bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(CrossSectionRadius, StartRadius, dRadiusdTheta, StartZ, dZdTheta,
+			StartTheta, Color_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void CgleToroidExtrusion::WireDraw(double CrossSectionRadius, double StartRadius,
 												double dRadiusdTheta, double StartZ,
 												double dZdTheta, double StartTheta,
@@ -12,7 +12,7 @@
 
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -41,6 +41,16 @@ CgleTwistExtrusion::~CgleTwistExtrusion()
 void CgleTwistExtrusion::Draw(double Point_Array[][3],// polyline
 											float Color_Array[][3],// color of polyline
 											double Twist_Array[], bool bTextured)//countour twists	  (in degrees)
+{
+	if (SubmitIfBuilt({ bTextured ? 1.0 : 0.0 }, { Point_Array, Color_Array, Twist_Array }))
+		return;
+
+	LoadTwists(Twist_Array);
+
+	CgleBaseExtrusion::DrawExtrusion(Point_Array, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleTwistExtrusion::LoadTwists(double Twist_Array[])
 {
 	double angle;
 	double si, co;
@@ -57,8 +67,24 @@ void CgleTwistExtrusion::Draw(double Point_Array[][3],// polyline
 		AVAL(m_ptrXforms, j, 1, 1) = co;
 		AVAL(m_ptrXforms, j, 1, 2) = 0.0;
 	}
-
-	CgleBaseExtrusion::DrawExtrusion(Point_Array, Color_Array, bTextured);
+}
+//----------------------------------------------------------------------------
+void CgleTwistExtrusion::Build(double Point_Array[][3], float Color_Array[][3],
+											double Twist_Array[], bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, Twist_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleTwistExtrusion::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], double Twist_Array[],
+	bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, Twist_Array, bTextured);
+	}));
 }
 //----------------------------------------------------------------------------
 void CgleTwistExtrusion::WireDraw(double Point_Array[][3],// polyline
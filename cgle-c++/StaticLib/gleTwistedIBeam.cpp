@@ -11,7 +11,7 @@
 ************************************************************/
 
 #include "stdafx.h"
-#include "extrusioninternals.h"
+#include "ExtrusionInternals.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -28,19 +28,25 @@ CgleTwistedIBeam::CgleTwistedIBeam(int Points, double Radius) :
 		GLE_JN_ANGLE);
 
 
-	LoadContourPoint(0, 1.0, 1.0);
-	LoadContourPoint(1, -1.0, 1.0);
-	LoadContourPoint(2, -1.0, 0.9);
-	LoadContourPoint(3, -0.15, 0.9);
-	LoadContourPoint(4, -0.15, -0.9);
-	LoadContourPoint(5, -1.0, -0.9);
-	LoadContourPoint(6, -1.0, -1.0);
-	LoadContourPoint(7, 1.0, -1.0);
-	LoadContourPoint(8, 1.0, -0.9);
-	LoadContourPoint(9, 0.15, -0.9);
-	LoadContourPoint(10, 0.15, 0.9);
-	LoadContourPoint(11, 1.0, 0.9);
-	LoadContourPoint(12, 1.0, 1.0);
+	// every I-beam of a given radius draws the same contour
+	if (!AdoptContour("I-beam"))
+	{
+		LoadContourPoint(0, 1.0, 1.0);
+		LoadContourPoint(1, -1.0, 1.0);
+		LoadContourPoint(2, -1.0, 0.9);
+		LoadContourPoint(3, -0.15, 0.9);
+		LoadContourPoint(4, -0.15, -0.9);
+		LoadContourPoint(5, -1.0, -0.9);
+		LoadContourPoint(6, -1.0, -1.0);
+		LoadContourPoint(7, 1.0, -1.0);
+		LoadContourPoint(8, 1.0, -0.9);
+		LoadContourPoint(9, 0.15, -0.9);
+		LoadContourPoint(10, 0.15, 0.9);
+		LoadContourPoint(11, 1.0, 0.9);
+		LoadContourPoint(12, 1.0, 1.0);
+
+		PublishContour("I-beam");
+	}
 }
 //----------------------------------------------------------------------------
 CgleTwistedIBeam::~CgleTwistedIBeam()
@@ -54,6 +60,24 @@ void CgleTwistedIBeam::Draw(double Point_Array[][3], float Color_Array[][3],
 	CgleTwistExtrusion::Draw(Point_Array, Color_Array, Twist_Array, bTextured);
 }
 //----------------------------------------------------------------------------
+void CgleTwistedIBeam::Build(double Point_Array[][3], float Color_Array[][3],
+	double Twist_Array[], bool bTextured)
+{
+	BeginBuild();
+	Draw(Point_Array, Color_Array, Twist_Array, bTextured);
+	EndBuild();
+}
+//----------------------------------------------------------------------------
+std::future<const CgleMesh &> CgleTwistedIBeam::BuildAsync(CgleThreadPool &Pool,
+	double Point_Array[][3], float Color_Array[][3], double Twist_Array[],
+	bool bTextured)
+{
+	return(QueueBuild(Pool, [=]()
+	{
+		Build(Point_Array, Color_Array, Twist_Array, bTextured);
+	}));
+}
+//----------------------------------------------------------------------------
 void CgleTwistedIBeam::WireDraw(double Point_Array[][3], float Color_Array[][3],
 	double Twist_Array[], bool bTextured)
 {
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#ifdef _WIN32
+
 #include "targetver.h"
 
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
@@ -46,5 +48,21 @@
 #pragma comment(lib, "opengl32.lib")
 #pragma comment(lib, "glu32.lib")
 
+#else
+
+// Elsewhere, the GL headers live in GL/, and TRUE and FALSE
+// don't come along with windows.h
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#ifndef TRUE
+#define TRUE	1
+#endif
+#ifndef FALSE
+#define FALSE	0
+#endif
+
+#endif // _WIN32
+
 
 #include "ExtrusionLib.h"
\ No newline at end of file
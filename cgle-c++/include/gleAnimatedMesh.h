@@ -0,0 +1,123 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <atomic>
+#include <thread>
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>An extrusion whose geometry changes every frame, built a frame ahead on a
+/// thread of its own, so that generating it overlaps drawing instead of adding to it.</summary>
+/// \details The object keeps three meshes: the front one, which the GL thread draws; the
+/// back one, which the worker thread builds into; and, between them, the last one the
+/// worker finished. At the start of each frame, Flip trades the front mesh for that one,
+/// if it is new, while the worker, having handed it over, is already on the frame after,
+/// in the back one. The build function is given the frame number, from 0, and builds
+/// that frame's geometry into a mesh:
+///
+///		CgleAnimatedMesh spring([&](int Frame, CgleMesh &Mesh)
+///		{
+///			CgleHelicoidExtrusion helix(Points, NULL, 1080.0, 20);
+///			helix.Build(1.0, 6.0, 2.0, -3.0, 4.0 + sin(0.05 * Frame), 0.0, NULL);
+///			Mesh = helix.TakeMesh();
+///		});
+///
+///		// in the display function
+///		spring.Draw(true);
+///
+/// The handoff is an atomic exchange of the middle mesh's index, one each way, so neither
+/// thread ever waits for the other, or takes a lock: Flip takes a finished frame, if there
+/// is one, and gives back the mesh it drew; the worker does the same with the mesh it
+/// built. If the next frame isn't done, the last one is drawn again, and counted by
+/// GetLateFrames. No frame is skipped: the worker builds up to two frames ahead, and, with
+/// both done, polls until Flip takes the first.
+///
+/// The build function runs on the worker, so it may only build (see Build and
+/// TakeMesh), not draw; anything it reads that the GL thread changes is for the caller to
+/// guard. It mustn't throw.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleAnimatedMesh
+{
+
+public:
+
+	typedef std::function<void(int Frame, CgleMesh &Mesh)> BuildFunction;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Starts the worker on frame 0.</summary>
+///
+/// @param	Build
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	explicit CgleAnimatedMesh(BuildFunction Build);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Lets the worker finish the frame it is building, then stops it.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	~CgleAnimatedMesh();
+
+	CgleAnimatedMesh(const CgleAnimatedMesh &) = delete;
+	CgleAnimatedMesh &operator=(const CgleAnimatedMesh &) = delete;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Makes the next frame the front one, if the worker has finished it, and
+/// returns whether it had.</summary>
+/// \details Called by the GL thread, once a frame, before drawing. The mesh GetFront
+/// returns stays as it is until the next call.
+///
+/// \retval		bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	bool Flip();
+
+	const CgleMesh &GetFront() const;	// empty until frame 0 is done
+	int GetFrame() const;			// of the front mesh; -1 until frame 0 is done
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Flips, then submits the front mesh, as CgleMesh::Submit does.</summary>
+///
+/// @param	UseLitMaterial
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Draw(bool UseLitMaterial);
+
+	int GetLateFrames() const;	// the calls to Flip that found the next frame not done
+
+
+private:
+
+	BuildFunction FBuild;
+
+	CgleMesh FMeshes[3];
+	int FFrames[3];
+	int FFront;			// the index of the mesh being drawn; the GL thread's
+	int FBack;			// and of the one being built; the worker's
+	std::atomic<int> FMiddle;	// the index of the other, ORed with NEW_FRAME if it's done
+	int FLate;
+
+	std::atomic<bool> FStop;
+	std::thread FThread;
+
+	void Run();
+
+};
+//----------------------------------------------------------------------------
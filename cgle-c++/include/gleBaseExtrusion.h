@@ -12,6 +12,11 @@
 
 #pragma once
 
+#include <memory>
+#include <functional>
+#include <future>
+#include <initializer_list>
+
 /////////////////////////////////////////////////////////////////////////////////////
 ///
 /// <summary>This is the ancestor class of all the extrusion objects. It provides the means to create any of the 
@@ -42,6 +47,13 @@ public:
 	CgleBaseExtrusion(int Points, int ContourPoints, double  Radius);
 	virtual ~CgleBaseExtrusion();
 
+	CgleBaseExtrusion(CgleBaseExtrusion &&Other);
+	CgleBaseExtrusion &operator=(CgleBaseExtrusion &&Other);
+
+	// each object owns its scratch memory and tessellator; move it, don't copy it
+	CgleBaseExtrusion(const CgleBaseExtrusion &) = delete;
+	CgleBaseExtrusion &operator=(const CgleBaseExtrusion &) = delete;
+
 
 /////////////////////////////////////////////////////////////////////////////////////
 ///
@@ -90,17 +102,155 @@ public:
 
 	void LoadUpVector(double Up[3]);
 
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Retained mode. Once an object has been built, by calling the Build function of
+/// its class with the arguments Draw would be given, Draw submits the stored geometry
+/// instead of regenerating it.</summary>
+/// \details The geometry is kept as an indexed triangle mesh (see CgleMesh), and is
+/// regenerated by Draw only when it has been given different arguments, or a setter has
+/// been called since; otherwise Draw does nothing but submit it. Arrays are compared by
+/// address, not content; see Invalidate.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Invalidate();
+	void DiscardBuild();
+	bool IsBuilt() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the geometry generated by the last Build or Draw of a built object.</summary>
+/// \details A mesh that came from the mesh cache is kept mapped, not copied (see
+/// GetMappedMesh); the first call to GetMesh after such a build copies it out.
+///
+/// \retval	const CgleMesh &
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	const CgleMesh &GetMesh() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the mesh cache file that the last build was drawn from, or NULL if the
+/// mesh was generated.</summary>
+///
+/// \retval	const CgleMappedMesh *
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	const CgleMappedMesh *GetMappedMesh() const;
+
+	CgleMeshSegments GetSegments() const;	// of the mapped mesh, if any; else GetMesh()'s
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Hands each segment of the mesh to Sink as soon as it has been generated, while
+/// the rest of the mesh is still being built.</summary>
+/// \details For a renderer of its own to start uploading the geometry before Build returns:
+///
+///		beam.SetSegmentSink([&](const CgleMeshSegment &seg)
+///			{ staging.Write(seg.Vertices, seg.Normals, seg.Count); });
+///		beam.Build(...);
+///
+/// The segments come in the order GetSegments gives them, on the thread doing the build,
+/// which, for BuildAsync, is one of the pool's; a long path it splits up comes as its runs
+/// are put together. The pointers are into the mesh under construction, which may move as
+/// it grows, so they're only good for the call. An optional array is NULL if the mesh
+/// hasn't had any of it so far, though a later segment may; the segment's vertices then
+/// have the GL defaults, as GetSegments will show. A build drawn from the mesh cache hands
+/// over all the segments once it's done. The mesh is kept as before, for GetSegments and
+/// GetMesh. An empty function, the default, stops streaming.
+///
+/// @param	Sink
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void SetSegmentSink(CgleSegmentSink Sink);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Hands over the built geometry, without copying it, and returns the object to
+/// immediate mode, as DiscardBuild does.</summary>
+///
+/// \retval		CgleMesh
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	CgleMesh TakeMesh();
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Keeps the object's built geometry in a cache on disk, so that a later run
+/// that builds it from the same inputs reads the mesh instead of generating it; see
+/// CgleMeshCache.</summary>
+/// \details The cache isn't owned, and must outlive the object's builds. NULL, the
+/// default, stops using it.
+///
+/// @param	Cache
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void UseMeshCache(CgleMeshCache *Cache);
+	CgleMeshCache *GetMeshCache() const;
+
 
 protected:
 
 	void  LoadContourPoint(int Index, double X, double Y);
 
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Shares a fixed contour among all the objects that use it.</summary>
+/// \details A class whose contour never changes, like the I-beam, calls AdoptContour
+/// in its constructor. If another object of the same contour point count and radius has
+/// already published the named profile, this object takes the same contour and normals,
+/// read only, and true is returned. Otherwise false is returned; the class loads the
+/// points as usual, then calls PublishContour so that the next object can adopt them.
+/// A later LoadContourPoint gives the object a private copy again.
+///
+/// @param	Profile The name of the contour, such as "I-beam".
+///
+/// \retval		bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	bool AdoptContour(const char *Profile);
+	void PublishContour(const char *Profile);
+
 	/// @cond
 	void DrawExtrusion(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
 
 
 	void DrawWireExtrusion(double Point_Array[][3], float Color_Array[][3], bool bTextured = false);
 
+	void BeginBuild();
+	void EndBuild();
+	/// @endcond
+
+	bool SubmitIfBuilt(std::initializer_list<double> Values,
+		std::initializer_list<const void *> Arrays);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Runs Build on a worker of the given pool, for the BuildAsync functions of the
+/// descendant classes.</summary>
+/// \details The future becomes ready, with the object's mesh, once Build has returned.
+/// Until then the object, and the arrays given to BuildAsync, belong to the worker: they
+/// mustn't be changed, drawn or destroyed. A GL context isn't needed, as building
+/// doesn't draw; submitting the mesh is left to the GL thread.
+///
+/// A long path is split up on the pool as well. The join code hands the up vector, the
+/// bisecting plane and the texture length on from each segment to the next, so one pass
+/// down the path works those out first, which is cheap next to building the segments;
+/// then runs of the path are built at once, each starting from what the pass found
+/// there, and their meshes are put together in order. The mesh is the same, to the bit,
+/// as one built in one piece. Round and cut joins textured by the length of the path
+/// are built in one piece, as their fillets start the length over.
+///
+/// @param	Pool
+/// @param	Build Calls the descendant's Build with the arguments of BuildAsync.
+///
+/// \retval		std::future<const CgleMesh &>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	std::future<const CgleMesh &> QueueBuild(CgleThreadPool &Pool, std::function<void()> Build);
+
+	/// @cond
+
 
 	gleContourVector *m_ptrCont_Norms, *m_ptrContours;
 
@@ -110,8 +260,6 @@ protected:
 	double m_dRadius;
 
 	int     m_iPoints, m_iContourPoints;
-	gleVector *m_ptrPath;
-	double  *m_ptrTwarr;
 	double  *m_ptrUp;
 
 	bool m_bUseLitMaterial;
@@ -128,53 +276,119 @@ protected:
 
 	gleAffine *m_ptrXforms;
 
+	// A path straight up the z axis, given by its ends rather than its points:
+	// points 1 to m_iPoints - 2 run evenly from Start to End, and points 0 and
+	// m_iPoints - 1 repeat them. If Twisted, the contour turns evenly as well,
+	// from TwistStart to TwistEnd degrees; if not, m_ptrXforms, if any, is used.
+	struct gleStraightAxis
+	{
+		double Start, End;
+		bool Twisted;
+		double TwistStart, TwistEnd;
+	};
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Draws the extrusion along a straight axis, for the screw, the taper and the
+/// simple beams, without a path or twist array.</summary>
+/// \details The angle join, and the capped round join, generate each ring of contour
+/// straight from its place along the axis; the other joins, which need the polyline, get
+/// one made from the axis just for the draw. In retained mode the build is keyed on the
+/// axis and the color array.
+///
+/// @param	Axis
+/// @param	Color_Array
+/// @param	bTextured
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void DrawStraightExtrusion(const gleStraightAxis &Axis, float Color_Array[][3],
+		bool bTextured = false);
+
 
 
 private:
 
 
+	std::shared_ptr<double> FContour;	// the contour and its normals, perhaps shared
+	bool FContourShared;
+	double FUpVector[3];
+
+	// The work areas, and the tessellator, are the calling thread's; see AttachScratch.
 	char  *FMemAnchor, *FXAJMemAnchor, *FROCJMemAnchor, *FMallocedArea;
 
 	GLUtesselator   *m_objTess;
+	gleGC           *m_ptrGC;	// texgen, color and capture state, current while generating
 
-	double *FDRSECPoints, *FCapLoop, *FNNormCapLoop, *FNNormLoop;
+	double *FCapLoop, *FNNormCapLoop, *FNNormLoop;
 
+	mutable CgleMesh m_objMesh;	// filled from FMappedMesh by GetMesh, if mapped
+	CgleMappedMesh FMappedMesh;	// the cache file, on a cache hit
+	bool m_bRetained, m_bMeshValid, m_bBuildOnly;
+	bool FKeyTaken;				// the arguments of the Draw under way are noted
+	std::vector<double> FKeyValues;		// those the mesh was built from; see SubmitIfBuilt
+	std::vector<const void *> FKeyArrays;
+	std::vector<double> FCacheInputs;
+	CgleMeshCache *FMeshCache;
+	CgleSegmentSink FSegmentSink;
 
+	bool FStraightAxis;			// set while DrawStraightExtrusion is drawing
+	gleStraightAxis FAxis;
 
-	void Draw_Fillet_Triangle_N_Norms(double va[3], double vb[3],
-		double vc[3], int face, float front_color[3],
-		double na[3], double nb[3]);
+	// Where a join loop is at the top, for a segment: the segment's first and next
+	// points, and the first point of the segment before it, the segment's length, the
+	// up vector, and that of the segment before, and the path length before the
+	// segment, for the texture. Split_Join works these out for each run of a long path.
+	struct gleJoinRun
+	{
+		int Before, First, Next;
+		int Stop;			// the first point of the next run; m_iPoints for the last
+		double Length;
+		double Up[3], LastUp[3];
+		double Accum;
+	};
 
+	struct gleSplitBuild;		// the runs of one path being built; see Split_Join
 
-	void Draw_Segment_Edge_N(double front_contour[][3],
-		double back_contour[][3], double norm_cont[][3]);
+	typedef void (CgleBaseExtrusion::*JoinFunction)();
 
-	void Draw_Segment_C_And_Edge_N(double front_contour[][3],
-		double back_contour[][3], double norm_cont[][3]);
+	CgleThreadPool *FSplitPool;		// set while a task of QueueBuild's builds
+	const gleJoinRun *FRun;			// set on an object building one run of a path
 
-	void Draw_Segment_Facet_N(double front_contour[][3],
-		double back_contour[][3], double norm_cont[][3]);
+	CgleBaseExtrusion(const CgleBaseExtrusion &Whole, const gleJoinRun &Run);
 
-	void Draw_Segment_C_And_Facet_N(double front_contour[][3],
-		double back_contour[][3], double norm_cont[][3]);
+	void Swap(CgleBaseExtrusion &Other);
 
+	void SubmitMesh() const;
 
-	void Draw_Binorm_Segment_Edge_N(double front_contour[][3],
-		double back_contour[][3], double front_norm[][3],
-		double back_norm[][3]);
+	void AttachScratch();
 
-	void Draw_Binorm_Segment_C_And_Edge_N(double front_contour[][3],
-		double back_contour[][3], double front_norm[][3],
-		double back_norm[][3]);
+	void GenerateExtrusion(double Point_Array[][3], float Color_Array[][3], bool bTextured);
+
+	void BuildExtrusion(double Point_Array[][3], float Color_Array[][3], bool bTextured);
+
+	void SaveInputs(std::vector<double> &Inputs, double Point_Array[][3],
+		float Color_Array[][3], bool bTextured);
+
+
+
+	void Draw_Fillet_Triangle_N_Norms(double va[3], double vb[3],
+		double vc[3], int face, float front_color[3],
+		double na[3], double nb[3]);
 
-	void Draw_Binorm_Segment_Facet_N(double front_contour[][3],
+
+	typedef void (CgleBaseExtrusion::*SegmentEmitter)(double front_contour[][3],
 		double back_contour[][3], double front_norm[][3],
 		double back_norm[][3]);
 
-	void Draw_Binorm_Segment_C_And_Facet_N(double front_contour[][3],
+	SegmentEmitter FEmitSegment, FEmitBinormSegment;	// picked at the start of each draw
+
+	template <bool HasColor, int NormalMode, bool BiNorm, bool HasTexgen, bool ToMesh>
+	void Emit_Segment(double front_contour[][3],
 		double back_contour[][3], double front_norm[][3],
 		double back_norm[][3]);
 
+	SegmentEmitter Select_Segment_Emitter(bool HasColor, bool BiNorm);
+
 	void Draw_Fillets_And_Join_N_Norms(int ncp, double trimmed_loop[][3],
 		double untrimmed_loop[][3], int is_trimmed[],
 		double bis_origin[3], double bis_vector[3],
@@ -203,29 +417,30 @@ private:
 	void Draw_Angle_Style_Front_Cap(double bi[3],
 		double point_array[][3]);
 
-	void Draw_Raw_Segment_C_And_Facet_N();
-
-	void Draw_Raw_Segment_Facet_N();
-
-	void Draw_Raw_Segment_C_And_Edge_N();
-
-	void Draw_Raw_Segment_Edge_N();
-
 	void Draw_Back_Contour_Cap(double contour[][3]);
 
 	void Draw_Front_Contour_Cap(double contour[][3]);
 
 	void Up_Sanity_Check(double up[3]);
 
-	void Draw_Raw_Style_End_Cap(double contour[][2], double zval,
-		int frontwards);
-
 	void Extrusion_Round_Or_Cut_Join();
 
 	void Extrusion_Angle_Join();
 
+	void Extrusion_Straight_Axis(bool bRound);
+
+	bool Straight_Axis_Xform(int Point, gleAffine Xform);
+
+	void Unroll_Straight_Axis();
+
 	void Extrusion_Raw_Join();
 
+	void Join_Start(gleJoinRun &Run, bool Raw);
+	void Join_Step(gleJoinRun &Run, bool Raw);
+	bool Split_Join(JoinFunction Join, bool Raw);
+	bool Build_Run(gleSplitBuild &Split) const;
+	void Generate_Run(CgleMesh &Mesh, JoinFunction Join);
+
 	/// @endcond
 
 };
@@ -1,6 +1,6 @@
 /***********************************************************
 *									     GLE32 Extrusion Library							*
-*							Copyright 2000 - 2017 by Dave Richards	 			*
+*							Copyright© 2000 - 2017 by Dave Richards	 			*
 *										  All Rights Reserved.							*
 *												Ver 6.0									*
 *																				       		*
@@ -22,9 +22,18 @@ public:
 	CgleConeExtrusion(int Points, int Facets);
 	virtual ~CgleConeExtrusion();
 
+	CgleConeExtrusion(CgleConeExtrusion &&Other) = default;
+	CgleConeExtrusion &operator=(CgleConeExtrusion &&Other) = default;
+
 
 	void Draw(double Point_Array[][3], float Color_Array[][3], double Radius_Array[], bool bTextured = false);
 
+	void Build(double Point_Array[][3], float Color_Array[][3], double Radius_Array[], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], double Radius_Array[],
+		bool bTextured = false);
+
 	void WireDraw(double Point_Array[][3], float Color_Array[][3], double Radius_Array[], bool bTextured = false);
 
 
@@ -23,6 +23,9 @@ public:
 	CgleCylinderExtrusion(int Points, int Facets);
 	virtual ~CgleCylinderExtrusion();
 
+	CgleCylinderExtrusion(CgleCylinderExtrusion &&Other) = default;
+	CgleCylinderExtrusion &operator=(CgleCylinderExtrusion &&Other) = default;
+
 	using CgleConeExtrusion::SetExtrusionMode;   	// redeclare as public
 	using CgleConeExtrusion::GetExtrusionMode;
 
@@ -34,9 +37,26 @@ public:
 
 	using CgleConeExtrusion::LoadUpVector;
 
+	using CgleConeExtrusion::Invalidate;
+	using CgleConeExtrusion::DiscardBuild;
+	using CgleConeExtrusion::IsBuilt;
+	using CgleConeExtrusion::GetMesh;
+	using CgleConeExtrusion::GetMappedMesh;
+	using CgleConeExtrusion::GetSegments;
+	using CgleConeExtrusion::SetSegmentSink;
+	using CgleConeExtrusion::TakeMesh;
+	using CgleConeExtrusion::UseMeshCache;
+	using CgleConeExtrusion::GetMeshCache;
+
 
 	void Draw(double Point_Array[][3], float Color_Array[][3], double Radius, bool bTextured = false);
 
+	void Build(double Point_Array[][3], float Color_Array[][3], double Radius, bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], double Radius,
+		bool bTextured = false);
+
 	void WireDraw(double Point_Array[][3], float Color_Array[][3], double Radius, bool bTextured = false);
 
 
@@ -23,6 +23,9 @@ public:
 
 	virtual ~CgleHelicoidExtrusion();
 
+	CgleHelicoidExtrusion(CgleHelicoidExtrusion &&Other) = default;
+	CgleHelicoidExtrusion &operator=(CgleHelicoidExtrusion &&Other) = default;
+
 
 	using CgleSpiralExtrusion::SetExtrusionMode;   	// redeclare as public
 	using CgleSpiralExtrusion::GetExtrusionMode;
@@ -35,6 +38,19 @@ public:
 
 	using CgleSpiralExtrusion::LoadUpVector;
 
+	using CgleSpiralExtrusion::SetTForm;		// dXFormdTheta, with a StartXForm
+
+	using CgleSpiralExtrusion::Invalidate;
+	using CgleSpiralExtrusion::DiscardBuild;
+	using CgleSpiralExtrusion::IsBuilt;
+	using CgleSpiralExtrusion::GetMesh;
+	using CgleSpiralExtrusion::GetMappedMesh;
+	using CgleSpiralExtrusion::GetSegments;
+	using CgleSpiralExtrusion::SetSegmentSink;
+	using CgleSpiralExtrusion::TakeMesh;
+	using CgleSpiralExtrusion::UseMeshCache;
+	using CgleSpiralExtrusion::GetMeshCache;
+
 
 
 	void    Draw(double CrossSectionRadius, double StartRadius,
@@ -42,6 +58,16 @@ public:
 							double dZdTheta, double StartTheta,
 							float Color_Array[][3], bool bTextured = false);
 
+	void    Build(double CrossSectionRadius, double StartRadius,
+							double dRadiusdTheta, double StartZ,
+							double dZdTheta, double StartTheta,
+							float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double CrossSectionRadius, double StartRadius, double dRadiusdTheta,
+		double StartZ, double dZdTheta, double StartTheta, float Color_Array[][3],
+		bool bTextured = false);
+
 	void    WireDraw(double CrossSectionRadius, double StartRadius,
 							double dRadiusdTheta, double StartZ,
 							double dZdTheta, double StartTheta,
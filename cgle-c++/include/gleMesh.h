@@ -0,0 +1,295 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <iterator>
+#include <functional>
+
+//----------------------------------------------------------------------------
+/// @cond
+// Where a mesh's arrays are, whoever holds them: a CgleMesh, or a cache file mapped by
+// CgleMappedMesh. The optional arrays are NULL where the mesh hasn't got them.
+struct CgleMeshArrays
+{
+	const float *Vertices, *Normals, *Colors, *TexCoords;
+	const GLuint *Indices;
+	const GLint *Primitives;	// mode, first vertex and count, a segment
+	int VertexCount, IndexCount, SegmentCount;
+};
+/// @endcond
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>One primitive of a mesh, as the extrusion code generated it.</summary>
+/// \details A tube segment is a GL_TRIANGLE_STRIP running around the contour, front
+/// ring vertex then back ring vertex; the caps and fillets come out as fans, polygons or
+/// triangles. The pointers are into the mesh's own arrays, at the segment's first vertex,
+/// and stay valid until the mesh is next cleared, regenerated or unmapped. The vertices are
+/// contiguous, so Count of them can be copied or uploaded as they stand.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+struct CgleMeshSegment
+{
+	GLenum Mode;			// as it would be given to glDrawArrays
+	int First, Count;		// the vertices, as indices into the mesh's arrays
+
+	const float *Vertices;	// three floats a vertex
+	const float *Normals;	// three floats a vertex; NULL if none were given
+	const float *Colors;	// three floats a vertex; NULL if none were given
+	const float *TexCoords;	// two floats a vertex; NULL if none were given
+};
+
+//----------------------------------------------------------------------------
+/// <summary>Called with each segment of a mesh as soon as it has been generated; see
+/// CgleBaseExtrusion::SetSegmentSink.</summary>
+typedef std::function<void(const CgleMeshSegment &Segment)> CgleSegmentSink;
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>The segments of a mesh, in the order they were generated.</summary>
+/// \details A range, for use as
+///
+///		for (const CgleMeshSegment &seg : beam.GetSegments())
+///			...
+///
+/// Nothing is copied or called back per vertex; each step of the iterator just points a
+/// CgleMeshSegment at the next run of vertices.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleMeshSegments
+{
+
+public:
+
+	class const_iterator
+	{
+
+	public:
+
+		typedef std::forward_iterator_tag iterator_category;
+		typedef CgleMeshSegment value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const CgleMeshSegment *pointer;
+		typedef const CgleMeshSegment &reference;
+
+		const_iterator() : FIndex(0) {}
+
+		reference operator*() const { Fetch(); return(FSegment); }
+		pointer operator->() const { Fetch(); return(&FSegment); }
+
+		const_iterator &operator++() { FIndex++; return(*this); }
+		const_iterator operator++(int) { const_iterator old(*this); FIndex++; return(old); }
+
+		bool operator==(const const_iterator &Other) const { return(FIndex == Other.FIndex); }
+		bool operator!=(const const_iterator &Other) const { return(FIndex != Other.FIndex); }
+
+	private:
+
+		friend class CgleMeshSegments;
+		const_iterator(const CgleMeshArrays &Arrays, int Index) : FArrays(Arrays), FIndex(Index) {}
+
+		void Fetch() const;
+
+		CgleMeshArrays FArrays;
+		int FIndex;
+		mutable CgleMeshSegment FSegment;
+
+	};
+
+	const_iterator begin() const { return(const_iterator(FArrays, 0)); }
+	const_iterator end() const { return(const_iterator(FArrays, FArrays.SegmentCount)); }
+
+	int size() const { return(FArrays.SegmentCount); }
+	bool empty() const { return(FArrays.SegmentCount == 0); }
+	CgleMeshSegment operator[](int Index) const;
+
+	/// @cond
+	static CgleMeshSegment Segment(const CgleMeshArrays &Arrays, int Index);
+	/// @endcond
+
+private:
+
+	friend class CgleMesh;
+	friend class CgleMappedMesh;
+	explicit CgleMeshSegments(const CgleMeshArrays &Arrays) : FArrays(Arrays) {}
+
+	CgleMeshArrays FArrays;
+
+};
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>A triangle mesh, as generated by CgleBaseExtrusion::Build.</summary>
+/// \details An extrusion object that has been built keeps its geometry in one of these,
+/// rather than regenerating it on each call to Draw. The strips, fans and tessellated caps
+/// that the extrusion code produces are stored as indexed triangles, with the modelview
+/// transforms that the join code applies already folded into the vertex positions and
+/// normals. Normals, colors and texture coordinates are only present if the extrusion
+/// supplied them.
+///
+/// The arrays are exposed so that the geometry can also be handed to something other
+/// than the fixed function pipeline.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleMesh
+{
+
+public:
+
+	CgleMesh();
+	~CgleMesh();
+
+	CgleMesh(const CgleMesh &) = default;
+	CgleMesh &operator=(const CgleMesh &) = default;
+	CgleMesh(CgleMesh &&) = default;
+	CgleMesh &operator=(CgleMesh &&) = default;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Discards the geometry, keeping the storage for reuse.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Clear();
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Adds a copy of another mesh's geometry to the end of this one.</summary>
+/// \details The other mesh's vertices are numbered after this one's, so its first vertex
+/// is GetVertexCount(), as it was before the call, and its first index GetIndexCount().
+/// Normals, colors and texture coordinates are kept wherever either mesh has them;
+/// where only one does, the other's vertices have the GL defaults.
+///
+/// @param	Other
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Append(const CgleMesh &Other);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Makes room for the mesh to grow to so many vertices, indices and segments
+/// without reallocating.</summary>
+///
+/// @param	Vertices
+/// @param	Indices
+/// @param	Segments
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Reserve(int Vertices, int Indices, int Segments);
+
+	bool IsEmpty() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the number of vertices; each has three position floats and, where
+/// present, three normal floats, three color floats and two texture coordinate floats.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int GetVertexCount() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the number of triangle indices; three per triangle.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	int GetIndexCount() const;
+
+	const float *GetVertices() const;
+	const float *GetNormals() const;		// NULL if none were given
+	const float *GetColors() const;		// NULL if none were given
+	const float *GetTexCoords() const;	// NULL if none were given
+	const GLuint *GetIndices() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the mesh as it was generated, segment by segment, for a renderer of
+/// its own to stream from; see CgleMeshSegments.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	CgleMeshSegments GetSegments() const;
+	int GetSegmentCount() const;
+	CgleMeshSegment GetSegment(int Index) const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Draws the mesh with glDrawElements.</summary>
+/// \details Colors are applied the way the extrusion objects apply them: with
+/// UseLitMaterial set, as ambient, diffuse and emissive material, which cannot come from
+/// a vertex array; such meshes are drawn primitive by primitive, as they were generated.
+///
+/// @param	UseLitMaterial
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Submit(bool UseLitMaterial) const;
+
+	/// @cond
+	// The recording interface; these mirror the GL calls the extrusion code makes.
+	void Begin(GLenum mode);
+	void End();
+	void Normal(const double n[3]);
+	void Color(const float c[3]);
+	void TexCoord(double s, double t);
+	void Vertex(const double v[3]);
+
+	void PushMatrix();
+	void MultMatrix(const double m[16]);
+	void PopMatrix();
+
+	// each segment is handed to the sink as it's ended or appended; NULL for none
+	void SetSink(const CgleSegmentSink *Sink);
+	bool HasSink() const;
+
+	// GLU tessellator callbacks, with the mesh passed as the polygon data
+	static void APIENTRY TessBegin(GLenum mode, void *mesh);
+	static void APIENTRY TessVertex(void *vertex, void *mesh);
+	static void APIENTRY TessEnd(void *mesh);
+	/// @endcond
+
+private:
+
+	friend class CgleMeshCache;
+	friend class CgleMappedMesh;
+
+	CgleMeshArrays GetArrays() const;
+
+	static void Submit(const CgleMeshArrays &Arrays, bool UseLitMaterial);
+	static void SubmitLit(const CgleMeshArrays &Arrays);
+	static bool SameColor(const float *a, const float *b);
+	static void SetMaterial(const float c[3]);
+
+	std::vector<float> FVertices, FNormals, FColors, FTexCoords;
+	std::vector<GLuint> FIndices;
+	std::vector<GLint> FPrimitives;	// mode, first vertex and count, as recorded
+
+	bool FHasNormals, FHasColors, FHasTexCoords;
+
+	double FNormal[3];
+	float FColor[3];
+	float FTexCoord[2];
+
+	GLenum FMode;
+	size_t FFirst;			// first vertex of the current primitive
+
+	double FMatrix[16];
+	bool FIdentity;
+	std::vector<double> FMatrixStack;
+
+	const CgleSegmentSink *FSink;	// not owned
+
+	void Stream(int First) const;
+
+};
+//----------------------------------------------------------------------------
@@ -0,0 +1,220 @@
+/***********************************************************
+*									     GLE32 Extrusion Library                                     *
+*							Written October 2026 for this library                      *
+*							See COPYING in the top directory.                          *
+*												Ver 6.0									*
+*																				       		*
+*											HISTORY:										*
+*									Linas Vepstas 1990 - 1997							*
+*									Dave Richards  2000 - 2017						*
+*																							*
+************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>The header of a mesh cache file.</summary>
+/// \details A file holds one mesh, in the byte order of the machine that wrote it,
+/// laid out so that a renderer can map it into memory and hand it to GL as it stands: each
+/// array starts on a multiple of 16 bytes, at the offset given here, and is in the form
+/// CgleMesh gives it -- three floats a vertex for the positions, normals and colors,
+/// two for the texture coordinates, and three GLuints a triangle for the indices. An
+/// offset of zero is an array the mesh hasn't got.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+struct CgleMeshFileHeader
+{
+	char Magic[8];			// "GLEMESH", and a NUL
+	uint32_t ByteOrder;		// 0x01020304, as the writer stores it
+	uint32_t Layout;		// CgleMeshCache::Layout
+	uint64_t Version;		// a hash of CgleMeshCache::GetVersion()
+
+	uint32_t VertexCount, IndexCount, SegmentCount;
+	uint32_t InputCount;		// doubles; see CgleMeshCache::Fetch
+
+	uint64_t Inputs;		// the offsets of the arrays
+	uint64_t Vertices, Normals, Colors, TexCoords;
+	uint64_t Indices;
+	uint64_t Segments;		// GLint mode, first vertex and count, a segment
+};
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>A mesh read from a cache file by mapping the file into memory, and used where
+/// it lies.</summary>
+/// \details The arrays are those of the file itself, so nothing is read or copied until GL,
+/// or the caller, touches the pages. It offers what a renderer wants of a CgleMesh: the
+/// counts, the array pointers, GetSegments and Submit. It cannot be added to or changed;
+/// CopyTo makes a CgleMesh of it, for that. The mapping lasts until the object is cleared,
+/// fetched into again, or destroyed, and the pointers it hands out are good until then.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleMappedMesh
+{
+
+public:
+
+	CgleMappedMesh();
+	~CgleMappedMesh();
+
+	CgleMappedMesh(const CgleMappedMesh &) = delete;
+	CgleMappedMesh &operator=(const CgleMappedMesh &) = delete;
+	CgleMappedMesh(CgleMappedMesh &&Other);
+	CgleMappedMesh &operator=(CgleMappedMesh &&Other);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Unmaps the file.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Clear();
+
+	bool IsEmpty() const;
+
+	int GetVertexCount() const;
+	int GetIndexCount() const;
+
+	const float *GetVertices() const;
+	const float *GetNormals() const;		// NULL if the mesh has none
+	const float *GetColors() const;		// NULL if the mesh has none
+	const float *GetTexCoords() const;	// NULL if the mesh has none
+	const GLuint *GetIndices() const;
+
+	CgleMeshSegments GetSegments() const;
+	int GetSegmentCount() const;
+	CgleMeshSegment GetSegment(int Index) const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Draws the mesh, straight from the mapping, as CgleMesh::Submit would.</summary>
+///
+/// @param	UseLitMaterial
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void Submit(bool UseLitMaterial) const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Replaces the given mesh with a copy of this one, for a caller that wants a
+/// CgleMesh of its own.</summary>
+///
+/// @param	Mesh
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	void CopyTo(CgleMesh &Mesh) const;
+
+
+private:
+
+	friend class CgleMeshCache;
+
+	bool Map(const std::string &Path);
+	void Swap(CgleMappedMesh &Other);
+
+	const unsigned char *FData;	// the whole file
+	size_t FSize;
+#ifdef _WIN32
+	HANDLE FFile, FMapping;
+#endif
+
+	CgleMeshArrays FArrays;		// into FData; all zero if not mapped
+
+};
+
+//----------------------------------------------------------------------------
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>A directory of built meshes, kept from one run of a program to the next, so
+/// that objects built with the same inputs needn't be generated again.</summary>
+/// \details An object given a cache with UseMeshCache looks in it whenever it is built;
+/// if a mesh was stored from the same inputs -- everything CgleBaseExtrusion compares to
+/// decide whether a built mesh is stale -- by the same version of the library, the file is
+/// mapped and drawn where it lies (see CgleMappedMesh), and no geometry is computed. Otherwise the mesh is generated, and
+/// stored. Each mesh is a file of its own, named for a hash of the inputs and the
+/// version, and holding the inputs as well, so that a collision of hashes is a miss and
+/// not a wrong mesh. Files are written under a temporary name and then renamed, so that
+/// a reader never sees half a file.
+///
+/// The directory must exist. Nothing is ever removed from it; meshes of other versions,
+/// or of inputs no longer used, stay until it is cleared by hand.
+///
+/// A cache may be shared by objects built on any number of threads.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+class CgleMeshCache
+{
+
+public:
+
+	static const uint32_t Layout = 1;
+
+	explicit CgleMeshCache(const std::string &Directory);
+
+	CgleMeshCache(const CgleMeshCache &) = delete;
+	CgleMeshCache &operator=(const CgleMeshCache &) = delete;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Maps the mesh built from the given inputs, if it has been stored.</summary>
+/// \details The header, the inputs and the indices are checked in place; the vertex
+/// arrays are not read at all, so a warm start costs the mapping and the check.
+///
+/// @param	Inputs What the mesh was built from, as CgleBaseExtrusion flattens it.
+/// @param	Mesh Replaced by the stored mesh; left alone if there isn't one.
+///
+/// \retval		bool
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	bool Fetch(const std::vector<double> &Inputs, CgleMappedMesh &Mesh);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>As the other Fetch, but copies the stored mesh into a CgleMesh.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	bool Fetch(const std::vector<double> &Inputs, CgleMesh &Mesh);
+
+	bool Store(const std::vector<double> &Inputs, const CgleMesh &Mesh);
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the name of the file that the mesh built from the given inputs is
+/// kept in; see CgleMeshFileHeader.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	std::string GetPath(const std::vector<double> &Inputs) const;
+
+	const std::string &GetDirectory() const;
+
+	int GetHits() const;
+	int GetMisses() const;
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// <summary>Returns the version that cached meshes are keyed by. It changes whenever the
+/// geometry the library generates does.</summary>
+///
+/////////////////////////////////////////////////////////////////////////////////////
+	static const char *GetVersion();
+
+
+private:
+
+	std::string FDirectory;
+	std::atomic<int> FHits, FMisses;
+	std::atomic<unsigned> FSerial;	// names the temporary files
+
+	static uint64_t Hash(const void *Data, size_t Size, uint64_t Seed);
+	static uint64_t VersionHash();
+	static uint64_t Key(const std::vector<double> &Inputs);
+
+};
+//----------------------------------------------------------------------------
@@ -24,23 +24,41 @@ public:
 	CgleSimpleBeam(int Points, double Radius);
 	virtual ~CgleSimpleBeam();
 
+	CgleSimpleBeam(CgleSimpleBeam &&Other) = default;
+	CgleSimpleBeam &operator=(CgleSimpleBeam &&Other) = default;
+
 
 	using CgleIBeam::UseLitMaterial;
 	using CgleIBeam::IsUsingLitMaterial;
 
 	using CgleIBeam::LoadUpVector;
 
+	using CgleIBeam::Invalidate;
+	using CgleIBeam::DiscardBuild;
+	using CgleIBeam::IsBuilt;
+	using CgleIBeam::GetMesh;
+	using CgleIBeam::GetMappedMesh;
+	using CgleIBeam::GetSegments;
+	using CgleIBeam::SetSegmentSink;
+	using CgleIBeam::TakeMesh;
+	using CgleIBeam::UseMeshCache;
+	using CgleIBeam::GetMeshCache;
+
 
 
 	void Draw(float Color_Array[][3], double Length, bool bTextured = false);
 
+	void Build(float Color_Array[][3], double Length, bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		float Color_Array[][3], double Length, bool bTextured = false);
+
 	void WireDraw(float Color_Array[][3], double Length, bool bTextured = false);
 
 
 private:
 
 	int FPoints;
-	gleVector *FSpinePoints;
 
 };
 //----------------------------------------------------------------------------
@@ -23,6 +23,9 @@ public:
 	CgleSimpleTwistedBeam(int Points, double Radius);
 	virtual ~CgleSimpleTwistedBeam();
 
+	CgleSimpleTwistedBeam(CgleSimpleTwistedBeam &&Other) = default;
+	CgleSimpleTwistedBeam &operator=(CgleSimpleTwistedBeam &&Other) = default;
+
 
 
 	using CgleTwistedIBeam::UseLitMaterial;
@@ -30,11 +33,29 @@ public:
 
 	using CgleTwistedIBeam::LoadUpVector;
 
+	using CgleTwistedIBeam::Invalidate;
+	using CgleTwistedIBeam::DiscardBuild;
+	using CgleTwistedIBeam::IsBuilt;
+	using CgleTwistedIBeam::GetMesh;
+	using CgleTwistedIBeam::GetMappedMesh;
+	using CgleTwistedIBeam::GetSegments;
+	using CgleTwistedIBeam::SetSegmentSink;
+	using CgleTwistedIBeam::TakeMesh;
+	using CgleTwistedIBeam::UseMeshCache;
+	using CgleTwistedIBeam::GetMeshCache;
+
 
 
 	void   Draw(float Color_Array[][3], double Twist_Array[],
 					double Length, bool bTextured = false);
 
+	void   Build(float Color_Array[][3], double Twist_Array[],
+					double Length, bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		float Color_Array[][3], double Twist_Array[], double Length,
+		bool bTextured = false);
+
 	void   WireDraw(float Color_Array[][3], double Twist_Array[],
 					double Length, bool bTextured = false);
 
@@ -42,6 +63,5 @@ public:
 private:
 
 	int m_iPrivatePoints;
-	gleVector *FSpinePoints;
 };
 //----------------------------------------------------------------------------
@@ -24,6 +24,9 @@ public:
 
 	virtual ~CgleSpiralExtrusion();
 
+	CgleSpiralExtrusion(CgleSpiralExtrusion &&Other);
+	CgleSpiralExtrusion &operator=(CgleSpiralExtrusion &&Other);
+
 
 	using CgleBaseExtrusion::LoadContourPoint;	// redeclare as public
 
@@ -35,6 +38,14 @@ public:
 							double dZdTheta, double StartTheta,
 							float Color_Array[][3], bool bTextured = false);
 
+	void Build(double StartRadius, double dRadiusdTheta, double StartZ,
+							double dZdTheta, double StartTheta,
+							float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool, double StartRadius,
+		double dRadiusdTheta, double StartZ, double dZdTheta, double StartTheta,
+		float Color_Array[][3], bool bTextured = false);
+
 	virtual void WireDraw(double StartRadius, double dRadiusdTheta, double StartZ,
 							double dZdTheta, double StartTheta,
 							float Color_Array[][3], bool bTextured = false);
@@ -49,5 +60,7 @@ protected:
 	double FDeltaAngle, FSweep;
 	double FStartXForm[2][3];
 
+	void  LoadTForm(double dXFormdTheta[2][3]);
+
 };
 //----------------------------------------------------------------------------
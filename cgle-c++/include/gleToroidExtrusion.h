@@ -23,6 +23,9 @@ public:
 
 	virtual ~CgleToroidExtrusion();
 
+	CgleToroidExtrusion(CgleToroidExtrusion &&Other) = default;
+	CgleToroidExtrusion &operator=(CgleToroidExtrusion &&Other) = default;
+
 
 	using CgleLatheExtrusion::SetExtrusionMode;   	// redeclare as public
 	using CgleLatheExtrusion::GetExtrusionMode;
@@ -35,6 +38,19 @@ public:
 
 	using CgleLatheExtrusion::LoadUpVector;
 
+	using CgleLatheExtrusion::SetTForm;		// dXFormdTheta
+
+	using CgleLatheExtrusion::Invalidate;
+	using CgleLatheExtrusion::DiscardBuild;
+	using CgleLatheExtrusion::IsBuilt;
+	using CgleLatheExtrusion::GetMesh;
+	using CgleLatheExtrusion::GetMappedMesh;
+	using CgleLatheExtrusion::GetSegments;
+	using CgleLatheExtrusion::SetSegmentSink;
+	using CgleLatheExtrusion::TakeMesh;
+	using CgleLatheExtrusion::UseMeshCache;
+	using CgleLatheExtrusion::GetMeshCache;
+
 
 
 	void   Draw(double CrossSectionRadius, double StartRadius,
@@ -42,6 +58,16 @@ public:
 							double dZdTheta, double StartTheta,
 							float Color_Array[][3], bool bTextured = false);
 
+	void   Build(double CrossSectionRadius, double StartRadius,
+							double dRadiusdTheta, double StartZ,
+							double dZdTheta, double StartTheta,
+							float Color_Array[][3], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double CrossSectionRadius, double StartRadius, double dRadiusdTheta,
+		double StartZ, double dZdTheta, double StartTheta, float Color_Array[][3],
+		bool bTextured = false);
+
 	void   WireDraw(double CrossSectionRadius, double StartRadius,
 							double dRadiusdTheta, double StartZ,
 							double dZdTheta, double StartTheta,
@@ -24,13 +24,27 @@ public:
 	CgleTwistExtrusion(int Points, int ContourPoints, double Radius);
 	virtual ~CgleTwistExtrusion();
 
+	CgleTwistExtrusion(CgleTwistExtrusion &&Other) = default;
+	CgleTwistExtrusion &operator=(CgleTwistExtrusion &&Other) = default;
+
 
 	using CgleBaseExtrusion::LoadContourPoint;     	// redeclare as public
 
 
 	void Draw(double Point_Array[][3], float Color_Array[][3], double Twist_Array[], bool bTextured = false);
 
+	void Build(double Point_Array[][3], float Color_Array[][3], double Twist_Array[], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], double Twist_Array[],
+		bool bTextured = false);
+
 	void WireDraw(double Point_Array[][3], float Color_Array[][3], double Twist_Array[], bool bTextured = false);
 
+protected:
+
+	// turns the contour at each path point by its twist, in degrees
+	void LoadTwists(double Twist_Array[]);
+
 };
 //----------------------------------------------------------------------------
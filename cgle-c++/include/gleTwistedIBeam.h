@@ -23,6 +23,9 @@ public:
 	CgleTwistedIBeam(int Points, double Radius);
 	~CgleTwistedIBeam();
 
+	CgleTwistedIBeam(CgleTwistedIBeam &&Other) = default;
+	CgleTwistedIBeam &operator=(CgleTwistedIBeam &&Other) = default;
+
 
 
 	using CgleTwistExtrusion::UseLitMaterial;
@@ -30,11 +33,29 @@ public:
 
 	using CgleTwistExtrusion::LoadUpVector;
 
+	using CgleTwistExtrusion::Invalidate;
+	using CgleTwistExtrusion::DiscardBuild;
+	using CgleTwistExtrusion::IsBuilt;
+	using CgleTwistExtrusion::GetMesh;
+	using CgleTwistExtrusion::GetMappedMesh;
+	using CgleTwistExtrusion::GetSegments;
+	using CgleTwistExtrusion::SetSegmentSink;
+	using CgleTwistExtrusion::TakeMesh;
+	using CgleTwistExtrusion::UseMeshCache;
+	using CgleTwistExtrusion::GetMeshCache;
+
 
 
 	void  Draw(double Point_Array[][3], float Color_Array[][3],
 		double Twist_Array[], bool bTextured = false);
 
+	void  Build(double Point_Array[][3], float Color_Array[][3],
+		double Twist_Array[], bool bTextured = false);
+
+	std::future<const CgleMesh &> BuildAsync(CgleThreadPool &Pool,
+		double Point_Array[][3], float Color_Array[][3], double Twist_Array[],
+		bool bTextured = false);
+
 
 	void  WireDraw(double Point_Array[][3], float Color_Array[][3],
 		double Twist_Array[], bool bTextured = false);
@@ -0,0 +1,82 @@
+
+/*
+ * animated helicoid demo
+ *
+ * FUNCTION:
+ * The helicoid of helix.c, stretching and relaxing like a spring.
+ * Its shape changes every frame, so it is regenerated every frame;
+ * here that is done by the C++ class library, on a thread of its own,
+ * a frame ahead of the one being drawn (see CgleAnimatedMesh), so
+ * that the display callback only draws.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * other demos; see COPYING in the top directory.
+ */
+
+/* required include files */
+#include <math.h>
+#include <stdlib.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <GL/glut.h>
+#include "ExtrusionLib.h"
+
+extern "C" {
+#include "main.h"
+}
+
+/* the number of path points gleHelicoid would use for 1080 degrees at
+ * 20 sides */
+#define NUM_SIDES 20
+#define SWEEP 1080.0
+#define NUM_PTS ((int) (NUM_SIDES * SWEEP / 360.0) + 4)
+
+static CgleAnimatedMesh *spring = 0x0;
+
+/* called on the worker thread; builds, but doesn't draw */
+static void BuildSpring (int frame, CgleMesh &mesh) {
+   CgleHelicoidExtrusion helix (NUM_PTS, NULL, SWEEP, NUM_SIDES);
+   double dzdtheta;
+
+   dzdtheta = 4.0 + 2.5 * sin (0.05 * frame);
+
+   helix.SetExtrusionMode (GLE_NORM_EDGE | GLE_JN_ANGLE | GLE_JN_CAP);
+   helix.Build (1.0, 6.0, 2.0, -3.0 * dzdtheta / 4.0, dzdtheta, 0.0, NULL);
+   mesh = helix.TakeMesh ();
+}
+
+static void Animate (void) {
+   glutPostRedisplay ();
+}
+
+void InitStuff (void) {
+   lastx = 121.0;
+   lasty = 121.0;
+
+   InitializeExtrusionLib ();
+   spring = new CgleAnimatedMesh (BuildSpring);
+   glutIdleFunc (Animate);
+}
+
+/* draw the helix shape */
+void DrawStuff (void) {
+
+   glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+   glColor3f (0.6, 0.8, 0.3);
+
+   /* set up some matrices so that the object spins with the mouse */
+   glPushMatrix ();
+   glTranslatef (0.0, 0.0, -80.0);
+   glRotatef (lastx, 0.0, 1.0, 0.0);
+   glRotatef (lasty, 1.0, 0.0, 0.0);
+
+   /* the latest frame the worker has finished */
+   spring->Draw (false);
+
+   glPopMatrix ();
+
+   glutSwapBuffers ();
+}
+
+/* ------------------------- end of file ----------------- */
@@ -112,10 +112,18 @@ SOURCE=..\..\src\ex_cut_round.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\ex_float.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\ex_raw.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\ex_stride.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\extrude.c
 # End Source File
 # Begin Source File
@@ -124,10 +132,18 @@ SOURCE=..\..\src\intersect.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\path.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\qmesh.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\ring.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\rot_prince.c
 # End Source File
 # Begin Source File
@@ -144,10 +160,22 @@ SOURCE=..\..\src\segment.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\stats.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\src\sweep.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\texgen.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\trace.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\urotate.c
 # End Source File
 # Begin Source File
@@ -188,6 +216,10 @@ SOURCE=..\..\src\segment.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\trace.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\tube_gc.h
 # End Source File
 # Begin Source File
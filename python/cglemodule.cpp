@@ -0,0 +1,1257 @@
+/*
+ * cglemodule.cpp
+ *
+ * Python bindings for the GLE32 extrusion classes (cgle-c++).
+ *
+ * The arrays are taken through the buffer protocol, so that anything
+ * C-contiguous will do: NumPy arrays, array.array, memoryviews, ... .
+ * Where an array is already of the type the classes compute in (double
+ * for points, radii, twists and transforms; float for colors) it is used
+ * where it lies; otherwise it is converted, once, into a scratch array.
+ *
+ * The geometry is generated the way CgleBaseExtrusion::Build generates it,
+ * into a CgleMesh, so that no GL context is needed.  The mesh is then
+ * handed to Python whole, and its arrays exported, again through the
+ * buffer protocol, as NumPy arrays that look into it.
+ *
+ * See README in this directory.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <gl/gl.h>
+#include <gl/glu.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+
+#include <limits.h>
+#include <string.h>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ExtrusionLib.h"
+
+/* As many sides as the tube is ever drawn with; beyond that, it is a mistake. */
+#define MAX_SIDES 4096
+
+/* ====================================================== */
+/* Input arrays */
+
+/*
+ * An array argument, held for as long as the call needs it.  Only
+ * float64 and float32 of the native byte order are taken.
+ */
+class gleArrayArg
+{
+
+public:
+
+	gleArrayArg() { held = false; }
+	~gleArrayArg() { if (held) PyBuffer_Release(&view); }
+
+	gleArrayArg(const gleArrayArg &) = delete;
+	gleArrayArg &operator=(const gleArrayArg &) = delete;
+
+	/* Width is the number of values per element: 3 for a point. */
+	bool Get(PyObject *obj, const char *name, int width);
+
+	Py_ssize_t Count() const { return(count); }
+
+	const double *Doubles();
+	const float *Floats();
+
+private:
+
+	Py_buffer view;
+	bool held;
+	Py_ssize_t itemsize, count;
+
+	std::vector<double> dcopy;
+	std::vector<float> fcopy;
+
+};
+
+bool gleArrayArg::Get(PyObject *obj, const char *name, int width)
+{
+	const char *fmt;
+
+	if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+	{
+		PyErr_Format(PyExc_TypeError,
+			"%s must be a C-contiguous array of float64 or float32", name);
+		return(false);
+	}
+	held = true;
+
+	fmt = (view.format != NULL) ? view.format : "B";
+	if ((*fmt == '@') || (*fmt == '='))
+		fmt++;
+#if PY_LITTLE_ENDIAN
+	else if (*fmt == '<')
+		fmt++;
+#else
+	else if (*fmt == '>')
+		fmt++;
+#endif
+
+	if (((strcmp(fmt, "d") != 0) || (view.itemsize != 8)) &&
+		((strcmp(fmt, "f") != 0) || (view.itemsize != 4)))
+	{
+		PyErr_Format(PyExc_TypeError,
+			"%s must be float64 or float32, not format '%s'", name, view.format);
+		return(false);
+	}
+
+	itemsize = view.itemsize;
+	count = view.len / itemsize;
+
+	if ((count == 0) || (count % width != 0))
+	{
+		PyErr_Format(PyExc_ValueError,
+			"%s must hold a whole, non-zero number of %d-vectors", name, width);
+		return(false);
+	}
+	count /= width;
+
+	return(true);
+}
+
+const double *gleArrayArg::Doubles()
+{
+	if (itemsize == 8)
+		return((const double *)view.buf);
+
+	const float *src = (const float *)view.buf;
+	dcopy.assign(src, src + view.len / 4);
+	return(&dcopy[0]);
+}
+
+const float *gleArrayArg::Floats()
+{
+	if (itemsize == 4)
+		return((const float *)view.buf);
+
+	const double *src = (const double *)view.buf;
+	fcopy.resize(view.len / 8);
+	for (size_t i = 0; i < fcopy.size(); i++)
+		fcopy[i] = (float)src[i];
+	return(&fcopy[0]);
+}
+
+/*
+ * An optional argument: fetched only if given, and not None.
+ */
+static bool
+get_optional (gleArrayArg &arg, PyObject *obj, const char *name, int width)
+{
+	if ((obj == NULL) || (obj == Py_None))
+		return(true);
+	return(arg.Get(obj, name, width));
+}
+
+static bool
+check_count (const gleArrayArg &arg, PyObject *obj, const char *name, Py_ssize_t npoints)
+{
+	if ((obj == NULL) || (obj == Py_None) || (arg.Count() == npoints))
+		return(true);
+
+	PyErr_Format(PyExc_ValueError, "%s has %zd entries, but there are %zd points",
+		name, arg.Count(), npoints);
+	return(false);
+}
+
+/*
+ * The classes count points, contour points and sides in ints, and size
+ * their arrays by the product of the points and the sides.
+ */
+static bool
+check_size (Py_ssize_t npoints, Py_ssize_t nsides, const char *sides)
+{
+	if ((npoints > INT_MAX) || (nsides > INT_MAX) ||
+		((nsides > 0) && (npoints > INT_MAX / 2 / nsides)))
+	{
+		PyErr_Format(PyExc_ValueError, "%zd points of %zd %s is too many",
+			npoints, nsides, sides);
+		return(false);
+	}
+	return(true);
+}
+
+/* ====================================================== */
+/* Output arrays */
+
+/*
+ * One array of a mesh, exported read only through the buffer protocol.
+ * It keeps the mesh alive.
+ */
+typedef struct {
+	PyObject_HEAD
+	PyObject *owner;
+	const void *data;
+	int ndim;
+	Py_ssize_t shape[2];
+	Py_ssize_t strides[2];
+	Py_ssize_t itemsize;
+	char format[2];
+} gleArrayObject;
+
+static int
+array_getbuffer (gleArrayObject *self, Py_buffer *view, int flags)
+{
+	static float empty;
+
+	if (flags & PyBUF_WRITABLE)
+	{
+		PyErr_SetString(PyExc_BufferError, "mesh arrays are read only");
+		view->obj = NULL;
+		return(-1);
+	}
+
+	view->obj = (PyObject *)self;
+	Py_INCREF(self);
+
+	view->buf = (self->data != NULL) ? (void *)self->data : (void *)&empty;
+	view->len = self->shape[0] * self->shape[1] * self->itemsize;
+	view->readonly = 1;
+	view->itemsize = self->itemsize;
+	view->format = (flags & PyBUF_FORMAT) ? self->format : NULL;
+	view->ndim = self->ndim;
+	view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+	view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+	return(0);
+}
+
+static void
+array_dealloc (gleArrayObject *self)
+{
+	Py_XDECREF(self->owner);
+	Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyBufferProcs array_as_buffer = {
+	(getbufferproc)array_getbuffer,
+	NULL,
+};
+
+static PyTypeObject gleArrayType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"cgle.MeshArray",			/* tp_name */
+	sizeof(gleArrayObject),		/* tp_basicsize */
+};
+
+/*
+ * numpy.asarray, if NumPy is there; otherwise a memoryview.
+ */
+static PyObject *
+as_ndarray (PyObject *exporter)
+{
+	static PyObject *asarray = NULL;
+	static bool looked = false;
+
+	if (!looked)
+	{
+		PyObject *numpy = PyImport_ImportModule("numpy");
+
+		looked = true;
+		if (numpy != NULL)
+		{
+			asarray = PyObject_GetAttrString(numpy, "asarray");
+			Py_DECREF(numpy);
+		}
+		PyErr_Clear();
+	}
+
+	if (asarray != NULL)
+		return(PyObject_CallFunctionObjArgs(asarray, exporter, NULL));
+	return(PyMemoryView_FromObject(exporter));
+}
+
+/* cols of 0 for a one dimensional array */
+static PyObject *
+new_array (PyObject *owner, const void *data, Py_ssize_t rows, Py_ssize_t cols,
+	char format, Py_ssize_t itemsize)
+{
+	gleArrayObject *arr;
+	PyObject *result;
+
+	arr = PyObject_New(gleArrayObject, &gleArrayType);
+	if (arr == NULL)
+		return(NULL);
+
+	Py_INCREF(owner);
+	arr->owner = owner;
+	arr->data = data;
+	arr->ndim = (cols > 0) ? 2 : 1;
+	if (cols == 0)
+		cols = 1;
+	arr->shape[0] = rows;
+	arr->shape[1] = cols;
+	arr->strides[0] = cols * itemsize;
+	arr->strides[1] = itemsize;
+	arr->itemsize = itemsize;
+	arr->format[0] = format;
+	arr->format[1] = '\0';
+
+	result = as_ndarray((PyObject *)arr);
+	Py_DECREF(arr);
+	return(result);
+}
+
+/* ====================================================== */
+/* Meshes */
+
+typedef struct {
+	PyObject_HEAD
+	CgleMesh *mesh;
+	std::vector<long long> *offsets;	/* of a batch: vertices, then triangles */
+} gleMeshObject;
+
+static void
+mesh_dealloc (gleMeshObject *self)
+{
+	delete self->mesh;
+	delete self->offsets;
+	Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+mesh_positions (gleMeshObject *self, void *)
+{
+	return(new_array((PyObject *)self, self->mesh->GetVertices(),
+		self->mesh->GetVertexCount(), 3, 'f', 4));
+}
+
+static PyObject *
+mesh_normals (gleMeshObject *self, void *)
+{
+	if (self->mesh->GetNormals() == NULL)
+		Py_RETURN_NONE;
+	return(new_array((PyObject *)self, self->mesh->GetNormals(),
+		self->mesh->GetVertexCount(), 3, 'f', 4));
+}
+
+static PyObject *
+mesh_colors (gleMeshObject *self, void *)
+{
+	if (self->mesh->GetColors() == NULL)
+		Py_RETURN_NONE;
+	return(new_array((PyObject *)self, self->mesh->GetColors(),
+		self->mesh->GetVertexCount(), 3, 'f', 4));
+}
+
+static PyObject *
+mesh_texcoords (gleMeshObject *self, void *)
+{
+	if (self->mesh->GetTexCoords() == NULL)
+		Py_RETURN_NONE;
+	return(new_array((PyObject *)self, self->mesh->GetTexCoords(),
+		self->mesh->GetVertexCount(), 2, 'f', 4));
+}
+
+static PyObject *
+mesh_indices (gleMeshObject *self, void *)
+{
+	return(new_array((PyObject *)self, self->mesh->GetIndices(),
+		self->mesh->GetIndexCount() / 3, 3, 'I', sizeof(GLuint)));
+}
+
+/*
+ * Where each path's vertices and triangles start, in a mesh made by one of
+ * the batch functions; there is one more entry than there are paths.
+ */
+static PyObject *
+mesh_vertex_offsets (gleMeshObject *self, void *)
+{
+	if (self->offsets == NULL)
+		Py_RETURN_NONE;
+	return(new_array((PyObject *)self, &(*self->offsets)[0],
+		self->offsets->size() / 2, 0, 'q', sizeof(long long)));
+}
+
+static PyObject *
+mesh_triangle_offsets (gleMeshObject *self, void *)
+{
+	if (self->offsets == NULL)
+		Py_RETURN_NONE;
+	return(new_array((PyObject *)self, &(*self->offsets)[self->offsets->size() / 2],
+		self->offsets->size() / 2, 0, 'q', sizeof(long long)));
+}
+
+static PyGetSetDef mesh_getset[] = {
+	{ (char *)"positions", (getter)mesh_positions, NULL,
+		(char *)"float32 array of shape (vertices, 3)", NULL },
+	{ (char *)"normals", (getter)mesh_normals, NULL,
+		(char *)"float32 array of shape (vertices, 3), or None", NULL },
+	{ (char *)"colors", (getter)mesh_colors, NULL,
+		(char *)"float32 array of shape (vertices, 3), or None", NULL },
+	{ (char *)"texcoords", (getter)mesh_texcoords, NULL,
+		(char *)"float32 array of shape (vertices, 2), or None", NULL },
+	{ (char *)"indices", (getter)mesh_indices, NULL,
+		(char *)"uint32 array of shape (triangles, 3)", NULL },
+	{ (char *)"vertex_offsets", (getter)mesh_vertex_offsets, NULL,
+		(char *)"int64 array of paths + 1 vertex offsets, for a batch; else None", NULL },
+	{ (char *)"triangle_offsets", (getter)mesh_triangle_offsets, NULL,
+		(char *)"int64 array of paths + 1 triangle offsets, for a batch; else None", NULL },
+	{ NULL }
+};
+
+static PyTypeObject gleMeshType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"cgle.Mesh",				/* tp_name */
+	sizeof(gleMeshObject),		/* tp_basicsize */
+};
+
+/*
+ * Takes the geometry an object has just built.
+ */
+static PyObject *
+new_mesh (CgleMesh &&mesh)
+{
+	gleMeshObject *obj;
+
+	obj = PyObject_New(gleMeshObject, &gleMeshType);
+	if (obj == NULL)
+		return(NULL);
+
+	obj->offsets = NULL;
+	obj->mesh = new (std::nothrow) CgleMesh(std::move(mesh));
+	if (obj->mesh == NULL)
+	{
+		Py_DECREF(obj);
+		return(PyErr_NoMemory());
+	}
+	return((PyObject *)obj);
+}
+
+/*
+ * Builds one mesh, as Build() gives it, turning what the classes throw
+ * into Python's exceptions, as run_batch does.
+ */
+template <class Builder> static PyObject *
+run_single (const Builder &build)
+{
+	try
+	{
+		return(new_mesh(build()));
+	}
+	catch (std::bad_alloc &)
+	{
+		return(PyErr_NoMemory());
+	}
+	catch (std::exception &e)
+	{
+		PyErr_SetString(PyExc_RuntimeError, e.what());
+		return(NULL);
+	}
+}
+
+/* ====================================================== */
+/* The extrusions */
+
+/*
+ * Style, texture mode and up vector, as every function takes them.  They
+ * are read while the interpreter lock is held, and applied, perhaps on a
+ * worker thread, with apply_options.
+ */
+struct gleOptions
+{
+	int style;
+	int texture;		/* 0 for none, otherwise as in gle.h */
+	bool has_up;
+	double up[3];
+};
+
+static bool
+get_options (gleOptions &opts, int style, int texture, PyObject *upobj)
+{
+	if ((texture < 0) || (texture > (int)gleTexMode::GLE_TEXTURE_NORMAL_MODEL_SPH + 1))
+	{
+		PyErr_SetString(PyExc_ValueError, "unknown texture mode");
+		return(false);
+	}
+
+	opts.style = style;
+	opts.texture = texture;
+	opts.has_up = ((upobj != NULL) && (upobj != Py_None));
+
+	if (opts.has_up)
+	{
+		gleArrayArg up;
+
+		if (!up.Get(upobj, "up", 3))
+			return(false);
+		memcpy(opts.up, up.Doubles(), sizeof(opts.up));
+	}
+	return(true);
+}
+
+/* The classes are templated over, as not all of them show their base class. */
+template <class Extrusion> static void
+apply_options (Extrusion &obj, const gleOptions &opts)
+{
+	double up[3];
+
+	if (opts.style >= 0)
+		obj.SetExtrusionMode(opts.style);
+
+	if (opts.texture > 0)
+		obj.SetTextureMode((gleTexMode)(opts.texture - 1));
+
+	if (opts.has_up)
+	{
+		memcpy(up, opts.up, sizeof(up));
+		obj.LoadUpVector(up);
+	}
+}
+
+template <class Extrusion> static void
+load_contour (Extrusion &obj, const double *contour, Py_ssize_t count)
+{
+	for (Py_ssize_t i = 0; i < count; i++)
+		obj.LoadContourPoint((int)i, contour[2*i], contour[2*i+1]);
+}
+
+static const char extrusion_doc[] =
+"extrusion(contour, points, colors=None, xforms=None, up=None,\n"
+"          style=-1, texture=0, radius=1.0) -> Mesh\n\n"
+"Sweeps the (n, 2) contour along the (m, 3) points.  colors is (m, 3),\n"
+"xforms (m, 2, 3).  style is an OR of the JN_, NORM_ and CONTOUR_ flags;\n"
+"texture one of the TEXTURE_ modes, or 0 for none.";
+
+static PyObject *
+cgle_extrusion (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "contour", "points", "colors", "xforms", "up",
+		"style", "texture", "radius", NULL };
+	PyObject *cobj, *pobj, *colobj = NULL, *xobj = NULL, *upobj = NULL;
+	int style = -1, texture = 0;
+	double radius = 1.0;
+	gleArrayArg contour, points, colors, xforms;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOOiid", (char **)kwlist,
+			&cobj, &pobj, &colobj, &xobj, &upobj, &style, &texture, &radius))
+		return(NULL);
+
+	if (!contour.Get(cobj, "contour", 2) || !points.Get(pobj, "points", 3) ||
+		!get_optional(colors, colobj, "colors", 3) ||
+		!get_optional(xforms, xobj, "xforms", 6) ||
+		!check_count(colors, colobj, "colors", points.Count()) ||
+		!check_count(xforms, xobj, "xforms", points.Count()) ||
+		!get_options(opts, style, texture, upobj) ||
+		!check_size(points.Count(), contour.Count(), "contour points"))
+		return(NULL);
+
+	return(run_single([&]() -> CgleMesh
+	{
+		CgleExtrusion obj((int)points.Count(), (int)contour.Count(), radius);
+
+		apply_options(obj, opts);
+		load_contour(obj, contour.Doubles(), contour.Count());
+
+		if ((xobj != NULL) && (xobj != Py_None))
+			obj.SetTForm((double *(*)[2][3])xforms.Doubles());
+
+		obj.Build((double (*)[3])points.Doubles(),
+			((colobj != NULL) && (colobj != Py_None)) ? (float (*)[3])colors.Floats() : NULL,
+			opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+static const char twist_extrusion_doc[] =
+"twist_extrusion(contour, points, twists, colors=None, up=None,\n"
+"                style=-1, texture=0, radius=1.0) -> Mesh\n\n"
+"As extrusion, with the contour turned twists[i] degrees at point i.";
+
+static PyObject *
+cgle_twist_extrusion (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "contour", "points", "twists", "colors", "up",
+		"style", "texture", "radius", NULL };
+	PyObject *cobj, *pobj, *tobj, *colobj = NULL, *upobj = NULL;
+	int style = -1, texture = 0;
+	double radius = 1.0;
+	gleArrayArg contour, points, twists, colors;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|OOiid", (char **)kwlist,
+			&cobj, &pobj, &tobj, &colobj, &upobj, &style, &texture, &radius))
+		return(NULL);
+
+	if (!contour.Get(cobj, "contour", 2) || !points.Get(pobj, "points", 3) ||
+		!twists.Get(tobj, "twists", 1) ||
+		!get_optional(colors, colobj, "colors", 3) ||
+		!check_count(twists, tobj, "twists", points.Count()) ||
+		!check_count(colors, colobj, "colors", points.Count()) ||
+		!get_options(opts, style, texture, upobj) ||
+		!check_size(points.Count(), contour.Count(), "contour points"))
+		return(NULL);
+
+	return(run_single([&]() -> CgleMesh
+	{
+		CgleTwistExtrusion obj((int)points.Count(), (int)contour.Count(), radius);
+
+		apply_options(obj, opts);
+		load_contour(obj, contour.Doubles(), contour.Count());
+
+		obj.Build((double (*)[3])points.Doubles(),
+			((colobj != NULL) && (colobj != Py_None)) ? (float (*)[3])colors.Floats() : NULL,
+			(double *)twists.Doubles(), opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+static const char polycone_doc[] =
+"polycone(points, radii, colors=None, sides=20, up=None,\n"
+"         style=-1, texture=0) -> Mesh\n\n"
+"A tube along the (m, 3) points, of radius radii[i] at point i.";
+
+static PyObject *
+cgle_polycone (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "points", "radii", "colors", "sides", "up",
+		"style", "texture", NULL };
+	PyObject *pobj, *robj, *colobj = NULL, *upobj = NULL;
+	int sides = 20, style = -1, texture = 0;
+	gleArrayArg points, radii, colors;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OiOii", (char **)kwlist,
+			&pobj, &robj, &colobj, &sides, &upobj, &style, &texture))
+		return(NULL);
+
+	if (!points.Get(pobj, "points", 3) || !radii.Get(robj, "radii", 1) ||
+		!get_optional(colors, colobj, "colors", 3) ||
+		!check_count(radii, robj, "radii", points.Count()) ||
+		!check_count(colors, colobj, "colors", points.Count()) ||
+		!get_options(opts, style, texture, upobj))
+		return(NULL);
+
+	if ((sides < 3) || (sides > MAX_SIDES))
+	{
+		PyErr_Format(PyExc_ValueError, "a polycone needs from 3 to %d sides", MAX_SIDES);
+		return(NULL);
+	}
+	if (!check_size(points.Count(), sides, "sides"))
+		return(NULL);
+
+	return(run_single([&]() -> CgleMesh
+	{
+		CgleConeExtrusion obj((int)points.Count(), sides);
+
+		apply_options(obj, opts);
+
+		obj.Build((double (*)[3])points.Doubles(),
+			((colobj != NULL) && (colobj != Py_None)) ? (float (*)[3])colors.Floats() : NULL,
+			(double *)radii.Doubles(), opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+static const char polycylinder_doc[] =
+"polycylinder(points, radius, colors=None, sides=20, up=None,\n"
+"             style=-1, texture=0) -> Mesh\n\n"
+"A tube of the given radius along the (m, 3) points.";
+
+static PyObject *
+cgle_polycylinder (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "points", "radius", "colors", "sides", "up",
+		"style", "texture", NULL };
+	PyObject *pobj, *colobj = NULL, *upobj = NULL;
+	double radius;
+	int sides = 20, style = -1, texture = 0;
+	gleArrayArg points, colors;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "Od|OiOii", (char **)kwlist,
+			&pobj, &radius, &colobj, &sides, &upobj, &style, &texture))
+		return(NULL);
+
+	if (!points.Get(pobj, "points", 3) ||
+		!get_optional(colors, colobj, "colors", 3) ||
+		!check_count(colors, colobj, "colors", points.Count()) ||
+		!get_options(opts, style, texture, upobj))
+		return(NULL);
+
+	if ((sides < 3) || (sides > MAX_SIDES))
+	{
+		PyErr_Format(PyExc_ValueError, "a polycylinder needs from 3 to %d sides", MAX_SIDES);
+		return(NULL);
+	}
+	if (!check_size(points.Count(), sides, "sides"))
+		return(NULL);
+
+	return(run_single([&]() -> CgleMesh
+	{
+		CgleCylinderExtrusion obj((int)points.Count(), sides);
+
+		apply_options(obj, opts);
+
+		obj.Build((double (*)[3])points.Doubles(),
+			((colobj != NULL) && (colobj != Py_None)) ? (float (*)[3])colors.Floats() : NULL,
+			radius, opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+/* ====================================================== */
+/* Batches */
+
+/*
+ * A per-point argument given for many paths at once: either a list of
+ * arrays, one a path, or one array of all the paths end to end, cut up
+ * by the offsets.  Each path's values are made double or float, as the
+ * classes want them, while the interpreter lock is held.
+ */
+class gleRaggedArg
+{
+
+public:
+
+	bool Get(PyObject *obj, const char *name, int width, bool doubles,
+		const std::vector<Py_ssize_t> *offsets);
+
+	size_t Paths() const { return(count.size()); }
+	Py_ssize_t Count(size_t i) const { return(count[i]); }
+	const void *Data(size_t i) const { return(data[i]); }
+
+private:
+
+	std::vector<std::unique_ptr<gleArrayArg> > arrays;
+	std::vector<const void *> data;
+	std::vector<Py_ssize_t> count;
+
+};
+
+bool gleRaggedArg::Get(PyObject *obj, const char *name, int width, bool doubles,
+	const std::vector<Py_ssize_t> *offsets)
+{
+	if (offsets == NULL)
+	{
+		// an array's rows would pass for a list of one-point paths
+		PyObject *seq = PyObject_CheckBuffer(obj) ? NULL : PySequence_Fast(obj, "");
+
+		if (seq == NULL)
+		{
+			PyErr_Format(PyExc_TypeError,
+				"%s must be a list of arrays, unless offsets are given", name);
+			return(false);
+		}
+
+		for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); i++)
+		{
+			arrays.push_back(std::unique_ptr<gleArrayArg>(new gleArrayArg));
+			if (!arrays.back()->Get(PySequence_Fast_GET_ITEM(seq, i), name, width))
+			{
+				Py_DECREF(seq);
+				return(false);
+			}
+			data.push_back(doubles ? (const void *)arrays.back()->Doubles() :
+				(const void *)arrays.back()->Floats());
+			count.push_back(arrays.back()->Count());
+		}
+		Py_DECREF(seq);
+		return(true);
+	}
+
+	arrays.push_back(std::unique_ptr<gleArrayArg>(new gleArrayArg));
+	if (!arrays.back()->Get(obj, name, width))
+		return(false);
+
+	if (offsets->back() > arrays.back()->Count())
+	{
+		PyErr_Format(PyExc_ValueError, "the offsets run past the end of %s", name);
+		return(false);
+	}
+
+	size_t size = doubles ? sizeof(double) : sizeof(float);
+	const char *base = doubles ? (const char *)arrays.back()->Doubles() :
+		(const char *)arrays.back()->Floats();
+
+	for (size_t i = 0; i + 1 < offsets->size(); i++)
+	{
+		data.push_back(base + (*offsets)[i] * width * size);
+		count.push_back((*offsets)[i+1] - (*offsets)[i]);
+	}
+	return(true);
+}
+
+static bool
+get_offsets (std::vector<Py_ssize_t> &offsets, PyObject *obj)
+{
+	PyObject *seq = PySequence_Fast(obj, "offsets must be a sequence of integers");
+
+	if (seq == NULL)
+		return(false);
+
+	for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); i++)
+	{
+		Py_ssize_t off = PyNumber_AsSsize_t(PySequence_Fast_GET_ITEM(seq, i), NULL);
+
+		if ((off == -1) && PyErr_Occurred())
+			break;
+		if ((off < 0) || (!offsets.empty() && (off < offsets.back())))
+		{
+			PyErr_SetString(PyExc_ValueError, "offsets must not go down, nor below 0");
+			break;
+		}
+		offsets.push_back(off);
+	}
+	Py_DECREF(seq);
+
+	if (PyErr_Occurred())
+		return(false);
+	if (offsets.size() < 2)
+	{
+		PyErr_SetString(PyExc_ValueError, "offsets needs an entry per path, and one more");
+		return(false);
+	}
+	return(true);
+}
+
+/*
+ * Every path must have the same number of values in each argument.
+ */
+static bool
+check_paths (const gleRaggedArg &arg, PyObject *obj, const char *name,
+	const gleRaggedArg &points)
+{
+	if ((obj == NULL) || (obj == Py_None))
+		return(true);
+
+	if (arg.Paths() != points.Paths())
+	{
+		PyErr_Format(PyExc_ValueError, "%s has %zd paths, but there are %zd",
+			name, (Py_ssize_t)arg.Paths(), (Py_ssize_t)points.Paths());
+		return(false);
+	}
+
+	for (size_t i = 0; i < points.Paths(); i++)
+	{
+		if (arg.Count(i) != points.Count(i))
+		{
+			PyErr_Format(PyExc_ValueError, "path %zd has %zd %s, but %zd points",
+				(Py_ssize_t)i, arg.Count(i), name, points.Count(i));
+			return(false);
+		}
+	}
+	return(true);
+}
+
+static bool
+check_sizes (const gleRaggedArg &points, Py_ssize_t nsides, const char *sides)
+{
+	for (size_t i = 0; i < points.Paths(); i++)
+		if (!check_size(points.Count(i), nsides, sides))
+			return(false);
+	return(true);
+}
+
+/*
+ * A per-path value: one number for all of them, or a sequence of one a path.
+ */
+static bool
+get_per_path (std::vector<double> &values, PyObject *obj, const char *name,
+	size_t paths)
+{
+	if (PyNumber_Check(obj) && !PySequence_Check(obj))
+	{
+		double v = PyFloat_AsDouble(obj);
+
+		if ((v == -1.0) && PyErr_Occurred())
+			return(false);
+		values.assign(paths, v);
+		return(true);
+	}
+
+	PyObject *seq = PySequence_Fast(obj, "");
+
+	if (seq == NULL)
+	{
+		PyErr_Format(PyExc_TypeError, "%s must be a number, or a sequence of them", name);
+		return(false);
+	}
+	if ((size_t)PySequence_Fast_GET_SIZE(seq) != paths)
+	{
+		PyErr_Format(PyExc_ValueError, "%s has %zd entries, but there are %zd paths",
+			name, PySequence_Fast_GET_SIZE(seq), (Py_ssize_t)paths);
+		Py_DECREF(seq);
+		return(false);
+	}
+	for (size_t i = 0; i < paths; i++)
+	{
+		values.push_back(PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i)));
+		if ((values.back() == -1.0) && PyErr_Occurred())
+			break;
+	}
+	Py_DECREF(seq);
+	return(!PyErr_Occurred());
+}
+
+/*
+ * Builds each path's mesh on a pool of threads, with the interpreter lock
+ * released, and joins them into one Mesh.  Build(i) gives path i's mesh;
+ * it runs on a worker, and so mustn't touch anything of Python's.  Threads
+ * of 0 uses the library's shared pool.
+ */
+template <class Builder> static PyObject *
+run_batch (size_t paths, int threads, const Builder &build)
+{
+	std::vector<CgleMesh> meshes(paths);
+	std::unique_ptr<CgleMesh> joined;
+	std::unique_ptr<std::vector<long long> > offsets;
+	std::string error;
+	bool nomem = false;
+
+	Py_BEGIN_ALLOW_THREADS
+
+	try
+	{
+		std::unique_ptr<CgleThreadPool> own;
+		std::vector<std::future<void> > done;
+
+		if (threads > 0)
+			own.reset(new CgleThreadPool(threads));
+		CgleThreadPool &pool = own ? *own : CgleThreadPool::GetDefault();
+
+		for (size_t i = 0; i < paths; i++)
+		{
+			std::shared_ptr<std::packaged_task<void()> > task(
+				new std::packaged_task<void()>([&meshes, &build, i]()
+				{
+					meshes[i] = build(i);
+				}));
+			done.push_back(task->get_future());
+			pool.Submit([task]() { (*task)(); });
+		}
+
+		// every task must have finished before anything goes out of scope
+		for (size_t i = 0; i < paths; i++)
+		{
+			try
+			{
+				done[i].get();
+			}
+			catch (std::bad_alloc &)
+			{
+				nomem = true;
+			}
+			catch (std::exception &e)
+			{
+				if (error.empty())
+					error = e.what();
+			}
+		}
+
+		if (!nomem && error.empty())
+		{
+			joined.reset(new CgleMesh);
+			offsets.reset(new std::vector<long long>(2 * (paths + 1)));
+
+			for (size_t i = 0; i < paths; i++)
+			{
+				(*offsets)[i] = joined->GetVertexCount();
+				(*offsets)[paths + 1 + i] = joined->GetIndexCount() / 3;
+				joined->Append(meshes[i]);
+				meshes[i] = CgleMesh();
+			}
+			(*offsets)[paths] = joined->GetVertexCount();
+			(*offsets)[2 * paths + 1] = joined->GetIndexCount() / 3;
+		}
+	}
+	catch (std::bad_alloc &)
+	{
+		nomem = true;
+	}
+
+	Py_END_ALLOW_THREADS
+
+	if (nomem)
+		return(PyErr_NoMemory());
+	if (!error.empty())
+	{
+		PyErr_SetString(PyExc_RuntimeError, error.c_str());
+		return(NULL);
+	}
+
+	PyObject *mesh = new_mesh(std::move(*joined));
+	if (mesh != NULL)
+		((gleMeshObject *)mesh)->offsets = offsets.release();
+	return(mesh);
+}
+
+static const char polycylinder_batch_doc[] =
+"polycylinder_batch(paths, radius, colors=None, offsets=None, sides=20,\n"
+"                   up=None, style=-1, texture=0, threads=0) -> Mesh\n\n"
+"polycylinder, for many paths at once, in parallel.  paths is a list of\n"
+"(m, 3) arrays, or, with offsets, one array of all of them end to end,\n"
+"path i being points[offsets[i]:offsets[i+1]].  colors goes the same way.\n"
+"radius is one for all the paths, or one a path.  The meshes are joined\n"
+"into one; see Mesh.vertex_offsets and Mesh.triangle_offsets.  threads of\n"
+"0 uses a shared pool of one thread a core.";
+
+static PyObject *
+cgle_polycylinder_batch (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "paths", "radius", "colors", "offsets", "sides",
+		"up", "style", "texture", "threads", NULL };
+	PyObject *pobj, *robj, *colobj = NULL, *offobj = NULL, *upobj = NULL;
+	int sides = 20, style = -1, texture = 0, threads = 0;
+	std::vector<Py_ssize_t> offsets;
+	gleRaggedArg points, colors;
+	std::vector<double> radius;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOiOiii", (char **)kwlist,
+			&pobj, &robj, &colobj, &offobj, &sides, &upobj, &style, &texture, &threads))
+		return(NULL);
+
+	bool has_offsets = ((offobj != NULL) && (offobj != Py_None));
+	bool has_colors = ((colobj != NULL) && (colobj != Py_None));
+
+	if ((has_offsets && !get_offsets(offsets, offobj)) ||
+		!points.Get(pobj, "paths", 3, true, has_offsets ? &offsets : NULL) ||
+		(has_colors && !colors.Get(colobj, "colors", 3, false, has_offsets ? &offsets : NULL)) ||
+		!check_paths(colors, colobj, "colors", points) ||
+		!get_per_path(radius, robj, "radius", points.Paths()) ||
+		!get_options(opts, style, texture, upobj))
+		return(NULL);
+
+	if ((sides < 3) || (sides > MAX_SIDES))
+	{
+		PyErr_Format(PyExc_ValueError, "a polycylinder needs from 3 to %d sides", MAX_SIDES);
+		return(NULL);
+	}
+	if (!check_sizes(points, sides, "sides"))
+		return(NULL);
+
+	return(run_batch(points.Paths(), threads, [&](size_t i) -> CgleMesh
+	{
+		CgleCylinderExtrusion obj((int)points.Count(i), sides);
+
+		apply_options(obj, opts);
+		obj.Build((double (*)[3])points.Data(i),
+			has_colors ? (float (*)[3])colors.Data(i) : NULL,
+			radius[i], opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+static const char polycone_batch_doc[] =
+"polycone_batch(paths, radii, colors=None, offsets=None, sides=20,\n"
+"               up=None, style=-1, texture=0, threads=0) -> Mesh\n\n"
+"polycone, for many paths at once; see polycylinder_batch.  radii goes\n"
+"as the paths do, with a radius a point.";
+
+static PyObject *
+cgle_polycone_batch (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "paths", "radii", "colors", "offsets", "sides",
+		"up", "style", "texture", "threads", NULL };
+	PyObject *pobj, *robj, *colobj = NULL, *offobj = NULL, *upobj = NULL;
+	int sides = 20, style = -1, texture = 0, threads = 0;
+	std::vector<Py_ssize_t> offsets;
+	gleRaggedArg points, radii, colors;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOiOiii", (char **)kwlist,
+			&pobj, &robj, &colobj, &offobj, &sides, &upobj, &style, &texture, &threads))
+		return(NULL);
+
+	bool has_offsets = ((offobj != NULL) && (offobj != Py_None));
+	bool has_colors = ((colobj != NULL) && (colobj != Py_None));
+
+	if ((has_offsets && !get_offsets(offsets, offobj)) ||
+		!points.Get(pobj, "paths", 3, true, has_offsets ? &offsets : NULL) ||
+		!radii.Get(robj, "radii", 1, true, has_offsets ? &offsets : NULL) ||
+		(has_colors && !colors.Get(colobj, "colors", 3, false, has_offsets ? &offsets : NULL)) ||
+		!check_paths(radii, robj, "radii", points) ||
+		!check_paths(colors, colobj, "colors", points) ||
+		!get_options(opts, style, texture, upobj))
+		return(NULL);
+
+	if ((sides < 3) || (sides > MAX_SIDES))
+	{
+		PyErr_Format(PyExc_ValueError, "a polycone needs from 3 to %d sides", MAX_SIDES);
+		return(NULL);
+	}
+	if (!check_sizes(points, sides, "sides"))
+		return(NULL);
+
+	return(run_batch(points.Paths(), threads, [&](size_t i) -> CgleMesh
+	{
+		CgleConeExtrusion obj((int)points.Count(i), sides);
+
+		apply_options(obj, opts);
+		obj.Build((double (*)[3])points.Data(i),
+			has_colors ? (float (*)[3])colors.Data(i) : NULL,
+			(double *)radii.Data(i), opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+static const char extrusion_batch_doc[] =
+"extrusion_batch(contour, paths, colors=None, offsets=None, twists=None,\n"
+"                up=None, style=-1, texture=0, radius=1.0, threads=0) -> Mesh\n\n"
+"extrusion, or with twists twist_extrusion, of the one contour along many\n"
+"paths at once; see polycylinder_batch.  twists goes as the paths do;\n"
+"radius is one for all the paths, or one a path.";
+
+static PyObject *
+cgle_extrusion_batch (PyObject *, PyObject *args, PyObject *kwds)
+{
+	static const char *kwlist[] = { "contour", "paths", "colors", "offsets", "twists",
+		"up", "style", "texture", "radius", "threads", NULL };
+	PyObject *cobj, *pobj, *colobj = NULL, *offobj = NULL, *tobj = NULL, *upobj = NULL;
+	PyObject *robj = NULL;
+	int style = -1, texture = 0, threads = 0;
+	std::vector<Py_ssize_t> offsets;
+	gleArrayArg contour;
+	gleRaggedArg points, colors, twists;
+	std::vector<double> radius;
+	gleOptions opts;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOOOiiOi", (char **)kwlist,
+			&cobj, &pobj, &colobj, &offobj, &tobj, &upobj, &style, &texture, &robj,
+			&threads))
+		return(NULL);
+
+	bool has_offsets = ((offobj != NULL) && (offobj != Py_None));
+	bool has_colors = ((colobj != NULL) && (colobj != Py_None));
+	bool has_twists = ((tobj != NULL) && (tobj != Py_None));
+
+	if (!contour.Get(cobj, "contour", 2) ||
+		(has_offsets && !get_offsets(offsets, offobj)) ||
+		!points.Get(pobj, "paths", 3, true, has_offsets ? &offsets : NULL) ||
+		(has_colors && !colors.Get(colobj, "colors", 3, false, has_offsets ? &offsets : NULL)) ||
+		(has_twists && !twists.Get(tobj, "twists", 1, true, has_offsets ? &offsets : NULL)) ||
+		!check_paths(colors, colobj, "colors", points) ||
+		!check_paths(twists, tobj, "twists", points) ||
+		!get_options(opts, style, texture, upobj) ||
+		!check_sizes(points, contour.Count(), "contour points"))
+		return(NULL);
+
+	if (robj == NULL)
+		radius.assign(points.Paths(), 1.0);
+	else if (!get_per_path(radius, robj, "radius", points.Paths()))
+		return(NULL);
+
+	const double *cont = contour.Doubles();
+	Py_ssize_t ncont = contour.Count();
+
+	return(run_batch(points.Paths(), threads, [&](size_t i) -> CgleMesh
+	{
+		float (*col)[3] = has_colors ? (float (*)[3])colors.Data(i) : NULL;
+
+		if (has_twists)
+		{
+			CgleTwistExtrusion obj((int)points.Count(i), (int)ncont, radius[i]);
+
+			apply_options(obj, opts);
+			load_contour(obj, cont, ncont);
+			obj.Build((double (*)[3])points.Data(i), col, (double *)twists.Data(i),
+				opts.texture > 0);
+			return(obj.TakeMesh());
+		}
+
+		CgleExtrusion obj((int)points.Count(i), (int)ncont, radius[i]);
+
+		apply_options(obj, opts);
+		load_contour(obj, cont, ncont);
+		obj.Build((double (*)[3])points.Data(i), col, opts.texture > 0);
+		return(obj.TakeMesh());
+	}));
+}
+
+/* ====================================================== */
+
+static PyMethodDef cgle_methods[] = {
+	{ "extrusion", (PyCFunction)(void (*)(void))cgle_extrusion,
+		METH_VARARGS | METH_KEYWORDS, extrusion_doc },
+	{ "twist_extrusion", (PyCFunction)(void (*)(void))cgle_twist_extrusion,
+		METH_VARARGS | METH_KEYWORDS, twist_extrusion_doc },
+	{ "polycone", (PyCFunction)(void (*)(void))cgle_polycone,
+		METH_VARARGS | METH_KEYWORDS, polycone_doc },
+	{ "polycylinder", (PyCFunction)(void (*)(void))cgle_polycylinder,
+		METH_VARARGS | METH_KEYWORDS, polycylinder_doc },
+	{ "extrusion_batch", (PyCFunction)(void (*)(void))cgle_extrusion_batch,
+		METH_VARARGS | METH_KEYWORDS, extrusion_batch_doc },
+	{ "polycone_batch", (PyCFunction)(void (*)(void))cgle_polycone_batch,
+		METH_VARARGS | METH_KEYWORDS, polycone_batch_doc },
+	{ "polycylinder_batch", (PyCFunction)(void (*)(void))cgle_polycylinder_batch,
+		METH_VARARGS | METH_KEYWORDS, polycylinder_batch_doc },
+	{ NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef cgle_module = {
+	PyModuleDef_HEAD_INIT,
+	"cgle",
+	"GLE extrusions, generated into NumPy arrays without a GL context.",
+	-1,
+	cgle_methods,
+};
+
+PyMODINIT_FUNC
+PyInit_cgle (void)
+{
+	PyObject *m;
+
+	gleArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+	gleArrayType.tp_doc = "One array of a Mesh, exported through the buffer protocol.";
+	gleArrayType.tp_dealloc = (destructor)array_dealloc;
+	gleArrayType.tp_as_buffer = &array_as_buffer;
+
+	gleMeshType.tp_flags = Py_TPFLAGS_DEFAULT;
+	gleMeshType.tp_doc = "A generated triangle mesh.";
+	gleMeshType.tp_dealloc = (destructor)mesh_dealloc;
+	gleMeshType.tp_getset = mesh_getset;
+
+	if ((PyType_Ready(&gleArrayType) < 0) || (PyType_Ready(&gleMeshType) < 0))
+		return(NULL);
+
+	m = PyModule_Create(&cgle_module);
+	if (m == NULL)
+		return(NULL);
+
+	Py_INCREF(&gleMeshType);
+	PyModule_AddObject(m, "Mesh", (PyObject *)&gleMeshType);
+
+	PyModule_AddIntConstant(m, "JN_RAW", GLE_JN_RAW);
+	PyModule_AddIntConstant(m, "JN_ANGLE", GLE_JN_ANGLE);
+	PyModule_AddIntConstant(m, "JN_CUT", GLE_JN_CUT);
+	PyModule_AddIntConstant(m, "JN_ROUND", GLE_JN_ROUND);
+	PyModule_AddIntConstant(m, "JN_CAP", GLE_JN_CAP);
+	PyModule_AddIntConstant(m, "NORM_FACET", GLE_NORM_FACET);
+	PyModule_AddIntConstant(m, "NORM_EDGE", GLE_NORM_EDGE);
+	PyModule_AddIntConstant(m, "NORM_PATH_EDGE", GLE_NORM_PATH_EDGE);
+	PyModule_AddIntConstant(m, "CONTOUR_CLOSED", GLE_CONTOUR_CLOSED);
+
+	/* the numbering of gle.h */
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_FLAT", 1);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_FLAT", 2);
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_CYL", 3);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_CYL", 4);
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_SPH", 5);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_SPH", 6);
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_MODEL_FLAT", 7);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_MODEL_FLAT", 8);
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_MODEL_CYL", 9);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_MODEL_CYL", 10);
+	PyModule_AddIntConstant(m, "TEXTURE_VERTEX_MODEL_SPH", 11);
+	PyModule_AddIntConstant(m, "TEXTURE_NORMAL_MODEL_SPH", 12);
+
+	return(m);
+}
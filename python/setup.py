@@ -0,0 +1,42 @@
+# Builds the cgle Python module, together with the C++ class library it
+# wraps (../cgle-c++), so that nothing needs to be installed first:
+#
+#     python3 setup.py build_ext --inplace
+#
+# NumPy is used at run time, if it's there, but isn't needed to build.
+
+import os
+import sys
+from glob import glob
+
+from setuptools import setup, Extension
+
+here = os.path.dirname(os.path.abspath(__file__))
+lib = os.path.join(here, '..', 'cgle-c++', 'StaticLib')
+
+# StaticLib.cpp is an older copy of ExtrusionLib.cpp; stdafx.cpp is the
+# Visual Studio precompiled header
+sources = ['cglemodule.cpp'] + [
+    os.path.relpath(f, here) for f in sorted(glob(os.path.join(lib, '*.cpp')))
+    if os.path.basename(f) not in ('StaticLib.cpp', 'stdafx.cpp')]
+
+if sys.platform == 'win32':
+    libraries = ['opengl32', 'glu32']
+    extra = []
+else:
+    libraries = ['GLU', 'GL']
+    extra = ['-std=c++11', '-pthread']
+
+setup(
+    name='cgle',
+    version='3.1.0',
+    description='GLE extrusions, generated into NumPy arrays without a GL context',
+    ext_modules=[Extension(
+        'cgle',
+        sources=sources,
+        include_dirs=[lib],
+        libraries=libraries,
+        extra_compile_args=extra,
+        extra_link_args=extra[1:],
+    )],
+)
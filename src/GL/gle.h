@@ -17,12 +17,16 @@
 #ifndef GLE_H__
 #define GLE_H__
 
+#include <stddef.h>	/* for size_t */
+
 #if defined(__cplusplus) || defined(c_plusplus)
 extern "C" {
 #endif
 
 /* some types */
+#ifndef __GLE_DOUBLE
 #define __GLE_DOUBLE  1
+#endif
 #if __GLE_DOUBLE
 typedef double gleDouble;
 #else 
@@ -67,6 +71,50 @@ typedef float gleColor4f[4];
 #define GLE_TEXTURE_VERTEX_MODEL_SPH	11
 #define GLE_TEXTURE_NORMAL_MODEL_SPH	12
 
+/* ====================================================== */
+
+/* Run-time statistics; see gleGetStats().  The primitives that calls
+ * are counted for; the _c4f, _f and strided variants count as the
+ * primitive that they draw. */
+#define GLE_STATS_POLYCYLINDER		0
+#define GLE_STATS_POLYCONE		1
+#define GLE_STATS_EXTRUSION		2
+#define GLE_STATS_TWIST_EXTRUSION	3
+#define GLE_STATS_SUPER_EXTRUSION	4
+#define GLE_STATS_SPIRAL		5
+#define GLE_STATS_LATHE			6
+#define GLE_STATS_HELICOID		7
+#define GLE_STATS_TOROID		8
+#define GLE_STATS_SCREW			9
+#define GLE_STATS_NUM_PRIMITIVES	10
+
+/* The phases that the time of a call is divided among.  Each moment
+ * is charged to exactly one of them, so that they add up to the
+ * time spent in the library. */
+#define GLE_STATS_SETUP		0	/* up vector, join planes, frames */
+#define GLE_STATS_JOIN		1	/* contour transforms, intersections */
+#define GLE_STATS_CAP		2	/* end caps, round and cut joins */
+#define GLE_STATS_EMIT		3	/* between glBegin() and glEnd() */
+#define GLE_STATS_NUM_PHASES	4
+
+typedef struct {
+   size_t calls[GLE_STATS_NUM_PRIMITIVES]; /* top-level calls only */
+   size_t segments;          /* tube segments drawn */
+   size_t degenerate_points; /* path points skipped as degenerate */
+   size_t vertices;          /* vertices emitted; see below */
+   size_t normals;
+   size_t colors;
+   size_t tessellations;     /* caps handed to the GLU tessellator */
+   size_t round_pieces;      /* pieces the round joins are cut into */
+   size_t mallocs;           /* scratch allocations */
+   size_t malloc_bytes;
+   double seconds[GLE_STATS_NUM_PHASES];
+} gleStats;
+
+/* Sweep files; see gleSweepOpen() */
+typedef struct _gleSweepWriter gleSweepWriter;
+typedef struct _gleSweepFile gleSweepFile;
+
 #ifdef GL_32
 /* HACK for GL 3.2 -- needed because no way to tell if lighting is on.  */
 #define TUBE_LIGHTING_ON	0x80000000
@@ -101,6 +149,37 @@ extern void gleHelicoid ();
 extern void gleToroid ();
 extern void gleScrew ();
 
+extern void gleSetOrigin ();
+extern void gleGetOrigin ();
+extern void glePolyCylinder_f ();
+extern void glePolyCone_f ();
+extern void gleExtrusion_f ();
+extern void gleTwistExtrusion_f ();
+extern void gleSuperExtrusion_f ();
+extern void glePolyCylinderStrided ();
+extern void glePolyConeStrided ();
+extern void gleExtrusionStrided ();
+extern void gleTwistExtrusionStrided ();
+extern void gleSuperExtrusionStrided ();
+
+extern void gleEnableStats ();
+extern void gleGetStats ();
+extern void gleResetStats ();
+
+extern int gleTraceOpen ();
+extern void gleTraceClose ();
+
+extern gleSweepWriter * gleSweepCreate ();
+extern int gleSweepAddPolyCylinder ();
+extern int gleSweepAddPolyCone ();
+extern int gleSweepAddExtrusion ();
+extern int gleSweepFinish ();
+extern gleSweepFile * gleSweepOpen ();
+extern void gleSweepClose ();
+extern int gleSweepCount ();
+extern int gleSweepGetBounds ();
+extern void gleSweepDraw ();
+
 /* Rotation Utilities */
 extern void rot_axis ();
 extern void rot_about_axis ();
@@ -274,6 +353,158 @@ extern void gleScrew (int ncp,          /* number of contour points */
 
 extern void gleTextureMode (int mode);
 
+/* Single-precision entry points, in libgle_f.  The path coordinates
+ * are relative to the origin set with gleSetOrigin(); the origin itself
+ * is kept in double precision.  The joins, normals and rings are worked
+ * out in float, by a second build of the extrusion engine, and drawn
+ * with glVertex3fv() and glNormal3fv(). */
+extern void gleSetOrigin (gleDouble origin[3]);
+extern void gleGetOrigin (gleDouble origin[3]);
+
+extern void 
+glePolyCylinder_f (int npoints,	/* num points in polyline */
+                   float point_array[][3],	/* polyline vertces */
+                   gleColor color_array[],	/* colors at polyline verts */
+                   float radius);		/* radius of polycylinder */
+
+extern void 
+glePolyCone_f (int npoints,	 /* numpoints in poly-line */
+                   float point_array[][3],	/* polyline vertices */
+                   gleColor color_array[],	/* colors at polyline verts */
+                   float radius_array[]); /* cone radii at polyline verts */
+
+extern void 
+gleExtrusion_f (int ncp,         /* number of contour points */
+                float contour[][2],     /* 2D contour */
+                float cont_normal[][2], /* 2D contour normals */
+                float up[3],            /* up vector for contour */
+                int npoints,            /* numpoints in poly-line */
+                float point_array[][3], /* polyline vertices */
+                gleColor color_array[]); /* colors at polyline verts */
+
+extern void 
+gleTwistExtrusion_f (int ncp,         /* number of contour points */
+                float contour[][2],    /* 2D contour */
+                float cont_normal[][2], /* 2D contour normals */
+                float up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                float point_array[][3],        /* polyline vertices */
+                gleColor color_array[],        /* color at polyline verts */
+                float twist_array[]);   /* countour twists (in degrees) */
+
+extern void 
+gleSuperExtrusion_f (int ncp,  /* number of contour points */
+                float contour[][2],    /* 2D contour */
+                float cont_normal[][2], /* 2D contour normals */
+                float up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                float point_array[][3],        /* polyline vertices */
+                gleColor color_array[],        /* color at polyline verts */
+                float xform_array[][2][3]);   /* 2D contour xforms */
+
+/* Strided entry points.  Each per-vertex array is given as a base 
+ * pointer plus a byte stride, as for glVertexPointer().  A stride of 
+ * zero means the array is tightly packed.  The arrays are read where 
+ * they lie; nothing is copied.  Negative strides are not allowed. */
+extern void 
+glePolyCylinderStrided (int npoints,	/* num points in polyline */
+                   void *points, int point_stride, /* gleDouble[3] verts */
+                   void *colors, int color_stride, /* gleColor, or NULL */
+                   gleDouble radius);		/* radius of polycylinder */
+
+extern void 
+glePolyConeStrided (int npoints,	 /* numpoints in poly-line */
+                   void *points, int point_stride, /* gleDouble[3] verts */
+                   void *colors, int color_stride, /* gleColor, or NULL */
+                   void *radii, int radius_stride); /* gleDouble radii */
+
+extern void 
+gleExtrusionStrided (int ncp,         /* number of contour points */
+                gleDouble contour[][2],     /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],            /* up vector for contour */
+                int npoints,            /* numpoints in poly-line */
+                void *points, int point_stride, /* gleDouble[3] verts */
+                void *colors, int color_stride); /* gleColor, or NULL */
+
+extern void 
+gleTwistExtrusionStrided (int ncp,         /* number of contour points */
+                gleDouble contour[][2],    /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                void *points, int point_stride, /* gleDouble[3] verts */
+                void *colors, int color_stride, /* gleColor, or NULL */
+                void *twists, int twist_stride); /* gleDouble, in degrees */
+
+extern void 
+gleSuperExtrusionStrided (int ncp,  /* number of contour points */
+                gleDouble contour[][2],    /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                void *points, int point_stride, /* gleDouble[3] verts */
+                void *colors, int color_stride, /* gleColor, or NULL */
+                void *xforms, int xform_stride); /* gleAffine, or NULL */
+
+/* Run-time statistics.  Nothing is counted until gleEnableStats(1)
+ * is called; until then, each place that would count costs a test of
+ * one pointer.  The counters accumulate until gleResetStats().  The
+ * vertex count is of those GLE emits itself: the vertices that the
+ * tessellator makes for the caps are not included. */
+extern void gleEnableStats (int enable);
+extern void gleGetStats (gleStats *stats);	/* zeros, if not enabled */
+extern void gleResetStats (void);
+
+/* Call tracing.  From gleTraceOpen() until gleTraceClose(), each call
+ * the application makes into GLE is written to the named file, with
+ * its arguments, for bench/glereplay to play back and time.  The
+ * single-precision and strided entry points are recorded as the
+ * double-precision calls, with their arguments widened.  Returns 0
+ * if the file could not be created. */
+extern int gleTraceOpen (const char *filename);
+extern void gleTraceClose (void);
+
+/* Sweep files.  A sweep file keeps many extrusions as their contours,
+ * paths, colors and transforms, not as the tubes drawn from them, and
+ * is memory-mapped when opened, so that only the table of contents is
+ * read until a sweep is drawn.  Each gleSweepAdd*() call records the
+ * join style and number of sides in effect, and returns the index of
+ * the sweep, or -1 on failure; gleSweepFinish() returns 0 on failure,
+ * and frees the writer either way. */
+extern gleSweepWriter * gleSweepCreate (const char *filename);
+extern int gleSweepAddPolyCylinder (gleSweepWriter *writer,
+                int npoints,
+                gleDouble point_array[][3],
+                gleColor color_array[],		/* or NULL */
+                gleDouble radius);
+extern int gleSweepAddPolyCone (gleSweepWriter *writer,
+                int npoints,
+                gleDouble point_array[][3],
+                gleColor color_array[],		/* or NULL */
+                gleDouble radius_array[]);
+extern int gleSweepAddExtrusion (gleSweepWriter *writer,
+                int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],	/* or NULL */
+                gleDouble up[3],		/* or NULL */
+                int npoints,
+                gleDouble point_array[][3],
+                gleColor color_array[],		/* or NULL */
+                gleDouble twist_array[],	/* or NULL */
+                gleDouble xform_array[][2][3]);	/* or NULL; not both */
+extern int gleSweepFinish (gleSweepWriter *writer);
+
+/* Returns NULL if the file can't be read, or isn't a sweep file */
+extern gleSweepFile * gleSweepOpen (const char *filename);
+extern void gleSweepClose (gleSweepFile *file);
+extern int gleSweepCount (gleSweepFile *file);
+/* a box holding all of the sweep's tube, for culling; 0 if no such sweep */
+extern int gleSweepGetBounds (gleSweepFile *file, int index,
+                gleDouble min[3], gleDouble max[3]);
+/* draws the sweep with the join style and sides it was added with */
+extern void gleSweepDraw (gleSweepFile *file, int index);
+
 /* Rotation Utilities */
 extern void rot_axis (gleDouble omega, gleDouble axis[3]);
 extern void rot_about_axis (gleDouble angle, gleDouble axis[3]);
@@ -19,7 +19,7 @@
  */
 
 #undef   C3F
-#define  C3F(x)      glColor4fv(x)
+#define  C3F(x)      { GLE_STATS_COUNT (colors, 1); glColor4fv(x); }
 #define  gleColor    gleColor4f
 #define  COLOR_SIGNATURE 1
 
@@ -87,11 +87,13 @@ void draw_angle_style_front_cap (int ncp,	/* number of contour points */
    GLUtriangulatorObj *tobj;
 #ifdef DELICATE_TESSELATOR
    int is_colinear;
-   double *previous_vertex = 0x0;
-   double *first_vertex = 0x0;
+   gleDouble *previous_vertex = 0x0;
+   gleDouble *first_vertex = 0x0;
 #endif /* DELICATE_TESSELATOR */     
 #endif /* OPENGL_10 */
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
    if (bi[2] < 0.0) {
       VEC_SCALE (bi, -1.0, bi); 
    }
@@ -112,15 +114,16 @@ void draw_angle_style_front_cap (int ncp,	/* number of contour points */
 #ifdef OPENGL_10
    N3F(bi);
 
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr)glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr)glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr)glEnd);
 
 #ifdef LENIENT_TESSELATOR 
    gluBeginPolygon (tobj);
    for (j=0; j<ncp; j++) {
-      gluTessVertex (tobj, point_array[j], point_array[j]);
+      TESS_VERTEX (tobj, point_array[j]);
    }
    gluEndPolygon (tobj);
 #endif /* LENIENT_TESSELATOR */  
@@ -137,7 +140,7 @@ void draw_angle_style_front_cap (int ncp,	/* number of contour points */
       for (j=0; j<ncp-1; j++) {
          COLINEAR (is_colinear, previous_vertex, point_array[j], point_array[j+1]);
          if (!is_colinear) {
-            gluTessVertex (tobj, point_array[j], point_array[j]);
+            TESS_VERTEX (tobj, point_array[j]);
             previous_vertex = point_array[j];
             if (!first_vertex) first_vertex = previous_vertex;
          }
@@ -145,13 +148,15 @@ void draw_angle_style_front_cap (int ncp,	/* number of contour points */
 
       if (!first_vertex) first_vertex = point_array[0];
       COLINEAR (is_colinear, previous_vertex, point_array[ncp-1], first_vertex);
-      if (!is_colinear) gluTessVertex (tobj, point_array[ncp-1], point_array[ncp-1]);
+      if (!is_colinear) TESS_VERTEX (tobj, point_array[ncp-1]);
 
       gluEndPolygon (tobj);
 #endif /* DELICATE_TESSELATOR */
 
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
+
+   GLE_STATS_POP ();
 }
 
 /* ============================================================ */
@@ -166,11 +171,13 @@ void draw_angle_style_back_cap (int ncp,	/* number of contour points */
    GLUtriangulatorObj *tobj;
 #ifdef DELICATE_TESSELATOR
    int is_colinear;
-   double *previous_vertex = 0x0;
-   double *first_vertex = 0x0;
+   gleDouble *previous_vertex = 0x0;
+   gleDouble *first_vertex = 0x0;
 #endif /* DELICATE_TESSELATOR */     
 #endif /* OPENGL_10 */
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
    if (bi[2] > 0.0) {
       VEC_SCALE (bi, -1.0, bi); 
    }
@@ -191,15 +198,16 @@ void draw_angle_style_back_cap (int ncp,	/* number of contour points */
 #ifdef OPENGL_10
    N3F (bi);
 
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr)glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr)glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr)glEnd);
 
 #ifdef LENIENT_TESSELATOR 
    gluBeginPolygon (tobj);
    for (j=ncp-1; j>=0; j--) {
-      gluTessVertex (tobj, point_array[j], point_array[j]);
+      TESS_VERTEX (tobj, point_array[j]);
    }
    gluEndPolygon (tobj);
 #endif /* LENIENT_TESSELATOR */  
@@ -212,7 +220,7 @@ void draw_angle_style_back_cap (int ncp,	/* number of contour points */
       for (j=ncp-1; j>0; j--) {
          COLINEAR (is_colinear, previous_vertex, point_array[j], point_array[j-1]);
          if (!is_colinear) {
-            gluTessVertex (tobj, point_array[j], point_array[j]);
+            TESS_VERTEX (tobj, point_array[j]);
             previous_vertex = point_array[j];
             if (!first_vertex) first_vertex = previous_vertex;
          }
@@ -220,13 +228,15 @@ void draw_angle_style_back_cap (int ncp,	/* number of contour points */
 
       if (!first_vertex) first_vertex = point_array[ncp-1];
       COLINEAR (is_colinear, previous_vertex, point_array[0], first_vertex);
-      if (!is_colinear) gluTessVertex (tobj, point_array[0], point_array[0]);
+      if (!is_colinear) TESS_VERTEX (tobj, point_array[0]);
 
       gluEndPolygon (tobj);
 #endif /* DELICATE_TESSELATOR */
 
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
+
+   GLE_STATS_POP ();
 }
 
 #endif /* COLOR_SIGNATURE */
@@ -247,17 +257,19 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
    gleDouble m[4][4];
    gleDouble len;
    gleDouble len_seg;
-   gleDouble diff[3];
    gleDouble bi_0[3], bi_1[3];		/* bisecting plane */
    gleDouble bisector_0[3], bisector_1[3];	/* bisecting plane */
-   gleDouble end_point_0[3], end_point_1[3]; 
    gleDouble origin[3], neg_z[3];
    gleDouble yup[3];		/* alternate up vector */
    gleDouble *front_loop, *back_loop;   /* contours in 3D */
    char * mem_anchor;
-   double *norm_loop; 
-   double *front_norm, *back_norm, *tmp; /* contour normals in 3D */
+   gleDouble *norm_loop; 
+   gleDouble *front_norm, *back_norm, *tmp; /* contour normals in 3D */
    int first_time;
+   int has_xform;		/* TRUE if contour is transformed */
+   gleRingXform xf_0, xf_1;	/* contour transforms at either end */
+   gleDouble *ring_0, *ring_1;	/* transformed contours at either end */
+   gleJoinPath path;		/* bisecting planes for the whole path */
 
    /* By definition, the contour passed in has its up vector pointing in
     * the y direction */
@@ -282,64 +294,81 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
    neg_z[1] = 0.0;
    neg_z[2] = 1.0;
 
-   /* ignore all segments of zero length */
+   /* get all of the bisecting planes, skipping over segments of
+    * zero length */
+   if (!join_path_planes (&path, npoints, point_array, FALSE)) return;
+
    i = 1;
-   inext = i;
-   FIND_NON_DEGENERATE_POINT (inext, npoints, len, diff, point_array);
+   inext = path.next[i];
+   len = path.len[i];
    len_seg = len;	/* store for later use */
 
    /* get the bisecting plane */
-   bisecting_plane (bi_0, point_array[0], 
-                          point_array[1], 
-                          point_array[inext]);
+   VEC_COPY (bi_0, path.bi[i]);
    /* reflect the up vector in the bisecting plane */
    VEC_REFLECT (yup, yup, bi_0);
 
    /* malloc the storage we'll need for relaying changed contours to the
     * drawing routines. */
-   mem_anchor =  malloc (2 * 3 * (size_t) ncp * sizeof(double)
-                      +  2 * 3 * (size_t) ncp * sizeof(gleDouble));
+   mem_anchor =  gle_malloc (2 * 3 * (size_t) ncp * sizeof(gleDouble)
+                      +  4 * 3 * (size_t) ncp * sizeof(gleDouble));
    front_loop = (gleDouble *) mem_anchor;
    back_loop = front_loop + 3 * ncp;
-   front_norm = (double *) (back_loop + 3 * ncp);
+   ring_0 = back_loop + 3 * ncp;
+   ring_1 = ring_0 + 3 * ncp;
+   front_norm = (gleDouble *) (ring_1 + 3 * ncp);
    back_norm = front_norm + 3 * ncp;
    norm_loop = front_norm;
 
+   has_xform = __TUBE_HAS_XFORM (xform_array);
+   xf_1.index = -1;
+
    /* may as well get the normals set up now */
    if (cont_normal != NULL) {
-      if (xform_array == NULL) {
+      if (!has_xform) {
          for (j=0; j<ncp; j++) {
             norm_loop[3*j] = cont_normal[j][0];
             norm_loop[3*j+1] = cont_normal[j][1];
             norm_loop[3*j+2] = 0.0;
          }
       } else {
+         ring_xform (&xf_1, xform_array, inext-1);
+         ring_norm_contour (ncp, (gleVector *) front_norm, &xf_1, cont_normal);
          for (j=0; j<ncp; j++) {
-            NORM_XFORM_2X2 ( (&front_norm[3*j]),
-                              xform_array[inext-1],
-                              cont_normal [j]);
-            front_norm[3*j+2] = 0.0;
             back_norm[3*j+2] = 0.0;
          }
       }
    }
 
+   /* without transforms, both ends of every segment see the same
+    * contour; lay it out once, the way the ring transforms would */
+   if (!has_xform) {
+      ring_1 = ring_0;
+      for (j=0; j<ncp; j++) {
+         ring_0[3*j] = contour[j][0];
+         ring_0[3*j+1] = contour[j][1];
+         ring_0[3*j+2] = 0.0;
+      }
+   }
+
    first_time = TRUE;
    /* draw tubing, not doing the first segment */
+   GLE_STATS_PHASE (GLE_STATS_JOIN);
    while (inext<npoints-1) {
 
-      inextnext = inext;
+      GLE_STATS_COUNT (segments, 1);
+
       /* ignore all segments of zero length */
-      FIND_NON_DEGENERATE_POINT (inextnext, npoints, len, diff, point_array);
+      inextnext = path.next[inext];
+      len = path.len[inext];
 
       /* get the next bisecting plane */
-      bisecting_plane (bi_1, point_array[i], 
-                             point_array[inext], 
-                             point_array[inextnext]);  
+      VEC_COPY (bi_1, path.bi[inext]);
 
       /* rotate so that z-axis points down v2-v1 axis, 
        * and so that origen is at v1 */
-      uviewpoint (m, point_array[i], point_array[inext], yup);
+      uviewpoint (m, PATH_POINT (point_array, i),
+                     PATH_POINT (point_array, inext), yup);
       PUSHMATRIX ();
       MULTMATRIX (m);
 
@@ -349,115 +378,79 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
 
       neg_z[2] = -len_seg;
 
+      /* transform the contour for both ends of the segment, and
+       * set up the back normals with the inverse transpose. (The
+       * front normals we inherit from previous pass through the loop) */
+      if (has_xform) {
+         RING_XFORM (xf_0, xf_1, xform_array, inext-1);
+         ring_xform (&xf_1, xform_array, inext);
+         ring_dot_contour (ncp, (gleVector *) ring_0, &xf_0, contour, 0.0);
+         ring_dot_contour (ncp, (gleVector *) ring_1, &xf_1, contour, 0.0);
+         if (cont_normal != NULL) {
+            ring_norm_contour (ncp, (gleVector *) back_norm, &xf_1, cont_normal);
+         }
+      }
+
       /* draw the tube */
       /* --------- START OF TMESH GENERATION -------------- */
-      for (j=0; j<ncp; j++) {
 
-         /* if there are normals, and there are either affine xforms, OR
-          * path-edge normals need to be drawn, then compute local
-          * coordinate system normals. 
-          */
-         if (cont_normal != NULL) {
-          
-            /* set up the back normals. (The front normals we inherit
-             * from previous pass through the loop) */
-            if (xform_array != NULL) {
-               /* do up the normal vectors with the inverse transpose */
-               NORM_XFORM_2X2 ( (&back_norm[3*j]),
-                                 xform_array[inext],
-                                 cont_normal [j]);
+      /* if there are normals, and there are either affine xforms, OR
+       * path-edge normals need to be drawn, then compute local
+       * coordinate system normals. 
+       *
+       * Note that if the xform array is NULL, then normals are
+       * constant, and are set up outside of the loop.
+       *
+       * if there are normal vectors, and the style calls for it, 
+       * then we want to project the normal vectors into the
+       * bisecting plane. (This style is needed to make toroids, etc. 
+       * look good: Without this, segmentation artifacts show up
+       * under lighting.
+       */
+      if ((cont_normal != NULL) && __TUBE_DRAW_PATH_EDGE_NORMALS) {
+         for (j=0; j<ncp; j++) {
+            /* Hmm, if no affine xforms, then we haven't yet set
+             * back vector. So do it. */
+            if (!has_xform) {
+               back_norm[3*j] = cont_normal[j][0];
+               back_norm[3*j+1] = cont_normal[j][1];
             }
 
-            /* Note that if the xform array is NULL, then normals are
-             * constant, and are set up outside of the loop.
-             */
-
-            /* 
-             * if there are normal vectors, and the style calls for it, 
-             * then we want to project the normal vectors into the
-             * bisecting plane. (This style is needed to make toroids, etc. 
-             * look good: Without this, segmentation artifacts show up
-             * under lighting.
-             */
-            if (__TUBE_DRAW_PATH_EDGE_NORMALS) {
-               /* Hmm, if no affine xforms, then we haven't yet set
-                * back vector. So do it. */
-               if (xform_array == NULL) {
-                  back_norm[3*j] = cont_normal[j][0];
-                  back_norm[3*j+1] = cont_normal[j][1];
-               }
-   
-               /* now, start with a fresh normal (z component equal to
-                * zero), project onto bisecting plane (by computing 
-                * perpendicular componenet to bisect vector, and renormalize 
-                * (since projected vector is not of unit length */ 
-               front_norm[3*j+2] = 0.0;
-               VEC_PERP ((&front_norm[3*j]), (&front_norm[3*j]), bisector_0);
-               VEC_NORMALIZE ((&front_norm[3*j]));
-    
-               back_norm[3*j+2] = 0.0;
-               VEC_PERP ((&back_norm[3*j]), (&back_norm[3*j]), bisector_1);
-               VEC_NORMALIZE ((&back_norm[3*j]));
-            } 
-         } 
-
-         /* Next, we want to define segements. We find the endpoints of
-          * the segments by intersecting the contour with the bisecting
-          * plane.  If there is no local affine transform, this is easy.
-          *
-          * If there is an affine tranform, then we want to remove the
-          * torsional component, so that the intersection points won't
-          * get twisted out of shape.  We do this by applying the
-          * local affine transform to the entire coordinate system.
-          */
-         if (xform_array == NULL) {
-            end_point_0 [0] = contour[j][0];
-            end_point_0 [1] = contour[j][1];
-   
-            end_point_1 [0] = contour[j][0];
-            end_point_1 [1] = contour[j][1];
-         } else {
-            /* transform the contour points with the local xform */
-            MAT_DOT_VEC_2X3 (end_point_0,
-                             xform_array[inext-1], contour[j]);
-            MAT_DOT_VEC_2X3 (end_point_1,
-                             xform_array[inext-1], contour[j]);
-         }
+            /* now, start with a fresh normal (z component equal to
+             * zero), project onto bisecting plane (by computing 
+             * perpendicular componenet to bisect vector, and renormalize 
+             * (since projected vector is not of unit length */ 
+            front_norm[3*j+2] = 0.0;
+            VEC_PERP ((&front_norm[3*j]), (&front_norm[3*j]), bisector_0);
+            VEC_NORMALIZE ((&front_norm[3*j]));
 
-         end_point_0 [2] = 0.0;
-         end_point_1 [2] = - len_seg;
-
-         /* The two end-points define a line.  Intersect this line
-          * against the clipping plane defined by the PREVIOUS
-          * tube segment.  */
-
-         INNERSECT ((&front_loop[3*j]), /* intersection point (returned) */
-                    origin,		/* point on intersecting plane */
-                    bisector_0,		/* normal vector to plane */
-                    end_point_0,	/* point on line */
-                    end_point_1);	/* another point on the line */	
-
-         /* The two end-points define a line.  Intersect this line
-          * against the clipping plane defined by the NEXT
-          * tube segment.  */
-
-         /* if there's an affine coordinate change, be sure to use it */
-         if (xform_array != NULL) {
-            /* transform the contour points with the local xform */
-            MAT_DOT_VEC_2X3 (end_point_0,
-                             xform_array[inext], contour[j]);
-            MAT_DOT_VEC_2X3 (end_point_1,
-                             xform_array[inext], contour[j]);
+            back_norm[3*j+2] = 0.0;
+            VEC_PERP ((&back_norm[3*j]), (&back_norm[3*j]), bisector_1);
+            VEC_NORMALIZE ((&back_norm[3*j]));
          }
-
-         INNERSECT ((&back_loop[3*j]),	/* intersection point (returned) */
-                    neg_z,		/* point on intersecting plane */
-                    bisector_1,		/* normal vector to plane */
-                    end_point_0,	/* point on line */
-                    end_point_1);	/* another point on the line */	
-
       }
 
+      /* Next, we want to define segements. We find the endpoints of
+       * the segments by intersecting the contour with the bisecting
+       * plane.  If there is no local affine transform, this is easy.
+       *
+       * If there is an affine tranform, then we want to remove the
+       * torsional component, so that the intersection points won't
+       * get twisted out of shape.  We do this by applying the
+       * local affine transform to the entire coordinate system.
+       *
+       * Each contour point defines a line parallel to the z axis.
+       * Intersect these against the clipping plane defined by the
+       * PREVIOUS tube segment, and then against the one defined by
+       * the NEXT tube segment; a whole ring at a time. */
+      intersect_ring (ncp, (gleVector *) front_loop, origin, bisector_0,
+                      (gleVector *) ring_0, 0.0,
+                      (gleVector *) ring_0, - len_seg);
+
+      intersect_ring (ncp, (gleVector *) back_loop, neg_z, bisector_1,
+                      (gleVector *) ring_1, 0.0,
+                      (gleVector *) ring_1, - len_seg);
+
       /* --------- END OF TMESH GENERATION -------------- */
 
       /* v^v^v^v^v^v^v^v^v  BEGIN END CAPS v^v^v^v^v^v^v^v^v^v^v^v */
@@ -466,12 +459,12 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
        * but the very first and last caps */
       if (__TUBE_DRAW_CAP) {
          if (first_time) {
-            if (color_array != NULL) C3F (color_array[inext-1]);
+            if (color_array != NULL) C3F (PATH_COLOR (color_array, inext-1));
             first_time = FALSE;
             draw_angle_style_front_cap (ncp, bisector_0, (gleVector *) front_loop);
          }
          if (inext == npoints-2) {
-            if (color_array != NULL) C3F (color_array[inext]);
+            if (color_array != NULL) C3F (PATH_COLOR (color_array, inext));
             draw_angle_style_back_cap (ncp, bisector_1, (gleVector *) back_loop);
          }
       }
@@ -482,7 +475,7 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
        * absecnce of colors and normals, and for interpretation of
        * normals. The blechy set of nested if statements below
        * branch to each of the six cases */
-      if ((xform_array == NULL) && (!__TUBE_DRAW_PATH_EDGE_NORMALS)) {
+      if ((!has_xform) && (!__TUBE_DRAW_PATH_EDGE_NORMALS)) {
          if (color_array == NULL) {
             if (cont_normal == NULL) {
                draw_segment_plain (ncp, (gleVector *) front_loop,
@@ -501,23 +494,23 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
             if (cont_normal == NULL) {
                draw_segment_color (ncp, (gleVector *) front_loop, 
                                         (gleVector *) back_loop, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
             } else
             if (__TUBE_DRAW_FACET_NORMALS) {
                draw_segment_c_and_facet_n (ncp, 
                                    (gleVector *) front_loop, 
                                    (gleVector *) back_loop, 
                                    (gleVector *) norm_loop,
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
             } else {
                draw_segment_c_and_edge_n (ncp, 
                                    (gleVector *) front_loop, 
                                    (gleVector *) back_loop, 
                                    (gleVector *) norm_loop,
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
              }
           }
       } else {
@@ -543,8 +536,8 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
             if (cont_normal == NULL) {
                draw_segment_color (ncp, (gleVector *) front_loop, 
                                         (gleVector *) back_loop, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
             } else
             if (__TUBE_DRAW_FACET_NORMALS) {
                draw_binorm_segment_c_and_facet_n (ncp, 
@@ -552,16 +545,16 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
                                    (gleVector *) back_loop, 
                                    (gleVector *) front_norm, 
                                    (gleVector *) back_norm, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
             } else {
                draw_binorm_segment_c_and_edge_n (ncp, 
                                    (gleVector *) front_loop, 
                                    (gleVector *) back_loop, 
                                    (gleVector *) front_norm, 
                                    (gleVector *) back_norm, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, len_seg);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, len_seg);
              }
           }
       }
@@ -587,7 +580,163 @@ void extrusion_angle_join (int ncp,		/* number of contour points */
 
    /* be sure to free it all up */
    free (mem_anchor);
+   join_path_free (&path);
 
 }
    
 /* ============================================================ */
+#if !defined(COLOR_SIGNATURE) && __GLE_DOUBLE
+/*
+ * When the path runs straight up the z axis, as it does for the screw,
+ * the bisecting planes are all square to the axis, and the angle join
+ * comes down to plain rings of contour.  So there is no polyline to
+ * walk: ring i sits at z0 + i*dz, and is turned through i*dtwist
+ * degrees.  The view matrix is computed once, and only its origin
+ * moved; each ring is transformed once, and serves as the back of one
+ * segment and the front of the next.  What gets drawn is what
+ * extrusion_angle_join() would draw for the same path and twists.
+ */
+
+void extrusion_straight_join (int ncp,	/* number of contour points */
+                           gleDouble contour[][2],	/* 2D contour */
+                           gleDouble cont_normal[][2], /* 2D normal vecs */
+                           gleDouble up[3],	/* up vector for contour */
+                           int nrings,		/* number of rings */
+                           gleDouble z0,	/* z of the first ring */
+                           gleDouble dz,	/* z step from ring to ring */
+                           gleDouble dtwist)	/* twist step, in degrees */
+{
+   int i, j;
+   gleDouble m[4][4];
+   gleDouble len;
+   gleDouble axis[2][3];		/* the first segment */
+   gleDouble front_cap[3], back_cap[3];	/* the caps face along the axis */
+   gleDouble yup[3];		/* alternate up vector */
+   gleDouble *front_loop, *back_loop;   /* contours in 3D */
+   char * mem_anchor;
+   gleDouble *front_norm, *back_norm, *tmp; /* contour normals in 3D */
+   double angle;
+   gleRingXform xf;
+
+   /* every ring on top of the last: as with any other path, nothing
+    * is drawn */
+   if ((nrings < 2) || (dz == 0.0)) return;
+   len = fabs (dz);
+
+   /* By definition, the contour passed in has its up vector pointing in
+    * the y direction */
+   if (up == NULL) {
+      yup[0] = 0.0;
+      yup[1] = 1.0;
+      yup[2] = 0.0;
+   } else {
+      VEC_COPY(yup, up);
+   }
+
+   axis[0][0] = axis[0][1] = axis[1][0] = axis[1][1] = 0.0;
+   axis[0][2] = z0;
+   axis[1][2] = z0 + dz;
+   (void) up_sanity_check (yup, 2, axis);
+
+   /* the one orientation every segment has */
+   uviewpoint (m, axis[0], axis[1], yup);
+
+   front_cap[0] = front_cap[1] = 0.0;
+   front_cap[2] = 1.0;
+   back_cap[0] = back_cap[1] = 0.0;
+   back_cap[2] = -1.0;
+
+   mem_anchor =  gle_malloc (4 * 3 * (size_t) ncp * sizeof(gleDouble));
+   front_loop = (gleDouble *) mem_anchor;
+   back_loop = front_loop + 3 * ncp;
+   front_norm = back_loop + 3 * ncp;
+   back_norm = front_norm + 3 * ncp;
+
+   /* the first ring, and its normals */
+   xf.index = 0;
+   xf.kind = CONTOUR_XFORM_TWIST;
+   xf.a = 1.0;
+   xf.b = 0.0;
+   ring_dot_contour (ncp, (gleVector *) front_loop, &xf, contour, 0.0);
+   if (cont_normal != NULL) {
+      ring_norm_contour (ncp, (gleVector *) front_norm, &xf, cont_normal);
+   }
+
+   GLE_STATS_PHASE (GLE_STATS_JOIN);
+   for (i=0; i<nrings-1; i++) {
+
+      GLE_STATS_COUNT (segments, 1);
+
+      /* only the origin moves along the axis */
+      m[3][2] = z0 + ((gleDouble) i) * dz;
+      PUSHMATRIX ();
+      MULTMATRIX (m);
+
+      /* the next ring, len along */
+      angle = (M_PI/180.0) * ((gleDouble) (i+1)) * dtwist;
+      xf.index = i+1;
+      xf.a = cos (angle);
+      xf.b = sin (angle);
+      ring_dot_contour (ncp, (gleVector *) back_loop, &xf, contour, - len);
+
+      if (cont_normal != NULL) {
+         ring_norm_contour (ncp, (gleVector *) back_norm, &xf, cont_normal);
+
+         /* projected onto a plane square to the axis, the path-edge
+          * normals only need renormalizing */
+         if (__TUBE_DRAW_PATH_EDGE_NORMALS) {
+            for (j=0; j<ncp; j++) {
+               VEC_NORMALIZE ((&front_norm[3*j]));
+               VEC_NORMALIZE ((&back_norm[3*j]));
+            }
+         }
+      }
+
+      if (__TUBE_DRAW_CAP) {
+         if (0 == i) {
+            draw_angle_style_front_cap (ncp, front_cap, (gleVector *) front_loop);
+         }
+         if (nrings-2 == i) {
+            draw_angle_style_back_cap (ncp, back_cap, (gleVector *) back_loop);
+         }
+      }
+
+      /* ring i is path vertex i+1 of the equivalent polyline */
+      if (cont_normal == NULL) {
+         draw_segment_plain (ncp, (gleVector *) front_loop, 
+                                  (gleVector *) back_loop, i+2, len);
+      } else
+      if (__TUBE_DRAW_FACET_NORMALS) {
+         draw_binorm_segment_facet_n (ncp, (gleVector *) front_loop, 
+                                           (gleVector *) back_loop,
+                                           (gleVector *) front_norm, 
+                                           (gleVector *) back_norm,
+                                           i+2, len);
+      } else {
+         draw_binorm_segment_edge_n (ncp, (gleVector *) front_loop, 
+                                          (gleVector *) back_loop,
+                                          (gleVector *) front_norm,
+                                          (gleVector *) back_norm,
+                                          i+2, len);
+      }
+
+      POPMATRIX ();
+
+      /* the back ring becomes the front of the next segment */
+      tmp = front_loop;
+      front_loop = back_loop;
+      back_loop = tmp;
+      for (j=0; j<ncp; j++) {
+         front_loop[3*j+2] = 0.0;
+      }
+
+      tmp = front_norm;
+      front_norm = back_norm;
+      back_norm = tmp;
+   }
+
+   free (mem_anchor);
+}
+
+#endif /* !COLOR_SIGNATURE && __GLE_DOUBLE */
+/* ============================================================ */
@@ -37,11 +37,11 @@
 #include "segment.h"
 
 typedef void (*gleCapCallback) (int iloop,
-                                double cap[][3], 
+                                gleDouble cap[][3], 
                                 float face_color[3],
                                 gleDouble cut_vector[3],
                                 gleDouble bisect_vector[3],
-                                double norms[][3], 
+                                gleDouble norms[][3], 
                                 int frontwards);
 
 #define INVALID_BUG_NEEDS_FIXING 0
@@ -58,15 +58,17 @@ typedef void (*gleCapCallback) (int iloop,
 
 static void 
 draw_cut_style_cap_callback (int iloop,
-                                  double cap[][3], 
+                                  gleDouble cap[][3], 
                                   float face_color[3],
                                   gleDouble cut_vector[3],
                                   gleDouble bisect_vector[3],
-                                  double norms[][3], 
+                                  gleDouble norms[][3], 
                                   int frontwards)
 {
    int i;
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
    if (face_color != NULL) C3F (face_color);
 
    if (frontwards) {
@@ -77,11 +79,11 @@ draw_cut_style_cap_callback (int iloop,
          if (cut_vector[2] < 0.0) { 
             VEC_SCALE (cut_vector, -1.0, cut_vector); 
          }
-         N3F_D (cut_vector);
+         N3F (cut_vector);
       }
       BGNPOLYGON();
       for (i=0; i<iloop; i++) {
-         V3F_D (cap[i], i, FRONT_CAP);
+         V3F (cap[i], i, FRONT_CAP);
       }
       ENDPOLYGON();
    } else {
@@ -91,16 +93,17 @@ draw_cut_style_cap_callback (int iloop,
          /* if normal pointing in wrong direction, flip it. */
          if (cut_vector[2] > 0.0) 
            { VEC_SCALE (cut_vector, -1.0, cut_vector); }
-         N3F_D (cut_vector);
+         N3F (cut_vector);
       }
       /* the sense of the loop is reversed for backfacing culling */
       BGNPOLYGON();
       for (i=iloop-1; i>-1; i--) {
-         V3F_D (cap[i], i, BACK_CAP);
+         V3F (cap[i], i, BACK_CAP);
       }
       ENDPOLYGON();
    }
 
+   GLE_STATS_POP ();
 }
 
 #else /* NONCONCAVE_CAPS */
@@ -113,11 +116,11 @@ draw_cut_style_cap_callback (int iloop,
 
 static void 
 draw_cut_style_cap_callback (int iloop,
-                                  double cap[][3], 
+                                  gleDouble cap[][3], 
                                   float face_color[3],
                                   gleDouble cut_vector[3],
                                   gleDouble bisect_vector[3],
-                                  double norms[][3], 
+                                  gleDouble norms[][3], 
                                   int frontwards)
 {
 #ifdef GL_32
@@ -127,18 +130,21 @@ draw_cut_style_cap_callback (int iloop,
 #ifdef DELICATE_TESSELATOR
    int i;
    int is_colinear;
-   double *previous_vertex = 0x0;
-   double *first_vertex = 0x0;
+   gleDouble *previous_vertex = 0x0;
+   gleDouble *first_vertex = 0x0;
 #endif /* DELICATE_TESSELATOR */
 
 #ifdef OPENGL_10
    GLUtriangulatorObj *tobj;
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr) glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr) glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr) glEnd);
 #endif /* OPENGL_10 */
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
    if (face_color != NULL) C3F (face_color);
 
    if (frontwards) {
@@ -149,12 +155,12 @@ draw_cut_style_cap_callback (int iloop,
          if (cut_vector[2] < 0.0) { 
             VEC_SCALE (cut_vector, -1.0, cut_vector); 
          }
-         N3F_D (cut_vector);
+         N3F (cut_vector);
       }
 #ifdef GL_32
       BGNPOLYGON();
       for (i=0; i<iloop; i++) {
-         V3F_D (cap[i], i, FRONT_CAP);
+         V3F (cap[i], i, FRONT_CAP);
       }
       ENDPOLYGON();
 #endif /* GL_32 */
@@ -176,7 +182,7 @@ draw_cut_style_cap_callback (int iloop,
 #ifdef LENIENT_TESSELATOR
       gluBeginPolygon (tobj);
       for (i=0; i<iloop; i++) {
-         gluTessVertex (tobj, cap[i], cap[i]);
+         TESS_VERTEX (tobj, cap[i]);
       }
       gluEndPolygon (tobj);
 #endif /* LENIENT_TESSELATOR */
@@ -189,7 +195,7 @@ draw_cut_style_cap_callback (int iloop,
       for (i=0; i<iloop-1; i++) {
          COLINEAR (is_colinear, previous_vertex, cap[i], cap[i+1]);
          if (!is_colinear) {
-            gluTessVertex (tobj, cap[i], cap[i]);
+            TESS_VERTEX (tobj, cap[i]);
             previous_vertex = cap[i];
             if (!first_vertex) first_vertex = previous_vertex;
          }
@@ -197,7 +203,7 @@ draw_cut_style_cap_callback (int iloop,
 
       if (!first_vertex) first_vertex = cap[0];
       COLINEAR (is_colinear, previous_vertex, cap[iloop-1], first_vertex);
-      if (!is_colinear) gluTessVertex (tobj, cap[iloop-1], cap[iloop-1]);
+      if (!is_colinear) TESS_VERTEX (tobj, cap[iloop-1]);
 
       gluEndPolygon (tobj);
 #endif /* DELICATE_TESSELATOR */
@@ -211,13 +217,13 @@ draw_cut_style_cap_callback (int iloop,
          if (cut_vector[2] > 0.0) {
             VEC_SCALE (cut_vector, -1.0, cut_vector); 
          }
-         N3F_D (cut_vector);
+         N3F (cut_vector);
       }
       /* the sense of the loop is reversed for backfacing culling */
 #ifdef GL_32
       BGNPOLYGON();
       for (i=iloop-1; i>-1; i--) {
-         V3F_D (cap[i], i, BACK_CAP);
+         V3F (cap[i], i, BACK_CAP);
       }
       ENDPOLYGON();
 #endif /* GL_32 */
@@ -226,7 +232,7 @@ draw_cut_style_cap_callback (int iloop,
 #ifdef LENIENT_TESSELATOR
       gluBeginPolygon (tobj);
       for (i=iloop-1; i>-1; i--) {
-         gluTessVertex (tobj, cap[i], cap[i]);
+         TESS_VERTEX (tobj, cap[i]);
       }
       gluEndPolygon (tobj);
 #endif /* LENIENT_TESSELATOR */
@@ -239,7 +245,7 @@ draw_cut_style_cap_callback (int iloop,
       for (i=iloop-1; i>0; i--) {
          COLINEAR (is_colinear, previous_vertex, cap[i], cap[i-1]);
          if (!is_colinear) {
-            gluTessVertex (tobj, cap[i], cap[i]);
+            TESS_VERTEX (tobj, cap[i]);
             previous_vertex = cap[i];
             if (!first_vertex) first_vertex = previous_vertex;
          }
@@ -247,7 +253,7 @@ draw_cut_style_cap_callback (int iloop,
 
       if (!first_vertex) first_vertex = cap[iloop-1];
       COLINEAR (is_colinear, previous_vertex, cap[0], first_vertex);
-      if (!is_colinear) gluTessVertex (tobj, cap[0], cap[0]);
+      if (!is_colinear) TESS_VERTEX (tobj, cap[0]);
 
       gluEndPolygon (tobj);
 #endif /* DELICATE_TESSELATOR */
@@ -259,6 +265,7 @@ draw_cut_style_cap_callback (int iloop,
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
 
+   GLE_STATS_POP ();
 }
 #endif /* NONCONCAVE_ENDCAPS */
 
@@ -269,11 +276,11 @@ draw_cut_style_cap_callback (int iloop,
 
 static void 
 null_cap_callback (int iloop,
-                        double cap[][3], 
+                        gleDouble cap[][3], 
                         float face_color[3],
                         gleDouble cut_vector[3],
                         gleDouble bisect_vector[3],
-                        double norms[][3], 
+                        gleDouble norms[][3], 
                         int frontwards)
 {}
 
@@ -344,14 +351,14 @@ static void draw_fillet_triangle_n_norms
                            int face,
                            float front_color[3],
                            float back_color[3],
-                           double na[3],
-                           double nb[3])
+                           gleDouble na[3],
+                           gleDouble nb[3])
 {
 
    if (front_color != NULL) C3F (front_color);
    BGNTMESH (-5, 0.0);
    if (__TUBE_DRAW_FACET_NORMALS) {
-      N3F_D (na);
+      N3F (na);
       if (face) {
          V3F (va, INVALID_BUG_NEEDS_FIXING, FILLET);
          V3F (vb, INVALID_BUG_NEEDS_FIXING, FILLET);
@@ -362,16 +369,16 @@ static void draw_fillet_triangle_n_norms
       V3F (vc, INVALID_BUG_NEEDS_FIXING, FILLET);
    } else {
       if (face) {
-         N3F_D (na);
+         N3F (na);
          V3F (va, INVALID_BUG_NEEDS_FIXING, FILLET);
-         N3F_D (nb);
+         N3F (nb);
          V3F (vb, INVALID_BUG_NEEDS_FIXING, FILLET);
       } else {
-         N3F_D (nb);
+         N3F (nb);
          V3F (vb, INVALID_BUG_NEEDS_FIXING, FILLET);
-         N3F_D (na);
+         N3F (na);
          V3F (va, INVALID_BUG_NEEDS_FIXING, FILLET);
-         N3F_D (nb);
+         N3F (nb);
       }
       V3F (vc, INVALID_BUG_NEEDS_FIXING, FILLET);
    }
@@ -396,13 +403,13 @@ static void draw_fillets_and_join_plain
 {
    int istop;
    int icnt, icnt_prev, iloop;
-   double *cap_loop;
+   gleDouble *cap_loop;
    gleDouble sect[3];
    gleDouble tmp_vec[3];
    int save_style = 0;
    int was_trimmed = FALSE;
 
-   cap_loop = (double *) malloc (((size_t)ncp+3)*3*sizeof (double));
+   cap_loop = (gleDouble *) gle_malloc (((size_t)ncp+3)*3*sizeof (gleDouble));
    
    /*
     * If the first point is trimmed, keep going until one
@@ -603,7 +610,7 @@ draw_fillets_and_join_n_norms
                     int is_trimmed[],
                     gleDouble bis_origin[3], 
                     gleDouble bis_vector[3], 
-                    double normals[][3],
+                    gleDouble normals[][3],
                     float front_color[3],
                     float back_color[3],
                     gleDouble cut_vector[3], 
@@ -612,14 +619,14 @@ draw_fillets_and_join_n_norms
 {
    int istop;
    int icnt, icnt_prev, iloop;
-   double *cap_loop, *norm_loop;
+   gleDouble *cap_loop, *norm_loop;
    gleDouble sect[3];
    gleDouble tmp_vec[3]; 
    int save_style = 0;
    int was_trimmed = FALSE;
 
    save_style = gleGetJoinStyle ();
-   cap_loop = (double *) malloc (((size_t)ncp+3)*3*2*sizeof (double));
+   cap_loop = (gleDouble *) gle_malloc (((size_t)ncp+3)*3*2*sizeof (gleDouble));
    norm_loop = cap_loop + (ncp+3)*3;
    
    /* 
@@ -850,21 +857,17 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
    int inext, inextnext;
    gleDouble m[4][4];
    gleDouble tube_len, seg_len;
-   gleDouble diff[3];
    gleDouble bi_0[3], bi_1[3];		/* bisecting plane */
    gleDouble bisector_0[3], bisector_1[3];		/* bisecting plane */
    gleDouble cut_0[3], cut_1[3];	/* cutting planes */
    gleDouble lcut_0[3], lcut_1[3];	/* cutting planes */
    int valid_cut_0, valid_cut_1;	/* flag -- cut vector is valid */
-   gleDouble end_point_0[3], end_point_1[3]; 
-   gleDouble torsion_point_0[3], torsion_point_1[3]; 
-   gleDouble isect_point[3];
    gleDouble origin[3], neg_z[3];
    gleDouble yup[3];		/* alternate up vector */
    gleDouble *front_cap, *back_cap;	/* arrays containing the end caps */
    gleDouble *front_loop, *back_loop; /* arrays containing the tube ends */
-   double *front_norm, *back_norm; /* arrays containing normal vecs */
-   double *norm_loop=0x0, *tmp; /* normal vectors, cast into 3d from 2d */
+   gleDouble *front_norm, *back_norm; /* arrays containing normal vecs */
+   gleDouble *norm_loop=0x0, *tmp; /* normal vectors, cast into 3d from 2d */
    int *front_is_trimmed, *back_is_trimmed;   /* T or F */
    float *front_color, *back_color;  /* pointers to segment colors */
    gleCapCallback cap_callback = 0x0 ;  /* function callback to draw cap */
@@ -874,6 +877,11 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
    char *mem_anchor;
    int first_time = TRUE;
    gleDouble *cut_vec;
+   int has_xform;		/* TRUE if contour is transformed */
+   gleRingXform xf_0, xf_1;	/* contour transforms at either end */
+   gleDouble *ring_0, *ring_1;	/* transformed contours at either end */
+   gleDouble *front_sect, *back_sect;	/* bisecting plane intersections */
+   gleJoinPath path;		/* bisecting and cutting planes of the path */
 
    /* create a local, block scope copy of of the join style.
     * this will alleviate wasted cycles and register write-backs */
@@ -909,17 +917,25 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
    neg_z[1] = 0.0;
    neg_z[2] = 1.0;
 
+   /* get all of the bisecting and cutting planes, skipping over
+    * segments of zero length */
+   if (!join_path_planes (&path, npoints, point_array, TRUE)) return;
+
    /* malloc the data areas that we'll need to store the end-caps */
-   mem_anchor = malloc (4 * 3*(size_t)ncp*sizeof(gleDouble)
-                      + 2 * 3*(size_t)ncp*sizeof(double)
+   mem_anchor = gle_malloc (8 * 3*(size_t)ncp*sizeof(gleDouble)
+                      + 2 * 3*(size_t)ncp*sizeof(gleDouble)
                       + 2 * 1*(size_t)ncp*sizeof(int));
-   front_norm = (double *) mem_anchor;
+   front_norm = (gleDouble *) mem_anchor;
    back_norm = front_norm + 3*ncp;
    front_loop = (gleDouble *) (back_norm + 3*ncp);
    back_loop = front_loop + 3*ncp;
    front_cap = back_loop + 3*ncp;
    back_cap  = front_cap + 3*ncp;
-   front_is_trimmed = (int *) (back_cap + 3*ncp);
+   ring_0 = back_cap + 3*ncp;
+   ring_1 = ring_0 + 3*ncp;
+   front_sect = ring_1 + 3*ncp;
+   back_sect = front_sect + 3*ncp;
+   front_is_trimmed = (int *) (back_sect + 3*ncp);
    back_is_trimmed = front_is_trimmed + ncp;
 
    /* ======================================= */
@@ -928,13 +944,16 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
 
    /* ignore all segments of zero length */
    i = 1;
-   inext = i;
-   FIND_NON_DEGENERATE_POINT (inext, npoints, seg_len, diff, point_array);
+   inext = path.next[i];
+   seg_len = path.len[i];
    tube_len = seg_len;	/* store for later use */
 
+   has_xform = __TUBE_HAS_XFORM (xform_array);
+   xf_1.index = -1;
+
    /* may as well get the normals set up now */
    if (cont_normal != NULL) {
-      if (xform_array == NULL) {
+      if (!has_xform) {
          norm_loop = front_norm;
          back_norm = norm_loop;
          for (j=0; j<ncp; j++) {
@@ -943,11 +962,9 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
             norm_loop[3*j+2] = 0.0;
          }
       } else {
+         ring_xform (&xf_1, xform_array, inext-1);
+         ring_norm_contour (ncp, (gleVector *) front_norm, &xf_1, cont_normal);
          for (j=0; j<ncp; j++) {
-            NORM_XFORM_2X2 ( (&front_norm[3*j]),
-                              xform_array[inext-1],
-                              cont_normal [j]);
-            front_norm[3*j+2] = 0.0;
             back_norm[3*j+2] = 0.0;
          }
       }
@@ -955,15 +972,23 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
       front_norm = back_norm = norm_loop = NULL;
    }
 
+   /* without transforms, both ends of every segment see the same
+    * contour; lay it out once, the way the ring transforms would */
+   if (!has_xform) {
+      ring_1 = ring_0;
+      for (j=0; j<ncp; j++) {
+         ring_0[3*j] = contour[j][0];
+         ring_0[3*j+1] = contour[j][1];
+         ring_0[3*j+2] = 0.0;
+      }
+   }
+
    /* get the bisecting plane */
-   bisecting_plane (bi_0, point_array[i-1], 
-                          point_array[i], 
-                          point_array[inext]);
-
-   /* compute cutting plane */
-   CUTTING_PLANE (valid_cut_0, cut_0, point_array[i-1], 
-                         point_array[i], 
-                         point_array[inext]);
+   VEC_COPY (bi_0, path.bi[i]);
+
+   /* get the cutting plane */
+   VEC_COPY (cut_0, path.cut[i]);
+   valid_cut_0 = path.valid_cut[i];
    
    /* reflect the up vector in the bisecting plane */
    VEC_REFLECT (yup, yup, bi_0);
@@ -971,27 +996,26 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
    /* |-|-|-|-|-|-|-|-| START LOOP OVER SEGMENTS |-|-|-|-|-|-|-| */
 
    /* draw tubing, not doing the first segment */
+   GLE_STATS_PHASE (GLE_STATS_JOIN);
    while (inext<npoints-1) {
 
-      inextnext = inext;
+      GLE_STATS_COUNT (segments, 1);
+
       /* ignore all segments of zero length */
-      FIND_NON_DEGENERATE_POINT (inextnext, npoints, 
-                                 seg_len, diff, point_array);
+      inextnext = path.next[inext];
+      seg_len = path.len[inext];
 
       /* get the far bisecting plane */
-      bisecting_plane (bi_1, point_array[i], 
-                             point_array[inext], 
-                             point_array[inextnext]);
+      VEC_COPY (bi_1, path.bi[inext]);
 
-
-      /* compute cutting plane */
-      CUTTING_PLANE (valid_cut_1, cut_1, point_array[i], 
-                            point_array[inext], 
-                            point_array[inextnext]);  
+      /* get the far cutting plane */
+      VEC_COPY (cut_1, path.cut[inext]);
+      valid_cut_1 = path.valid_cut[inext];
 
       /* rotate so that z-axis points down v2-v1 axis, 
        * and so that origen is at v1 */
-      uviewpoint (m, point_array[i], point_array[inext], yup);
+      uviewpoint (m, PATH_POINT (point_array, i),
+                     PATH_POINT (point_array, inext), yup);
       PUSHMATRIX ();
       MULTMATRIX (m);
 
@@ -1006,90 +1030,78 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
 
       neg_z[2] = -tube_len;
 
+      /* transform the contour for both ends of the segment, and
+       * if there are normals, compute the local coordinate system
+       * back normals with the inverse transpose. (The front normals
+       * we inherit from previous pass through the loop).  */
+      if (has_xform) {
+         RING_XFORM (xf_0, xf_1, xform_array, inext-1);
+         ring_xform (&xf_1, xform_array, inext);
+         ring_dot_contour (ncp, (gleVector *) ring_0, &xf_0, contour, 0.0);
+         ring_dot_contour (ncp, (gleVector *) ring_1, &xf_1, contour, 0.0);
+         if (cont_normal != NULL) {
+            ring_norm_contour (ncp, (gleVector *) back_norm, &xf_1, cont_normal);
+         }
+      }
+
       /* draw the tube */
       /* --------- START OF TMESH GENERATION -------------- */
+
+      /* Each contour point defines a line running from the front
+       * end of the segment (ring_0, at z=0) to the back end (ring_1,
+       * at z=-tube_len).  The torsion lines run straight down the
+       * z axis from either end.  Intersect whole rings of these 
+       * against the clipping planes defined by the PREVIOUS and the
+       * NEXT tube segments.  */
+
+      /* if this and the last tube are co-linear, don't cut the angle
+       * if you do, a divide by zero will result.  This and last tube
+       * are co-linear when the cut vector is of zero length */
+      if (valid_cut_0 && join_style_is_cut) {
+         intersect_ring (ncp, (gleVector *) front_loop, origin, lcut_0,
+                         (gleVector *) ring_0, 0.0,
+                         (gleVector *) ring_1, - tube_len);
+         if (lcut_0[2] < 0.0) { VEC_SCALE (lcut_0, -1.0, lcut_0); }
+      }
+      intersect_ring (ncp, (gleVector *) front_sect, origin, bisector_0,
+                      (gleVector *) ring_0, 0.0,
+                      (gleVector *) ring_0, - tube_len);
+
+      if (valid_cut_1 && join_style_is_cut) {
+         intersect_ring (ncp, (gleVector *) back_loop, neg_z, lcut_1,
+                         (gleVector *) ring_1, - tube_len,
+                         (gleVector *) ring_0, 0.0);
+         if (lcut_1[2] > 0.0) { VEC_SCALE (lcut_1, -1.0, lcut_1); }
+      }
+      intersect_ring (ncp, (gleVector *) back_sect, neg_z, bisector_1,
+                      (gleVector *) ring_1, 0.0,
+                      (gleVector *) ring_1, - tube_len);
+
       for (j=0; j<ncp; j++) {
 
-         /* set up the endpoints for segment clipping */
-         if (xform_array == NULL) {
-            VEC_COPY_2 (end_point_0, contour[j]);
-            VEC_COPY_2 (end_point_1, contour[j]);
-            VEC_COPY_2 (torsion_point_0, contour[j]);
-            VEC_COPY_2 (torsion_point_1, contour[j]);
-         } else {
-            /* transform the contour points with the local xform */
-            MAT_DOT_VEC_2X3 (end_point_0,
-                             xform_array[inext-1], contour[j]);
-            MAT_DOT_VEC_2X3 (torsion_point_0,
-                             xform_array[inext], contour[j]);
-            MAT_DOT_VEC_2X3 (end_point_1,
-                             xform_array[inext], contour[j]);
-            MAT_DOT_VEC_2X3 (torsion_point_1,
-                             xform_array[inext-1], contour[j]);
-
-            /* if there are normals and there are affine xforms,
-             * then compute local coordinate system normals.
-             * Set up the back normals. (The front normals we inherit
-             * from previous pass through the loop).  */
-            if (cont_normal != NULL) {
-               /* do up the normal vectors with the inverse transpose */
-               NORM_XFORM_2X2 ( (&back_norm[3*j]),
-                                xform_array[inext],
-                                cont_normal [j]);
-            }
-         }
-         end_point_0 [2] = 0.0;
-         torsion_point_0 [2] = 0.0;
-         end_point_1 [2] = - tube_len;
-         torsion_point_1 [2] = - tube_len;
-
-         /* The two end-points define a line.  Intersect this line
-          * against the clipping plane defined by the PREVIOUS
-          * tube segment.  */
-
-         /* if this and the last tube are co-linear, don't cut the angle
-          * if you do, a divide by zero will result.  This and last tube
-          * are co-linear when the cut vector is of zero length */
+         /* determine whether the raw end of the extrusion would have
+          * been cut, by checking to see if the raw and is on the 
+          * far end of the half-plane defined by the cut vector.
+          * If the raw end is not "cut", then it is "trimmed".
+          */
          if (valid_cut_0 && join_style_is_cut) {
-             INNERSECT (isect_point,  /* isect point (returned) */
-                       origin,		/* point on intersecting plane */
-                       lcut_0,		/* normal vector to plane */
-                       end_point_0,	/* point on line */
-                       end_point_1);	/* another point on the line */	
-
-            /* determine whether the raw end of the extrusion would have
-             * been cut, by checking to see if the raw and is on the 
-             * far end of the half-plane defined by the cut vector.
-             * If the raw end is not "cut", then it is "trimmed".
-             */
-            if (lcut_0[2] < 0.0) { VEC_SCALE (lcut_0, -1.0, lcut_0); }
-            dot = lcut_0[0] * end_point_0[0];
-            dot += lcut_0[1] * end_point_0[1];
-
-            VEC_COPY ((&front_loop[3*j]), isect_point);
+            dot = lcut_0[0] * ring_0[3*j];
+            dot += lcut_0[1] * ring_0[3*j+1];
          } else {
             /* actual value of dot not interseting; need 
              * only be positive so that if test below failes */
             dot = 1.0;   
-            VEC_COPY ((&front_loop[3*j]), end_point_0);
+            VEC_COPY_2 ((&front_loop[3*j]), (&ring_0[3*j]));
+            front_loop[3*j+2] = 0.0;
          }
 
-         INNERSECT (isect_point, 	/* intersection point (returned) */
-                    origin,		/* point on intersecting plane */
-                    bisector_0,		/* normal vector to plane */
-                    end_point_0,	/* point on line */
-                    torsion_point_1);	/* another point on the line */	
-
          /* trim out interior of intersecting tube */
          /* ... but save the untrimmed version for drawing the endcaps */
          /* ... note that cap contains valid data ONLY when is_trimmed
           * is TRUE. */
-         if ((dot <= 0.0) || (isect_point[2] < front_loop[3*j+2])) {
-/*
-         if ((dot <= 0.0) || (front_loop[3*j+2] > 0.0)) {
-*/
+         if ((dot <= 0.0) || (front_sect[3*j+2] < front_loop[3*j+2])) {
             VEC_COPY ((&front_cap[3*j]), (&front_loop [3*j]));
-            VEC_COPY ((&front_loop[3*j]), isect_point);
+            VEC_COPY ((&front_loop[3*j]), (&front_sect[3*j]));
             front_is_trimmed[j] = TRUE;
          } else {
             front_is_trimmed[j] = FALSE;
@@ -1100,54 +1112,30 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
           * Note that coding front_loop [3*j+2] = -tube_len;
           * doesn't work when twists are involved, */
          if (front_loop[3*j+2] < -tube_len) {
-            VEC_COPY( (&front_loop[3*j]), end_point_1);
+            VEC_COPY_2 ((&front_loop[3*j]), (&ring_1[3*j]));
+            front_loop[3*j+2] = - tube_len;
          } 
 
          /* --------------------------------------------------- */
-         /* The two end-points define a line.  We did one endpoint 
-          * above. Now do the other.Intersect this line
-          * against the clipping plane defined by the NEXT
-          * tube segment.  */
-
-         /* if this and the last tube are co-linear, don't cut the angle
-          * if you do, a divide by zero will result.  This and last tube
-          * are co-linear when the cut vector is of zero length */
+         /* Now do the other end, against the NEXT tube segment. */
          if (valid_cut_1 && join_style_is_cut) {
-            INNERSECT (isect_point,  /* isect point (returned) */
-                       neg_z,		/* point on intersecting plane */
-                       lcut_1,		/* normal vector to plane */
-                       end_point_1,	/* point on line */
-                       end_point_0);	/* another point on the line */	
-
-            if (lcut_1[2] > 0.0) { VEC_SCALE (lcut_1, -1.0, lcut_1); }
-            dot = lcut_1[0] * end_point_1[0];
-            dot += lcut_1[1] * end_point_1[1];
-
-   
-            VEC_COPY ((&back_loop[3*j]), isect_point);
+            dot = lcut_1[0] * ring_1[3*j];
+            dot += lcut_1[1] * ring_1[3*j+1];
          } else {
             /* actual value of dot not interseting; need 
              * only be positive so that if test below failes */
             dot = 1.0;   
-            VEC_COPY ((&back_loop[3*j]), end_point_1);
+            VEC_COPY_2 ((&back_loop[3*j]), (&ring_1[3*j]));
+            back_loop[3*j+2] = - tube_len;
          }
 
-         INNERSECT (isect_point, 	/* intersection point (returned) */
-                    neg_z,		/* point on intersecting plane */
-                    bisector_1,		/* normal vector to plane */
-                    torsion_point_0,	/* point on line */
-                    end_point_1);	/* another point on the line */	
-
          /* cut out interior of intersecting tube */
          /* ... but save the uncut version for drawing the endcaps */
          /* ... note that cap contains valid data ONLY when is
           *_trimmed is TRUE. */
-/*
-        if ((dot <= 0.0) || (back_loop[3*j+2] < -tube_len)) {
-*/
-        if ((dot <= 0.0) || (isect_point[2] > back_loop[3*j+2])) {
+         if ((dot <= 0.0) || (back_sect[3*j+2] > back_loop[3*j+2])) {
             VEC_COPY ((&back_cap[3*j]), (&back_loop [3*j]));
-            VEC_COPY ((&back_loop[3*j]), isect_point);
+            VEC_COPY ((&back_loop[3*j]), (&back_sect[3*j]));
             back_is_trimmed[j] = TRUE;
          } else {
             back_is_trimmed[j] = FALSE;
@@ -1158,7 +1146,8 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
           * Note that coding back_loop [3*j+2] = 0.0;
           * doesn't work when twists are involved, */
          if (back_loop[3*j+2] > 0.0) {
-            VEC_COPY( (&back_loop[3*j]), end_point_0);
+            VEC_COPY_2 ((&back_loop[3*j]), (&ring_0[3*j]));
+            back_loop[3*j+2] = 0.0;
          } 
       }
 
@@ -1169,7 +1158,7 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
        * absecnce of colors and normals, and for interpretation of
        * normals. The blechy set of nested if statements below
        * branch to each of the six cases */
-      if (xform_array == NULL) {
+      if (!has_xform) {
          if (color_array == NULL) {
             if (cont_normal == NULL) {
                draw_segment_plain (ncp, (gleVector *) front_loop, (gleVector *) back_loop, inext, seg_len);
@@ -1184,19 +1173,19 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
          } else {
             if (cont_normal == NULL) {
                draw_segment_color (ncp, (gleVector *) front_loop, (gleVector *) back_loop, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
             } else
             if (__TUBE_DRAW_FACET_NORMALS) {
                draw_segment_c_and_facet_n (ncp, 
                                    (gleVector *) front_loop, (gleVector *) back_loop, (gleVector *) norm_loop,
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
             } else {
                draw_segment_c_and_edge_n (ncp, 
                                    (gleVector *) front_loop, (gleVector *) back_loop, (gleVector *) norm_loop,
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
              }
           }
       } else {
@@ -1216,21 +1205,21 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
          } else {
             if (cont_normal == NULL) {
                draw_segment_color (ncp, (gleVector *) front_loop, (gleVector *) back_loop, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
             } else
             if (__TUBE_DRAW_FACET_NORMALS) {
                draw_binorm_segment_c_and_facet_n (ncp, 
                                    (gleVector *) front_loop, (gleVector *) back_loop, 
                                    (gleVector *) front_norm, (gleVector *) back_norm, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
             } else {
                draw_binorm_segment_c_and_edge_n (ncp, 
                                    (gleVector *) front_loop, (gleVector *) back_loop,
                                    (gleVector *) front_norm, (gleVector *) back_norm, 
-                                   color_array[inext-1],
-                                   color_array[inext], inext, seg_len);
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext), inext, seg_len);
              }
           }
       }
@@ -1245,7 +1234,7 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
          tmp_cap_callback = cap_callback;
          cap_callback = null_cap_callback;
          if (__TUBE_DRAW_CAP) {
-            if (color_array != NULL) C3F (color_array[inext-1]);
+            if (color_array != NULL) C3F (PATH_COLOR (color_array, inext-1));
             draw_angle_style_front_cap (ncp, bisector_0, 
                                        (gleVector *) front_loop);
          }
@@ -1257,8 +1246,8 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
        * Now, draw the fillet triangles, and the join-caps.
        */
       if (color_array != NULL) {
-         front_color = color_array[inext-1];
-         back_color = color_array[inext];
+         front_color = PATH_COLOR (color_array, inext-1);
+         back_color = PATH_COLOR (color_array, inext);
       } else {
          front_color = NULL;
          back_color = NULL;
@@ -1288,7 +1277,7 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
          /* v^v^v^v^v^v^v^v^v  BEGIN END CAPS v^v^v^v^v^v^v^v^v^v^v^v */
          if (inext == npoints-2) {
             if (__TUBE_DRAW_CAP) {
-               if (color_array != NULL) C3F (color_array[inext]);
+               if (color_array != NULL) C3F (PATH_COLOR (color_array, inext));
                draw_angle_style_back_cap (ncp, bisector_1, 
                                            (gleVector *) back_loop);
                cap_callback = null_cap_callback;
@@ -1344,7 +1333,7 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
          /* v^v^v^v^v^v^v^v^v  BEGIN END CAPS v^v^v^v^v^v^v^v^v^v^v^v */
          if (inext == npoints-2) {
             if (__TUBE_DRAW_CAP) {
-               if (color_array != NULL) C3F (color_array[inext]);
+               if (color_array != NULL) C3F (PATH_COLOR (color_array, inext));
                draw_angle_style_back_cap (ncp, bisector_1, 
                                          (gleDouble (*)[3]) back_loop);
                cap_callback = null_cap_callback;
@@ -1400,6 +1389,7 @@ extrusion_round_or_cut_join (int ncp,	/* number of contour points */
    /* |-|-|-|-|-|-|-|-| END LOOP OVER SEGMENTS |-|-|-|-|-|-|-| */
 
    free (mem_anchor);
+   join_path_free (&path);
 
 }
    
@@ -0,0 +1,92 @@
+/*
+ * FILE:
+ * ex_float.c
+ *
+ * FUNCTION:
+ * Framework file to build the single-precision extrusion engine.
+ * The join, segment, cap, ring and path code is compiled a second
+ * time here, with __GLE_DOUBLE set to 0, so that gleDouble is float:
+ * the contours, paths, rings and normals are float from end to end,
+ * and go out as glVertex3fv and glNormal3fv.  The routines get an _f
+ * suffix, as the _c4f ones do in ex_alpha.c; the entry points are
+ * the glePolyCylinder_f ... gleSuperExtrusion_f of gle.h.  This file
+ * makes up libgle_f, which links against libgle for the GC, the
+ * statistics and the join style, circle and texture mode settings.
+ *
+ * The path coordinates handed to the *_f routines are taken to be
+ * relative to an origin, set with gleSetOrigin().  The origin is held
+ * in double precision and applied as a single translation on the
+ * modelview matrix, so that paths located far away from the world
+ * origin do not lose their low-order bits to float round-off.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#define __GLE_DOUBLE 0
+
+/* The entry points */
+#define gleSuperExtrusion              gleSuperExtrusion_f
+#define gleExtrusion                   gleExtrusion_f
+#define glePolyCylinder                glePolyCylinder_f
+#define glePolyCone                    glePolyCone_f
+#define gleTwistExtrusion              gleTwistExtrusion_f
+
+/* and everything underneath them */
+#define extrusion_raw_join             extrusion_raw_join_f
+#define extrusion_angle_join           extrusion_angle_join_f
+#define extrusion_round_or_cut_join    extrusion_round_or_cut_join_f
+#define draw_raw_style_end_cap         draw_raw_style_end_cap_f
+#define draw_angle_style_front_cap     draw_angle_style_front_cap_f
+#define draw_angle_style_back_cap      draw_angle_style_back_cap_f
+#define draw_round_style_cap_callback  draw_round_style_cap_callback_f
+#define up_sanity_check                up_sanity_check_f
+
+#define draw_segment_plain             draw_segment_plain_f
+#define draw_segment_color             draw_segment_color_f
+#define draw_segment_edge_n            draw_segment_edge_n_f
+#define draw_segment_c_and_edge_n      draw_segment_c_and_edge_n_f
+#define draw_segment_facet_n           draw_segment_facet_n_f
+#define draw_segment_c_and_facet_n     draw_segment_c_and_facet_n_f
+#define draw_binorm_segment_edge_n     draw_binorm_segment_edge_n_f
+#define draw_binorm_segment_c_and_edge_n draw_binorm_segment_c_and_edge_n_f
+#define draw_binorm_segment_facet_n    draw_binorm_segment_facet_n_f
+#define draw_binorm_segment_c_and_facet_n draw_binorm_segment_c_and_facet_n_f
+
+#define ring_xform                     ring_xform_f
+#define ring_dot_contour               ring_dot_contour_f
+#define ring_norm_contour              ring_norm_contour_f
+#define ring_kernel_select             ring_kernel_select_f
+#define join_path_planes               join_path_planes_f
+#define join_path_free                 join_path_free_f
+#define intersect_ring                 intersect_ring_f
+#define intersect                      intersect_f
+#define bisecting_plane                bisecting_plane_f
+#define uview_direction                uview_direction_f
+#define uviewpoint                     uviewpoint_f
+#define urot_axis                      urot_axis_f
+#define urot_about_axis                urot_about_axis_f
+#define urot_omega                     urot_omega_f
+
+#define gle_trace_polycone             gle_trace_polycone_f
+#define gle_trace_extrusion            gle_trace_extrusion_f
+#define gle_texgen_select              gle_texgen_select_f
+
+/* Now include the source files ! */
+
+#include "extrude.c"
+#include "ex_angle.c"
+#include "ex_cut_round.c"
+#include "ex_raw.c"
+#include "round_cap.c"
+#include "segment.c"
+#include "ring.c"
+#include "path.c"
+#include "intersect.c"
+#include "view.c"
+#include "urotate.c"
+#include "texgen.c"
+#include "trace.c"
+
+/* ===================== END OF FILE ======================== */
@@ -58,7 +58,7 @@ void up_sanity_check (gleDouble up[3],	/* up vector for contour */
 
    /* now, right off the bat, we should make sure that the up vector 
     * is in fact perpendicular to the polyline direction */
-   VEC_DIFF (diff, point_array[1], point_array[0]);
+   VEC_DIFF (diff, PATH_POINT (point_array, 1), PATH_POINT (point_array, 0));
    VEC_LENGTH (len, diff);
    if (len == 0.0) {
       /* This error message should go through an "official" error interface */
@@ -70,7 +70,8 @@ void up_sanity_check (gleDouble up[3],	/* up vector for contour */
 
       /* loop till we find something that ain't of zero length */
       for (i=1; i<npoints-2; i++) {
-         VEC_DIFF (diff, point_array[i+1], point_array[i]);
+         VEC_DIFF (diff, PATH_POINT (point_array, i+1),
+                         PATH_POINT (point_array, i));
          VEC_LENGTH (len, diff);
          if (len != 0.0) break;
       }
@@ -119,10 +120,12 @@ void draw_raw_style_end_cap (int ncp,		/* number of contour points */
 
 #ifdef OPENGL_10
    GLUtriangulatorObj *tobj;
-   double *pts;
+   gleDouble *pts;
 #endif /* OPENGL_10 */
 
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
 #ifdef GL_32
    /* Old-style gl handles concave polygons no problem, so the code is
     * simple.  New-style gl is a lot more tricky. */
@@ -149,10 +152,11 @@ void draw_raw_style_end_cap (int ncp,		/* number of contour points */
 
 #ifdef OPENGL_10
    /* malloc the @#$%^&* array that OpenGL wants ! */
-   pts = (double *) malloc (3*(size_t)ncp*sizeof(double));
+   pts = (gleDouble *) gle_malloc (3*(size_t)ncp*sizeof(gleDouble));
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr)glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr)glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr)glEnd);
    gluBeginPolygon (tobj);
 
@@ -162,7 +166,7 @@ void draw_raw_style_end_cap (int ncp,		/* number of contour points */
             pts [3*j] = contour[j][0];
             pts [3*j+1] = contour[j][1];
             pts [3*j+2] = zval;
-            gluTessVertex (tobj, &pts[3*j], &pts[3*j]);
+            TESS_VERTEX (tobj, &pts[3*j]);
          }
 
       } else {
@@ -171,7 +175,7 @@ void draw_raw_style_end_cap (int ncp,		/* number of contour points */
             pts [3*j] = contour[j][0];
             pts [3*j+1] = contour[j][1];
             pts [3*j+2] = zval;
-            gluTessVertex (tobj, &pts[3*j], &pts[3*j]);
+            TESS_VERTEX (tobj, &pts[3*j]);
          }
       }
 
@@ -179,6 +183,8 @@ void draw_raw_style_end_cap (int ncp,		/* number of contour points */
    free (pts);
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
+
+   GLE_STATS_POP ();
 }
 
 #endif /* COLOR_SIGNATURE */
@@ -197,6 +203,8 @@ draw_front_contour_cap (int ncp,	/* number of contour points */
    GLUtriangulatorObj *tobj;
 #endif /* OPENGL_10 */
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
 #ifdef GL_32
    /* old-style gl handles concave polygons no problem, so the code is
     * simple.  New-style gl is a lot more tricky. */
@@ -210,18 +218,21 @@ draw_front_contour_cap (int ncp,	/* number of contour points */
 #endif /* GL_32 */
 
 #ifdef OPENGL_10
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr)glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr)glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr)glEnd);
    gluBeginPolygon (tobj);
 
    for (j=0; j<ncp; j++) {
-      gluTessVertex (tobj, contour[j], contour[j]);
+      TESS_VERTEX (tobj, contour[j]);
    }
    gluEndPolygon (tobj);
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
+
+   GLE_STATS_POP ();
 }
 
 
@@ -240,6 +251,8 @@ draw_back_contour_cap (int ncp,	/* number of contour points */
    GLUtriangulatorObj *tobj;
 #endif /* OPENGL_10 */
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
 #ifdef GL_32
    /* old-style gl handles concave polygons no problem, so the code is
     * simple.  New-style gl is a lot more tricky. */
@@ -256,9 +269,10 @@ draw_back_contour_cap (int ncp,	/* number of contour points */
 #endif /* GL_32 */
 
 #ifdef OPENGL_10
+   GLE_STATS_COUNT (tessellations, 1);
    tobj = gluNewTess ();
    gluTessCallback (tobj, GLU_BEGIN, (_GLUfuncptr)glBegin);
-   gluTessCallback (tobj, GLU_VERTEX, (_GLUfuncptr)glVertex3dv);
+   gluTessCallback (tobj, GLU_VERTEX, TESS_VERTEX_CALLBACK);
    gluTessCallback (tobj, GLU_END, (_GLUfuncptr)glEnd);
    gluBeginPolygon (tobj);
 
@@ -266,11 +280,13 @@ draw_back_contour_cap (int ncp,	/* number of contour points */
    /* draw the loop clockwise for the back cap */
    /* the sense of the loop is reversed for backfacing culling */
    for (j=ncp-1; j>-1; j--) {
-      gluTessVertex (tobj, contour[j], contour[j]);
+      TESS_VERTEX (tobj, contour[j]);
    }
    gluEndPolygon (tobj);
    gluDeleteTess (tobj);
 #endif /* OPENGL_10 */
+
+   GLE_STATS_POP ();
 }
 
 /* ============================================================ */
@@ -288,7 +304,7 @@ draw_raw_segment_plain (int ncp,		/* number of contour points */
 
 {
    int j;
-   double point[3]; 
+   gleDouble point[3]; 
 
    /* draw the tube segment */
    BGNTMESH (inext, len);
@@ -342,7 +358,7 @@ draw_raw_segment_color (int ncp,		/* number of contour points */
 
 {
    int j;
-   double point[3]; 
+   gleDouble point[3]; 
 
    /* draw the tube segment */
    BGNTMESH (inext, len);
@@ -350,11 +366,11 @@ draw_raw_segment_color (int ncp,		/* number of contour points */
       point [0] = contour[j][0];
       point [1] = contour[j][1];
       point [2] = 0.0;
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
       V3F (point, j, FRONT);
 
       point [2] = - len;
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       V3F (point, j, BACK);
    }
 
@@ -364,11 +380,11 @@ draw_raw_segment_color (int ncp,		/* number of contour points */
       point [1] = contour[0][1];
       point [2] = 0.0;
    
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
       V3F (point, 0, FRONT);
    
       point [2] = - len;
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       V3F (point, 0, BACK);
    }
 
@@ -378,11 +394,11 @@ draw_raw_segment_color (int ncp,		/* number of contour points */
    if (__TUBE_DRAW_CAP) {
 
       /* draw the front cap */
-      C3F (color_array[inext-1]);	
+      C3F (PATH_COLOR (color_array, inext-1));	
       draw_raw_style_end_cap (ncp, contour, 0.0, TRUE);
 
       /* draw the back cap */
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       draw_raw_style_end_cap (ncp, contour, -len, FALSE);
    }
 
@@ -404,8 +420,8 @@ draw_raw_segment_edge_n (int ncp,	/* number of contour points */
 
 {
    int j;
-   double point[3]; 
-   double norm[3]; 
+   gleDouble point[3]; 
+   gleDouble norm[3]; 
 
    /* draw the tube segment */
    norm [2] = 0.0;
@@ -476,14 +492,14 @@ draw_raw_segment_c_and_edge_n (int ncp,	/* number of contour points */
 
 {
    int j;
-   double point[3]; 
-   double norm[3];
+   gleDouble point[3]; 
+   gleDouble norm[3];
 
    /* draw the tube segment */
    norm [2] = 0.0;
    BGNTMESH (inext, len);
    for (j=0; j<ncp; j++) {
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
 
       norm [0] = cont_normal[j][0];
       norm [1] = cont_normal[j][1];
@@ -494,7 +510,7 @@ draw_raw_segment_c_and_edge_n (int ncp,	/* number of contour points */
       point [2] = 0.0;
       V3F (point, j, FRONT);
 
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       N3F (norm);
 
       point [2] = - len;
@@ -503,7 +519,7 @@ draw_raw_segment_c_and_edge_n (int ncp,	/* number of contour points */
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
    
       norm [0] = cont_normal[0][0];
       norm [1] = cont_normal[0][1];
@@ -515,7 +531,7 @@ draw_raw_segment_c_and_edge_n (int ncp,	/* number of contour points */
       V3F (point, 0, FRONT);
       
    
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       norm [0] = cont_normal[0][0];
       norm [1] = cont_normal[0][1];
       N3F (norm);
@@ -530,14 +546,14 @@ draw_raw_segment_c_and_edge_n (int ncp,	/* number of contour points */
    if (__TUBE_DRAW_CAP) {
 
       /* draw the front cap */
-      C3F (color_array[inext-1]);	
+      C3F (PATH_COLOR (color_array, inext-1));	
       norm [0] = norm [1] = 0.0;
       norm [2] = 1.0;
       N3F (norm);
       draw_raw_style_end_cap (ncp, contour, 0.0, TRUE);
 
       /* draw the back cap */
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       norm [2] = -1.0;
       N3F (norm);
       draw_raw_style_end_cap (ncp, contour, -len, FALSE);
@@ -561,8 +577,8 @@ draw_raw_segment_facet_n (int ncp,	/* number of contour points */
 
 {
    int j;
-   double point[3]; 
-   double norm[3]; 
+   gleDouble point[3]; 
+   gleDouble norm[3]; 
 
    /* draw the tube segment */
    norm [2] = 0.0;
@@ -649,8 +665,8 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
 
 {
    int j;
-   double point[3]; 
-   double norm[3]; 
+   gleDouble point[3]; 
+   gleDouble norm[3]; 
 
    /* draw the tube segment */
    norm [2] = 0.0;
@@ -662,7 +678,7 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
        * automatically trigger the lighting equations -- it only
        * triggers when there is a local light) */
 
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
 
       norm [0] = cont_normal[j][0];
       norm [1] = cont_normal[j][1];
@@ -673,13 +689,13 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
       point [2] = 0.0;
       V3F (point, j, FRONT);
 
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       N3F (norm);
       point [2] = - len;
       V3F (point, j, BACK);
       
 
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
       N3F (norm);
 
       point [0] = contour[j+1][0];
@@ -687,7 +703,7 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
       point [2] = 0.0;
       V3F (point, j+1, FRONT);
 
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       N3F (norm);
       point [2] = - len;
       V3F (point, j+1, BACK);
@@ -698,20 +714,20 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
       point [0] = contour[ncp-1][0];
       point [1] = contour[ncp-1][1];
       point [2] = 0.0;
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
    
       norm [0] = cont_normal[ncp-1][0];
       norm [1] = cont_normal[ncp-1][1];
       N3F (norm);
       V3F (point, ncp-1, FRONT);
    
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       N3F (norm);
    
       point [2] = - len;
       V3F (point, ncp-1, BACK);
    
-      C3F (color_array[inext-1]);
+      C3F (PATH_COLOR (color_array, inext-1));
    
       norm [0] = cont_normal[0][0];
       norm [1] = cont_normal[0][1];
@@ -722,7 +738,7 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
       point [2] = 0.0;
       V3F (point, 0, FRONT);
    
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       N3F (norm);
    
       point [2] = - len;
@@ -735,14 +751,14 @@ draw_raw_segment_c_and_facet_n (int ncp,	/* number of contour points */
    if (__TUBE_DRAW_CAP) {
 
       /* draw the front cap */
-      C3F (color_array[inext-1]);	
+      C3F (PATH_COLOR (color_array, inext-1));	
       norm [0] = norm [1] = 0.0;
       norm [2] = 1.0;
       N3F (norm);
       draw_raw_style_end_cap (ncp, contour, 0.0, TRUE);
 
       /* draw the back cap */
-      C3F (color_array[inext]);	
+      C3F (PATH_COLOR (color_array, inext));	
       norm [2] = -1.0;
       N3F (norm);
       draw_raw_style_end_cap (ncp, contour, -len, FALSE);
@@ -775,6 +791,7 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
    gleDouble yup[3];		/* alternate up vector */
    gleDouble nrmv[3];
    short no_norm, no_cols, no_xform;     /*booleans */
+   gleRingXform xf_0, xf_1;	/* contour transforms at either end */
    char *mem_anchor = 0x0;
    gleDouble *front_loop=0x0, *back_loop=0x0;  /* countour loops */
    gleDouble *front_norm=0x0, *back_norm=0x0;  /* countour loops */
@@ -784,11 +801,11 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
    /* use some local variables for needed booleans */
    no_norm = (cont_normal == NULL);
    no_cols = (color_array == NULL);
-   no_xform = (xform_array == NULL);
+   no_xform = ! __TUBE_HAS_XFORM (xform_array);
 
    /* alloc loop arrays if needed */
    if (! no_xform) {
-      mem_anchor = malloc (4 * (size_t)ncp * 3 * sizeof(gleDouble));
+      mem_anchor = gle_malloc (4 * (size_t)ncp * 3 * sizeof(gleDouble));
       front_loop = (gleDouble *) mem_anchor;
       back_loop = front_loop + 3*ncp;
       front_norm = back_loop + 3*ncp;
@@ -812,39 +829,38 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
    i = 1;
    inext = i;
    FIND_NON_DEGENERATE_POINT (inext, npoints, len, diff, point_array);
+   GLE_STATS_COUNT (degenerate_points, inext - i - 1);
 
    /* first time through, get the loops */
    if (! no_xform) {
-      for (j=0; j<ncp; j++) {
-            MAT_DOT_VEC_2X3 ((&front_loop[3*j]), 
-                             xform_array[inext-1], contour[j]);
-            front_loop[3*j+2] = 0.0;
-      }
+      ring_xform (&xf_0, xform_array, inext-1);
+      ring_dot_contour (ncp, (gleVector *) front_loop, &xf_0, contour, 0.0);
       if (!no_norm) {
+         ring_norm_contour (ncp, (gleVector *) front_norm, &xf_0, cont_normal);
          for (j=0; j<ncp; j++) {
-            NORM_XFORM_2X2 ( (&front_norm[3*j]),
-                             xform_array[inext-1],
-                             cont_normal [j]);
-            front_norm[3*j+2] = 0.0;
             back_norm[3*j+2] = 0.0;
          }
       }
    }
 
    /* draw tubing, not doing the first segment */
+   GLE_STATS_PHASE (GLE_STATS_JOIN);
    while (inext<npoints-1) {
 
+      GLE_STATS_COUNT (segments, 1);
+
       /* get the two bisecting planes */
-      bisecting_plane (bi_0, point_array[i-1], 
-                             point_array[i], 
-                             point_array[inext]);
+      bisecting_plane (bi_0, PATH_POINT (point_array, i-1), 
+                             PATH_POINT (point_array, i), 
+                             PATH_POINT (point_array, inext));
 
       /* reflect the up vector in the bisecting plane */
       VEC_REFLECT (yup, yup, bi_0);
 
       /* rotate so that z-axis points down v2-v1 axis, 
        * and so that origen is at v1 */
-      uviewpoint (m, point_array[i], point_array[inext], yup);
+      uviewpoint (m, PATH_POINT (point_array, i),
+                     PATH_POINT (point_array, inext), yup);
       PUSHMATRIX ();
       MULTMATRIX (m);
 
@@ -883,19 +899,14 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
       } else {
 
          /* else -- there are scales and offsets to deal with */
+         ring_xform (&xf_1, xform_array, inext);
+         ring_dot_contour (ncp, (gleVector *) back_loop, &xf_1, contour, -len);
          for (j=0; j<ncp; j++) {
-            MAT_DOT_VEC_2X3 ((&back_loop[3*j]), 
-                             xform_array[inext], contour[j]);
-            back_loop[3*j+2] = -len;
             front_loop[3*j+2] = 0.0;
          }
 
          if (!no_norm) {
-            for (j=0; j<ncp; j++) {
-               NORM_XFORM_2X2 ( (&back_norm[3*j]),
-                                             xform_array[inext],
-                                             cont_normal [j]);
-            }
+            ring_norm_contour (ncp, (gleVector *) back_norm, &xf_1, cont_normal);
          }
 
          if (no_cols) {
@@ -928,8 +939,8 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
                draw_segment_color (ncp, 
                                    (gleVector *) front_loop, 
                                    (gleVector *) back_loop,
-                                   color_array[inext-1],
-                                   color_array[inext],
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext),
                                    inext, len);
             } else
             if (__TUBE_DRAW_FACET_NORMALS) {
@@ -938,8 +949,8 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
                                    (gleVector *) back_loop,
                                    (gleVector *) front_norm,
                                    (gleVector *) back_norm,
-                                   color_array[inext-1],
-                                   color_array[inext],
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext),
                                    inext, len);
             } else {
                draw_binorm_segment_c_and_edge_n (ncp,
@@ -947,16 +958,16 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
                                    (gleVector *) back_loop,
                                    (gleVector *) front_norm, 
                                    (gleVector *) back_norm,
-                                   color_array[inext-1],
-                                   color_array[inext],
+                                   PATH_COLOR (color_array, inext-1),
+                                   PATH_COLOR (color_array, inext),
                                    inext, len);
             }
             if (__TUBE_DRAW_CAP) {
-                C3F (color_array[inext-1]);
+                C3F (PATH_COLOR (color_array, inext-1));
                 nrmv[2] = 1.0; N3F (nrmv);
                 draw_front_contour_cap (ncp, (gleVector *) front_loop);
 
-                C3F (color_array[inext]);
+                C3F (PATH_COLOR (color_array, inext));
                 nrmv[2] = -1.0; N3F (nrmv);
                 draw_back_contour_cap (ncp, (gleVector *) back_loop);
             }
@@ -977,6 +988,7 @@ void extrusion_raw_join (int ncp,		/* number of contour points */
       i = inext;
       /* ignore all segments of zero length */
       FIND_NON_DEGENERATE_POINT (inext, npoints, len, diff, point_array);
+      GLE_STATS_COUNT (degenerate_points, inext - i - 1);
 
    }
 
@@ -0,0 +1,162 @@
+/*
+ * FILE:
+ * ex_stride.c
+ *
+ * FUNCTION:
+ * Strided entry points for the extrusion library.  These take a base
+ * pointer plus a byte stride for each of the per-vertex arrays
+ * (points, colors, radii, twists and affines), in the manner of
+ * glVertexPointer(), so that applications keeping their data as an
+ * array of structures can hand it to GLE without first packing it.
+ *
+ * Nothing is copied: the strides are left in the GC for the length
+ * of the call, and the engine reads every path array through them
+ * (see PATH_POINT and friends in tube_gc.h).  A stride of zero, or of
+ * the size of the element, means the array is tightly packed.  A
+ * negative stride is refused, and nothing is drawn.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#include <stdio.h>	/* to get stderr defined */
+#include <stdlib.h>
+
+#include "gle.h"
+#include "port.h"
+#include "tube_gc.h"
+
+/* ============================================================ */
+/* Leaves the strides in the GC, for the call about to be made.
+ * Returns FALSE, having complained, if any of them is negative. */
+
+static int
+set_strides (int point_stride, int color_stride,
+             int xform_stride, int scalar_stride)
+{
+   if ((0 > point_stride) || (0 > color_stride) ||
+       (0 > xform_stride) || (0 > scalar_stride)) {
+      fprintf (stderr, "GLE: Warning: negative array stride; "
+                       "nothing drawn\n");
+      return FALSE;
+   }
+
+   _gle_gc -> point_stride = point_stride;
+   _gle_gc -> color_stride = color_stride;
+   _gle_gc -> xform_stride = xform_stride;
+   _gle_gc -> scalar_stride = scalar_stride;
+   return TRUE;
+}
+
+/* and back to packed, for the calls that take packed arrays */
+static void
+clear_strides (void)
+{
+   _gle_gc -> point_stride = 0;
+   _gle_gc -> color_stride = 0;
+   _gle_gc -> xform_stride = 0;
+   _gle_gc -> scalar_stride = 0;
+}
+
+/* ============================================================ */
+
+void gleSuperExtrusionStrided (int ncp,  /* number of contour points */
+                gleDouble contour[][2],    /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                void *points, int point_stride,     /* gleDouble[3] */
+                void *colors, int color_stride,     /* gleColor, or NULL */
+                void *xforms, int xform_stride)     /* gleAffine, or NULL */
+{
+   INIT_GC();
+   if (!set_strides (point_stride, color_stride, xform_stride, 0)) return;
+
+   gleSuperExtrusion (ncp, contour, cont_normal, up, npoints,
+                      (gleDouble (*)[3]) points,
+                      (gleColor *) colors,
+                      (gleDouble (*)[2][3]) xforms);
+
+   clear_strides ();
+}
+
+/* ============================================================ */
+
+void gleExtrusionStrided (int ncp,  /* number of contour points */
+                gleDouble contour[][2],    /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                void *points, int point_stride,     /* gleDouble[3] */
+                void *colors, int color_stride)     /* gleColor, or NULL */
+{
+   INIT_GC();
+   if (!set_strides (point_stride, color_stride, 0, 0)) return;
+
+   gleExtrusion (ncp, contour, cont_normal, up, npoints,
+                 (gleDouble (*)[3]) points,
+                 (gleColor *) colors);
+
+   clear_strides ();
+}
+
+/* ============================================================ */
+
+void gleTwistExtrusionStrided (int ncp,  /* number of contour points */
+                gleDouble contour[][2],    /* 2D contour */
+                gleDouble cont_normal[][2], /* 2D contour normals */
+                gleDouble up[3],           /* up vector for contour */
+                int npoints,           /* numpoints in poly-line */
+                void *points, int point_stride,     /* gleDouble[3] */
+                void *colors, int color_stride,     /* gleColor, or NULL */
+                void *twists, int twist_stride)     /* gleDouble, degrees */
+{
+   INIT_GC();
+   if (!set_strides (point_stride, color_stride, 0, twist_stride)) return;
+
+   gleTwistExtrusion (ncp, contour, cont_normal, up, npoints,
+                      (gleDouble (*)[3]) points,
+                      (gleColor *) colors,
+                      (gleDouble *) twists);
+
+   clear_strides ();
+}
+
+/* ============================================================ */
+
+void glePolyCylinderStrided (int npoints,
+                   void *points, int point_stride,     /* gleDouble[3] */
+                   void *colors, int color_stride,     /* gleColor, or NULL */
+                   gleDouble radius)
+{
+   INIT_GC();
+   if (!set_strides (point_stride, color_stride, 0, 0)) return;
+
+   glePolyCylinder (npoints,
+                    (gleDouble (*)[3]) points,
+                    (gleColor *) colors,
+                    radius);
+
+   clear_strides ();
+}
+
+/* ============================================================ */
+
+void glePolyConeStrided (int npoints,
+                   void *points, int point_stride,     /* gleDouble[3] */
+                   void *colors, int color_stride,     /* gleColor, or NULL */
+                   void *radii, int radius_stride)     /* gleDouble */
+{
+   INIT_GC();
+   if (!set_strides (point_stride, color_stride, 0, radius_stride)) return;
+
+   glePolyCone (npoints,
+                (gleDouble (*)[3]) points,
+                (gleColor *) colors,
+                (gleDouble *) radii);
+
+   clear_strides ();
+}
+
+/* ===================== END OF FILE ======================== */
@@ -29,15 +29,20 @@
 #include "tube_gc.h"
 #include "extrude.h"
 #include "intersect.h"
+#include "trace.h"
+
+/* floats per color; four in the _c4f build, see ex_alpha.c */
+#define COLOR_SIZE ((int) (sizeof (gleColor) / sizeof (float)))
 
 /* ============================================================ */
-#ifndef COLOR_SIGNATURE
+#if !defined(COLOR_SIGNATURE) && __GLE_DOUBLE
 /* The routine below  determines the type of join style that will be
  * used for tubing. */
 
 void gleSetJoinStyle (int style) 
 {
    INIT_GC();
+   GLE_TRACE_SETTING (gle_trace_int (GLE_TRACE_JOIN_STYLE, style));
    extrusion_join_style = style;
 }
 
@@ -47,6 +52,95 @@ int gleGetJoinStyle (void)
    return (extrusion_join_style);
 }
 
+/* ============================================================ */
+/* The origin that the single-precision (*_f) paths are relative to.
+ * It is sticky: it stays in effect for all subsequent *_f calls,
+ * until changed. */
+
+void gleSetOrigin (gleDouble origin[3])
+{
+   INIT_GC();
+   if (origin) {
+      _gle_gc -> origin[0] = origin[0];
+      _gle_gc -> origin[1] = origin[1];
+      _gle_gc -> origin[2] = origin[2];
+   } else {
+      _gle_gc -> origin[0] = 0.0;
+      _gle_gc -> origin[1] = 0.0;
+      _gle_gc -> origin[2] = 0.0;
+   }
+   GLE_TRACE_SETTING (gle_trace_origin (_gle_gc -> origin));
+}
+
+void gleGetOrigin (gleDouble origin[3])
+{
+   INIT_GC();
+   origin[0] = _gle_gc -> origin[0];
+   origin[1] = _gle_gc -> origin[1];
+   origin[2] = _gle_gc -> origin[2];
+}
+
+#endif /* !COLOR_SIGNATURE && __GLE_DOUBLE */
+/* ============================================================ */
+#ifndef COLOR_SIGNATURE
+/* Fill in the contour transform for path vertex n.  See extrude.h */
+
+void ring_xform (gleRingXform *r,
+                 gleDouble xform_array[][2][3],
+                 int n)
+{
+   double angle;
+
+   r->index = n;
+   r->kind = _gle_gc->xform_kind;
+
+   switch (r->kind) {
+      case CONTOUR_XFORM_SCALE:
+         r->a = PATH_SCALAR (n);
+         r->b = 0.0;
+         break;
+
+      case CONTOUR_XFORM_TWIST:
+         angle = (M_PI/180.0) * PATH_SCALAR (n);
+         r->a = cos (angle);
+         r->b = sin (angle);
+         break;
+
+      default:
+         r->m = PATH_XFORM (xform_array, n);
+         break;
+   }
+}
+
+#if !__GLE_DOUBLE
+/* ============================================================ */
+/* push the origin onto the modelview stack, for the float build.  The
+ * origin is held in double precision, and only multiplied in if it is
+ * not the world origin. */
+
+static void
+push_origin (void)
+{
+   double m[4][4];
+
+   PUSHMATRIX();
+
+   if ((0.0 == _gle_gc->origin[0]) &&
+       (0.0 == _gle_gc->origin[1]) &&
+       (0.0 == _gle_gc->origin[2])) return;
+
+   m[0][0] = 1.0; m[0][1] = 0.0; m[0][2] = 0.0; m[0][3] = 0.0;
+   m[1][0] = 0.0; m[1][1] = 1.0; m[1][2] = 0.0; m[1][3] = 0.0;
+   m[2][0] = 0.0; m[2][1] = 0.0; m[2][2] = 1.0; m[2][3] = 0.0;
+   m[3][0] = _gle_gc->origin[0];
+   m[3][1] = _gle_gc->origin[1];
+   m[3][2] = _gle_gc->origin[2];
+   m[3][3] = 1.0;
+
+   MULTMATRIX_D (m);
+}
+
+#endif /* !__GLE_DOUBLE */
 #endif /* COLOR_SIGNATURE */
 /* ============================================================ */
 /*
@@ -63,6 +157,13 @@ void gleSuperExtrusion (int ncp,               /* number of contour points */
                 gleDouble xform_array[][2][3])   /* 2D contour xforms */
 {   
    INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_SUPER_EXTRUSION);
+   GLE_TRACE_ENTER (gle_trace_extrusion (GLE_TRACE_SUPER_EXTRUSION,
+                       ncp, contour, cont_normal, up,
+                       npoints, point_array,
+                       (float *) color_array, COLOR_SIZE,
+                       NULL, xform_array));
+
    _gle_gc -> ncp = ncp;
    _gle_gc -> contour = contour;
    _gle_gc -> cont_normal = cont_normal;
@@ -72,6 +173,14 @@ void gleSuperExtrusion (int ncp,               /* number of contour points */
    _gle_gc -> color_array = color_array;
    _gle_gc -> xform_array = xform_array;
 
+#if !__GLE_DOUBLE
+   /* gleTextureMode() hooks up the double-precision mappers only */
+   _gle_gc -> v3f_gen_texture = 0x0;
+   _gle_gc -> n3f_gen_texture = 0x0;
+   (void) gle_texgen_select (_gle_gc -> texture_style);
+   push_origin ();
+#endif /* !__GLE_DOUBLE */
+
    switch (__TUBE_STYLE) {
       case TUBE_JN_RAW:
          (void) extrusion_raw_join (ncp, contour, cont_normal, up,
@@ -99,6 +208,13 @@ void gleSuperExtrusion (int ncp,               /* number of contour points */
       default:
          break;
    }
+
+#if !__GLE_DOUBLE
+   POPMATRIX ();
+#endif /* !__GLE_DOUBLE */
+
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
@@ -111,10 +227,19 @@ void gleExtrusion (int ncp,               /* number of contour points */
                 gleDouble point_array[][3],        /* polyline */
                 gleColor color_array[])        /* color of polyline */
 {   
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_EXTRUSION);
+   GLE_TRACE_ENTER (gle_trace_extrusion (GLE_TRACE_EXTRUSION,
+                       ncp, contour, cont_normal, up,
+                       npoints, point_array,
+                       (float *) color_array, COLOR_SIZE,
+                       NULL, NULL));
    gleSuperExtrusion (ncp, contour, cont_normal, up,
                     npoints,
                     point_array, color_array,
                     NULL);
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
@@ -126,10 +251,10 @@ gen_polycone (int npoints,
                gleDouble point_array[][3],
                gleColor color_array[],
                gleDouble radius,
-               gleDouble xform_array[][2][3])
+               gleDouble radius_array[])
 {
    int saved_style;
-   gleTwoVec *circle, *norm;
+   gleDouble (*circle)[2], (*norm)[2];
    int i, nslices;
    double v21[3];
    double len;
@@ -142,7 +267,7 @@ gen_polycone (int npoints,
 
    /* this if statement forces this routine into double-duty for
     * both the polycone and the polycylinder routines */
-   if (xform_array != NULL) radius = 1.0;
+   if (radius_array != NULL) radius = 1.0;
 
    /* draw a norm using recursion relations */
    for (i=0; i<nslices; i++) {
@@ -168,18 +293,28 @@ gen_polycone (int npoints,
    saved_style = extrusion_join_style;
    extrusion_join_style |= TUBE_CONTOUR_CLOSED;
 
+   /* the radii are applied as a uniform scale on each ring; 
+    * no affine array is needed for that. */
+   if (radius_array != NULL) {
+      _gle_gc -> xform_kind = CONTOUR_XFORM_SCALE;
+      _gle_gc -> xform_scalars = radius_array;
+   }
+
    /* if lighting is not turned on, don't send normals.  
     * MMODE is a good indicator of whether lighting is active */
    if (!__IS_LIGHTING_ON) {
        gleSuperExtrusion (nslices, circle, NULL, up,
                      npoints, point_array, color_array,
-                     xform_array);
+                     NULL);
    } else {
        gleSuperExtrusion (nslices, circle, norm, up,
                      npoints, point_array, color_array,
-                     xform_array);
+                     NULL);
    }
    
+   _gle_gc -> xform_kind = CONTOUR_XFORM_AFFINE;
+   _gle_gc -> xform_scalars = NULL;
+
    /* restore the join style */
    extrusion_join_style = saved_style;
 }
@@ -191,7 +326,15 @@ void glePolyCylinder (int npoints,
                    gleColor color_array[],
                    gleDouble radius)
 {
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_POLYCYLINDER);
+   GLE_TRACE_ENTER (gle_trace_polycone (GLE_TRACE_POLYCYLINDER,
+                       npoints, point_array,
+                       (float *) color_array, COLOR_SIZE,
+                       radius, NULL));
    gen_polycone (npoints, point_array, color_array, radius, NULL);
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
@@ -201,23 +344,15 @@ void glePolyCone (int npoints,
                gleColor color_array[],
                gleDouble radius_array[])
 {
-   gleAffine * xforms;
-   int j;
-
-   /* build 2D affine matrices from radius array */
-   xforms = (gleAffine *) malloc ((size_t)npoints * sizeof(gleAffine));
-   for (j=0; j<npoints; j++) {
-      AVAL(xforms,j,0,0) = radius_array[j];
-      AVAL(xforms,j,0,1) = 0.0;
-      AVAL(xforms,j,0,2) = 0.0;
-      AVAL(xforms,j,1,0) = 0.0;
-      AVAL(xforms,j,1,1) = radius_array[j];
-      AVAL(xforms,j,1,2) = 0.0;
-   }
-
-   gen_polycone (npoints, point_array, color_array, 1.0, xforms);
-
-   free (xforms);
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_POLYCONE);
+   GLE_TRACE_ENTER (gle_trace_polycone (GLE_TRACE_POLYCONE,
+                       npoints, point_array,
+                       (float *) color_array, COLOR_SIZE,
+                       1.0, radius_array));
+   gen_polycone (npoints, point_array, color_array, 1.0, radius_array);
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
@@ -232,26 +367,18 @@ void gleTwistExtrusion (int ncp,         /* number of contour points */
                 gleDouble twist_array[])   /* countour twists (in degrees) */
 
 {
-   int j;
-   double angle;
-   double si, co;
-
-   gleAffine *xforms;
-
-   /* build 2D affine matrices from radius array */
-   xforms = (gleAffine *) malloc ((size_t)npoints * sizeof(gleAffine));
-
-   for (j=0; j<npoints; j++) {
-      angle = (M_PI/180.0) * twist_array[j];
-      si = sin (angle);
-      co = cos (angle);
-      AVAL(xforms,j,0,0) = co;
-      AVAL(xforms,j,0,1) = -si;
-      AVAL(xforms,j,0,2) = 0.0;
-      AVAL(xforms,j,1,0) = si;
-      AVAL(xforms,j,1,1) = co;
-      AVAL(xforms,j,1,2) = 0.0;
-   }
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_TWIST_EXTRUSION);
+   GLE_TRACE_ENTER (gle_trace_extrusion (GLE_TRACE_TWIST_EXTRUSION,
+                       ncp, contour, cont_normal, up,
+                       npoints, point_array,
+                       (float *) color_array, COLOR_SIZE,
+                       twist_array, NULL));
+
+   /* the twists are applied as a pure rotation on each ring, 
+    * computed by the join code; no affine array is needed. */
+   _gle_gc -> xform_kind = CONTOUR_XFORM_TWIST;
+   _gle_gc -> xform_scalars = twist_array;
 
    gleSuperExtrusion (ncp,               /* number of contour points */
                 contour,    /* 2D contour */
@@ -260,13 +387,17 @@ void gleTwistExtrusion (int ncp,         /* number of contour points */
                 npoints,           /* numpoints in poly-line */
                 point_array,        /* polyline */
                 color_array,        /* color of polyline */
-                xforms);
+                NULL);
+
+   _gle_gc -> xform_kind = CONTOUR_XFORM_AFFINE;
+   _gle_gc -> xform_scalars = NULL;
 
-   free (xforms);
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
-#ifndef COLOR_SIGNATURE
+#if !defined(COLOR_SIGNATURE) && __GLE_DOUBLE
 /* 
  * The spiral primitive forms the basis for the helicoid primitive.
  *
@@ -317,15 +448,22 @@ void gleSpiral (int ncp,               /* number of contour points */
    int i;
 
    INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_SPIRAL);
+   GLE_TRACE_ENTER (gle_trace_helix (GLE_TRACE_SPIRAL,
+                       ncp, contour, cont_normal, up, 0.0,
+                       startRadius, drdTheta, startZ, dzdTheta,
+                       startXform, dXformdTheta,
+                       startTheta, sweepTheta));
+
    /* allocate sufficient memory to store path */
    npoints = (int) ((((double) __TESS_SLICES) /360.0) * fabs(sweepTheta)) + 4;
 
    if (startXform == NULL) {
-      mem_anchor = malloc (3*(size_t)npoints * sizeof (gleDouble));
+      mem_anchor = gle_malloc (3*(size_t)npoints * sizeof (gleDouble));
       pts = (gleDouble *) mem_anchor;
       xforms = NULL;
    } else {
-      mem_anchor = malloc ((1+2)* 3*(size_t)npoints * sizeof (gleDouble));
+      mem_anchor = gle_malloc ((1+2)* 3*(size_t)npoints * sizeof (gleDouble));
       pts = (gleDouble *) mem_anchor;
       xforms = (gleAffine *) (pts + 3*npoints);
    }
@@ -475,6 +613,8 @@ void gleSpiral (int ncp,               /* number of contour points */
 
    free (mem_anchor);
 
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 
@@ -500,6 +640,14 @@ void gleLathe (int ncp,               /* number of contour points */
    gleDouble trans[2];
    gleDouble start[2][3], delt[2][3];
 
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_LATHE);
+   GLE_TRACE_ENTER (gle_trace_helix (GLE_TRACE_LATHE,
+                       ncp, contour, cont_normal, up, 0.0,
+                       startRadius, drdTheta, startZ, dzdTheta,
+                       startXform, dXformdTheta,
+                       startTheta, sweepTheta));
+
    /* Because the spiral always starts on the axis, and proceeds in the
     * positive y direction, we can see that valid up-vectors must lie 
     * in the x-z plane. Therefore, we make sure we have a valid up
@@ -573,6 +721,9 @@ void gleLathe (int ncp,               /* number of contour points */
               start, delt,
               startTheta, sweepTheta);
    }
+
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 
@@ -679,6 +830,14 @@ void gleHelicoid (gleDouble rToroid,
              gleDouble startTheta,	      /* start angle, in degrees */
              gleDouble sweepTheta)        /* sweep angle, in degrees */
 {
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_HELICOID);
+   GLE_TRACE_ENTER (gle_trace_helix (GLE_TRACE_HELICOID,
+                       0, NULL, NULL, NULL, rToroid,
+                       startRadius, drdTheta, startZ, dzdTheta,
+                       startXform, dXformdTheta,
+                       startTheta, sweepTheta));
+
    super_helix (rToroid,
              startRadius,
              drdTheta,        /* change in radius per revolution */
@@ -689,6 +848,9 @@ void gleHelicoid (gleDouble rToroid,
              startTheta,	      /* start angle, in degrees */
              sweepTheta,       /* sweep angle, in degrees */
              gleSpiral);
+
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 
@@ -709,6 +871,14 @@ void gleToroid (gleDouble rToroid,
              gleDouble startTheta,	      /* start angle, in degrees */
              gleDouble sweepTheta)        /* sweep angle, in degrees */
 {
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_TOROID);
+   GLE_TRACE_ENTER (gle_trace_helix (GLE_TRACE_TOROID,
+                       0, NULL, NULL, NULL, rToroid,
+                       startRadius, drdTheta, startZ, dzdTheta,
+                       startXform, dXformdTheta,
+                       startTheta, sweepTheta));
+
    super_helix (rToroid,
              startRadius,
              drdTheta,        /* change in radius per revolution */
@@ -719,6 +889,9 @@ void gleToroid (gleDouble rToroid,
              startTheta,	      /* start angle, in degrees */
              sweepTheta,       /* sweep angle, in degrees */
              gleLathe);
+
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
 /* ============================================================ */
@@ -737,12 +910,38 @@ void gleScrew (int ncp,
    gleDouble currz, delta; 
    gleDouble currang, delang; 
 
+   INIT_GC();
+   GLE_STATS_ENTER (GLE_STATS_SCREW);
+   GLE_TRACE_ENTER (gle_trace_screw (ncp, contour, cont_normal, up,
+                       startz, endz, twist));
+
    /* no segment should rotate more than 18 degrees */
    numsegs = (int) fabs (twist / 18.0) + 4;
 
+   /* the angle join along a straight axis needs no path at all:
+    * the rings are worked out from their place along it */
+   if (TUBE_JN_ANGLE == __TUBE_STYLE) {
+      _gle_gc -> ncp = ncp;
+      _gle_gc -> contour = contour;
+      _gle_gc -> cont_normal = cont_normal;
+      _gle_gc -> up = up;
+      _gle_gc -> npoints = numsegs;
+      _gle_gc -> point_array = NULL;
+      _gle_gc -> color_array = NULL;
+      _gle_gc -> xform_array = NULL;
+
+      extrusion_straight_join (ncp, contour, cont_normal, up, numsegs-2,
+                               startz, (endz-startz) / ((gleDouble) (numsegs-3)),
+                               twist / ((gleDouble) (numsegs-3)));
+
+      GLE_TRACE_LEAVE ();
+      GLE_STATS_LEAVE ();
+      return;
+   }
+
    /* malloc the extrusion array and the twist array */
-   path = (gleVector *) malloc ((size_t)numsegs * sizeof (gleVector));
-   twarr = (gleDouble *) malloc ((size_t)numsegs * sizeof (gleDouble));
+   path = (gleVector *) gle_malloc ((size_t)numsegs * sizeof (gleVector));
+   twarr = (gleDouble *) gle_malloc ((size_t)numsegs * sizeof (gleDouble));
 
    /* fill in the extrusion array and the twist array uniformly */
    delta = (endz-startz) / ((gleDouble) (numsegs-3));
@@ -762,7 +961,10 @@ void gleScrew (int ncp,
 
    free (path);
    free (twarr);
+
+   GLE_TRACE_LEAVE ();
+   GLE_STATS_LEAVE ();
 }
 
-#endif /* COLOR_SIGNATURE */
+#endif /* !COLOR_SIGNATURE && __GLE_DOUBLE */
 /* ============================================================ */
@@ -27,6 +27,109 @@
 #define INNERSECT(sect,p,n,v1,v2) intersect(sect,p,n,v1,v2)
 #endif /* INLINE_INTERSECT */
 
+/* ============================================================ */
+/* Contour transforms.
+ *
+ * In general, the contour is transformed at each path vertex by a 
+ * 2x3 affine taken from the xform array.  The polycone and the twist
+ * extrusion only ever need a uniform scale, or a pure rotation; for
+ * these, the radii (or twist angles) are stashed in the GC, and the
+ * join code builds the much simpler transform once per ring, instead
+ * of reading it out of a malloc'ed affine array.
+ */
+
+#define CONTOUR_XFORM_AFFINE	0
+#define CONTOUR_XFORM_SCALE	1
+#define CONTOUR_XFORM_TWIST	2
+
+typedef struct {
+   int index;           /* path vertex that this transform belongs to */
+   int kind;            /* one of the CONTOUR_XFORM defines above */
+   gleDouble a, b;      /* scale, or cosine and sine of the twist */
+   gleDouble (*m)[3];   /* the affine, in the general case */
+} gleRingXform;
+
+/* TRUE if the contour is transformed at all */
+#define __TUBE_HAS_XFORM(xform_array) \
+   ((NULL != (xform_array)) || (CONTOUR_XFORM_AFFINE != _gle_gc->xform_kind))
+
+/* set up ring transform r for path vertex n; reuse the previous ring
+ * transform, if it was for the same vertex */
+#define RING_XFORM(r,prev,xform_array,n) {			\
+   if ((prev).index == (n)) {					\
+      (r) = (prev);						\
+   } else {							\
+      ring_xform (&(r), xform_array, n);			\
+   }								\
+}
+
+extern void 
+ring_xform (gleRingXform *r,              /* ring transform (returned) */
+            gleDouble xform_array[][2][3], /* 2D contour xforms, or NULL */
+            int n);                       /* path vertex */
+
+/* Apply a ring transform to the whole contour (or to the whole set
+ * of contour normals) at once.  A uniform scale leaves the normals 
+ * alone; a rotation rotates them like any other vector; an affine
+ * applies its inverse transpose.  The SIMD kernel that does the work
+ * is chosen at run time. See ring.c */
+#define RING_KERNEL_SCALAR	0
+#define RING_KERNEL_SSE2	1
+#define RING_KERNEL_AVX2	2
+
+extern int 
+ring_kernel_select (int level);           /* -1 picks the best available */
+
+extern void 
+ring_dot_contour (int ncp,                /* number of contour points */
+            gleDouble loop[][3],          /* 3D contour loop (returned) */
+            gleRingXform *r,              /* ring transform */
+            gleDouble contour[][2],       /* 2D contour */
+            gleDouble z);                 /* z value for the loop */
+
+extern void 
+ring_norm_contour (int ncp,               /* number of contour points */
+            gleDouble norm[][3],             /* 3D normal loop (returned) */
+            gleRingXform *r,              /* ring transform */
+            gleDouble cont_normal[][2]);  /* 2D contour normals */
+
+/* ============================================================ */
+/* Batch join geometry.  The bisecting planes (and the cutting planes,
+ * for the cut and round join styles) of the whole path are computed
+ * in one go, before any drawing is done.  The arrays are indexed by
+ * path vertex; next[i] and len[i] are what FIND_NON_DEGENERATE_POINT
+ * would have returned, starting at vertex i.  See path.c */
+
+typedef struct {
+   int *next;            /* next non-degenerate vertex */
+   gleDouble *len;       /* length of the last step taken to get there */
+   gleDouble (*bi)[3];   /* bisecting plane at each vertex */
+   gleDouble (*cut)[3];  /* cutting plane at each vertex, or NULL */
+   int *valid_cut;       /* TRUE if the cutting plane is valid */
+   char *mem_anchor;
+} gleJoinPath;
+
+extern int 
+join_path_planes (gleJoinPath *jp,        /* path geometry (returned) */
+            int npoints,                  /* numpoints in poly-line */
+            gleDouble point_array[][3],   /* polyline */
+            int want_cuts);               /* TRUE to compute cut planes */
+
+extern void 
+join_path_free (gleJoinPath *jp);
+
+/* Intersect a ring of lines with a plane, as the INTERSECT macro does
+ * for a single line.  Line j runs from (xy1[j], z1) to (xy2[j], z2). */
+extern void 
+intersect_ring (int ncp,                  /* number of contour points */
+            gleDouble sect[][3],          /* intersections (returned) */
+            gleDouble p[3],               /* point on plane */
+            gleDouble n[3],               /* plane normal */
+            gleDouble xy1[][3],           /* first point of each line */
+            gleDouble z1,                 /* z of first points */
+            gleDouble xy2[][3],           /* second point of each line */
+            gleDouble z2);                /* z of second points */
+
 /* ============================================================ */
 /* The folowing defines give a kludgy way of accessing the qmesh primitive */
 
@@ -57,20 +160,20 @@ draw_raw_style_end_cap (int ncp,             /* number of contour points */
 
 extern void 
 draw_round_style_cap_callback (int iloop,
-                    double cap[][3],
+                    gleDouble cap[][3],
                     gleColor face_color,
                     gleDouble cut_vector[3],
                     gleDouble bisect_vector[3],
-                    double norms[][3],
+                    gleDouble norms[][3],
                     int frontwards);
 
 extern void 
 draw_round_style_cap_callback_c4f (int iloop,
-                    double cap[][3],
+                    gleDouble cap[][3],
                     gleColor4f face_color,
                     gleDouble cut_vector[3],
                     gleDouble bisect_vector[3],
-                    double norms[][3],
+                    gleDouble norms[][3],
                     int frontwards);
 
 extern void 
@@ -137,5 +240,16 @@ extrusion_angle_join_c4f (int ncp,      /* number of contour points */
                     gleColor4f color_array[],        /* color of polyline */
                     gleDouble xform_array[][2][3]);  /* 2D contour xforms */
 
+/* the angle join along a straight, evenly stepped axis; see ex_angle.c */
+extern void 
+extrusion_straight_join (int ncp,      /* number of contour points */
+                    gleDouble contour[][2],    /* 2D contour */
+                    gleDouble cont_normal[][2],/* 2D contour normal vecs */
+                    gleDouble up[3],           /* up vector for contour */
+                    int nrings,                /* number of rings */
+                    gleDouble z0,              /* z of the first ring */
+                    gleDouble dz,              /* z step from ring to ring */
+                    gleDouble dtwist);         /* twist step, in degrees */
+
 #endif /* GLE_EXTRUDE_H_ */
 /* -------------------------- end of file -------------------------------- */
@@ -431,7 +431,8 @@ int bisecting_plane (gleDouble n[3],    /* returned */
 
 /* ============================================================ */
 /* This macro is used in several places to cycle through a series of
- * points to find the next non-degenerate point in a series */
+ * points to find the next non-degenerate point in a series.  The
+ * points are those of the path, read with PATH_POINT (see tube_gc.h) */
 
 #define FIND_NON_DEGENERATE_POINT(inext,npoints,len,diff,point_array)   \
 {                                                                       \
@@ -440,9 +441,11 @@ int bisecting_plane (gleDouble n[3],    /* returned */
    									\
    do {                                                                 \
       /* get distance to next point */                                  \
-      VEC_DIFF (diff, point_array[inext+1], point_array[inext]);        \
+      VEC_DIFF (diff, PATH_POINT (point_array, inext+1),                \
+                      PATH_POINT (point_array, inext));                 \
       VEC_LENGTH (len, diff);                                           \
-      VEC_SUM (summa, point_array[inext+1], point_array[inext]);        \
+      VEC_SUM (summa, PATH_POINT (point_array, inext+1),                \
+                      PATH_POINT (point_array, inext));                 \
       VEC_LENGTH (slen, summa);                                         \
       slen *= DEGENERATE_TOLERANCE;					\
       inext ++;                                                         \
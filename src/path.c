@@ -0,0 +1,319 @@
+/*
+ * FILE:
+ * path.c
+ *
+ * FUNCTION:
+ * Batch geometry for the join styles.  Rather than computing the
+ * bisecting (and cutting) plane of each path vertex as the join code
+ * gets to it, join_path_planes() computes all of them for the whole
+ * path up front, in a few straight passes over structure-of-arrays
+ * scratch storage.  Likewise, intersect_ring() intersects a whole
+ * contour ring with a plane in one pass, instead of one INTERSECT
+ * macro per contour point.
+ *
+ * The per-element arithmetic is exactly that of the
+ * FIND_NON_DEGENERATE_POINT, BISECTING_PLANE, CUTTING_PLANE and
+ * INTERSECT macros in intersect.h, operation for operation, so the
+ * results are bit-for-bit the same, including the handling of the
+ * degenerate cases (see DEGENERATE_TOLERANCE).  The difference is
+ * only that every case is computed, and the branches merely pick
+ * among the answers, so that the inner loops are straight-line code
+ * that the compiler can if-convert and vectorize.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "gle.h"
+#include "port.h"
+#include "vvector.h"
+#include "tube_gc.h"
+#include "extrude.h"
+#include "intersect.h"
+
+/* ============================================================ */
+/* Compute the segment-skipping table and the bisecting planes (and,
+ * if asked for, the cutting planes) for the whole path.  Returns
+ * FALSE if the path is too short to have any joins, or if memory
+ * could not be had.  The storage is released with join_path_free(). */
+
+int join_path_planes (gleJoinPath *jp,
+                      int npoints,
+                      gleDouble point_array[][3],
+                      int want_cuts)
+{
+   int k, m, v;
+   size_t sz;
+   gleDouble *ax, *ay, *az, *al;
+   gleDouble *p1, *p2;
+   int *deg, *seq;
+   double x21, y21, z21, l21, r21;
+   double x32, y32, z32, l32, r32;
+   double nx, ny, nz, nl, dot;
+   double slen;
+   int case1, case2, colin;
+
+   jp->mem_anchor = 0x0;
+   if (3 > npoints) return FALSE;
+
+   sz = (size_t) npoints * (4 * sizeof (gleDouble) + sizeof (int));
+   if (want_cuts) sz += (size_t) npoints * (3 * sizeof (gleDouble) + sizeof (int));
+   sz += (size_t) npoints * (4 * sizeof (gleDouble) + 2 * sizeof (int));
+
+   jp->mem_anchor = (char *) gle_malloc (sz);
+   if (!jp->mem_anchor) return FALSE;
+
+   /* doubles first, then ints, to keep everything aligned */
+   jp->len = (gleDouble *) jp->mem_anchor;
+   jp->bi = (gleDouble (*)[3]) &jp->len[npoints];
+   ax = (gleDouble *) &jp->bi[npoints];
+   jp->cut = 0x0;
+   if (want_cuts) {
+      jp->cut = (gleDouble (*)[3]) ax;
+      ax = (gleDouble *) &jp->cut[npoints];
+   }
+   ay = &ax[npoints];
+   az = &ay[npoints];
+   al = &az[npoints];
+   jp->next = (int *) &al[npoints];
+   deg = &jp->next[npoints];
+   seq = &deg[npoints];
+   jp->valid_cut = 0x0;
+   if (want_cuts) jp->valid_cut = &seq[npoints];
+
+   /* Pass one: the length of each step along the path, and whether
+    * the step is degenerate, in the sense of FIND_NON_DEGENERATE_POINT */
+   for (k=1; k<npoints-1; k++) {
+      p1 = PATH_POINT (point_array, k);
+      p2 = PATH_POINT (point_array, k+1);
+      x21 = p2[0] - p1[0];
+      y21 = p2[1] - p1[1];
+      z21 = p2[2] - p1[2];
+      l21 = x21*x21 + y21*y21;
+      l21 += z21*z21;
+      al[k] = sqrt (l21);
+
+      x32 = p2[0] + p1[0];
+      y32 = p2[1] + p1[1];
+      z32 = p2[2] + p1[2];
+      slen = x32*x32 + y32*y32;
+      slen += z32*z32;
+      slen = sqrt (slen);
+      slen *= DEGENERATE_TOLERANCE;
+      deg[k] = (al[k] <= slen);
+   }
+
+   /* Pass two: for each vertex, the vertex that FIND_NON_DEGENERATE_POINT
+    * would arrive at, and the length it would report.  Done back to
+    * front, so that runs of degenerate steps are resolved in one go. */
+   for (v=npoints-2; v>0; v--) {
+      if ((!deg[v]) || (v+1 >= npoints-1)) {
+         jp->next[v] = v+1;
+         jp->len[v] = al[v];
+      } else {
+         jp->next[v] = jp->next[v+1];
+         jp->len[v] = jp->len[v+1];
+      }
+   }
+
+   /* Pass three: walk the non-degenerate vertices in the order that
+    * the join code will visit them, gathering the segments between
+    * them.  The first point only ever gives a direction, and so the
+    * first segment is never skipped. */
+   seq[0] = 0;
+   seq[1] = 1;
+   m = 2;
+   while (seq[m-1] < npoints-1) {
+      seq[m] = jp->next[seq[m-1]];
+      m++;
+   }
+   GLE_STATS_COUNT (degenerate_points, npoints - m);
+
+   for (k=0; k<m-1; k++) {
+      p1 = PATH_POINT (point_array, seq[k]);
+      p2 = PATH_POINT (point_array, seq[k+1]);
+      ax[k] = p2[0] - p1[0];
+      ay[k] = p2[1] - p1[1];
+      az[k] = p2[2] - p1[2];
+   }
+   for (k=0; k<m-1; k++) {
+      l21 = ax[k]*ax[k] + ay[k]*ay[k];
+      l21 += az[k]*az[k];
+      al[k] = sqrt (l21);
+   }
+
+   /* Pass four: the bisecting plane at each interior vertex, as in
+    * the BISECTING_PLANE macro.  Which of the cases applies is worked
+    * out up front, and the answer selected at the end.  The reciprocal
+    * lengths are guarded, so that no infinities get computed in the
+    * cases that are not taken. */
+   for (k=1; k<m-1; k++) {
+      l21 = al[k-1];
+      l32 = al[k];
+      case1 = (l21 <= DEGENERATE_TOLERANCE * l32);
+      case2 = (l32 <= DEGENERATE_TOLERANCE * l21);
+
+      r21 = (0.0 != l21) ? 1.0 / l21 : 0.0;
+      r32 = (0.0 != l32) ? 1.0 / l32 : 0.0;
+      x21 = r21 * ax[k-1];
+      y21 = r21 * ay[k-1];
+      z21 = r21 * az[k-1];
+      x32 = r32 * ax[k];
+      y32 = r32 * ay[k];
+      z32 = r32 * az[k];
+
+      dot = x32*x21 + y32*y21 + z32*z21;
+      colin = ((dot >= (1.0-DEGENERATE_TOLERANCE)) ||
+               (dot <= (-1.0+DEGENERATE_TOLERANCE)));
+
+      nx = dot * (x32 + x21) - x32 - x21;
+      ny = dot * (y32 + y21) - y32 - y21;
+      nz = dot * (z32 + z21) - z32 - z21;
+      nl = nx*nx + ny*ny;
+      nl += nz*nz;
+      nl = sqrt (nl);
+      nl = (0.0 != nl) ? 1.0 / nl : 1.0;
+
+      v = seq[k];
+      if (case1 && (0.0 == l32)) {
+         /* all three points lie on top of one another */
+         jp->bi[v][0] = 0.0;
+         jp->bi[v][1] = 0.0;
+         jp->bi[v][2] = 0.0;
+      } else if (case1) {
+         jp->bi[v][0] = x32;
+         jp->bi[v][1] = y32;
+         jp->bi[v][2] = z32;
+      } else if (case2 || colin) {
+         jp->bi[v][0] = x21;
+         jp->bi[v][1] = y21;
+         jp->bi[v][2] = z21;
+      } else {
+         jp->bi[v][0] = nx * nl;
+         jp->bi[v][1] = ny * nl;
+         jp->bi[v][2] = nz * nl;
+      }
+
+      if (!want_cuts) continue;
+
+      /* and the cutting plane, as in the CUTTING_PLANE macro */
+      nx = x21 - x32;
+      ny = y21 - y32;
+      nz = z21 - z32;
+      nl = nx*nx + ny*ny;
+      nl += nz*nz;
+      nl = sqrt (nl);
+
+      if (case1 && (0.0 == l32)) {
+         jp->cut[v][0] = 0.0;
+         jp->cut[v][1] = 0.0;
+         jp->cut[v][2] = 0.0;
+         jp->valid_cut[v] = FALSE;
+      } else if (case1) {
+         jp->cut[v][0] = x32;
+         jp->cut[v][1] = y32;
+         jp->cut[v][2] = z32;
+         jp->valid_cut[v] = TRUE;
+      } else if (case2) {
+         jp->cut[v][0] = x21;
+         jp->cut[v][1] = y21;
+         jp->cut[v][2] = z21;
+         jp->valid_cut[v] = TRUE;
+      } else if (nl < DEGENERATE_TOLERANCE) {
+         jp->cut[v][0] = 0.0;
+         jp->cut[v][1] = 0.0;
+         jp->cut[v][2] = 0.0;
+         jp->valid_cut[v] = FALSE;
+      } else {
+         nl = 1.0 / nl;
+         jp->cut[v][0] = nl * nx;
+         jp->cut[v][1] = nl * ny;
+         jp->cut[v][2] = nl * nz;
+         jp->valid_cut[v] = TRUE;
+      }
+   }
+
+   return TRUE;
+}
+
+/* ============================================================ */
+
+void join_path_free (gleJoinPath *jp)
+{
+   if (jp->mem_anchor) free (jp->mem_anchor);
+   jp->mem_anchor = 0x0;
+}
+
+/* ============================================================ */
+/* Intersect a whole ring of lines with the plane through p with
+ * normal n.  Line j runs from (xy1[j][0], xy1[j][1], z1) to
+ * (xy2[j][0], xy2[j][1], z2).  If a line lies parallel to the plane,
+ * then, just as with INTERSECT, the intersection is set to zero, and
+ * the plane normal is overwritten with the first point of the line;
+ * the remainder of the ring is then done one point at a time. */
+
+void intersect_ring (int ncp,
+                     gleDouble sect[][3],
+                     gleDouble p[3],
+                     gleDouble n[3],
+                     gleDouble xy1[][3],
+                     gleDouble z1,
+                     gleDouble xy2[][3],
+                     gleDouble z2)
+{
+   int j, ndegen;
+   gleDouble nn[3], pp[3];
+   gleDouble deno, numer, t, omt;
+   gleDouble v1[3], v2[3];
+
+   /* local copies, so that the compiler need not worry about the
+    * output aliasing the plane */
+   VEC_COPY (nn, n);
+   VEC_COPY (pp, p);
+
+   ndegen = 0;
+   for (j=0; j<ncp; j++) {
+      deno = (xy1[j][0] - xy2[j][0]) * nn[0];
+      deno += (xy1[j][1] - xy2[j][1]) * nn[1];
+      deno += (z1 - z2) * nn[2];
+
+      numer = (pp[0] - xy2[j][0]) * nn[0];
+      numer += (pp[1] - xy2[j][1]) * nn[1];
+      numer += (pp[2] - z2) * nn[2];
+
+      ndegen += (0.0 == deno);
+      deno = (0.0 == deno) ? 1.0 : deno;
+      t = numer / deno;
+      omt = 1.0 - t;
+
+      sect[j][0] = t * xy1[j][0] + omt * xy2[j][0];
+      sect[j][1] = t * xy1[j][1] + omt * xy2[j][1];
+      sect[j][2] = t * z1 + omt * z2;
+   }
+
+   if (0 == ndegen) return;
+
+   /* Co-planar lines are exceedingly rare; redo the ring from the
+    * first one on, exactly as the INTERSECT macro would have. */
+   for (j=0; j<ncp; j++) {
+      deno = (xy1[j][0] - xy2[j][0]) * nn[0];
+      deno += (xy1[j][1] - xy2[j][1]) * nn[1];
+      deno += (z1 - z2) * nn[2];
+      if (0.0 == deno) break;
+   }
+   for (; j<ncp; j++) {
+      v1[0] = xy1[j][0];
+      v1[1] = xy1[j][1];
+      v1[2] = z1;
+      v2[0] = xy2[j][0];
+      v2[1] = xy2[j][1];
+      v2[2] = z2;
+      INTERSECT (sect[j], p, n, v1, v2);
+   }
+}
+
+/* ===================== END OF FILE ======================== */
@@ -45,7 +45,7 @@ typedef gleDouble gleVector;
 #define VVAL(arr,n,i)  arr(3*n+i)
 
 #else  /* FUNKY_C */
-typedef double gleVector[3];
+typedef gleDouble gleVector[3];
 #define AVAL(arr,n,i,j)  arr[n][i][j]
 #define VVAL(arr,n,i)  arr[n][i];
 
@@ -63,7 +63,7 @@ typedef double gleVector[3];
 
 /* ====================================================== */
 
-#ifdef __GLE_DOUBLE
+#if __GLE_DOUBLE
 /* #define gleDouble 		double */
 #define MULTMATRIX(m)		MULTMATRIX_D(m)
 #define LOADMATRIX(m)		LOADMATRIX_D(m)
@@ -71,7 +71,7 @@ typedef double gleVector[3];
 #define N3F(x)			N3F_D(x)
 #define T2F(x,y)		T2F_D(x,y)
 #else 
-#define gleDouble 		float
+/* #define gleDouble 		float */
 #define MULTMATRIX(m)		MULTMATRIX_F(m)
 #define LOADMATRIX(m)		LOADMATRIX_F(m)
 #define V3F(x,j,id)		V3F_F(x,j,id)
@@ -218,7 +218,7 @@ typedef double gleVector[3];
 }
 #endif /* FLIP_NORMAL */
 
-#define	C3F(x)		glColor3fv(x)
+#define	C3F(x)		{ GLE_STATS_COUNT (colors, 1); glColor3fv(x); }
 #define	T2F_F(x,y)	glTexCoord2f(x,y)
 #define	T2F_D(x,y)	glTexCoord2d(x,y)
 
@@ -231,6 +231,24 @@ typedef double gleVector[3];
 #define	MULTMATRIX_D(x)	glMultMatrixd ((const GLdouble *)x)
 #define	LOADMATRIX_D(x)	glLoadMatrixd ((const GLdouble *)x)
 
+/* The GLU tessellator takes its coordinates in double precision, and
+ * copies them; the data pointer is handed back to the vertex callback
+ * as is.  So the float build tessellates a widened copy of each vertex,
+ * but has the callback draw the vertex itself. */
+#if __GLE_DOUBLE
+#define TESS_VERTEX_CALLBACK	((_GLUfuncptr) glVertex3dv)
+#define TESS_VERTEX(tobj,x)	gluTessVertex (tobj, x, x)
+#else
+#define TESS_VERTEX_CALLBACK	((_GLUfuncptr) glVertex3fv)
+#define TESS_VERTEX(tobj,x) {				\
+   GLdouble ttt[3];					\
+   ttt[0] = (GLdouble) (x)[0];				\
+   ttt[1] = (GLdouble) (x)[1];				\
+   ttt[2] = (GLdouble) (x)[2];				\
+   gluTessVertex (tobj, ttt, x);			\
+}
+#endif
+
 #define __IS_LIGHTING_ON  (glIsEnabled(GL_LIGHTING))
 
 /* ====================================================== */
@@ -238,57 +256,65 @@ typedef double gleVector[3];
 
 #define BGNTMESH(i,len) { 					\
 	if(_gle_gc -> bgn_gen_texture) (*(_gle_gc -> bgn_gen_texture))(i,len);\
+	GLE_STATS_PUSH (GLE_STATS_EMIT);			\
 	glBegin (GL_TRIANGLE_STRIP); 			\
 }
 
 #define BGNPOLYGON() { 					\
 	if(_gle_gc -> bgn_gen_texture) (*(_gle_gc -> bgn_gen_texture))();\
+	GLE_STATS_PUSH (GLE_STATS_EMIT);			\
 	glBegin (GL_POLYGON);				\
 }
 
 #define N3F_F(x) { 					\
 	if(_gle_gc -> n3f_gen_texture) (*(_gle_gc -> n3f_gen_texture))(x); \
+	GLE_STATS_COUNT (normals, 1);				\
 	glNormal3fv(x); 				\
 }
 
 #define N3F_D(x) { 					\
 	if(_gle_gc -> n3d_gen_texture) (*(_gle_gc -> n3d_gen_texture))(x); \
+	GLE_STATS_COUNT (normals, 1);				\
 	glNormal3dv(x); 				\
 }
 
 #define V3F_F(x,j,id) { 					\
 	if(_gle_gc -> v3f_gen_texture) (*(_gle_gc -> v3f_gen_texture))(x,j,id);\
+	GLE_STATS_COUNT (vertices, 1);				\
 	glVertex3fv(x); 				\
 }
 
 #define V3F_D(x,j,id) { 					\
 	if(_gle_gc -> v3d_gen_texture) (*(_gle_gc -> v3d_gen_texture))(x,j,id); \
+	GLE_STATS_COUNT (vertices, 1);				\
 	glVertex3dv(x); 				\
 }
 
 #define ENDTMESH() {					\
 	if(_gle_gc -> end_gen_texture) (*(_gle_gc -> end_gen_texture))(); \
 	glEnd ();					\
+	GLE_STATS_POP ();					\
 }
 
 #define ENDPOLYGON() {					\
 	if(_gle_gc -> end_gen_texture) (*(_gle_gc -> end_gen_texture))(); \
 	glEnd ();					\
+	GLE_STATS_POP ();					\
 }
 
 /* ====================================================== */
 #else /* AUTO_TEXTURE */
 
-#define BGNTMESH(i,len)	glBegin (GL_TRIANGLE_STRIP);
-#define BGNPOLYGON() 	glBegin (GL_POLYGON);
+#define BGNTMESH(i,len)	{ GLE_STATS_PUSH (GLE_STATS_EMIT); glBegin (GL_TRIANGLE_STRIP); }
+#define BGNPOLYGON() 	{ GLE_STATS_PUSH (GLE_STATS_EMIT); glBegin (GL_POLYGON); }
 
-#define	N3F_F(x)	glNormal3fv(x)
-#define	N3F_D(x)	glNormal3dv(x)
-#define V3F_F(x,j,id)	glVertex3fv(x);
-#define V3F_D(x,j,id)	glVertex3dv(x);
+#define	N3F_F(x)	{ GLE_STATS_COUNT (normals, 1); glNormal3fv(x); }
+#define	N3F_D(x)	{ GLE_STATS_COUNT (normals, 1); glNormal3dv(x); }
+#define V3F_F(x,j,id)	{ GLE_STATS_COUNT (vertices, 1); glVertex3fv(x); }
+#define V3F_D(x,j,id)	{ GLE_STATS_COUNT (vertices, 1); glVertex3dv(x); }
 
-#define ENDTMESH()	glEnd ()
-#define ENDPOLYGON()	glEnd()
+#define ENDTMESH()	{ glEnd (); GLE_STATS_POP (); }
+#define ENDPOLYGON()	{ glEnd (); GLE_STATS_POP (); }
 
 #endif /* AUTO_TEXTURE */
 
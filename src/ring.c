@@ -0,0 +1,403 @@
+/*
+ * FILE:
+ * ring.c
+ *
+ * FUNCTION:
+ * Whole-ring contour transform kernels.  These apply the contour
+ * transform of one path vertex (see gleRingXform in extrude.h) to
+ * every point, or every normal, of the 2D contour in one go, writing
+ * the 3D contour loops that the segment drawing routines consume.
+ *
+ * A 2D contour point is exactly one pair of doubles, so it sits in
+ * a single SSE2 register with no shuffling; the AVX2 kernel handles
+ * two points per instruction.  In the float build (see ex_float.c),
+ * a point is a pair of floats, and the kernels handle two and four
+ * points per instruction.  The kernel is picked at run time,
+ * according to what the CPU supports; a plain C version is always
+ * available, and is the only one compiled on non-x86 machines.
+ *
+ * The kernels perform exactly the same floating point operations, in
+ * the same order, and in the same precision, as the plain C version,
+ * which in double precision are those of the MAT_DOT_VEC_2X3 and
+ * NORM_XFORM_2X2 macros; so the results are bit-for-bit identical
+ * whichever one runs.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "gle.h"
+#include "port.h"
+#include "vvector.h"
+#include "tube_gc.h"
+#include "extrude.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(GLE_NO_SIMD)
+#define RING_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+/* ============================================================ */
+/* Reduce a ring transform to three columns: the images of the unit
+ * x and y vectors, and the offset.  For the normals, the columns are
+ * those of the inverse transpose (less the determinant, since the
+ * normals get renormalized anyway). */
+
+typedef struct {
+   gleDouble c0[2], c1[2], off[2];
+   int copy;            /* TRUE if the transform is the identity (up to scale) */
+   int renorm;          /* TRUE if the result must be renormalized */
+} ringCols;
+
+static void
+ring_point_cols (ringCols *rc, gleRingXform *r)
+{
+   switch (r->kind) {
+      case CONTOUR_XFORM_SCALE:
+         rc->c0[0] = r->a;   rc->c0[1] = 0.0;
+         rc->c1[0] = 0.0;    rc->c1[1] = r->a;
+         rc->off[0] = 0.0;   rc->off[1] = 0.0;
+         break;
+      case CONTOUR_XFORM_TWIST:
+         rc->c0[0] = r->a;   rc->c0[1] = r->b;
+         rc->c1[0] = - r->b; rc->c1[1] = r->a;
+         rc->off[0] = 0.0;   rc->off[1] = 0.0;
+         break;
+      default:
+         rc->c0[0] = r->m[0][0];  rc->c0[1] = r->m[1][0];
+         rc->c1[0] = r->m[0][1];  rc->c1[1] = r->m[1][1];
+         rc->off[0] = r->m[0][2]; rc->off[1] = r->m[1][2];
+         break;
+   }
+   rc->copy = FALSE;
+   rc->renorm = FALSE;
+}
+
+static void
+ring_norm_cols (ringCols *rc, gleRingXform *r)
+{
+   gleDouble (*m)[3];
+
+   rc->off[0] = 0.0;
+   rc->off[1] = 0.0;
+   rc->copy = FALSE;
+   rc->renorm = FALSE;
+
+   switch (r->kind) {
+      case CONTOUR_XFORM_SCALE:
+         rc->copy = TRUE;
+         break;
+      case CONTOUR_XFORM_TWIST:
+         rc->c0[0] = r->a;   rc->c0[1] = r->b;
+         rc->c1[0] = - r->b; rc->c1[1] = r->a;
+         break;
+      default:
+         m = r->m;
+         /* same test as in NORM_XFORM_2X2, hoisted out of the loop */
+         if ((m[0][1] != 0.0) || (m[1][0] != 0.0) || (m[0][0] != m[1][1])) {
+            rc->c0[0] = m[1][1];    rc->c0[1] = - m[0][1];
+            rc->c1[0] = - m[1][0];  rc->c1[1] = m[0][0];
+            rc->renorm = TRUE;
+         } else {
+            rc->copy = TRUE;
+         }
+         break;
+   }
+}
+
+/* ============================================================ */
+/* plain C kernels */
+
+static void
+ring_xform_scalar (int ncp, gleDouble loop[][3], ringCols *rc,
+                   gleDouble contour[][2], gleDouble z)
+{
+   int j;
+   gleDouble len;
+
+   if (rc->copy) {
+      for (j=0; j<ncp; j++) {
+         loop[j][0] = contour[j][0];
+         loop[j][1] = contour[j][1];
+         loop[j][2] = z;
+      }
+      return;
+   }
+
+   for (j=0; j<ncp; j++) {
+      loop[j][0] = rc->c0[0]*contour[j][0] + rc->c1[0]*contour[j][1] + rc->off[0];
+      loop[j][1] = rc->c0[1]*contour[j][0] + rc->c1[1]*contour[j][1] + rc->off[1];
+      loop[j][2] = z;
+   }
+
+   if (rc->renorm) {
+      for (j=0; j<ncp; j++) {
+         len = loop[j][0]*loop[j][0] + loop[j][1]*loop[j][1];
+         len = ((gleDouble) 1.0) / ((gleDouble) sqrt (len));
+         loop[j][0] *= len;
+         loop[j][1] *= len;
+      }
+   }
+}
+
+/* ============================================================ */
+#if defined(RING_HAVE_X86) && __GLE_DOUBLE
+
+__attribute__((target("sse2")))
+static void
+ring_xform_sse2 (int ncp, gleDouble loop[][3], ringCols *rc,
+                 gleDouble contour[][2], gleDouble z)
+{
+   int j;
+   __m128d c0, c1, off, v, xx, yy, p, sq, one;
+
+   if (rc->copy) {
+      for (j=0; j<ncp; j++) {
+         _mm_storeu_pd (&loop[j][0], _mm_loadu_pd (&contour[j][0]));
+         loop[j][2] = z;
+      }
+      return;
+   }
+
+   c0 = _mm_loadu_pd (rc->c0);
+   c1 = _mm_loadu_pd (rc->c1);
+   off = _mm_loadu_pd (rc->off);
+   one = _mm_set1_pd (1.0);
+
+   for (j=0; j<ncp; j++) {
+      v = _mm_loadu_pd (&contour[j][0]);
+      xx = _mm_unpacklo_pd (v, v);
+      yy = _mm_unpackhi_pd (v, v);
+      p = _mm_add_pd (_mm_add_pd (_mm_mul_pd (c0, xx),
+                                  _mm_mul_pd (c1, yy)), off);
+      if (rc->renorm) {
+         sq = _mm_mul_pd (p, p);
+         sq = _mm_add_pd (sq, _mm_shuffle_pd (sq, sq, 1));
+         p = _mm_mul_pd (p, _mm_div_pd (one, _mm_sqrt_pd (sq)));
+      }
+      _mm_storeu_pd (&loop[j][0], p);
+      loop[j][2] = z;
+   }
+}
+
+/* ============================================================ */
+
+__attribute__((target("avx2")))
+static void
+ring_xform_avx2 (int ncp, gleDouble loop[][3], ringCols *rc,
+                 gleDouble contour[][2], gleDouble z)
+{
+   int j;
+   __m256d c0, c1, off, v, xx, yy, p, sq, one;
+
+   if (rc->copy) {
+      ring_xform_sse2 (ncp, loop, rc, contour, z);
+      return;
+   }
+
+   c0 = _mm256_setr_pd (rc->c0[0], rc->c0[1], rc->c0[0], rc->c0[1]);
+   c1 = _mm256_setr_pd (rc->c1[0], rc->c1[1], rc->c1[0], rc->c1[1]);
+   off = _mm256_setr_pd (rc->off[0], rc->off[1], rc->off[0], rc->off[1]);
+   one = _mm256_set1_pd (1.0);
+
+   /* two contour points per pass */
+   for (j=0; j+1<ncp; j+=2) {
+      v = _mm256_loadu_pd (&contour[j][0]);
+      xx = _mm256_permute_pd (v, 0x0);
+      yy = _mm256_permute_pd (v, 0xf);
+      p = _mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (c0, xx),
+                                        _mm256_mul_pd (c1, yy)), off);
+      if (rc->renorm) {
+         sq = _mm256_mul_pd (p, p);
+         sq = _mm256_add_pd (sq, _mm256_permute_pd (sq, 0x5));
+         p = _mm256_mul_pd (p, _mm256_div_pd (one, _mm256_sqrt_pd (sq)));
+      }
+      _mm_storeu_pd (&loop[j][0], _mm256_castpd256_pd128 (p));
+      _mm_storeu_pd (&loop[j+1][0], _mm256_extractf128_pd (p, 1));
+      loop[j][2] = z;
+      loop[j+1][2] = z;
+   }
+
+   /* odd point out */
+   if (j < ncp) {
+      ring_xform_sse2 (1, &loop[j], rc, &contour[j], z);
+   }
+}
+
+#endif /* RING_HAVE_X86 && __GLE_DOUBLE */
+/* ============================================================ */
+#if defined(RING_HAVE_X86) && !__GLE_DOUBLE
+
+__attribute__((target("sse2")))
+static void
+ring_xform_sse2 (int ncp, gleDouble loop[][3], ringCols *rc,
+                 gleDouble contour[][2], gleDouble z)
+{
+   int j;
+   __m128 c0, c1, off, v, xx, yy, p, sq, one;
+
+   if (rc->copy) {
+      ring_xform_scalar (ncp, loop, rc, contour, z);
+      return;
+   }
+
+   c0 = _mm_setr_ps (rc->c0[0], rc->c0[1], rc->c0[0], rc->c0[1]);
+   c1 = _mm_setr_ps (rc->c1[0], rc->c1[1], rc->c1[0], rc->c1[1]);
+   off = _mm_setr_ps (rc->off[0], rc->off[1], rc->off[0], rc->off[1]);
+   one = _mm_set1_ps (1.0f);
+
+   /* two contour points per pass */
+   for (j=0; j+1<ncp; j+=2) {
+      v = _mm_loadu_ps (&contour[j][0]);
+      xx = _mm_shuffle_ps (v, v, _MM_SHUFFLE (2,2,0,0));
+      yy = _mm_shuffle_ps (v, v, _MM_SHUFFLE (3,3,1,1));
+      p = _mm_add_ps (_mm_add_ps (_mm_mul_ps (c0, xx),
+                                  _mm_mul_ps (c1, yy)), off);
+      if (rc->renorm) {
+         sq = _mm_mul_ps (p, p);
+         sq = _mm_add_ps (sq, _mm_shuffle_ps (sq, sq, _MM_SHUFFLE (2,3,0,1)));
+         p = _mm_mul_ps (p, _mm_div_ps (one, _mm_sqrt_ps (sq)));
+      }
+      _mm_storel_pi ((__m64 *) &loop[j][0], p);
+      _mm_storeh_pi ((__m64 *) &loop[j+1][0], p);
+      loop[j][2] = z;
+      loop[j+1][2] = z;
+   }
+
+   /* odd point out */
+   if (j < ncp) {
+      ring_xform_scalar (1, &loop[j], rc, &contour[j], z);
+   }
+}
+
+/* ============================================================ */
+
+__attribute__((target("avx2")))
+static void
+ring_xform_avx2 (int ncp, gleDouble loop[][3], ringCols *rc,
+                 gleDouble contour[][2], gleDouble z)
+{
+   int j;
+   __m256 c0, c1, off, v, xx, yy, p, sq, one;
+   __m128 lo, hi;
+
+   if (rc->copy) {
+      ring_xform_scalar (ncp, loop, rc, contour, z);
+      return;
+   }
+
+   c0 = _mm256_setr_ps (rc->c0[0], rc->c0[1], rc->c0[0], rc->c0[1],
+                        rc->c0[0], rc->c0[1], rc->c0[0], rc->c0[1]);
+   c1 = _mm256_setr_ps (rc->c1[0], rc->c1[1], rc->c1[0], rc->c1[1],
+                        rc->c1[0], rc->c1[1], rc->c1[0], rc->c1[1]);
+   off = _mm256_setr_ps (rc->off[0], rc->off[1], rc->off[0], rc->off[1],
+                         rc->off[0], rc->off[1], rc->off[0], rc->off[1]);
+   one = _mm256_set1_ps (1.0f);
+
+   /* four contour points per pass */
+   for (j=0; j+3<ncp; j+=4) {
+      v = _mm256_loadu_ps (&contour[j][0]);
+      xx = _mm256_permute_ps (v, _MM_SHUFFLE (2,2,0,0));
+      yy = _mm256_permute_ps (v, _MM_SHUFFLE (3,3,1,1));
+      p = _mm256_add_ps (_mm256_add_ps (_mm256_mul_ps (c0, xx),
+                                        _mm256_mul_ps (c1, yy)), off);
+      if (rc->renorm) {
+         sq = _mm256_mul_ps (p, p);
+         sq = _mm256_add_ps (sq, _mm256_permute_ps (sq, _MM_SHUFFLE (2,3,0,1)));
+         p = _mm256_mul_ps (p, _mm256_div_ps (one, _mm256_sqrt_ps (sq)));
+      }
+      lo = _mm256_castps256_ps128 (p);
+      hi = _mm256_extractf128_ps (p, 1);
+      _mm_storel_pi ((__m64 *) &loop[j][0], lo);
+      _mm_storeh_pi ((__m64 *) &loop[j+1][0], lo);
+      _mm_storel_pi ((__m64 *) &loop[j+2][0], hi);
+      _mm_storeh_pi ((__m64 *) &loop[j+3][0], hi);
+      loop[j][2] = z;
+      loop[j+1][2] = z;
+      loop[j+2][2] = z;
+      loop[j+3][2] = z;
+   }
+
+   /* up to three points left over */
+   if (j < ncp) {
+      ring_xform_sse2 (ncp-j, &loop[j], rc, &contour[j], z);
+   }
+}
+
+#endif /* RING_HAVE_X86 && !__GLE_DOUBLE */
+
+/* ============================================================ */
+/* run-time kernel selection */
+
+typedef void (*ringKernel) (int, gleDouble[][3], ringCols *,
+                            gleDouble[][2], gleDouble);
+
+static ringKernel ring_kernel = 0x0;
+
+int ring_kernel_select (int level)
+{
+   int best = RING_KERNEL_SCALAR;
+
+#ifdef RING_HAVE_X86
+   __builtin_cpu_init ();
+   if (__builtin_cpu_supports ("sse2")) best = RING_KERNEL_SSE2;
+   if (__builtin_cpu_supports ("avx2")) best = RING_KERNEL_AVX2;
+#endif /* RING_HAVE_X86 */
+
+   if ((0 > level) || (level > best)) level = best;
+
+   switch (level) {
+#ifdef RING_HAVE_X86
+      case RING_KERNEL_AVX2:
+         ring_kernel = ring_xform_avx2;
+         break;
+      case RING_KERNEL_SSE2:
+         ring_kernel = ring_xform_sse2;
+         break;
+#endif /* RING_HAVE_X86 */
+      default:
+         level = RING_KERNEL_SCALAR;
+         ring_kernel = ring_xform_scalar;
+         break;
+   }
+   return level;
+}
+
+/* ============================================================ */
+/* Transform the contour by ring transform r, writing the 3D loop
+ * (x, y, z) into loop.  */
+
+void ring_dot_contour (int ncp,
+                       gleDouble loop[][3],
+                       gleRingXform *r,
+                       gleDouble contour[][2],
+                       gleDouble z)
+{
+   ringCols rc;
+
+   if (!ring_kernel) (void) ring_kernel_select (-1);
+   ring_point_cols (&rc, r);
+   (*ring_kernel) (ncp, loop, &rc, contour, z);
+}
+
+/* Transform the contour normals by ring transform r, writing the 3D
+ * normal loop (with zero z component) into norm. */
+
+void ring_norm_contour (int ncp,
+                        gleDouble norm[][3],
+                        gleRingXform *r,
+                        gleDouble cont_normal[][2])
+{
+   ringCols rc;
+
+   if (!ring_kernel) (void) ring_kernel_select (-1);
+   ring_norm_cols (&rc, r);
+   (*ring_kernel) (ncp, norm, &rc, cont_normal, 0.0);
+}
+
+/* ===================== END OF FILE ======================== */
@@ -42,23 +42,23 @@
 #define __ROUND_TESS_PIECES 5
 
 void draw_round_style_cap_callback (int ncp,
-                                  double cap[][3],
+                                  gleDouble cap[][3],
                                   gleColor face_color,
                                   gleDouble cut[3],
                                   gleDouble bi[3],
-                                  double norms[][3],
+                                  gleDouble norms[][3],
                                   int frontwards)
 {
-   double axis[3];
-   double xycut[3];
+   gleDouble axis[3];
+   gleDouble xycut[3];
    double theta;
-   double *last_contour, *next_contour;
-   double *last_norm, *next_norm;
-   double *cap_z;
-   double *tmp;
+   gleDouble *last_contour, *next_contour;
+   gleDouble *last_norm, *next_norm;
+   gleDouble *cap_z;
+   gleDouble *tmp;
    char *malloced_area;
    int i, j, k;
-   double m[4][4];
+   gleDouble m[4][4];
 
    if (face_color != NULL) C3F (face_color);
 
@@ -67,6 +67,8 @@ void draw_round_style_cap_callback (int ncp,
     * a degenerate case), then we can't draw anything. return. */
    if (cut == NULL) return;
 
+   GLE_STATS_PUSH (GLE_STATS_CAP);
+
    /* make sure that the cut vector points inwards */
    if (cut[2] > 0.0) {
       VEC_SCALE (cut, -1.0, cut);
@@ -107,11 +109,11 @@ void draw_round_style_cap_callback (int ncp,
    /* ------------ done setting up rotation matrix ------------- */
 
    /* This malloc is a fancy version of:
-    * last_contour = (double *) malloc (3*ncp*sizeof(double);
-    * next_contour = (double *) malloc (3*ncp*sizeof(double);
+    * last_contour = (gleDouble *) malloc (3*ncp*sizeof(gleDouble);
+    * next_contour = (gleDouble *) malloc (3*ncp*sizeof(gleDouble);
     */
-   malloced_area = malloc ((4*3+1) *(size_t)ncp*sizeof (double));
-   last_contour = (double *) malloced_area;
+   malloced_area = gle_malloc ((4*3+1) *(size_t)ncp*sizeof (gleDouble));
+   last_contour = (gleDouble *) malloced_area;
    next_contour = last_contour +  3*ncp;
    cap_z = next_contour + 3*ncp;
    last_norm = cap_z + ncp;
@@ -160,6 +162,7 @@ void draw_round_style_cap_callback (int ncp,
    }
 
    /* &&&&&&&&&&&&&& start drawing cap &&&&&&&&&&&&& */
+   GLE_STATS_COUNT (round_pieces, __ROUND_TESS_PIECES);
 
    for (i=0; i<__ROUND_TESS_PIECES; i++) {
       for (j=0; j<ncp; j++) {
@@ -208,6 +211,8 @@ void draw_round_style_cap_callback (int ncp,
 
    /* Thou shalt not leak memory */
    free (malloced_area);
+
+   GLE_STATS_POP ();
 }
 
 /* ==================== END OF FILE =========================== */
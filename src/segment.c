@@ -95,7 +95,7 @@ void draw_segment_color (int ncp,	/* number of contour points */
 void draw_segment_edge_n (int ncp,	/* number of contour points */
                            gleDouble front_contour[][3],	
                            gleDouble back_contour[][3],	
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            int inext, double len)
 {
    int j;
@@ -103,14 +103,14 @@ void draw_segment_edge_n (int ncp,	/* number of contour points */
    /* draw the tube segment */
    BGNTMESH (inext,len);
    for (j=0; j<ncp; j++) {
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (front_contour[j], j, FRONT);
       V3F (back_contour[j], j, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
-      N3F_D (norm_cont[0]);
+      N3F (norm_cont[0]);
       V3F (front_contour[0], 0, FRONT);
       V3F (back_contour[0], 0, BACK);
    }
@@ -123,7 +123,7 @@ void draw_segment_edge_n (int ncp,	/* number of contour points */
 void draw_segment_c_and_edge_n (int ncp,	/* number of contour points */
                            gleDouble front_contour[][3],	
                            gleDouble back_contour[][3],	
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len)
@@ -134,22 +134,22 @@ void draw_segment_c_and_edge_n (int ncp,	/* number of contour points */
    BGNTMESH (inext, len);
    for (j=0; j<ncp; j++) {
       C3F (color_last);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (front_contour[j], j, FRONT);
 
       C3F (color_next);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (back_contour[j], j, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
       C3F (color_last);
-      N3F_D (norm_cont[0]);
+      N3F (norm_cont[0]);
       V3F (front_contour[0], 0, FRONT);
    
       C3F (color_next);
-      N3F_D (norm_cont[0]);
+      N3F (norm_cont[0]);
       V3F (back_contour[0], 0, BACK);
    }
    ENDTMESH ();
@@ -161,7 +161,7 @@ void draw_segment_c_and_edge_n (int ncp,	/* number of contour points */
 void draw_segment_facet_n (int ncp,	/* number of contour points */
                            gleDouble front_contour[][3],	
                            gleDouble back_contour[][3],	
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            int inext, double len)
 {
    int j;
@@ -169,7 +169,7 @@ void draw_segment_facet_n (int ncp,	/* number of contour points */
    /* draw the tube segment */
    BGNTMESH (inext, len);
    for (j=0; j<ncp-1; j++) {
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (front_contour[j], j, FRONT);
       V3F (back_contour[j], j, BACK);
       V3F (front_contour[j+1], j+1, FRONT);
@@ -178,7 +178,7 @@ void draw_segment_facet_n (int ncp,	/* number of contour points */
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
-      N3F_D (norm_cont[ncp-1]);
+      N3F (norm_cont[ncp-1]);
       V3F (front_contour[ncp-1], ncp-1, FRONT);
       V3F (back_contour[ncp-1], ncp-1, BACK);
       V3F (front_contour[0], 0, FRONT);
@@ -194,7 +194,7 @@ void draw_segment_facet_n (int ncp,	/* number of contour points */
 void draw_segment_c_and_facet_n (int ncp,	/* number of contour points */
                            gleDouble front_contour[][3],	
                            gleDouble back_contour[][3],	
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len)
@@ -215,38 +215,38 @@ void draw_segment_c_and_facet_n (int ncp,	/* number of contour points */
    BGNTMESH (inext, len);
    for (j=0; j<ncp-1; j++) {
       C3F (color_last);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (front_contour[j], j, FRONT);
 
       C3F (color_next);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (back_contour[j], j, BACK);
 
       C3F (color_last);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (front_contour[j+1], j+1, FRONT);
 
       C3F (color_next);
-      N3F_D (norm_cont[j]);
+      N3F (norm_cont[j]);
       V3F (back_contour[j+1], j+1, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
       C3F (color_last);
-      N3F_D (norm_cont[ncp-1]);
+      N3F (norm_cont[ncp-1]);
       V3F (front_contour[ncp-1], ncp-1, FRONT);
    
       C3F (color_next);
-      N3F_D (norm_cont[ncp-1]);
+      N3F (norm_cont[ncp-1]);
       V3F (back_contour[ncp-1], ncp-1, BACK);
    
       C3F (color_last);
-      N3F_D (norm_cont[ncp-1]);
+      N3F (norm_cont[ncp-1]);
       V3F (front_contour[0], 0, FRONT);
    
       C3F (color_next);
-      N3F_D (norm_cont[ncp-1]);
+      N3F (norm_cont[ncp-1]);
       V3F (back_contour[0], 0, BACK);
    }
 
@@ -261,10 +261,10 @@ void draw_segment_c_and_facet_n (int ncp,	/* number of contour points */
  */
 
 void draw_binorm_segment_edge_n (int ncp,      /* number of contour points */
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            int inext, double len)
 {
    int j;
@@ -272,18 +272,18 @@ void draw_binorm_segment_edge_n (int ncp,      /* number of contour points */
    /* draw the tube segment */
    BGNTMESH (inext, len);
    for (j=0; j<ncp; j++) {
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j], j, FRONT);
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j], j, BACK);
+      N3F (front_norm[j]);
+      V3F (front_contour[j], j, FRONT);
+      N3F (back_norm[j]);
+      V3F (back_contour[j], j, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
-      N3F_D (front_norm[0]);
-      V3F_D (front_contour[0], 0, FRONT);
-      N3F_D (back_norm[0]);
-      V3F_D (back_contour[0], 0, BACK);
+      N3F (front_norm[0]);
+      V3F (front_contour[0], 0, FRONT);
+      N3F (back_norm[0]);
+      V3F (back_contour[0], 0, BACK);
    }
    ENDTMESH ();
 
@@ -293,10 +293,10 @@ void draw_binorm_segment_edge_n (int ncp,      /* number of contour points */
 /* ============================================================ */
 
 void draw_binorm_segment_c_and_edge_n (int ncp,	/* number of contour points */
-                           double front_contour[][3],	
-                           double back_contour[][3],	
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],	
+                           gleDouble back_contour[][3],	
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len)
@@ -307,23 +307,23 @@ void draw_binorm_segment_c_and_edge_n (int ncp,	/* number of contour points */
    BGNTMESH (inext, len);
    for (j=0; j<ncp; j++) {
       C3F (color_last);
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j], j, FRONT);
+      N3F (front_norm[j]);
+      V3F (front_contour[j], j, FRONT);
 
       C3F (color_next);
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j], j, BACK);
+      N3F (back_norm[j]);
+      V3F (back_contour[j], j, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
       C3F (color_last);
-      N3F_D (front_norm[0]);
-      V3F_D (front_contour[0], 0, FRONT);
+      N3F (front_norm[0]);
+      V3F (front_contour[0], 0, FRONT);
    
       C3F (color_next);
-      N3F_D (back_norm[0]);
-      V3F_D (back_contour[0], 0, BACK);
+      N3F (back_norm[0]);
+      V3F (back_contour[0], 0, BACK);
    }
    ENDTMESH ();
 }
@@ -338,10 +338,10 @@ void draw_binorm_segment_c_and_edge_n (int ncp,	/* number of contour points */
  */
 
 void draw_binorm_segment_facet_n (int ncp,      /* number of contour points */
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            int inext, double len)
 {
    int j;
@@ -349,32 +349,32 @@ void draw_binorm_segment_facet_n (int ncp,      /* number of contour points */
    /* draw the tube segment */
    BGNTMESH (inext, len);
    for (j=0; j<ncp-1; j++) {
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j], j, FRONT);
+      N3F (front_norm[j]);
+      V3F (front_contour[j], j, FRONT);
 
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j], j, BACK);
+      N3F (back_norm[j]);
+      V3F (back_contour[j], j, BACK);
 
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j+1], j+1, FRONT);
+      N3F (front_norm[j]);
+      V3F (front_contour[j+1], j+1, FRONT);
 
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j+1], j+1, BACK);
+      N3F (back_norm[j]);
+      V3F (back_contour[j+1], j+1, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
-      N3F_D (front_norm[ncp-1]);
-      V3F_D (front_contour[ncp-1], ncp-1, FRONT);
+      N3F (front_norm[ncp-1]);
+      V3F (front_contour[ncp-1], ncp-1, FRONT);
 
-      N3F_D (back_norm[ncp-1]);
-      V3F_D (back_contour[ncp-1], ncp-1, BACK);
+      N3F (back_norm[ncp-1]);
+      V3F (back_contour[ncp-1], ncp-1, BACK);
 
-      N3F_D (front_norm[ncp-1]);
-      V3F_D (front_contour[0], 0, FRONT);
+      N3F (front_norm[ncp-1]);
+      V3F (front_contour[0], 0, FRONT);
 
-      N3F_D (back_norm[ncp-1]);
-      V3F_D (back_contour[0], 0, BACK);
+      N3F (back_norm[ncp-1]);
+      V3F (back_contour[0], 0, BACK);
    }
    ENDTMESH ();
 }
@@ -383,10 +383,10 @@ void draw_binorm_segment_facet_n (int ncp,      /* number of contour points */
 /* ============================================================ */
 
 void draw_binorm_segment_c_and_facet_n (int ncp,
-                           double front_contour[][3],	
-                           double back_contour[][3],	
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],	
+                           gleDouble back_contour[][3],	
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len)
@@ -397,39 +397,39 @@ void draw_binorm_segment_c_and_facet_n (int ncp,
    BGNTMESH (inext, len);
    for (j=0; j<ncp-1; j++) {
       C3F (color_last);
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j], j, FRONT);
+      N3F (front_norm[j]);
+      V3F (front_contour[j], j, FRONT);
 
       C3F (color_next);
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j], j, BACK);
+      N3F (back_norm[j]);
+      V3F (back_contour[j], j, BACK);
 
       C3F (color_last);
-      N3F_D (front_norm[j]);
-      V3F_D (front_contour[j+1], j+1, FRONT);
+      N3F (front_norm[j]);
+      V3F (front_contour[j+1], j+1, FRONT);
 
       C3F (color_next);
-      N3F_D (back_norm[j]);
-      V3F_D (back_contour[j+1], j+1, BACK);
+      N3F (back_norm[j]);
+      V3F (back_contour[j+1], j+1, BACK);
    }
 
    if (__TUBE_CLOSE_CONTOUR) {
       /* connect back up to first point of contour */
       C3F (color_last);
-      N3F_D (front_norm[ncp-1]);
-      V3F_D (front_contour[ncp-1], ncp-1, FRONT);
+      N3F (front_norm[ncp-1]);
+      V3F (front_contour[ncp-1], ncp-1, FRONT);
    
       C3F (color_next);
-      N3F_D (back_norm[ncp-1]);
-      V3F_D (back_contour[ncp-1], ncp-1, BACK);
+      N3F (back_norm[ncp-1]);
+      V3F (back_contour[ncp-1], ncp-1, BACK);
    
       C3F (color_last);
-      N3F_D (front_norm[ncp-1]);
-      V3F_D (front_contour[0], 0, FRONT);
+      N3F (front_norm[ncp-1]);
+      V3F (front_contour[0], 0, FRONT);
    
       C3F (color_next);
-      N3F_D (back_norm[ncp-1]);
-      V3F_D (back_contour[0], 0, BACK);
+      N3F (back_norm[ncp-1]);
+      V3F (back_contour[0], 0, BACK);
    }
 
    ENDTMESH ();
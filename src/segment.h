@@ -37,13 +37,13 @@ extern void draw_segment_color_c4f (int ncp,   /* number of contour points */
 extern void draw_segment_edge_n (int ncp,      /* number of contour points */
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            int inext, double len);
 
 extern void draw_segment_c_and_edge_n (int ncp,   
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len);
@@ -51,7 +51,7 @@ extern void draw_segment_c_and_edge_n (int ncp,
 extern void draw_segment_c_and_edge_n_c4f (int ncp,   
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor4f color_last,
                            gleColor4f color_next,
                            int inext, double len);
@@ -59,13 +59,13 @@ extern void draw_segment_c_and_edge_n_c4f (int ncp,
 extern void draw_segment_facet_n (int ncp,     
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            int inext, double len);
 
 extern void draw_segment_c_and_facet_n (int ncp,    
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len);
@@ -73,7 +73,7 @@ extern void draw_segment_c_and_facet_n (int ncp,
 extern void draw_segment_c_and_facet_n_c4f (int ncp,    
                            gleVector front_contour[],
                            gleVector back_contour[],
-                           double norm_cont[][3],
+                           gleDouble norm_cont[][3],
                            gleColor4f color_last,
                            gleColor4f color_next,
                            int inext, double len);
@@ -81,51 +81,51 @@ extern void draw_segment_c_and_facet_n_c4f (int ncp,
 /* ============================================================ */
 
 extern void draw_binorm_segment_edge_n (int ncp,  
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            int inext, double len);
 
 extern void draw_binorm_segment_c_and_edge_n (int ncp,   
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len);
 
 extern void draw_binorm_segment_c_and_edge_n_c4f (int ncp,   
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor4f color_last,
                            gleColor4f color_next,
                            int inext, double len);
 
 extern void draw_binorm_segment_facet_n (int ncp, 
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            int inext, double len);
 
 extern void draw_binorm_segment_c_and_facet_n (int ncp,    
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor color_last,
                            gleColor color_next,
                            int inext, double len);
 
 extern void draw_binorm_segment_c_and_facet_n_c4f (int ncp,    
-                           double front_contour[][3],
-                           double back_contour[][3],
-                           double front_norm[][3],
-                           double back_norm[][3],
+                           gleDouble front_contour[][3],
+                           gleDouble back_contour[][3],
+                           gleDouble front_norm[][3],
+                           gleDouble back_norm[][3],
                            gleColor4f color_last,
                            gleColor4f color_next,
                            int inext, double len);
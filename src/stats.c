@@ -0,0 +1,186 @@
+/*
+ * FILE:
+ * stats.c
+ *
+ * FUNCTION:
+ * Run-time statistics: counts of what the library draws, and of the
+ * time it spends drawing it, for finding out where an application's
+ * time goes.  The counters live in the GC, behind a pointer that is
+ * NULL until gleEnableStats() is called; the hooks in the drawing
+ * code (see tube_gc.h) test that pointer and nothing else, so that
+ * the cost is next to nothing when statistics are off.
+ *
+ * The time of a top-level call is divided among the phases of
+ * drawing.  The phases nest: a cap is drawn in the middle of a join,
+ * and the cap's polygons are emitted in the middle of the cap.  The
+ * phase on top of the stack is the one being charged; pushing or
+ * popping a phase charges the time since the last change to the one
+ * that was on top.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#if defined(_WIN32) && !defined(__clang__)
+# include <malloc.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gle.h"
+#include "port.h"
+#include "tube_gc.h"
+
+#define STATS_STACK	(sizeof (_gle_gc->stats_phase) / sizeof (int))
+
+/* ============================================================ */
+/* a monotonic clock, in seconds */
+
+static double
+stats_clock (void)
+{
+#if defined(WIN32)
+   LARGE_INTEGER now, freq;
+
+   QueryPerformanceCounter (&now);
+   QueryPerformanceFrequency (&freq);
+   return ((double) now.QuadPart) / ((double) freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+   struct timespec now;
+
+   clock_gettime (CLOCK_MONOTONIC, &now);
+   return ((double) now.tv_sec) + 1.0e-9 * ((double) now.tv_nsec);
+#else
+   return ((double) clock ()) / ((double) CLOCKS_PER_SEC);
+#endif
+}
+
+/* ============================================================ */
+/* charge the time since the last change to the phase on top.  The
+ * stack is deeper than the drawing code ever nests; should it ever
+ * not be, the innermost phases are charged to the deepest one kept. */
+
+static void
+stats_charge (void)
+{
+   double now;
+   size_t top;
+
+   now = stats_clock ();
+   top = (size_t) _gle_gc->stats_top;
+   if (STATS_STACK < top) top = STATS_STACK;
+   if (0 < top) {
+      _gle_gc->stats->seconds[_gle_gc->stats_phase[top-1]]
+                                       += now - _gle_gc->stats_mark;
+   }
+   _gle_gc->stats_mark = now;
+}
+
+void
+gle_stats_push (int phase)
+{
+   stats_charge ();
+   if (STATS_STACK > (size_t) _gle_gc->stats_top) {
+      _gle_gc->stats_phase[_gle_gc->stats_top] = phase;
+   }
+   _gle_gc->stats_top ++;
+}
+
+void
+gle_stats_pop (void)
+{
+   stats_charge ();
+   if (0 < _gle_gc->stats_top) _gle_gc->stats_top --;
+}
+
+void
+gle_stats_phase (int phase)
+{
+   if ((0 == _gle_gc->stats_top) ||
+       (STATS_STACK < (size_t) _gle_gc->stats_top)) return;
+   stats_charge ();
+   _gle_gc->stats_phase[_gle_gc->stats_top-1] = phase;
+}
+
+/* ============================================================ */
+/* The primitives call one another (the polycylinder is drawn as a
+ * super extrusion, the helicoid as a spiral), so only the outermost
+ * call is counted, and timed. */
+
+void
+gle_stats_enter (int primitive)
+{
+   if (0 == _gle_gc->stats_nest) {
+      _gle_gc->stats->calls[primitive] ++;
+      _gle_gc->stats_top = 0;
+      gle_stats_push (GLE_STATS_SETUP);
+   }
+   _gle_gc->stats_nest ++;
+}
+
+void
+gle_stats_leave (void)
+{
+   _gle_gc->stats_nest --;
+   if (0 == _gle_gc->stats_nest) {
+      stats_charge ();
+      _gle_gc->stats_top = 0;
+   }
+}
+
+/* ============================================================ */
+
+void *
+gle_malloc (size_t size)
+{
+   if (_gle_gc && _gle_gc->stats) {
+      _gle_gc->stats->mallocs ++;
+      _gle_gc->stats->malloc_bytes += size;
+   }
+   return malloc (size);
+}
+
+/* ============================================================ */
+
+void
+gleEnableStats (int enable)
+{
+   INIT_GC();
+
+   if (enable && !_gle_gc->stats) {
+      _gle_gc->stats = (gleStats *) malloc (sizeof (gleStats));
+      if (!_gle_gc->stats) return;
+      memset (_gle_gc->stats, 0, sizeof (gleStats));
+      _gle_gc->stats_nest = 0;
+      _gle_gc->stats_top = 0;
+   }
+
+   if (!enable && _gle_gc->stats) {
+      free (_gle_gc->stats);
+      _gle_gc->stats = 0x0;
+   }
+}
+
+void
+gleGetStats (gleStats *stats)
+{
+   INIT_GC();
+
+   if (_gle_gc->stats) {
+      memcpy (stats, _gle_gc->stats, sizeof (gleStats));
+   } else {
+      memset (stats, 0, sizeof (gleStats));
+   }
+}
+
+void
+gleResetStats (void)
+{
+   INIT_GC();
+
+   if (_gle_gc->stats) memset (_gle_gc->stats, 0, sizeof (gleStats));
+}
+
+/* ===================== END OF FILE ======================== */
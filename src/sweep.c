@@ -0,0 +1,846 @@
+/*
+ * FILE:
+ * sweep.c
+ *
+ * FUNCTION:
+ * Sweep files.  A sweep is stored as what it is swept from -- the
+ * contour, the path, and the colors and transforms along it -- which
+ * takes space in proportion to the number of contour points plus the
+ * number of path points, where the tube drawn from it takes their
+ * product.  A sweep file holds any number of them, and a scene kept
+ * in one can be opened in the time it takes to read its table of
+ * contents; each sweep is then extruded only when it is drawn.
+ *
+ * gleSweepCreate() starts a file; each gleSweepAdd*() call appends a
+ * sweep to it, along with the join style and the number of sides in
+ * effect at the time; gleSweepFinish() writes the table of contents.
+ * A file is untrusted input: every count, offset and setting in the
+ * table is checked when it is opened, and a table that fails is
+ * refused, as is a sweep added with settings that would fail.
+ * gleSweepOpen() maps a file into memory, and gleSweepDraw() draws
+ * one of its sweeps.  gleSweepGetBounds() returns a box that holds
+ * all of the sweep's tube, so that sweeps out of view need never be
+ * touched: the pages of those that aren't drawn are never read.
+ *
+ * The layout, all of it little-endian:
+ *
+ *    header    char magic[8] "GLESWEEP", u32 version, u32 count,
+ *              u64 offset of the table, u64 zero        (32 bytes)
+ *    arrays    f64 or f32, each starting on a multiple of 8 bytes
+ *    table     count entries of
+ *                 u32 kind, i32 join style, i32 sides, i32 ncp,
+ *                 i32 npoints, u32 floats per color (0 or 3),
+ *                 u32 zero[2],
+ *                 f64 radius, f64 bounds[6] (min xyz, then max xyz),
+ *                 u64 offsets of the contour f64[ncp][2], the
+ *                 contour normals f64[ncp][2], the up vector f64[3],
+ *                 the path f64[npoints][3], the colors f32[npoints][3],
+ *                 the radii or twists f64[npoints], and the
+ *                 transforms f64[npoints][2][3]     (144 bytes)
+ *
+ * An offset of zero is an absent array.  The arrays are laid out as
+ * the extrusion calls take them, so that on a little-endian host they
+ * are handed over in place, straight from the mapping.  Elsewhere,
+ * each sweep is copied out, and byte-swapped, when it is drawn.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#if defined(_WIN32) && !defined(__clang__)
+# include <malloc.h>
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(WIN32) && defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+# define SWEEP_MMAP 1
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "gle.h"
+#include "port.h"
+#include "tube_gc.h"
+
+#define SWEEP_MAGIC		"GLESWEEP"
+#define SWEEP_VERSION		1
+#define SWEEP_HEADER_SIZE	32
+#define SWEEP_ENTRY_SIZE	144
+
+/* Sides beyond this are refused, when writing and when reading: a
+ * corrupt count would otherwise be handed to gleSetNumSides(). */
+#define SWEEP_MAX_SLICES	4096
+
+/* the bits a join style may have */
+#define SWEEP_STYLE_BITS	(TUBE_JN_MASK | TUBE_JN_CAP | TUBE_NORM_MASK | \
+				 TUBE_CONTOUR_CLOSED)
+
+/* kinds of sweep */
+#define SWEEP_POLYCYLINDER	1
+#define SWEEP_POLYCONE		2
+#define SWEEP_EXTRUSION		3
+
+/* the arrays of an entry, in the order of their offsets */
+#define SWEEP_CONTOUR		0
+#define SWEEP_CONT_NORMAL	1
+#define SWEEP_UP		2
+#define SWEEP_POINTS		3
+#define SWEEP_COLORS		4
+#define SWEEP_SCALARS		5
+#define SWEEP_XFORMS		6
+#define SWEEP_NUM_ARRAYS	7
+
+/* a table entry, as held in memory */
+typedef struct {
+   int kind;
+   int join_style;
+   int slices;
+   int ncp;
+   int npoints;
+   int color_size;
+   double radius;
+   double bounds[6];
+   size_t offset[SWEEP_NUM_ARRAYS];
+} gleSweepEntry;
+
+struct _gleSweepWriter {
+   FILE *file;
+   size_t size;             /* bytes written so far */
+   gleSweepEntry *entries;
+   int count;
+   int room;
+   int failed;
+};
+
+struct _gleSweepFile {
+   const unsigned char *data;
+   size_t size;
+   int mapped;              /* else data was malloc'ed */
+   gleSweepEntry *entries;
+   int count;
+};
+
+/* ============================================================ */
+/* Byte order.  Doubles and floats are assumed to be IEEE. */
+
+static int
+host_is_big_endian (void)
+{
+   unsigned int one = 1;
+   return (0 == *((unsigned char *) &one));
+}
+
+/* the arrays can be used where they lie */
+#define IN_PLACE() (!host_is_big_endian () && (8 == sizeof (gleDouble)))
+
+static void
+le_bytes (unsigned char *b, const void *value, size_t n)
+{
+   size_t i;
+
+   if (host_is_big_endian ()) {
+      for (i=0; i<n; i++) b[i] = ((const unsigned char *) value)[n-1-i];
+   } else {
+      memcpy (b, value, n);
+   }
+}
+
+static void
+le_u32 (unsigned char *b, unsigned long v)
+{
+   b[0] = (unsigned char) (v & 0xff);
+   b[1] = (unsigned char) ((v >> 8) & 0xff);
+   b[2] = (unsigned char) ((v >> 16) & 0xff);
+   b[3] = (unsigned char) ((v >> 24) & 0xff);
+}
+
+static void
+le_u64 (unsigned char *b, size_t v)
+{
+   le_u32 (b, (unsigned long) (v & 0xffffffffUL));
+   /* shifted twice, as size_t may be only 32 bits */
+   le_u32 (b+4, (unsigned long) (((v >> 16) >> 16) & 0xffffffffUL));
+}
+
+static void
+le_f64 (unsigned char *b, double v)
+{
+   le_bytes (b, &v, 8);
+}
+
+static unsigned long
+get_u32 (const unsigned char *b)
+{
+   return ((unsigned long) b[0]) | (((unsigned long) b[1]) << 8) |
+          (((unsigned long) b[2]) << 16) | (((unsigned long) b[3]) << 24);
+}
+
+static int
+get_i32 (const unsigned char *b)
+{
+   unsigned long v = get_u32 (b);
+
+   if (v & 0x80000000UL) return - (int) (0xffffffffUL - v) - 1;
+   return (int) v;
+}
+
+/* returns 0 for an offset too big for this host; no file can then
+ * be mapped that large, and zero is an absent array */
+static size_t
+get_u64 (const unsigned char *b)
+{
+   size_t lo, hi;
+
+   lo = (size_t) get_u32 (b);
+   hi = (size_t) get_u32 (b+4);
+   if (hi && (4 >= sizeof (size_t))) return 0;
+   return lo | ((hi << 16) << 16);
+}
+
+static double
+get_f64 (const unsigned char *b)
+{
+   double v;
+   le_bytes ((unsigned char *) &v, b, 8);
+   return v;
+}
+
+/* ============================================================ */
+/* Writing */
+
+gleSweepWriter *
+gleSweepCreate (const char *filename)
+{
+   gleSweepWriter *w;
+   unsigned char header[SWEEP_HEADER_SIZE];
+
+   w = (gleSweepWriter *) malloc (sizeof (gleSweepWriter));
+   if (!w) return 0x0;
+   w->file = fopen (filename, "wb");
+   if (!w->file) {
+      free (w);
+      return 0x0;
+   }
+   w->entries = 0x0;
+   w->count = 0;
+   w->room = 0;
+   w->failed = 0;
+
+   /* the header is written again, filled in, by gleSweepFinish() */
+   memset (header, 0, SWEEP_HEADER_SIZE);
+   w->size = fwrite (header, 1, SWEEP_HEADER_SIZE, w->file);
+   if (SWEEP_HEADER_SIZE != w->size) w->failed = 1;
+   return w;
+}
+
+/* writes n bytes, then pads to a multiple of eight */
+static void
+write_bytes (gleSweepWriter *w, const unsigned char *b, size_t n)
+{
+   static const unsigned char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+   size_t pad = (8 - (n & 7)) & 7;
+
+   if (w->failed) return;
+   if ((n != fwrite (b, 1, n, w->file)) ||
+       (pad != fwrite (zeros, 1, pad, w->file))) {
+      w->failed = 1;
+      return;
+   }
+   w->size += n + pad;
+}
+
+/* appends an array of n doubles, or of n floats, and returns its
+ * offset; zero for a NULL array */
+static size_t
+write_array (gleSweepWriter *w, const void *v, int n, int is_float)
+{
+   unsigned char *b;
+   size_t offset, width;
+   int i;
+
+   if (!v || (0 >= n) || w->failed) return 0;
+
+   width = is_float ? 4 : 8;
+   b = (unsigned char *) malloc ((size_t) n * width);
+   if (!b) {
+      w->failed = 1;
+      return 0;
+   }
+   for (i=0; i<n; i++) {
+      if (is_float) {
+         le_bytes (b + 4*i, &((const float *) v)[i], 4);
+      } else {
+         le_f64 (b + 8*i, (double) ((const gleDouble *) v)[i]);
+      }
+   }
+   offset = w->size;
+   write_bytes (w, b, (size_t) n * width);
+   free (b);
+   return offset;
+}
+
+/* a join style and a number of sides that gleSweepDraw() can set */
+static int
+settings_valid (int join_style, int slices)
+{
+   int norm;
+
+   if ((0 >= slices) || (SWEEP_MAX_SLICES < slices)) return 0;
+   if (join_style & ~SWEEP_STYLE_BITS) return 0;
+   if (TUBE_JN_ROUND < (join_style & TUBE_JN_MASK)) return 0;
+
+   norm = join_style & TUBE_NORM_MASK;
+   return ((0 == norm) || (TUBE_NORM_FACET == norm) ||
+           (TUBE_NORM_EDGE == norm) || (TUBE_NORM_PATH_EDGE == norm));
+}
+
+/* The direction from a to b, and whether there is one. */
+static int
+sweep_direction (gleDouble a[3], gleDouble b[3], double d[3])
+{
+   double len;
+
+   d[0] = b[0] - a[0];
+   d[1] = b[1] - a[1];
+   d[2] = b[2] - a[2];
+   len = sqrt (d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+   if (0.0 >= len) return 0;
+   d[0] /= len;
+   d[1] /= len;
+   d[2] /= len;
+   return 1;
+}
+
+/* How much farther than the contour's reach the tube may get from the
+ * path at point i.  Every join style but the raw one meets at the plane
+ * that bisects the bend there (the round join only above the contour's
+ * origin), and a contour laid in that plane is stretched by 1/cos of
+ * half the bend.  Points that coincide are skipped, as the extrusion
+ * code skips them.  A path that doubles back on itself has no bound. */
+static double
+miter_factor (int npoints, gleDouble point_array[][3], int i)
+{
+   double before[3], after[3], half;
+   int j;
+
+   for (j=i-1; 0<=j; j--) {
+      if (sweep_direction (point_array[j], point_array[i], before)) break;
+   }
+   if (0 > j) return 1.0;
+   for (j=i+1; j<npoints; j++) {
+      if (sweep_direction (point_array[i], point_array[j], after)) break;
+   }
+   if (npoints <= j) return 1.0;
+
+   /* cos^2 of half the angle between the segments */
+   half = 0.5 * (1.0 + before[0]*after[0] + before[1]*after[1] +
+                 before[2]*after[2]);
+   if (1.0e-12 >= half) return HUGE_VAL;
+   return 1.0 / sqrt (half);
+}
+
+/* A box that holds the tube: the path, grown at each point by the
+ * farthest the contour reaches from it there, and by the stretch of
+ * the join at that point. */
+static void
+sweep_bounds (gleSweepEntry *e,
+              int ncp, gleDouble contour[][2],
+              int npoints, gleDouble point_array[][3],
+              gleDouble radius_array[],
+              gleDouble xform_array[][2][3])
+{
+   double reach, r, m;
+   int i, j, mitered;
+
+   reach = e->radius;
+   if (contour) {
+      reach = 0.0;
+      for (j=0; j<ncp; j++) {
+         r = sqrt (contour[j][0]*contour[j][0] + contour[j][1]*contour[j][1]);
+         if (r > reach) reach = r;
+      }
+   }
+   mitered = (TUBE_JN_RAW != (e->join_style & TUBE_JN_MASK));
+
+   for (j=0; j<3; j++) {
+      e->bounds[j] = HUGE_VAL;
+      e->bounds[j+3] = -HUGE_VAL;
+   }
+
+   for (i=0; i<npoints; i++) {
+      r = reach;
+      if (radius_array) r *= fabs (radius_array[i]);
+      if (xform_array) {
+         /* the Frobenius norm bounds the stretch; then the shift */
+         m = 0.0;
+         for (j=0; j<2; j++) {
+            m += xform_array[i][j][0] * xform_array[i][j][0];
+            m += xform_array[i][j][1] * xform_array[i][j][1];
+         }
+         r = r * sqrt (m) + sqrt (xform_array[i][0][2]*xform_array[i][0][2] +
+                                  xform_array[i][1][2]*xform_array[i][1][2]);
+      }
+      if (mitered && (0.0 < r)) r *= miter_factor (npoints, point_array, i);
+      for (j=0; j<3; j++) {
+         if (point_array[i][j] - r < e->bounds[j])
+            e->bounds[j] = point_array[i][j] - r;
+         if (point_array[i][j] + r > e->bounds[j+3])
+            e->bounds[j+3] = point_array[i][j] + r;
+      }
+   }
+}
+
+static int
+add_entry (gleSweepWriter *w,
+           int kind,
+           int ncp,
+           gleDouble contour[][2],
+           gleDouble cont_normal[][2],
+           gleDouble up[3],
+           int npoints,
+           gleDouble point_array[][3],
+           gleColor color_array[],
+           gleDouble radius,
+           gleDouble scalars[],
+           gleDouble xform_array[][2][3])
+{
+   gleSweepEntry *e, *grown;
+   int room;
+
+   if (!w || w->failed || (0 >= npoints)) return -1;
+   if ((SWEEP_EXTRUSION == kind) && ((0 >= ncp) || !contour)) return -1;
+
+   /* what couldn't be read back isn't written */
+   INIT_GC();
+   if (!settings_valid (_gle_gc->join_style, _gle_gc->slices)) return -1;
+
+   if (w->count == w->room) {
+      room = w->room ? 2 * w->room : 64;
+      grown = (gleSweepEntry *) realloc (w->entries,
+                                  (size_t) room * sizeof (gleSweepEntry));
+      if (!grown) {
+         w->failed = 1;
+         return -1;
+      }
+      w->entries = grown;
+      w->room = room;
+   }
+
+   e = &w->entries[w->count];
+   e->kind = kind;
+   e->join_style = _gle_gc->join_style;
+   e->slices = _gle_gc->slices;
+   e->ncp = ncp;
+   e->npoints = npoints;
+   e->color_size = color_array ? 3 : 0;
+   e->radius = radius;
+
+   e->offset[SWEEP_CONTOUR] = write_array (w, contour, 2*ncp, 0);
+   e->offset[SWEEP_CONT_NORMAL] = write_array (w, cont_normal, 2*ncp, 0);
+   e->offset[SWEEP_UP] = write_array (w, up, 3, 0);
+   e->offset[SWEEP_POINTS] = write_array (w, point_array, 3*npoints, 0);
+   e->offset[SWEEP_COLORS] = write_array (w, color_array, 3*npoints, 1);
+   e->offset[SWEEP_SCALARS] = write_array (w, scalars, npoints, 0);
+   e->offset[SWEEP_XFORMS] = write_array (w, xform_array, 6*npoints, 0);
+   if (w->failed) return -1;
+
+   sweep_bounds (e, ncp, contour, npoints, point_array,
+                 (SWEEP_POLYCONE == kind) ? scalars : NULL, xform_array);
+
+   return w->count ++;
+}
+
+int
+gleSweepAddPolyCylinder (gleSweepWriter *w,
+                         int npoints,
+                         gleDouble point_array[][3],
+                         gleColor color_array[],
+                         gleDouble radius)
+{
+   return add_entry (w, SWEEP_POLYCYLINDER, 0, NULL, NULL, NULL,
+                     npoints, point_array, color_array,
+                     radius, NULL, NULL);
+}
+
+int
+gleSweepAddPolyCone (gleSweepWriter *w,
+                     int npoints,
+                     gleDouble point_array[][3],
+                     gleColor color_array[],
+                     gleDouble radius_array[])
+{
+   return add_entry (w, SWEEP_POLYCONE, 0, NULL, NULL, NULL,
+                     npoints, point_array, color_array,
+                     1.0, radius_array, NULL);
+}
+
+int
+gleSweepAddExtrusion (gleSweepWriter *w,
+                      int ncp,
+                      gleDouble contour[][2],
+                      gleDouble cont_normal[][2],
+                      gleDouble up[3],
+                      int npoints,
+                      gleDouble point_array[][3],
+                      gleColor color_array[],
+                      gleDouble twist_array[],
+                      gleDouble xform_array[][2][3])
+{
+   /* one or the other; the twists would be ignored */
+   if (twist_array && xform_array) return -1;
+   return add_entry (w, SWEEP_EXTRUSION, ncp, contour, cont_normal, up,
+                     npoints, point_array, color_array,
+                     1.0, twist_array, xform_array);
+}
+
+/* Writes the table, and then the header, and closes the file.  The
+ * writer is freed, whether or not this succeeds. */
+int
+gleSweepFinish (gleSweepWriter *w)
+{
+   unsigned char b[SWEEP_ENTRY_SIZE];
+   gleSweepEntry *e;
+   size_t table;
+   int i, j, ok;
+
+   if (!w) return 0;
+
+   table = w->size;
+   for (i=0; i<w->count; i++) {
+      e = &w->entries[i];
+      memset (b, 0, SWEEP_ENTRY_SIZE);
+      le_u32 (b, (unsigned long) e->kind);
+      le_u32 (b+4, (unsigned long) (long) e->join_style & 0xffffffffUL);
+      le_u32 (b+8, (unsigned long) e->slices);
+      le_u32 (b+12, (unsigned long) e->ncp);
+      le_u32 (b+16, (unsigned long) e->npoints);
+      le_u32 (b+20, (unsigned long) e->color_size);
+      le_f64 (b+32, e->radius);
+      for (j=0; j<6; j++) le_f64 (b+40+8*j, e->bounds[j]);
+      for (j=0; j<SWEEP_NUM_ARRAYS; j++) le_u64 (b+88+8*j, e->offset[j]);
+      write_bytes (w, b, SWEEP_ENTRY_SIZE);
+   }
+
+   memset (b, 0, SWEEP_HEADER_SIZE);
+   memcpy (b, SWEEP_MAGIC, 8);
+   le_u32 (b+8, SWEEP_VERSION);
+   le_u32 (b+12, (unsigned long) w->count);
+   le_u64 (b+16, table);
+   if (!w->failed) {
+      if (fseek (w->file, 0, SEEK_SET) ||
+          (SWEEP_HEADER_SIZE != fwrite (b, 1, SWEEP_HEADER_SIZE, w->file))) {
+         w->failed = 1;
+      }
+   }
+
+   if (EOF == fclose (w->file)) w->failed = 1;
+   ok = !w->failed;
+   if (w->entries) free (w->entries);
+   free (w);
+   return ok;
+}
+
+/* ============================================================ */
+/* Reading */
+
+/* Maps the file, or failing that reads it in. */
+static int
+load_file (gleSweepFile *f, const char *filename)
+{
+   FILE *file;
+   long size;
+#ifdef SWEEP_MMAP
+   struct stat st;
+   void *addr;
+   int fd;
+
+   fd = open (filename, O_RDONLY);
+   if (0 > fd) return 0;
+   if ((0 == fstat (fd, &st)) && (0 < st.st_size)) {
+      addr = mmap (0x0, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (MAP_FAILED != addr) {
+         close (fd);
+         f->data = (const unsigned char *) addr;
+         f->size = (size_t) st.st_size;
+         f->mapped = 1;
+         return 1;
+      }
+   }
+   close (fd);
+#endif /* SWEEP_MMAP */
+
+   file = fopen (filename, "rb");
+   if (!file) return 0;
+   fseek (file, 0, SEEK_END);
+   size = ftell (file);
+   fseek (file, 0, SEEK_SET);
+   if (0 >= size) {
+      fclose (file);
+      return 0;
+   }
+   f->data = (const unsigned char *) malloc ((size_t) size);
+   if (!f->data ||
+       ((size_t) size != fread ((void *) f->data, 1, (size_t) size, file))) {
+      fclose (file);
+      return 0;
+   }
+   fclose (file);
+   f->size = (size_t) size;
+   f->mapped = 0;
+   return 1;
+}
+
+static void
+unload_file (gleSweepFile *f)
+{
+   if (!f->data) return;
+#ifdef SWEEP_MMAP
+   if (f->mapped) {
+      munmap ((void *) f->data, f->size);
+      f->data = 0x0;
+      return;
+   }
+#endif /* SWEEP_MMAP */
+   free ((void *) f->data);
+   f->data = 0x0;
+}
+
+/* the array lies within the file, on a multiple of eight */
+static int
+array_fits (gleSweepFile *f, size_t offset, int n, size_t width)
+{
+   if (0 == offset) return 1;
+   if ((0 > n) || (offset & 7) || (offset > f->size)) return 0;
+   return ((f->size - offset) / width >= (size_t) n);
+}
+
+/* Reads, and checks, the table of contents: this is all the work
+ * of opening a file.  Everything that gleSweepDraw() will trust is
+ * checked here. */
+static int
+read_table (gleSweepFile *f)
+{
+   const unsigned char *b;
+   gleSweepEntry *e;
+   size_t table;
+   unsigned long count;
+   int i, j;
+
+   if ((SWEEP_HEADER_SIZE > f->size) ||
+       memcmp (f->data, SWEEP_MAGIC, 8) ||
+       (SWEEP_VERSION != get_u32 (f->data+8))) return 0;
+
+   count = get_u32 (f->data+12);
+   table = get_u64 (f->data+16);
+   if ((0x7fffffffUL < count) || (table > f->size) ||
+       ((f->size - table) / SWEEP_ENTRY_SIZE < count)) return 0;
+
+   f->count = (int) count;
+   f->entries = (gleSweepEntry *) malloc ((count ? count : 1) *
+                                          sizeof (gleSweepEntry));
+   if (!f->entries) return 0;
+
+   for (i=0; i<f->count; i++) {
+      b = f->data + table + (size_t) i * SWEEP_ENTRY_SIZE;
+      e = &f->entries[i];
+      e->kind = get_i32 (b);
+      e->join_style = get_i32 (b+4);
+      e->slices = get_i32 (b+8);
+      e->ncp = get_i32 (b+12);
+      e->npoints = get_i32 (b+16);
+      e->color_size = get_i32 (b+20);
+      e->radius = get_f64 (b+32);
+      for (j=0; j<6; j++) e->bounds[j] = get_f64 (b+40+8*j);
+      for (j=0; j<SWEEP_NUM_ARRAYS; j++) e->offset[j] = get_u64 (b+88+8*j);
+
+      if ((SWEEP_POLYCYLINDER > e->kind) || (SWEEP_EXTRUSION < e->kind) ||
+          (0 >= e->npoints) || (0 > e->ncp) ||
+          (0x7fffffff / 6 < e->npoints) || (0x7fffffff / 2 < e->ncp) ||
+          (0 == e->offset[SWEEP_POINTS]) ||
+          !settings_valid (e->join_style, e->slices) ||
+          ((0 != e->color_size) && (3 != e->color_size)) ||
+          ((SWEEP_EXTRUSION == e->kind) &&
+           ((0 == e->ncp) || (0 == e->offset[SWEEP_CONTOUR]))) ||
+          !array_fits (f, e->offset[SWEEP_CONTOUR], 2*e->ncp, 8) ||
+          !array_fits (f, e->offset[SWEEP_CONT_NORMAL], 2*e->ncp, 8) ||
+          !array_fits (f, e->offset[SWEEP_UP], 3, 8) ||
+          !array_fits (f, e->offset[SWEEP_POINTS], 3*e->npoints, 8) ||
+          !array_fits (f, e->offset[SWEEP_COLORS],
+                       e->color_size*e->npoints, 4) ||
+          !array_fits (f, e->offset[SWEEP_SCALARS], e->npoints, 8) ||
+          !array_fits (f, e->offset[SWEEP_XFORMS], 6*e->npoints, 8)) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+gleSweepFile *
+gleSweepOpen (const char *filename)
+{
+   gleSweepFile *f;
+
+   f = (gleSweepFile *) malloc (sizeof (gleSweepFile));
+   if (!f) return 0x0;
+   f->data = 0x0;
+   f->size = 0;
+   f->mapped = 0;
+   f->entries = 0x0;
+   f->count = 0;
+
+   if (!load_file (f, filename) || !read_table (f)) {
+      gleSweepClose (f);
+      return 0x0;
+   }
+   return f;
+}
+
+void
+gleSweepClose (gleSweepFile *f)
+{
+   if (!f) return;
+   unload_file (f);
+   if (f->entries) free (f->entries);
+   free (f);
+}
+
+int
+gleSweepCount (gleSweepFile *f)
+{
+   return f ? f->count : 0;
+}
+
+int
+gleSweepGetBounds (gleSweepFile *f, int index,
+                   gleDouble min[3], gleDouble max[3])
+{
+   gleSweepEntry *e;
+   int j;
+
+   if (!f || (0 > index) || (f->count <= index)) return 0;
+   e = &f->entries[index];
+   for (j=0; j<3; j++) {
+      min[j] = (gleDouble) e->bounds[j];
+      max[j] = (gleDouble) e->bounds[j+3];
+   }
+   return 1;
+}
+
+/* ============================================================ */
+/* Drawing */
+
+/* An array of the entry, where it lies in the file if it can be used
+ * as it is, else copied into scratch, which is advanced past it. */
+static void *
+sweep_array (gleSweepFile *f, size_t offset, int n, int is_float,
+             unsigned char **scratch)
+{
+   void *v;
+   int i;
+
+   if (0 == offset) return 0x0;
+   if (IN_PLACE ()) return (void *) (f->data + offset);
+
+   v = (void *) *scratch;
+   for (i=0; i<n; i++) {
+      if (is_float) {
+         le_bytes ((unsigned char *) &((float *) v)[i],
+                   f->data + offset + 4*i, 4);
+      } else {
+         ((gleDouble *) v)[i] = (gleDouble) get_f64 (f->data + offset + 8*i);
+      }
+   }
+   /* the next array starts on a double */
+   *scratch += ((size_t) n * (is_float ? sizeof (float) : sizeof (gleDouble))
+               + sizeof (gleDouble) - 1) / sizeof (gleDouble)
+               * sizeof (gleDouble);
+   return v;
+}
+
+void
+gleSweepDraw (gleSweepFile *f, int index)
+{
+   gleSweepEntry *e;
+   unsigned char *mem_anchor, *scratch;
+   gleDouble (*contour)[2], (*cont_normal)[2], *up;
+   gleDouble (*points)[3], *scalars;
+   gleAffine *xforms;
+   float *colors;
+   int saved_style, saved_slices;
+   size_t n;
+
+   if (!f || (0 > index) || (f->count <= index)) return;
+   e = &f->entries[index];
+
+   INIT_GC();
+
+   mem_anchor = 0x0;
+   if (!IN_PLACE ()) {
+      /* every array, rounded up to a double */
+      n = 4*(size_t)e->ncp + 3 + 3*(size_t)e->npoints +
+          (3*(size_t)e->npoints + 1) / 2 +
+          7*(size_t)e->npoints + 7;
+      mem_anchor = (unsigned char *) gle_malloc (n * sizeof (gleDouble));
+      if (!mem_anchor) return;
+   }
+   scratch = mem_anchor;
+
+   contour = (gleDouble (*)[2]) sweep_array (f, e->offset[SWEEP_CONTOUR],
+                                             2*e->ncp, 0, &scratch);
+   cont_normal = (gleDouble (*)[2]) sweep_array (f,
+                     e->offset[SWEEP_CONT_NORMAL], 2*e->ncp, 0, &scratch);
+   up = (gleDouble *) sweep_array (f, e->offset[SWEEP_UP], 3, 0, &scratch);
+   points = (gleDouble (*)[3]) sweep_array (f, e->offset[SWEEP_POINTS],
+                                            3*e->npoints, 0, &scratch);
+   colors = (float *) sweep_array (f, e->offset[SWEEP_COLORS],
+                                   e->color_size*e->npoints, 1, &scratch);
+   scalars = (gleDouble *) sweep_array (f, e->offset[SWEEP_SCALARS],
+                                        e->npoints, 0, &scratch);
+   xforms = (gleAffine *) sweep_array (f, e->offset[SWEEP_XFORMS],
+                                       6*e->npoints, 0, &scratch);
+
+   /* each sweep is drawn as it was when it was added */
+   saved_style = _gle_gc->join_style;
+   saved_slices = _gle_gc->slices;
+   gleSetJoinStyle (e->join_style);
+   if (e->slices != saved_slices) gleSetNumSides (e->slices);
+
+   switch (e->kind) {
+      case SWEEP_POLYCYLINDER:
+         glePolyCylinder (e->npoints, points, (gleColor *) colors, e->radius);
+         break;
+
+      case SWEEP_POLYCONE:
+         glePolyCone (e->npoints, points, (gleColor *) colors, scalars);
+         break;
+
+      case SWEEP_EXTRUSION:
+         if (xforms) {
+            gleSuperExtrusion (e->ncp, contour, cont_normal, up,
+                      e->npoints, points, (gleColor *) colors, xforms);
+         } else if (scalars) {
+            gleTwistExtrusion (e->ncp, contour, cont_normal, up,
+                      e->npoints, points, (gleColor *) colors, scalars);
+         } else {
+            gleExtrusion (e->ncp, contour, cont_normal, up,
+                      e->npoints, points, (gleColor *) colors);
+         }
+         break;
+
+      default:
+         break;
+   }
+
+   gleSetJoinStyle (saved_style);
+   if (e->slices != saved_slices) gleSetNumSides (saved_slices);
+
+   if (mem_anchor) free (mem_anchor);
+}
+
+/* ===================== END OF FILE ======================== */
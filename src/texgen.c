@@ -22,7 +22,9 @@
 #include "gle.h"
 #include "port.h"
 #include "tube_gc.h"
+#include "trace.h"
 
+#if __GLE_DOUBLE
 /* ======================================================= */
 /* should really make this an adaptive algorithm ... */  
 #define _POLYCYL_TESS   20   
@@ -54,10 +56,34 @@ gleCreateGC (void)
    retval -> slices = 0;
    retval -> circle = 0x0;
    retval -> norm = 0x0;
+   retval -> circle_f = 0x0;
+   retval -> norm_f = 0x0;
    setup_circle (retval, _POLYCYL_TESS);
 
    retval -> ncp = 0;
    retval -> npoints = 0;
+   retval -> xform_kind = 0;
+   retval -> xform_scalars = 0x0;
+
+   retval -> origin[0] = 0.0;
+   retval -> origin[1] = 0.0;
+   retval -> origin[2] = 0.0;
+
+   retval -> point_stride = 0;
+   retval -> color_stride = 0;
+   retval -> xform_stride = 0;
+   retval -> scalar_stride = 0;
+
+   retval -> stats = 0x0;
+   retval -> stats_nest = 0;
+   retval -> stats_top = 0;
+   retval -> stats_mark = 0.0;
+
+   retval -> trace = 0x0;
+   retval -> trace_nest = 0;
+   retval -> texture_mode = 0;
+   retval -> texture_style = 0;
+   retval -> save_texture_style = 0;
 
    retval -> num_vert = 0;
    retval -> segment_number = 0;
@@ -75,8 +101,12 @@ gleDestroyGC (void)
 {
    if (_gle_gc) 
    {
+      gleTraceClose ();
       if (_gle_gc->circle) free (_gle_gc->circle);
       _gle_gc->circle = 0x0;
+      if (_gle_gc->circle_f) free (_gle_gc->circle_f);
+      _gle_gc->circle_f = 0x0;
+      if (_gle_gc->stats) free (_gle_gc->stats);
       free (_gle_gc);
    }
    _gle_gc = 0x0;
@@ -84,7 +114,8 @@ gleDestroyGC (void)
 
 /* ======================================================= */
 /* setup_circle is used to avoid excessive mallocs and frees
- * when drawing polycylinders and polycones */
+ * when drawing polycylinders and polycones.  The float build gets
+ * its own copy of the circle, rounded from this one. */
 
 static void 
 setup_circle (gleGC *gc, int nslices)
@@ -100,6 +131,9 @@ setup_circle (gleGC *gc, int nslices)
       gc->circle = (gleTwoVec *) realloc (gc->circle, 
                                           sizeof(gleTwoVec)*2*(size_t)nslices);
       gc->norm = &(gc->circle)[nslices];
+      gc->circle_f = (float (*)[2]) realloc (gc->circle_f,
+                                          2*sizeof(float)*2*(size_t)nslices);
+      gc->norm_f = &(gc->circle_f)[nslices];
    }
 
    s = sin (2.0*M_PI/ ((double) nslices));
@@ -114,6 +148,11 @@ setup_circle (gleGC *gc, int nslices)
       gc->norm [i][1] = gc->norm[i-1][0] * s + gc->norm[i-1][1] * c;
    }
 
+   for (i=0; i<nslices; i++) {
+      gc->norm_f [i][0] = (float) gc->norm[i][0];
+      gc->norm_f [i][1] = (float) gc->norm[i][1];
+   }
+
   gc->slices = nslices;
 }
 
@@ -128,9 +167,11 @@ void
 gleSetNumSides(int nslices)
 {
   INIT_GC(); 
+  GLE_TRACE_SETTING (gle_trace_int (GLE_TRACE_NUM_SIDES, nslices));
   setup_circle (_gle_gc, nslices);
 }
 
+#endif /* __GLE_DOUBLE */
 /* ======================================================= */
 
 #define segment_number (_gle_gc -> segment_number)
@@ -146,7 +187,7 @@ static double save_nx = 0.0;
 static double save_ny = 0.0;
 static double save_nz = 0.0;
 
-static void save_normal (double *v) {
+static void save_normal (gleDouble *v) {
    save_nx = v[0];
    save_ny = v[1];
    save_nz = v[2];
@@ -208,7 +249,7 @@ static void sphere_texgen (double x, double y, double z,
 /* ======================================================= */
 /* mappers */
 
-static void vertex_sphere_texgen_v (double *v, int jcnt, int which_end)  {
+static void vertex_sphere_texgen_v (gleDouble *v, int jcnt, int which_end)  {
    double x = v[0]; double y = v[1]; double z = v[2];
    double r;
 
@@ -219,11 +260,11 @@ static void vertex_sphere_texgen_v (double *v, int jcnt, int which_end)  {
    sphere_texgen (x, y, z, jcnt, which_end);
 }
 
-static void normal_sphere_texgen_v (double *v, int jcnt, int which_end)  {
+static void normal_sphere_texgen_v (gleDouble *v, int jcnt, int which_end)  {
    sphere_texgen (save_nx, save_ny, save_nz, jcnt, which_end);
 }
 
-static void vertex_sphere_model_v (double *v, int jcnt, int which_end) {
+static void vertex_sphere_model_v (gleDouble *v, int jcnt, int which_end) {
    double x = _gle_gc->contour[jcnt][0]; 
    double y = _gle_gc->contour[jcnt][1]; 
    double z = v[2];
@@ -236,7 +277,7 @@ static void vertex_sphere_model_v (double *v, int jcnt, int which_end) {
    sphere_texgen (x, y, z, jcnt, which_end);
 }
 
-static void normal_sphere_model_v (double *v, int jcnt, int which_end) {
+static void normal_sphere_model_v (gleDouble *v, int jcnt, int which_end) {
    if (!(_gle_gc -> cont_normal)) return;
    sphere_texgen (_gle_gc->cont_normal[jcnt][0], 
                 _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
@@ -295,7 +336,7 @@ static void cylinder_texgen (double x, double y, double z,
 /* ======================================================= */
 /* mappers */
 
-static void vertex_cylinder_texgen_v (double *v, int jcnt, int which_end) {
+static void vertex_cylinder_texgen_v (gleDouble *v, int jcnt, int which_end) {
    double x = v[0]; double y = v[1]; double z = v[2];
    double r;
 
@@ -305,11 +346,11 @@ static void vertex_cylinder_texgen_v (double *v, int jcnt, int which_end) {
    cylinder_texgen (x, y, z, jcnt, which_end);
 }
 
-static void normal_cylinder_texgen_v (double *v, int jcnt, int which_end) {
+static void normal_cylinder_texgen_v (gleDouble *v, int jcnt, int which_end) {
    cylinder_texgen (save_nx, save_ny, save_nz, jcnt, which_end);
 }
 
-static void vertex_cylinder_model_v (double *v, int jcnt, int which_end) {
+static void vertex_cylinder_model_v (gleDouble *v, int jcnt, int which_end) {
    double x = _gle_gc->contour[jcnt][0]; 
    double y = _gle_gc->contour[jcnt][1]; 
    double z = v[2];
@@ -321,7 +362,7 @@ static void vertex_cylinder_model_v (double *v, int jcnt, int which_end) {
    cylinder_texgen (x, y, z, jcnt, which_end);
 }
 
-static void normal_cylinder_model_v (double *v, int jcnt, int which_end) {
+static void normal_cylinder_model_v (gleDouble *v, int jcnt, int which_end) {
    if (!(_gle_gc -> cont_normal)) return;
    cylinder_texgen (_gle_gc->cont_normal[jcnt][0], 
                 _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
@@ -343,115 +384,149 @@ static void flat_texgen (double x, double y, double z,
 /* ======================================================= */
 
 
-static void vertex_flat_texgen_v (double *v, int jcnt, int which_end) {
+static void vertex_flat_texgen_v (gleDouble *v, int jcnt, int which_end) {
    flat_texgen (v[0], v[1], v[2], jcnt, which_end);
 }
 
-static void normal_flat_texgen_v (double *v, int jcnt, int which_end) {
+static void normal_flat_texgen_v (gleDouble *v, int jcnt, int which_end) {
    flat_texgen (save_nx, save_ny, save_nz, jcnt, which_end);
 }
 
-static void vertex_flat_model_v (double *v, int jcnt, int which_end) {
+static void vertex_flat_model_v (gleDouble *v, int jcnt, int which_end) {
    flat_texgen (_gle_gc->contour[jcnt][0], 
                 _gle_gc->contour[jcnt][1], v[2], jcnt, which_end);
 }
 
-static void normal_flat_model_v (double *v, int jcnt, int which_end) {
+static void normal_flat_model_v (gleDouble *v, int jcnt, int which_end) {
    if (!(_gle_gc -> cont_normal)) return;
    flat_texgen (_gle_gc->cont_normal[jcnt][0], 
                 _gle_gc->cont_normal[jcnt][1], 0.0, jcnt, which_end);
 }
 
 /* ======================================================= */
+/* Points the texture hooks of this precision, v3d and n3d in the
+ * double build, v3f and n3f in the float one, at the mappers for
+ * style.  Returns FALSE, leaving the hooks alone, if style is not
+ * one of the mapping styles. */
 
-void gleTextureMode (int mode) {
-
-   INIT_GC();
+int gle_texgen_select (int style) {
 
-   /* enable textureing by restoring the mode */
-   _gle_gc -> bgn_gen_texture = _gle_gc -> save_bgn_gen_texture; 
-   _gle_gc -> n3f_gen_texture = _gle_gc -> save_n3f_gen_texture; 
-   _gle_gc -> n3d_gen_texture = _gle_gc -> save_n3d_gen_texture; 
-   _gle_gc -> v3f_gen_texture = _gle_gc -> save_v3f_gen_texture; 
-   _gle_gc -> v3d_gen_texture = _gle_gc -> save_v3d_gen_texture; 
-   _gle_gc -> end_gen_texture = _gle_gc -> save_end_gen_texture; 
+   void (*bgn) (int, double);
+   void (*vert) (gleDouble *, int, int);
+   void (*norm) (gleDouble *);
 
-   switch (mode&GLE_TEXTURE_STYLE_MASK) {
+   switch (style) {
 
       case GLE_TEXTURE_VERTEX_FLAT:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_flat_texgen_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = vertex_flat_texgen_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_FLAT:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = normal_flat_texgen_v;
-         _gle_gc -> n3d_gen_texture = save_normal;
+         bgn = bgn_z_texgen;
+         vert = normal_flat_texgen_v;
+         norm = save_normal;
          break;
 
       case GLE_TEXTURE_VERTEX_MODEL_FLAT:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_flat_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = vertex_flat_model_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_MODEL_FLAT:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = normal_flat_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = normal_flat_model_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_VERTEX_CYL:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_cylinder_texgen_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = vertex_cylinder_texgen_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_CYL:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = normal_cylinder_texgen_v;
-         _gle_gc -> n3d_gen_texture = save_normal;
+         bgn = bgn_z_texgen;
+         vert = normal_cylinder_texgen_v;
+         norm = save_normal;
          break;
 
       case GLE_TEXTURE_VERTEX_MODEL_CYL:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_cylinder_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = vertex_cylinder_model_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_MODEL_CYL:
-         _gle_gc -> bgn_gen_texture = bgn_z_texgen;
-         _gle_gc -> v3d_gen_texture = normal_cylinder_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_z_texgen;
+         vert = normal_cylinder_model_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_VERTEX_SPH:
-         _gle_gc -> bgn_gen_texture = bgn_sphere_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_sphere_texgen_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_sphere_texgen;
+         vert = vertex_sphere_texgen_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_SPH:
-         _gle_gc -> bgn_gen_texture = bgn_sphere_texgen;
-         _gle_gc -> v3d_gen_texture = normal_sphere_texgen_v;
-         _gle_gc -> n3d_gen_texture = save_normal;
+         bgn = bgn_sphere_texgen;
+         vert = normal_sphere_texgen_v;
+         norm = save_normal;
          break;
 
       case GLE_TEXTURE_VERTEX_MODEL_SPH:
-         _gle_gc -> bgn_gen_texture = bgn_sphere_texgen;
-         _gle_gc -> v3d_gen_texture = vertex_sphere_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_sphere_texgen;
+         vert = vertex_sphere_model_v;
+         norm = 0x0;
          break;
 
       case GLE_TEXTURE_NORMAL_MODEL_SPH:
-         _gle_gc -> bgn_gen_texture = bgn_sphere_texgen;
-         _gle_gc -> v3d_gen_texture = normal_sphere_model_v;
-         _gle_gc -> n3d_gen_texture = 0x0;
+         bgn = bgn_sphere_texgen;
+         vert = normal_sphere_model_v;
+         norm = 0x0;
          break;
 
       default:
-         break;
+         return FALSE;
+   }
+
+   _gle_gc -> bgn_gen_texture = bgn;
+#if __GLE_DOUBLE
+   _gle_gc -> v3d_gen_texture = vert;
+   _gle_gc -> n3d_gen_texture = norm;
+#else
+   _gle_gc -> v3f_gen_texture = vert;
+   _gle_gc -> n3f_gen_texture = norm;
+#endif
+   return TRUE;
+}
+
+/* ======================================================= */
+#if __GLE_DOUBLE
+/* The float build does not look at the hooks set here; it hooks up
+ * its own mappers, for the texture_style recorded here, on each call
+ * (see gleSuperExtrusion() in extrude.c). */
+
+void gleTextureMode (int mode) {
+
+   INIT_GC();
+   GLE_TRACE_SETTING (gle_trace_int (GLE_TRACE_TEXTURE_MODE, mode));
+   _gle_gc -> texture_mode = mode;
+
+   /* enable textureing by restoring the mode */
+   _gle_gc -> bgn_gen_texture = _gle_gc -> save_bgn_gen_texture; 
+   _gle_gc -> n3f_gen_texture = _gle_gc -> save_n3f_gen_texture; 
+   _gle_gc -> n3d_gen_texture = _gle_gc -> save_n3d_gen_texture; 
+   _gle_gc -> v3f_gen_texture = _gle_gc -> save_v3f_gen_texture; 
+   _gle_gc -> v3d_gen_texture = _gle_gc -> save_v3d_gen_texture; 
+   _gle_gc -> end_gen_texture = _gle_gc -> save_end_gen_texture; 
+   _gle_gc -> texture_style = _gle_gc -> save_texture_style;
+
+   if (gle_texgen_select (mode&GLE_TEXTURE_STYLE_MASK)) {
+      _gle_gc -> texture_style = mode&GLE_TEXTURE_STYLE_MASK;
    }
 
    /* disable texturing, and save the mode */
@@ -462,6 +537,7 @@ void gleTextureMode (int mode) {
       _gle_gc -> save_v3f_gen_texture = _gle_gc -> v3f_gen_texture; 
       _gle_gc -> save_v3d_gen_texture = _gle_gc -> v3d_gen_texture; 
       _gle_gc -> save_end_gen_texture = _gle_gc -> end_gen_texture; 
+      _gle_gc -> save_texture_style = _gle_gc -> texture_style;
 
       _gle_gc -> bgn_gen_texture = 0x0;
       _gle_gc -> n3f_gen_texture = 0x0;
@@ -469,7 +545,9 @@ void gleTextureMode (int mode) {
       _gle_gc -> v3f_gen_texture = 0x0;
       _gle_gc -> v3d_gen_texture = 0x0;
       _gle_gc -> end_gen_texture = 0x0;
+      _gle_gc -> texture_style = 0;
    }
 }
 
+#endif /* __GLE_DOUBLE */
 /* ================== END OF FILE ========================= */
@@ -0,0 +1,446 @@
+/*
+ * FILE:
+ * trace.c
+ *
+ * FUNCTION:
+ * Call tracing.  Between gleTraceOpen() and gleTraceClose(), every
+ * call made into the library is written to a file, with all of its
+ * arguments, so that a workload captured in an application can later
+ * be replayed, and timed, without the application; see
+ * bench/glereplay.c.  The layout of the file is given in trace.h.
+ *
+ * Each record is put together in a buffer, and written with a single
+ * fwrite().  If a write fails, a warning is printed and nothing more
+ * is recorded, but the drawing goes on as before.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#if defined(_WIN32) && !defined(__clang__)
+# include <malloc.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gle.h"
+#include "port.h"
+#include "tube_gc.h"
+#include "trace.h"
+
+struct _gleTrace {
+   FILE *file;
+   unsigned char *buf;      /* the record being put together */
+   size_t len;
+   size_t size;
+   int failed;              /* a write or a malloc has failed */
+};
+
+/* ============================================================ */
+/* The buffer.  All values are stored little-endian. */
+
+static void
+put_bytes (struct _gleTrace *t, const void *bytes, size_t n)
+{
+   unsigned char *grown;
+   size_t size;
+
+   if (t->failed) return;
+
+   if (t->len + n > t->size) {
+      size = 2 * t->size;
+      if (size < t->len + n) size = t->len + n;
+      grown = (unsigned char *) realloc (t->buf, size);
+      if (!grown) {
+         t->failed = 1;
+         return;
+      }
+      t->buf = grown;
+      t->size = size;
+   }
+   memcpy (t->buf + t->len, bytes, n);
+   t->len += n;
+}
+
+static void
+put_u8 (struct _gleTrace *t, int v)
+{
+   unsigned char b = (unsigned char) v;
+   put_bytes (t, &b, 1);
+}
+
+static void
+put_u32 (struct _gleTrace *t, unsigned long v)
+{
+   unsigned char b[4];
+
+   b[0] = (unsigned char) (v & 0xff);
+   b[1] = (unsigned char) ((v >> 8) & 0xff);
+   b[2] = (unsigned char) ((v >> 16) & 0xff);
+   b[3] = (unsigned char) ((v >> 24) & 0xff);
+   put_bytes (t, b, 4);
+}
+
+static void
+put_i32 (struct _gleTrace *t, int v)
+{
+   put_u32 (t, ((unsigned long) (long) v) & 0xffffffffUL);
+}
+
+/* floats and doubles are assumed to be IEEE; only the byte order of
+ * the host is looked at */
+static int
+host_is_big_endian (void)
+{
+   unsigned int one = 1;
+   return (0 == *((unsigned char *) &one));
+}
+
+static void
+put_swapped (struct _gleTrace *t, const void *value, size_t n)
+{
+   unsigned char b[8];
+   size_t i;
+
+   if (host_is_big_endian ()) {
+      for (i=0; i<n; i++) b[i] = ((const unsigned char *) value)[n-1-i];
+      put_bytes (t, b, n);
+   } else {
+      put_bytes (t, value, n);
+   }
+}
+
+static void
+put_f64 (struct _gleTrace *t, double v)
+{
+   put_swapped (t, &v, sizeof (double));
+}
+
+static void
+put_f64s (struct _gleTrace *t, const gleDouble *v, int n)
+{
+   int i;
+   for (i=0; i<n; i++) put_f64 (t, (double) v[i]);
+}
+
+/* an array that may be NULL */
+static void
+put_opt_f64s (struct _gleTrace *t, const gleDouble *v, int n)
+{
+   put_u8 (t, v ? 1 : 0);
+   if (v) put_f64s (t, v, n);
+}
+
+/* The path arrays, read with the strides in the GC (see tube_gc.h),
+ * and written packed.  n values are taken from each element. */
+static void
+put_path_f64s (struct _gleTrace *t, const void *base, int stride,
+               size_t size, int n, int npoints)
+{
+   int i;
+   for (i=0; i<npoints; i++) {
+      put_f64s (t, (const gleDouble *) STRIDE_AT (base, stride, size, i), n);
+   }
+}
+
+static void
+put_opt_path_f64s (struct _gleTrace *t, const void *base, int stride,
+                   size_t size, int n, int npoints)
+{
+   put_u8 (t, base ? 1 : 0);
+   if (base) put_path_f64s (t, base, stride, size, n, npoints);
+}
+
+static void
+put_opt_path_f32s (struct _gleTrace *t, const float *base, int n, int npoints)
+{
+   const float *v;
+   int i, j;
+
+   put_u8 (t, base ? 1 : 0);
+   if (!base) return;
+   for (i=0; i<npoints; i++) {
+      v = (const float *) STRIDE_AT (base, _gle_gc->color_stride,
+                                     (size_t) n * sizeof (float), i);
+      for (j=0; j<n; j++) put_swapped (t, &v[j], sizeof (float));
+   }
+}
+
+/* ============================================================ */
+/* Records.  The length is filled in once the payload is known. */
+
+static struct _gleTrace *
+begin_record (int op)
+{
+   struct _gleTrace *t = _gle_gc->trace;
+
+   t->len = 0;
+   put_u8 (t, op);
+   put_u32 (t, 0);
+   return t;
+}
+
+static void
+end_record (struct _gleTrace *t)
+{
+   unsigned long n;
+
+   if (!t->failed) {
+      n = (unsigned long) (t->len - 5);
+      t->buf[1] = (unsigned char) (n & 0xff);
+      t->buf[2] = (unsigned char) ((n >> 8) & 0xff);
+      t->buf[3] = (unsigned char) ((n >> 16) & 0xff);
+      t->buf[4] = (unsigned char) ((n >> 24) & 0xff);
+      if (t->len != fwrite (t->buf, 1, t->len, t->file)) t->failed = 1;
+      if (!t->failed) return;
+   }
+
+   /* stop tracing, but keep the file open until gleTraceClose() */
+   fprintf (stderr, "GLE: Warning: the call trace could not be written; "
+                    "tracing has stopped\n");
+   t->failed = 2;
+}
+
+/* the flags common to all primitives */
+static void
+put_flags (struct _gleTrace *t, int color_size)
+{
+   int flags = 0;
+
+   if (__IS_LIGHTING_ON) flags |= GLE_TRACE_LIGHTING;
+   if (4 == color_size) flags |= GLE_TRACE_C4F;
+   put_u8 (t, flags);
+}
+
+static void
+put_contour (struct _gleTrace *t,
+             int ncp,
+             gleDouble contour[][2],
+             gleDouble cont_normal[][2],
+             gleDouble up[3])
+{
+   put_i32 (t, ncp);
+   put_f64s (t, (gleDouble *) contour, 2*ncp);
+   put_opt_f64s (t, (gleDouble *) cont_normal, 2*ncp);
+   put_opt_f64s (t, up, 3);
+}
+
+/* ============================================================ */
+/* The hooks called by the primitives.  A trace that has failed is
+ * left alone; see end_record(). */
+
+#define TRACING() (_gle_gc->trace && (2 != _gle_gc->trace->failed))
+
+#if __GLE_DOUBLE
+void
+gle_trace_int (int op, int value)
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (op);
+   put_i32 (t, value);
+   end_record (t);
+}
+
+void
+gle_trace_origin (double origin[3])
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (GLE_TRACE_ORIGIN);
+   put_f64 (t, origin[0]);
+   put_f64 (t, origin[1]);
+   put_f64 (t, origin[2]);
+   end_record (t);
+}
+#endif /* __GLE_DOUBLE */
+
+/* These two are built a second time by ex_float.c; a float call is
+ * recorded as the double-precision call, with its arguments widened. */
+
+void
+gle_trace_polycone (int op,
+                int npoints,
+                gleDouble point_array[][3],
+                float *color_array,
+                int color_size,
+                gleDouble radius,
+                gleDouble radius_array[])
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (op);
+   put_flags (t, color_size);
+   put_i32 (t, npoints);
+   put_path_f64s (t, point_array, _gle_gc->point_stride,
+                  sizeof (gleVector), 3, npoints);
+   put_opt_path_f32s (t, color_array, color_size, npoints);
+   if (GLE_TRACE_POLYCYLINDER == op) {
+      put_f64 (t, radius);
+   } else {
+      put_opt_path_f64s (t, radius_array, _gle_gc->scalar_stride,
+                         sizeof (gleDouble), 1, npoints);
+   }
+   end_record (t);
+}
+
+void
+gle_trace_extrusion (int op,
+                int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                int npoints,
+                gleDouble point_array[][3],
+                float *color_array,
+                int color_size,
+                gleDouble twist_array[],
+                gleDouble xform_array[][2][3])
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (op);
+   put_flags (t, color_size);
+   put_contour (t, ncp, contour, cont_normal, up);
+   put_i32 (t, npoints);
+   put_path_f64s (t, point_array, _gle_gc->point_stride,
+                  sizeof (gleVector), 3, npoints);
+   put_opt_path_f32s (t, color_array, color_size, npoints);
+   if (GLE_TRACE_TWIST_EXTRUSION == op) {
+      put_opt_path_f64s (t, twist_array, _gle_gc->scalar_stride,
+                         sizeof (gleDouble), 1, npoints);
+   }
+   if (GLE_TRACE_SUPER_EXTRUSION == op) {
+      put_opt_path_f64s (t, xform_array, _gle_gc->xform_stride,
+                         sizeof (gleAffine), 6, npoints);
+   }
+   end_record (t);
+}
+
+#if __GLE_DOUBLE
+void
+gle_trace_helix (int op,
+                int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                gleDouble rToroid,
+                gleDouble startRadius,
+                gleDouble drdTheta,
+                gleDouble startZ,
+                gleDouble dzdTheta,
+                gleDouble startXform[2][3],
+                gleDouble dXformdTheta[2][3],
+                gleDouble startTheta,
+                gleDouble sweepTheta)
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (op);
+   put_flags (t, 3);
+   if ((GLE_TRACE_SPIRAL == op) || (GLE_TRACE_LATHE == op)) {
+      put_contour (t, ncp, contour, cont_normal, up);
+   } else {
+      put_f64 (t, rToroid);
+   }
+   put_f64 (t, startRadius);
+   put_f64 (t, drdTheta);
+   put_f64 (t, startZ);
+   put_f64 (t, dzdTheta);
+   put_opt_f64s (t, (gleDouble *) startXform, 6);
+   put_opt_f64s (t, (gleDouble *) dXformdTheta, 6);
+   put_f64 (t, startTheta);
+   put_f64 (t, sweepTheta);
+   end_record (t);
+}
+
+void
+gle_trace_screw (int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                gleDouble startz,
+                gleDouble endz,
+                gleDouble twist)
+{
+   struct _gleTrace *t;
+
+   if (!TRACING()) return;
+   t = begin_record (GLE_TRACE_SCREW);
+   put_flags (t, 3);
+   put_contour (t, ncp, contour, cont_normal, up);
+   put_f64 (t, startz);
+   put_f64 (t, endz);
+   put_f64 (t, twist);
+   end_record (t);
+}
+
+/* ============================================================ */
+/* The trace starts with the state that the calls to come depend on,
+ * so that it replays the same whatever was set before it was opened. */
+
+int
+gleTraceOpen (const char *filename)
+{
+   struct _gleTrace *t;
+
+   INIT_GC();
+   gleTraceClose ();
+
+   t = (struct _gleTrace *) malloc (sizeof (struct _gleTrace));
+   if (!t) return 0;
+   t->file = fopen (filename, "wb");
+   if (!t->file) {
+      free (t);
+      return 0;
+   }
+   t->buf = 0x0;
+   t->len = 0;
+   t->size = 0;
+   t->failed = 0;
+
+   _gle_gc->trace = t;
+   _gle_gc->trace_nest = 0;
+
+   t->len = 0;
+   put_bytes (t, GLE_TRACE_MAGIC, 8);
+   put_u32 (t, GLE_TRACE_VERSION);
+   if ((t->failed) || (t->len != fwrite (t->buf, 1, t->len, t->file))) {
+      gleTraceClose ();
+      return 0;
+   }
+
+   gle_trace_int (GLE_TRACE_JOIN_STYLE, _gle_gc->join_style);
+   gle_trace_int (GLE_TRACE_NUM_SIDES, _gle_gc->slices);
+   gle_trace_int (GLE_TRACE_TEXTURE_MODE, _gle_gc->texture_mode);
+   gle_trace_origin (_gle_gc->origin);
+   return 1;
+}
+
+void
+gleTraceClose (void)
+{
+   struct _gleTrace *t;
+
+   if (!_gle_gc || !_gle_gc->trace) return;
+   t = _gle_gc->trace;
+   _gle_gc->trace = 0x0;
+   _gle_gc->trace_nest = 0;
+
+   if (EOF == fclose (t->file) && !t->failed) {
+      fprintf (stderr, "GLE: Warning: the call trace could not be "
+                       "written\n");
+   }
+   if (t->buf) free (t->buf);
+   free (t);
+}
+
+#endif /* __GLE_DOUBLE */
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,128 @@
+/*
+ * FILE:
+ * trace.h
+ *
+ * FUNCTION:
+ * The layout of the call traces written by gleTraceOpen(), and the
+ * recording hooks called by the primitives.  The layout is shared
+ * with the replay tool, bench/glereplay.c, and with tools/gle-batch.cpp,
+ * which reads traces as scenes.
+ *
+ * A trace is the eight bytes of GLE_TRACE_MAGIC and a u32 version,
+ * followed by records.  A record is a u8 opcode and a u32 count of
+ * the payload bytes that follow it.  Everything is little-endian,
+ * whatever the host: integers are i32, doubles are IEEE f64, colors
+ * are f32.  An array whose pointer may be NULL is preceded by a u8,
+ * which is 0 if the pointer was NULL, and then the array is absent.
+ * The lengths of the arrays are given by the counts before them.
+ *
+ * The payloads:
+ *
+ *    JOIN_STYLE, NUM_SIDES, TEXTURE_MODE    i32
+ *    ORIGIN                                 f64[3]
+ *
+ * and for the primitives, a u8 of GLE_TRACE_LIGHTING and GLE_TRACE_C4F
+ * flags, then
+ *
+ *    POLYCYLINDER   i32 npoints, f64[npoints][3], colors?, f64 radius
+ *    POLYCONE       i32 npoints, f64[npoints][3], colors?, f64[npoints]?
+ *    EXTRUSION      contour, i32 npoints, f64[npoints][3], colors?
+ *    TWIST          the same, then f64[npoints]?
+ *    SUPER          the same, then f64[npoints][2][3]?
+ *    SPIRAL, LATHE  contour, helix
+ *    HELICOID, TOROID  f64 rToroid, helix
+ *    SCREW          contour, f64 startz, endz, twist
+ *
+ * where colors are f32[npoints][3], or [4] with GLE_TRACE_C4F; a
+ * contour is i32 ncp, f64[ncp][2], f64[ncp][2]? of normals, f64[3]?
+ * up; and a helix is f64 startRadius, drdTheta, startZ, dzdTheta,
+ * f64[2][3]? startXform, f64[2][3]? dXformdTheta, f64 startTheta,
+ * sweepTheta.
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * rest of the library source; see COPYING.src in this directory.
+ */
+
+#ifndef GLE_TRACE_H_
+#define GLE_TRACE_H_
+
+#define GLE_TRACE_MAGIC		"GLETRACE"
+#define GLE_TRACE_VERSION	1
+
+/* state */
+#define GLE_TRACE_JOIN_STYLE		1
+#define GLE_TRACE_NUM_SIDES		2
+#define GLE_TRACE_TEXTURE_MODE		3
+#define GLE_TRACE_ORIGIN		4
+
+/* primitives */
+#define GLE_TRACE_POLYCYLINDER		16
+#define GLE_TRACE_POLYCONE		17
+#define GLE_TRACE_EXTRUSION		18
+#define GLE_TRACE_TWIST_EXTRUSION	19
+#define GLE_TRACE_SUPER_EXTRUSION	20
+#define GLE_TRACE_SPIRAL		21
+#define GLE_TRACE_LATHE			22
+#define GLE_TRACE_HELICOID		23
+#define GLE_TRACE_TOROID		24
+#define GLE_TRACE_SCREW			25
+
+/* primitive flags */
+#define GLE_TRACE_LIGHTING	0x1	/* lighting was on; normals were sent */
+#define GLE_TRACE_C4F		0x2	/* the _c4f entry point; RGBA colors */
+
+/* The recording hooks.  Only the outermost call is recorded, as
+ * primitives call one another; see the macros in tube_gc.h.  They are
+ * the library's own; a reader of traces needn't include gle.h. */
+#ifdef GLE_H__
+extern void gle_trace_int (int op, int value);
+extern void gle_trace_origin (double origin[3]);
+
+extern void gle_trace_polycone (int op,
+                int npoints,
+                gleDouble point_array[][3],
+                float *color_array,
+                int color_size,		/* floats per color */
+                gleDouble radius,
+                gleDouble radius_array[]);
+
+extern void gle_trace_extrusion (int op,
+                int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                int npoints,
+                gleDouble point_array[][3],
+                float *color_array,
+                int color_size,		/* floats per color */
+                gleDouble twist_array[],
+                gleDouble xform_array[][2][3]);
+
+extern void gle_trace_helix (int op,
+                int ncp,		/* spiral and lathe only */
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                gleDouble rToroid,	/* helicoid and toroid only */
+                gleDouble startRadius,
+                gleDouble drdTheta,
+                gleDouble startZ,
+                gleDouble dzdTheta,
+                gleDouble startXform[2][3],
+                gleDouble dXformdTheta[2][3],
+                gleDouble startTheta,
+                gleDouble sweepTheta);
+
+extern void gle_trace_screw (int ncp,
+                gleDouble contour[][2],
+                gleDouble cont_normal[][2],
+                gleDouble up[3],
+                gleDouble startz,
+                gleDouble endz,
+                gleDouble twist);
+#endif /* GLE_H__ */
+
+#endif /* GLE_TRACE_H_ */
+
+/* ===================== END OF FILE ======================== */
@@ -44,16 +44,44 @@ typedef struct {
    int slices;
    gleTwoVec *circle;   /* 2D contour for circle */
    gleTwoVec *norm;     /* normal vectors for circle */
+   float (*circle_f)[2];   /* the same two, for the float build */
+   float (*norm_f)[2];
 
    /* arguments passed into extrusion code */ 
    int ncp;     /* number of contour points */
-   gleTwoVec *contour;    /* 2D contour */
-   gleTwoVec *cont_normal;  /* 2D contour normals */
+   gleDouble (*contour)[2];    /* 2D contour */
+   gleDouble (*cont_normal)[2];  /* 2D contour normals */
    gleDouble *up;               /* up vector */
    int npoints;  /* number of points in polyline */
    gleVector *point_array;     /* path */
    gleColor *color_array;         /* path colors */
    gleAffine *xform_array;  /* contour xforms */
+   int xform_kind;          /* affine, scale or twist; see extrude.h */
+   gleDouble *xform_scalars;   /* radii or twists, if not affine */
+
+   /* byte strides of the four arrays above; zero if tightly packed.
+    * Set by the strided entry points only; see ex_stride.c */
+   int point_stride;
+   int color_stride;
+   int xform_stride;
+   int scalar_stride;
+
+   /* origin that the single-precision (*_f) paths are relative to */
+   double origin[3];
+
+   /* run-time statistics; NULL unless enabled.  See stats.c */
+   gleStats *stats;
+   int stats_nest;          /* depth of primitives calling primitives */
+   int stats_top;           /* depth of the phase stack */
+   int stats_phase[8];      /* phase stack; the top one is being timed */
+   double stats_mark;       /* when the top phase was last charged */
+
+   /* call trace; NULL unless one is open.  See trace.c */
+   struct _gleTrace *trace;
+   int trace_nest;          /* depth of primitives calling primitives */
+   int texture_mode;        /* as last given to gleTextureMode() */
+   int texture_style;       /* the mapping in effect; 0 if off */
+   int save_texture_style;
 
    /* private members, used by texturing code */
    int num_vert;
@@ -79,14 +107,82 @@ extern gleGC * gleCreateGC (void);
 #define extrusion_join_style (_gle_gc->join_style)
 
 #define __TESS_SLICES (_gle_gc->slices)
+#if __GLE_DOUBLE
 #define __TESS_CIRCLE (_gle_gc->circle)
 #define __TESS_NORM   (_gle_gc->norm)
+#else
+#define __TESS_CIRCLE (_gle_gc->circle_f)
+#define __TESS_NORM   (_gle_gc->norm_f)
+#endif
+
+/* The path arrays are read where the application left them, each
+ * with its own byte stride, as for glVertexPointer().  A stride of
+ * zero, the usual case, means the array is tightly packed.  The size
+ * of an element is that of the build doing the reading: gleDouble is
+ * float in ex_float.c, and gleColor has four floats in ex_alpha.c */
+#define STRIDE_AT(base,stride,size,n) \
+   ((char *) (base) + (size_t) (n) * ((stride) ? (size_t) (stride) : (size)))
+
+#define PATH_POINT(point_array,n) ((gleDouble *) \
+   STRIDE_AT (point_array, _gle_gc->point_stride, sizeof (gleVector), n))
+#define PATH_COLOR(color_array,n) ((float *) \
+   STRIDE_AT (color_array, _gle_gc->color_stride, sizeof (gleColor), n))
+#define PATH_XFORM(xform_array,n) ((gleDouble (*)[3]) \
+   STRIDE_AT (xform_array, _gle_gc->xform_stride, sizeof (gleAffine), n))
+#define PATH_SCALAR(n) (*(gleDouble *) \
+   STRIDE_AT (_gle_gc->xform_scalars, _gle_gc->scalar_stride, sizeof (gleDouble), n))
 
 #define __TUBE_CLOSE_CONTOUR (extrusion_join_style & TUBE_CONTOUR_CLOSED)
 #define __TUBE_DRAW_CAP (extrusion_join_style & TUBE_JN_CAP)
 #define __TUBE_DRAW_FACET_NORMALS (extrusion_join_style & TUBE_NORM_FACET)
 #define __TUBE_DRAW_PATH_EDGE_NORMALS (extrusion_join_style & TUBE_NORM_PATH_EDGE)
 
+/* The statistics hooks.  These cost a pointer test when statistics
+ * are off; the work is done out of line, in stats.c */
+#define GLE_STATS_COUNT(field,n) {					\
+   if (_gle_gc->stats) _gle_gc->stats->field += (size_t) (n);		\
+}
+#define GLE_STATS_ENTER(primitive) {					\
+   if (_gle_gc->stats) gle_stats_enter (primitive);			\
+}
+#define GLE_STATS_LEAVE() {						\
+   if (_gle_gc->stats) gle_stats_leave ();				\
+}
+#define GLE_STATS_PUSH(phase) {						\
+   if (_gle_gc->stats) gle_stats_push (phase);				\
+}
+#define GLE_STATS_POP() {						\
+   if (_gle_gc->stats) gle_stats_pop ();				\
+}
+#define GLE_STATS_PHASE(phase) {					\
+   if (_gle_gc->stats) gle_stats_phase (phase);			\
+}
+
+extern void gle_stats_enter (int primitive);
+extern void gle_stats_leave (void);
+extern void gle_stats_push (int phase);
+extern void gle_stats_pop (void);
+extern void gle_stats_phase (int phase);
+
+/* The tracing hooks; see trace.c.  A primitive is recorded only if
+ * it was called by the application, not by another primitive, and
+ * a setting only if it was not changed by a primitive. */
+#define GLE_TRACE_ENTER(record) {					\
+   if (_gle_gc->trace && (0 == _gle_gc->trace_nest++)) record;		\
+}
+#define GLE_TRACE_LEAVE() {						\
+   if (_gle_gc->trace) _gle_gc->trace_nest --;				\
+}
+#define GLE_TRACE_SETTING(record) {					\
+   if (_gle_gc->trace && (0 == _gle_gc->trace_nest)) record;		\
+}
+
+/* malloc, counted in the statistics */
+extern void * gle_malloc (size_t size);
+
+/* hook up the texture mappers of one precision; see texgen.c */
+extern int gle_texgen_select (int style);
+
 #define __TUBE_STYLE (extrusion_join_style & TUBE_JN_MASK)
 #define __TUBE_RAW_JOIN (extrusion_join_style & TUBE_JN_RAW)
 #define __TUBE_CUT_JOIN (extrusion_join_style & TUBE_JN_CUT)
@@ -0,0 +1,1336 @@
+/*
+ * FILE:
+ * gle-batch.cpp
+ *
+ * FUNCTION:
+ * Headless batch extrusion.  Reads a scene -- a list of primitives,
+ * with their arrays and join styles -- extrudes all of them in
+ * parallel, with the C++ class library (libcgle), and writes the
+ * meshes out as PLY, OBJ or STL.  No window is opened and no GL
+ * context is needed, so this runs on a build machine without a
+ * display, as part of preparing assets for rendering.
+ *
+ * A scene is either a text file, described in README, or a call trace
+ * recorded in an application with gleTraceOpen(); see src/trace.h.
+ * Either way the primitives are those of the C library, taking the
+ * arguments it takes, and the settings (join style, number of sides,
+ * texture mode) are in force for the primitives that follow them.
+ *
+ * The class library computes contour normals from the contour itself,
+ * so normals given in a scene are not used.  Colors with alpha, from
+ * the _c4f entry points, lose their alpha.
+ *
+ * Usage: gle-batch [-j threads] [-f ply|obj|stl] [-o output] [-v] scene
+ *
+ *    -j  extrude on this many threads (default: one a core)
+ *    -f  the output format; by default, taken from the output's name
+ *    -o  the output file.  All the meshes go into the one file, unless
+ *        the name has a %d in it, which is replaced by the number of
+ *        the primitive, from 0, to write a file for each.  Without -o,
+ *        nothing is written; the extrusions are only timed.
+ *    -v  report each primitive, not just each kind of primitive
+ *
+ * HISTORY:
+ * Written October 2026.  Distributed under the same terms as the
+ * library source; see COPYING in the top directory.
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ExtrusionLib.h"
+#include "trace.h"
+
+/* GLE_TEXTURE_ENABLE, in gle.h; the texture modes in gle.h are one more
+ * than the values of gleTexMode */
+#define TEXTURE_ENABLE	0x10000
+#define TEXTURE_STYLES	12
+
+/* the primitives are named by their trace opcodes */
+#define FIRST_KIND	GLE_TRACE_POLYCYLINDER
+#define NUM_KINDS	(GLE_TRACE_SCREW - GLE_TRACE_POLYCYLINDER + 1)
+
+static const char * kind_name[NUM_KINDS] = {
+   "polycylinder", "polycone", "extrusion", "twist_extrusion",
+   "super_extrusion", "spiral", "lathe", "helicoid", "toroid", "screw",
+};
+
+/* one primitive of the scene */
+struct Primitive {
+   int kind;                      /* a GLE_TRACE_ opcode */
+   int where;                     /* the line of the scene, or the record of the trace */
+
+   /* the settings in force */
+   int style;                     /* join style */
+   int sides;
+   int texture;                   /* as given to gleTextureMode() */
+
+   std::vector<double> contour;   /* [ncp][2] */
+   std::vector<double> up;        /* [3], or empty */
+   std::vector<double> points;    /* [npoints][3] */
+   std::vector<float> colors;     /* [npoints][3], or empty */
+   std::vector<double> radii;     /* polycone */
+   std::vector<double> twists;
+   std::vector<double> xforms;    /* [npoints][2][3] */
+
+   double radius;                 /* polycylinder; and the helicoid's, toroid's circle */
+
+   /* spiral, lathe, helicoid and toroid */
+   double start_radius, drdtheta, start_z, dzdtheta;
+   std::vector<double> start_xform, dxform;   /* [2][3], or empty */
+   double start_theta, sweep_theta;
+
+   /* screw, with start_z */
+   double end_z, twist;
+
+   bool has_normals;              /* contour normals were given, and ignored */
+
+   Primitive () : kind (0), where (0), style (-1), sides (20), texture (0),
+      radius (1.0), start_radius (1.0), drdtheta (0.0), start_z (0.0),
+      dzdtheta (0.0), start_theta (0.0), sweep_theta (360.0), end_z (1.0),
+      twist (0.0), has_normals (false) {}
+};
+
+/* what became of it */
+struct Result {
+   CgleMesh mesh;
+   double seconds;
+   std::string error;
+
+   Result () : seconds (0.0) {}
+};
+
+static int path_points (const Primitive &p) { return (int) (p.points.size () / 3); }
+static int contour_points (const Primitive &p) { return (int) (p.contour.size () / 2); }
+
+/* ============================================================ */
+/* Extrusion.  Each primitive gets an object of its own, built on a
+ * worker, and handed its mesh over. */
+
+/* The classes are templated over, as not all of them show their base class. */
+template <class Extrusion> static bool
+apply_settings (Extrusion &obj, const Primitive &p)
+{
+   int style = p.texture & 0xff;
+   double up[3];
+
+   if (0 <= p.style) obj.SetExtrusionMode (p.style);
+
+   if (!p.up.empty ()) {
+      memcpy (up, p.up.data (), sizeof (up));
+      obj.LoadUpVector (up);
+   }
+
+   if (!(p.texture & TEXTURE_ENABLE) || (1 > style) || (TEXTURE_STYLES < style)) {
+      return false;
+   }
+   obj.SetTextureMode ((gleTexMode) (style - 1));
+   return true;
+}
+
+template <class Extrusion> static void
+load_contour (Extrusion &obj, const Primitive &p)
+{
+   for (int i=0; i<contour_points (p); i++) {
+      obj.LoadContourPoint (i, p.contour[2*i], p.contour[2*i+1]);
+   }
+}
+
+static double (*path (Primitive &p))[3]
+{
+   return (double (*)[3]) p.points.data ();
+}
+
+static float (*colors (Primitive &p))[3]
+{
+   return p.colors.empty () ? NULL : (float (*)[3]) p.colors.data ();
+}
+
+static double (*xform (std::vector<double> &v))[3]
+{
+   return v.empty () ? NULL : (double (*)[3]) v.data ();
+}
+
+/* as gleSpiral() works it out */
+static int
+helix_points (const Primitive &p)
+{
+   return (int) ((((double) p.sides) / 360.0) * fabs (p.sweep_theta)) + 4;
+}
+
+/* The lathe, and so the toroid, take a start transform whatever is
+ * given, as gleLathe() does. */
+static double identity_xform[2][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 } };
+
+static CgleMesh
+extrude (Primitive &p)
+{
+   bool tex;
+
+   switch (p.kind) {
+      case GLE_TRACE_POLYCYLINDER: {
+         CgleCylinderExtrusion obj (path_points (p), p.sides);
+         tex = apply_settings (obj, p);
+         obj.Build (path (p), colors (p), p.radius, tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_POLYCONE: {
+         CgleConeExtrusion obj (path_points (p), p.sides);
+         tex = apply_settings (obj, p);
+         obj.Build (path (p), colors (p), p.radii.data (), tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_TWIST_EXTRUSION: {
+         CgleTwistExtrusion obj (path_points (p), contour_points (p), 1.0);
+         tex = apply_settings (obj, p);
+         load_contour (obj, p);
+         obj.Build (path (p), colors (p), p.twists.data (), tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_EXTRUSION:
+      case GLE_TRACE_SUPER_EXTRUSION: {
+         CgleExtrusion obj (path_points (p), contour_points (p), 1.0);
+         tex = apply_settings (obj, p);
+         load_contour (obj, p);
+         if (!p.xforms.empty ()) obj.SetTForm ((double *(*)[2][3]) p.xforms.data ());
+         obj.Build (path (p), colors (p), tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_SPIRAL: {
+         CgleSpiralExtrusion obj (helix_points (p), xform (p.start_xform),
+                                  contour_points (p), p.sweep_theta, 1.0);
+         tex = apply_settings (obj, p);
+         load_contour (obj, p);
+         if (!p.start_xform.empty ()) obj.SetTForm (xform (p.dxform));
+         obj.Build (p.start_radius, p.drdtheta, p.start_z, p.dzdtheta,
+                    p.start_theta, NULL, tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_LATHE: {
+         CgleLatheExtrusion obj (helix_points (p),
+                                 p.start_xform.empty () ? identity_xform : xform (p.start_xform),
+                                 contour_points (p), p.sweep_theta, 1.0);
+         tex = apply_settings (obj, p);
+         load_contour (obj, p);
+         if (!p.dxform.empty ()) obj.SetTForm (xform (p.dxform));
+         obj.Build (p.start_radius, p.drdtheta, p.start_z, p.dzdtheta,
+                    p.start_theta, NULL, tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_HELICOID: {
+         CgleHelicoidExtrusion obj (helix_points (p), xform (p.start_xform),
+                                    p.sweep_theta, p.sides);
+         tex = apply_settings (obj, p);
+         if (!p.start_xform.empty ()) obj.SetTForm (xform (p.dxform));
+         obj.Build (p.radius, p.start_radius, p.drdtheta, p.start_z, p.dzdtheta,
+                    p.start_theta, NULL, tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_TOROID: {
+         CgleToroidExtrusion obj (helix_points (p),
+                                  p.start_xform.empty () ? identity_xform : xform (p.start_xform),
+                                  p.sweep_theta, p.sides);
+         tex = apply_settings (obj, p);
+         if (!p.dxform.empty ()) obj.SetTForm (xform (p.dxform));
+         obj.Build (p.radius, p.start_radius, p.drdtheta, p.start_z, p.dzdtheta,
+                    p.start_theta, NULL, tex);
+         return obj.TakeMesh ();
+      }
+
+      case GLE_TRACE_SCREW: {
+         /* no segment should rotate more than 18 degrees; as gleScrew() */
+         int numsegs = (int) fabs (p.twist / 18.0) + 4;
+
+         /* the screw class starts at z = 0; elsewhere, the path is
+          * laid out here, as gleScrew() lays it out */
+         if (0.0 == p.start_z) {
+            CgleScrew obj (numsegs, contour_points (p), 1.0, p.twist);
+            tex = apply_settings (obj, p);
+            load_contour (obj, p);
+            obj.Build (p.end_z, NULL, tex);
+            return obj.TakeMesh ();
+         }
+
+         double delta = (p.end_z - p.start_z) / ((double) (numsegs-3));
+         double delang = p.twist / ((double) (numsegs-3));
+
+         p.points.resize (3 * numsegs);
+         p.twists.resize (numsegs);
+         for (int i=0; i<numsegs; i++) {
+            p.points[3*i] = 0.0;
+            p.points[3*i+1] = 0.0;
+            p.points[3*i+2] = p.start_z + (i-1) * delta;
+            p.twists[i] = (i-1) * delang;
+         }
+
+         CgleTwistExtrusion obj (numsegs, contour_points (p), 1.0);
+         tex = apply_settings (obj, p);
+         load_contour (obj, p);
+         obj.Build (path (p), NULL, p.twists.data (), tex);
+         return obj.TakeMesh ();
+      }
+   }
+   return CgleMesh ();
+}
+
+/* Extrudes every primitive, on a pool of the given number of threads,
+ * or the library's shared pool for 0.  Returns the wall clock time. */
+static double
+extrude_all (std::vector<Primitive> &scene, std::vector<Result> &results, int threads)
+{
+   std::unique_ptr<CgleThreadPool> own;
+   std::vector<std::future<void> > done;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+   if (0 < threads) own.reset (new CgleThreadPool (threads));
+   CgleThreadPool &pool = own ? *own : CgleThreadPool::GetDefault ();
+
+   results.resize (scene.size ());
+   for (size_t i=0; i<scene.size (); i++) {
+      std::shared_ptr<std::packaged_task<void()> > task (
+         new std::packaged_task<void()> ([&scene, &results, i] ()
+         {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+
+            try {
+               results[i].mesh = extrude (scene[i]);
+            } catch (std::bad_alloc &) {
+               results[i].error = "out of memory";
+            } catch (std::exception &e) {
+               results[i].error = e.what ();
+            }
+            results[i].seconds = std::chrono::duration<double> (
+                                    std::chrono::steady_clock::now () - t0).count ();
+         }));
+      done.push_back (task->get_future ());
+      pool.Submit ([task] () { (*task) (); });
+   }
+
+   for (size_t i=0; i<done.size (); i++) done[i].get ();
+
+   return std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+/* ============================================================ */
+/* Text scenes.  Tokens are separated by white space; a # starts a
+ * comment, to the end of the line.  Braces are tokens of their own. */
+
+struct Scanner {
+   const char *p;
+   const char *name;
+   int line;
+   bool bad;
+   std::string token;
+};
+
+static bool
+next_token (Scanner &s)
+{
+   s.token.clear ();
+   for (;;) {
+      if ('\n' == *s.p) s.line ++;
+      if ('#' == *s.p) {
+         while (*s.p && ('\n' != *s.p)) s.p ++;
+      } else if (*s.p && isspace ((unsigned char) *s.p)) {
+         s.p ++;
+      } else {
+         break;
+      }
+   }
+   if (!*s.p) return false;
+
+   if (('{' == *s.p) || ('}' == *s.p)) {
+      s.token.assign (s.p, 1);
+      s.p ++;
+      return true;
+   }
+   while (*s.p && !isspace ((unsigned char) *s.p) &&
+          ('{' != *s.p) && ('}' != *s.p) && ('#' != *s.p)) {
+      s.token += *s.p ++;
+   }
+   return true;
+}
+
+static void
+scan_error (Scanner &s, const char *what)
+{
+   if (!s.bad) fprintf (stderr, "%s:%d: %s\n", s.name, s.line, what);
+   s.bad = true;
+}
+
+static bool
+is_number (const std::string &token, double *value)
+{
+   char *end;
+
+   *value = strtod (token.c_str (), &end);
+   return !token.empty () && ('\0' == *end);
+}
+
+/* the numbers up to the next word; the token after them is left in s */
+static std::vector<double>
+get_numbers (Scanner &s)
+{
+   std::vector<double> values;
+   double v;
+
+   while (next_token (s) && is_number (s.token, &v)) values.push_back (v);
+   return values;
+}
+
+/* a value given by name: a number, or flags or'ed together with | */
+struct Name { const char *name; int value; };
+
+static const Name style_names[] = {
+   { "JN_RAW", GLE_JN_RAW }, { "JN_ANGLE", GLE_JN_ANGLE },
+   { "JN_CUT", GLE_JN_CUT }, { "JN_ROUND", GLE_JN_ROUND },
+   { "JN_CAP", GLE_JN_CAP }, { "NORM_FACET", GLE_NORM_FACET },
+   { "NORM_EDGE", GLE_NORM_EDGE }, { "NORM_PATH_EDGE", GLE_NORM_PATH_EDGE },
+   { "CONTOUR_CLOSED", GLE_CONTOUR_CLOSED }, { 0x0, 0 },
+};
+
+static const Name texture_names[] = {
+   { "OFF", 0 },
+   { "VERTEX_FLAT", TEXTURE_ENABLE | 1 }, { "NORMAL_FLAT", TEXTURE_ENABLE | 2 },
+   { "VERTEX_CYL", TEXTURE_ENABLE | 3 }, { "NORMAL_CYL", TEXTURE_ENABLE | 4 },
+   { "VERTEX_SPH", TEXTURE_ENABLE | 5 }, { "NORMAL_SPH", TEXTURE_ENABLE | 6 },
+   { "VERTEX_MODEL_FLAT", TEXTURE_ENABLE | 7 }, { "NORMAL_MODEL_FLAT", TEXTURE_ENABLE | 8 },
+   { "VERTEX_MODEL_CYL", TEXTURE_ENABLE | 9 }, { "NORMAL_MODEL_CYL", TEXTURE_ENABLE | 10 },
+   { "VERTEX_MODEL_SPH", TEXTURE_ENABLE | 11 }, { "NORMAL_MODEL_SPH", TEXTURE_ENABLE | 12 },
+   { 0x0, 0 },
+};
+
+static bool
+get_named (Scanner &s, const Name *names, int *value)
+{
+   std::string word;
+   size_t start = 0, bar;
+   double v;
+   int i;
+
+   if (!next_token (s)) return false;
+   if (is_number (s.token, &v)) {
+      *value = (int) v;
+      return true;
+   }
+
+   *value = 0;
+   do {
+      bar = s.token.find ('|', start);
+      word = s.token.substr (start, (std::string::npos == bar) ? bar : bar - start);
+      start = bar + 1;
+
+      /* gle.h's names, or the class library's, or neither prefix */
+      if (0 == word.compare (0, 5, "TUBE_")) word.erase (0, 5);
+      else if (0 == word.compare (0, 4, "GLE_")) word.erase (0, 4);
+      if (0 == word.compare (0, 8, "TEXTURE_")) word.erase (0, 8);
+      for (i=0; names[i].name; i++) {
+         if (!strcasecmp (word.c_str (), names[i].name)) break;
+      }
+      if (!names[i].name) return false;
+      *value |= names[i].value;
+   } while (std::string::npos != bar);
+   return true;
+}
+
+static bool
+get_scalar (Scanner &s, double *value)
+{
+   std::vector<double> v = get_numbers (s);
+
+   if (1 != v.size ()) return false;
+   *value = v[0];
+   return true;
+}
+
+/* the keys of a primitive, and the primitives they belong to */
+#define K_PATH     (1 << 0)      /* polycylinder, polycone, extrusion */
+#define K_CONTOUR  (1 << 1)      /* extrusion, spiral, lathe, screw */
+#define K_HELIX    (1 << 2)      /* spiral, lathe, helicoid, toroid */
+#define K_CIRCLE   (1 << 3)      /* polycylinder, helicoid, toroid */
+
+static int
+kind_keys (int kind)
+{
+   switch (kind) {
+      case GLE_TRACE_POLYCYLINDER: return K_PATH | K_CIRCLE;
+      case GLE_TRACE_POLYCONE:     return K_PATH;
+      case GLE_TRACE_EXTRUSION:    return K_PATH | K_CONTOUR;
+      case GLE_TRACE_SPIRAL:
+      case GLE_TRACE_LATHE:        return K_CONTOUR | K_HELIX;
+      case GLE_TRACE_HELICOID:
+      case GLE_TRACE_TOROID:       return K_HELIX | K_CIRCLE;
+      case GLE_TRACE_SCREW:        return K_CONTOUR;
+   }
+   return 0;
+}
+
+/* reads the body of a primitive, up to and including its closing brace */
+static void
+get_primitive (Scanner &s, Primitive &p)
+{
+   int keys = kind_keys (p.kind);
+   std::vector<double> v;
+   std::string key;
+   bool more;
+
+   more = next_token (s);
+   while (more && !s.bad && ("}" != s.token)) {
+      key = s.token;
+
+      if ((keys & K_PATH) && ("points" == key)) {
+         p.points = get_numbers (s);
+      } else if ((keys & K_PATH) && ("colors" == key)) {
+         v = get_numbers (s);
+         p.colors.assign (v.begin (), v.end ());
+      } else if ((GLE_TRACE_POLYCONE == p.kind) && ("radii" == key)) {
+         p.radii = get_numbers (s);
+      } else if ((keys & K_PATH) && (keys & K_CONTOUR) && ("twists" == key)) {
+         p.twists = get_numbers (s);
+      } else if ((keys & K_PATH) && (keys & K_CONTOUR) && ("xforms" == key)) {
+         p.xforms = get_numbers (s);
+      } else if ((keys & K_CONTOUR) && ("contour" == key)) {
+         p.contour = get_numbers (s);
+      } else if ((keys & K_CONTOUR) && ("normals" == key)) {
+         (void) get_numbers (s);
+         p.has_normals = true;
+      } else if ((keys & K_CONTOUR) && ("up" == key)) {
+         p.up = get_numbers (s);
+         if (3 != p.up.size ()) scan_error (s, "up takes 3 numbers");
+      } else if ((keys & K_CIRCLE) && ("radius" == key)) {
+         if (!get_scalar (s, &p.radius)) scan_error (s, "radius takes a number");
+      } else if ((keys & K_HELIX) && ("start_xform" == key)) {
+         p.start_xform = get_numbers (s);
+         if (6 != p.start_xform.size ()) scan_error (s, "start_xform takes 6 numbers");
+      } else if ((keys & K_HELIX) && ("dxform" == key)) {
+         p.dxform = get_numbers (s);
+         if (6 != p.dxform.size ()) scan_error (s, "dxform takes 6 numbers");
+      } else if ((keys & K_HELIX) && ("start_radius" == key)) {
+         if (!get_scalar (s, &p.start_radius)) scan_error (s, "start_radius takes a number");
+      } else if ((keys & K_HELIX) && ("drdtheta" == key)) {
+         if (!get_scalar (s, &p.drdtheta)) scan_error (s, "drdtheta takes a number");
+      } else if ((keys & K_HELIX) && ("dzdtheta" == key)) {
+         if (!get_scalar (s, &p.dzdtheta)) scan_error (s, "dzdtheta takes a number");
+      } else if ((keys & K_HELIX) && ("start_theta" == key)) {
+         if (!get_scalar (s, &p.start_theta)) scan_error (s, "start_theta takes a number");
+      } else if ((keys & K_HELIX) && ("sweep_theta" == key)) {
+         if (!get_scalar (s, &p.sweep_theta)) scan_error (s, "sweep_theta takes a number");
+      } else if (((keys & K_HELIX) || (GLE_TRACE_SCREW == p.kind)) && ("start_z" == key)) {
+         if (!get_scalar (s, &p.start_z)) scan_error (s, "start_z takes a number");
+      } else if ((GLE_TRACE_SCREW == p.kind) && ("end_z" == key)) {
+         if (!get_scalar (s, &p.end_z)) scan_error (s, "end_z takes a number");
+      } else if ((GLE_TRACE_SCREW == p.kind) && ("twist" == key)) {
+         if (!get_scalar (s, &p.twist)) scan_error (s, "twist takes a number");
+      } else {
+         scan_error (s, ("unknown key " + key + " for " +
+                         kind_name[p.kind - FIRST_KIND]).c_str ());
+      }
+      /* each key has read the token after its numbers */
+      more = !s.token.empty ();
+   }
+   if (!more) scan_error (s, "missing }");
+
+   /* an extrusion is twisted, or transformed, by what it is given */
+   if (GLE_TRACE_EXTRUSION == p.kind) {
+      if (!p.twists.empty () && !p.xforms.empty ()) {
+         scan_error (s, "an extrusion takes twists or xforms, not both");
+      }
+      if (!p.twists.empty ()) p.kind = GLE_TRACE_TWIST_EXTRUSION;
+      if (!p.xforms.empty ()) p.kind = GLE_TRACE_SUPER_EXTRUSION;
+   }
+}
+
+static bool
+load_text (const char *filename, const char *text, std::vector<Primitive> &scene)
+{
+   Scanner s;
+   Primitive settings;
+   int kind;
+
+   s.p = text;
+   s.name = filename;
+   s.line = 1;
+   s.bad = false;
+
+   while (!s.bad && next_token (s)) {
+      if ("join_style" == s.token) {
+         if (!get_named (s, style_names, &settings.style)) scan_error (s, "bad join_style");
+         continue;
+      }
+      if ("num_sides" == s.token) {
+         double v;
+         if (next_token (s) && is_number (s.token, &v)) settings.sides = (int) v;
+         else scan_error (s, "bad num_sides");
+         continue;
+      }
+      if ("texture_mode" == s.token) {
+         if (!get_named (s, texture_names, &settings.texture)) scan_error (s, "bad texture_mode");
+         continue;
+      }
+
+      for (kind=0; kind<NUM_KINDS; kind++) {
+         if (s.token == kind_name[kind]) break;
+      }
+      /* twisted and transformed extrusions are told apart by their keys */
+      if ((NUM_KINDS == kind) ||
+          (GLE_TRACE_TWIST_EXTRUSION == kind + FIRST_KIND) ||
+          (GLE_TRACE_SUPER_EXTRUSION == kind + FIRST_KIND)) {
+         scan_error (s, ("unknown primitive " + s.token).c_str ());
+         break;
+      }
+
+      scene.push_back (settings);
+      scene.back ().kind = kind + FIRST_KIND;
+      scene.back ().where = s.line;
+      if (!next_token (s) || ("{" != s.token)) {
+         scan_error (s, "expected {");
+         break;
+      }
+      get_primitive (s, scene.back ());
+   }
+   return !s.bad;
+}
+
+/* ============================================================ */
+/* Traces.  As bench/glereplay.c decodes them, but into primitives; the
+ * reader is bounded by the end of the record, and reading past it marks
+ * the record bad. */
+
+struct Reader {
+   const unsigned char *p;
+   const unsigned char *end;
+   bool bad;
+};
+
+static const unsigned char *
+take (Reader &r, size_t n)
+{
+   const unsigned char *p = r.p;
+
+   if (r.bad || ((size_t) (r.end - r.p) < n)) {
+      r.bad = true;
+      return 0x0;
+   }
+   r.p += n;
+   return p;
+}
+
+static int
+get_u8 (Reader &r)
+{
+   const unsigned char *p = take (r, 1);
+   return p ? p[0] : 0;
+}
+
+static unsigned long
+get_u32 (Reader &r)
+{
+   const unsigned char *p = take (r, 4);
+   if (!p) return 0;
+   return ((unsigned long) p[0]) | (((unsigned long) p[1]) << 8) |
+          (((unsigned long) p[2]) << 16) | (((unsigned long) p[3]) << 24);
+}
+
+static int
+get_i32 (Reader &r)
+{
+   unsigned long v = get_u32 (r);
+
+   if (v & 0x80000000UL) return - (int) (0xffffffffUL - v) - 1;
+   return (int) v;
+}
+
+static bool
+host_is_big_endian (void)
+{
+   unsigned int one = 1;
+   return (0 == *((unsigned char *) &one));
+}
+
+/* a little-endian IEEE value of n bytes */
+static void
+get_swapped (Reader &r, void *value, size_t n)
+{
+   const unsigned char *p = take (r, n);
+   size_t i;
+
+   if (!p) {
+      memset (value, 0, n);
+      return;
+   }
+   for (i=0; i<n; i++) {
+      ((unsigned char *) value)[i] = host_is_big_endian () ? p[n-1-i] : p[i];
+   }
+}
+
+static double
+get_f64 (Reader &r)
+{
+   double v;
+   get_swapped (r, &v, sizeof (double));
+   return v;
+}
+
+static std::vector<double>
+get_f64s (Reader &r, int n)
+{
+   std::vector<double> v;
+
+   /* a count larger than the record could hold is malformed */
+   if ((0 > n) || ((size_t) (r.end - r.p) < (size_t) n * 8)) {
+      r.bad = true;
+      return v;
+   }
+   v.resize ((size_t) n);
+   for (int i=0; i<n; i++) v[i] = get_f64 (r);
+   return v;
+}
+
+static std::vector<double>
+get_opt_f64s (Reader &r, int n)
+{
+   return get_u8 (r) ? get_f64s (r, n) : std::vector<double> ();
+}
+
+/* colors, keeping three floats of each */
+static std::vector<float>
+get_opt_colors (Reader &r, int n, int size)
+{
+   std::vector<float> v;
+   float c[4];
+
+   if (!get_u8 (r)) return v;
+   if ((0 > n) || ((size_t) (r.end - r.p) < (size_t) n * size * 4)) {
+      r.bad = true;
+      return v;
+   }
+   for (int i=0; i<n; i++) {
+      for (int j=0; j<size; j++) get_swapped (r, &c[j], sizeof (float));
+      v.insert (v.end (), c, c+3);
+   }
+   return v;
+}
+
+static void
+get_contour (Reader &r, Primitive &p)
+{
+   int ncp = get_i32 (r);
+
+   p.contour = get_f64s (r, 2*ncp);
+   p.has_normals = !get_opt_f64s (r, 2*ncp).empty ();
+   p.up = get_opt_f64s (r, 3);
+}
+
+static void
+get_path (Reader &r, Primitive &p, int flags)
+{
+   int npoints = get_i32 (r);
+
+   p.points = get_f64s (r, 3*npoints);
+   p.colors = get_opt_colors (r, npoints, (flags & GLE_TRACE_C4F) ? 4 : 3);
+}
+
+static void
+get_helix (Reader &r, Primitive &p)
+{
+   p.start_radius = get_f64 (r);
+   p.drdtheta = get_f64 (r);
+   p.start_z = get_f64 (r);
+   p.dzdtheta = get_f64 (r);
+   p.start_xform = get_opt_f64s (r, 6);
+   p.dxform = get_opt_f64s (r, 6);
+   p.start_theta = get_f64 (r);
+   p.sweep_theta = get_f64 (r);
+}
+
+/* decodes a primitive's record; the lighting flag doesn't matter here,
+ * as the meshes always have normals */
+static void
+decode (Reader &r, Primitive &p)
+{
+   int flags = get_u8 (r);
+   int npoints;
+
+   switch (p.kind) {
+      case GLE_TRACE_POLYCYLINDER:
+         get_path (r, p, flags);
+         p.radius = get_f64 (r);
+         break;
+
+      case GLE_TRACE_POLYCONE:
+         get_path (r, p, flags);
+         npoints = path_points (p);
+         p.radii = get_opt_f64s (r, npoints);
+         /* a NULL radius array draws radii of 1 */
+         if (p.radii.empty ()) p.radii.assign ((size_t) npoints, 1.0);
+         break;
+
+      case GLE_TRACE_EXTRUSION:
+      case GLE_TRACE_TWIST_EXTRUSION:
+      case GLE_TRACE_SUPER_EXTRUSION:
+         get_contour (r, p);
+         get_path (r, p, flags);
+         npoints = path_points (p);
+         if (GLE_TRACE_TWIST_EXTRUSION == p.kind) {
+            p.twists = get_opt_f64s (r, npoints);
+            if (p.twists.empty ()) p.kind = GLE_TRACE_EXTRUSION;
+         }
+         if (GLE_TRACE_SUPER_EXTRUSION == p.kind) {
+            p.xforms = get_opt_f64s (r, 6*npoints);
+            if (p.xforms.empty ()) p.kind = GLE_TRACE_EXTRUSION;
+         }
+         break;
+
+      case GLE_TRACE_SPIRAL:
+      case GLE_TRACE_LATHE:
+         get_contour (r, p);
+         get_helix (r, p);
+         break;
+
+      case GLE_TRACE_HELICOID:
+      case GLE_TRACE_TOROID:
+         p.radius = get_f64 (r);
+         get_helix (r, p);
+         break;
+
+      case GLE_TRACE_SCREW:
+         get_contour (r, p);
+         p.start_z = get_f64 (r);
+         p.end_z = get_f64 (r);
+         p.twist = get_f64 (r);
+         break;
+   }
+}
+
+/* Records of a kind this tool doesn't know, or doesn't need (the
+ * origin; see README), are skipped.  A truncated or malformed record
+ * ends the scene there, and is an error. */
+static bool
+load_trace (const char *filename, const unsigned char *data, size_t size,
+            std::vector<Primitive> &scene)
+{
+   Primitive settings;
+   Reader r, rec;
+   int op, n = 0;
+
+   r.p = data + 8;
+   r.end = data + size;
+   r.bad = false;
+   if (GLE_TRACE_VERSION != get_u32 (r)) {
+      fprintf (stderr, "%s: not a version %d GLE trace\n", filename, GLE_TRACE_VERSION);
+      return false;
+   }
+
+   while (r.p < r.end) {
+      op = get_u8 (r);
+      unsigned long len = get_u32 (r);
+      if (r.bad || ((unsigned long) (r.end - r.p) < len)) {
+         fprintf (stderr, "%s: truncated after %d records\n", filename, n);
+         return false;
+      }
+      rec.p = r.p;
+      rec.end = r.p + len;
+      rec.bad = false;
+      r.p += len;
+      n ++;
+
+      switch (op) {
+         case GLE_TRACE_JOIN_STYLE: settings.style = get_i32 (rec); break;
+         case GLE_TRACE_NUM_SIDES: settings.sides = get_i32 (rec); break;
+         case GLE_TRACE_TEXTURE_MODE: settings.texture = get_i32 (rec); break;
+
+         default:
+            if ((FIRST_KIND > op) || (FIRST_KIND + NUM_KINDS <= op)) continue;
+            scene.push_back (settings);
+            scene.back ().kind = op;
+            scene.back ().where = n;
+            decode (rec, scene.back ());
+            break;
+      }
+      if (rec.bad) {
+         fprintf (stderr, "%s: malformed record %d\n", filename, n);
+         return false;
+      }
+   }
+   return true;
+}
+
+/* ============================================================ */
+
+/* checks what the class library would otherwise trip over */
+static bool
+check (const char *filename, Primitive &p)
+{
+   const char *kind = kind_name[p.kind - FIRST_KIND];
+   int keys = kind_keys (p.kind);
+   int npoints = path_points (p);
+   const char *error = 0x0;
+
+   if ((keys & K_PATH) && ((0 != p.points.size () % 3) || (2 > npoints))) {
+      error = "points must be at least 2 triples";
+   } else if (!p.colors.empty () && (p.colors.size () != p.points.size ())) {
+      error = "colors must be one triple a point";
+   } else if ((GLE_TRACE_POLYCONE == p.kind) && (p.radii.size () != (size_t) npoints)) {
+      error = "radii must be one a point";
+   } else if ((GLE_TRACE_TWIST_EXTRUSION == p.kind) && (p.twists.size () != (size_t) npoints)) {
+      error = "twists must be one a point";
+   } else if ((GLE_TRACE_SUPER_EXTRUSION == p.kind) && (p.xforms.size () != 6 * (size_t) npoints)) {
+      error = "xforms must be 6 numbers a point";
+   } else if (((keys & K_CONTOUR) || (GLE_TRACE_TWIST_EXTRUSION == p.kind) ||
+               (GLE_TRACE_SUPER_EXTRUSION == p.kind)) &&
+              ((0 != p.contour.size () % 2) || (2 > contour_points (p)))) {
+      error = "contour must be at least 2 pairs";
+   } else if (!p.up.empty () && (3 != p.up.size ())) {
+      error = "up must be 3 numbers";
+   } else if (3 > p.sides) {
+      error = "num_sides must be at least 3";
+   }
+
+   if (error) {
+      fprintf (stderr, "%s:%d: %s: %s\n", filename, p.where, kind, error);
+      return false;
+   }
+   return true;
+}
+
+/* reads a scene, text or trace */
+static bool
+load (const char *filename, std::vector<Primitive> &scene)
+{
+   std::vector<unsigned char> data;
+   unsigned char buf[65536];
+   FILE *file;
+   size_t n;
+   bool ok;
+
+   file = fopen (filename, "rb");
+   if (!file) {
+      perror (filename);
+      return false;
+   }
+   while (0 < (n = fread (buf, 1, sizeof (buf), file))) data.insert (data.end (), buf, buf+n);
+   ok = !ferror (file);
+   fclose (file);
+   if (!ok) {
+      fprintf (stderr, "%s: could not be read\n", filename);
+      return false;
+   }
+
+   if ((12 <= data.size ()) && !memcmp (data.data (), GLE_TRACE_MAGIC, 8)) {
+      ok = load_trace (filename, data.data (), data.size (), scene);
+   } else {
+      data.push_back ('\0');
+      ok = load_text (filename, (const char *) data.data (), scene);
+   }
+
+   for (size_t i=0; ok && (i<scene.size ()); i++) ok = check (filename, scene[i]);
+   return ok;
+}
+
+/* ============================================================ */
+/* Output.  PLY and STL are binary, little-endian; OBJ is text.  Where
+ * some of the meshes going into a file have normals, colors or texture
+ * coordinates and others don't, the others get the GL defaults, as
+ * CgleMesh::Append gives them. */
+
+enum Format { FORMAT_NONE, FORMAT_PLY, FORMAT_OBJ, FORMAT_STL };
+
+struct Writer {
+   FILE *file;
+   std::vector<unsigned char> buf;
+};
+
+static void
+put_le (Writer &w, const void *value, size_t n)
+{
+   const unsigned char *b = (const unsigned char *) value;
+
+   for (size_t i=0; i<n; i++) w.buf.push_back (host_is_big_endian () ? b[n-1-i] : b[i]);
+}
+
+static void put_f32 (Writer &w, float v) { put_le (w, &v, 4); }
+static void put_u32 (Writer &w, unsigned int v) { put_le (w, &v, 4); }
+
+static bool
+flush (Writer &w)
+{
+   bool ok = (w.buf.size () == fwrite (w.buf.data (), 1, w.buf.size (), w.file));
+   w.buf.clear ();
+   return ok;
+}
+
+static const float default_normal[3] = { 0.0f, 0.0f, 1.0f };
+static const float default_color[3] = { 1.0f, 1.0f, 1.0f };
+static const float default_texcoord[2] = { 0.0f, 0.0f };
+
+static const float *
+attribute (const float *array, int width, int vertex, const float *fallback)
+{
+   return array ? array + width * vertex : fallback;
+}
+
+static bool
+write_ply (Writer &w, const std::vector<const CgleMesh *> &meshes)
+{
+   bool normals = false, colors = false, texcoords = false;
+   unsigned int vertices = 0, triangles = 0, first = 0;
+   unsigned char rgb[3], three = 3;
+   size_t m;
+   int i, j;
+
+   for (m=0; m<meshes.size (); m++) {
+      normals |= (NULL != meshes[m]->GetNormals ());
+      colors |= (NULL != meshes[m]->GetColors ());
+      texcoords |= (NULL != meshes[m]->GetTexCoords ());
+      vertices += (unsigned int) meshes[m]->GetVertexCount ();
+      triangles += (unsigned int) meshes[m]->GetIndexCount () / 3;
+   }
+
+   fprintf (w.file, "ply\nformat binary_little_endian 1.0\n"
+                    "comment written by gle-batch\n"
+                    "element vertex %u\n"
+                    "property float x\nproperty float y\nproperty float z\n", vertices);
+   if (normals) fprintf (w.file, "property float nx\nproperty float ny\nproperty float nz\n");
+   if (colors) fprintf (w.file, "property uchar red\nproperty uchar green\nproperty uchar blue\n");
+   if (texcoords) fprintf (w.file, "property float s\nproperty float t\n");
+   fprintf (w.file, "element face %u\nproperty list uchar uint vertex_indices\nend_header\n",
+            triangles);
+
+   for (m=0; m<meshes.size (); m++) {
+      const CgleMesh &mesh = *meshes[m];
+      for (i=0; i<mesh.GetVertexCount (); i++) {
+         for (j=0; j<3; j++) put_f32 (w, mesh.GetVertices ()[3*i+j]);
+         if (normals) {
+            const float *n = attribute (mesh.GetNormals (), 3, i, default_normal);
+            for (j=0; j<3; j++) put_f32 (w, n[j]);
+         }
+         if (colors) {
+            const float *c = attribute (mesh.GetColors (), 3, i, default_color);
+            for (j=0; j<3; j++) {
+               float v = c[j] < 0.0f ? 0.0f : (c[j] > 1.0f ? 1.0f : c[j]);
+               rgb[j] = (unsigned char) (255.0f * v + 0.5f);
+            }
+            w.buf.insert (w.buf.end (), rgb, rgb+3);
+         }
+         if (texcoords) {
+            const float *t = attribute (mesh.GetTexCoords (), 2, i, default_texcoord);
+            put_f32 (w, t[0]);
+            put_f32 (w, t[1]);
+         }
+      }
+      if (!flush (w)) return false;
+   }
+
+   for (m=0; m<meshes.size (); m++) {
+      const CgleMesh &mesh = *meshes[m];
+      for (i=0; i<mesh.GetIndexCount (); i+=3) {
+         w.buf.push_back (three);
+         for (j=0; j<3; j++) put_u32 (w, first + mesh.GetIndices ()[i+j]);
+      }
+      first += (unsigned int) mesh.GetVertexCount ();
+      if (!flush (w)) return false;
+   }
+   return true;
+}
+
+static bool
+write_obj (Writer &w, const std::vector<const CgleMesh *> &meshes,
+           const std::vector<size_t> &numbers)
+{
+   unsigned long first = 1;
+   size_t m;
+   int i;
+
+   fprintf (w.file, "# written by gle-batch\n");
+   for (m=0; m<meshes.size (); m++) {
+      const CgleMesh &mesh = *meshes[m];
+      const float *v = mesh.GetVertices ();
+      const float *n = mesh.GetNormals ();
+      const float *c = mesh.GetColors ();
+      const float *t = mesh.GetTexCoords ();
+
+      fprintf (w.file, "o primitive%lu\n", (unsigned long) numbers[m]);
+      for (i=0; i<mesh.GetVertexCount (); i++) {
+         /* the colors, where there are any, as the common extension has them */
+         if (c) {
+            fprintf (w.file, "v %.9g %.9g %.9g %.6g %.6g %.6g\n", v[3*i], v[3*i+1], v[3*i+2],
+                     c[3*i], c[3*i+1], c[3*i+2]);
+         } else {
+            fprintf (w.file, "v %.9g %.9g %.9g\n", v[3*i], v[3*i+1], v[3*i+2]);
+         }
+      }
+      for (i=0; n && (i<mesh.GetVertexCount ()); i++) {
+         fprintf (w.file, "vn %.9g %.9g %.9g\n", n[3*i], n[3*i+1], n[3*i+2]);
+      }
+      for (i=0; t && (i<mesh.GetVertexCount ()); i++) {
+         fprintf (w.file, "vt %.9g %.9g\n", t[2*i], t[2*i+1]);
+      }
+
+      /* normals and texture coordinates are numbered as the vertices are */
+      const GLuint *idx = mesh.GetIndices ();
+      for (i=0; i<mesh.GetIndexCount (); i+=3) {
+         unsigned long a = first + idx[i], b = first + idx[i+1], d = first + idx[i+2];
+         if (n && t) {
+            fprintf (w.file, "f %lu/%lu/%lu %lu/%lu/%lu %lu/%lu/%lu\n", a, a, a, b, b, b, d, d, d);
+         } else if (n) {
+            fprintf (w.file, "f %lu//%lu %lu//%lu %lu//%lu\n", a, a, b, b, d, d);
+         } else if (t) {
+            fprintf (w.file, "f %lu/%lu %lu/%lu %lu/%lu\n", a, a, b, b, d, d);
+         } else {
+            fprintf (w.file, "f %lu %lu %lu\n", a, b, d);
+         }
+      }
+      first += (unsigned long) mesh.GetVertexCount ();
+      if (ferror (w.file)) return false;
+   }
+   return true;
+}
+
+/* STL has only the triangles, each with the normal of its face */
+static bool
+write_stl (Writer &w, const std::vector<const CgleMesh *> &meshes)
+{
+   unsigned int triangles = 0;
+   unsigned char header[80];
+   size_t m;
+   int i, j, k;
+
+   memset (header, 0, sizeof (header));
+   strcpy ((char *) header, "binary STL written by gle-batch");
+   w.buf.insert (w.buf.end (), header, header+80);
+   for (m=0; m<meshes.size (); m++) triangles += (unsigned int) meshes[m]->GetIndexCount () / 3;
+   put_u32 (w, triangles);
+
+   for (m=0; m<meshes.size (); m++) {
+      const CgleMesh &mesh = *meshes[m];
+      const float *v = mesh.GetVertices ();
+      const GLuint *idx = mesh.GetIndices ();
+
+      for (i=0; i<mesh.GetIndexCount (); i+=3) {
+         const float *a = v + 3*idx[i], *b = v + 3*idx[i+1], *c = v + 3*idx[i+2];
+         float e1[3], e2[3], n[3], len;
+
+         for (k=0; k<3; k++) {
+            e1[k] = b[k] - a[k];
+            e2[k] = c[k] - a[k];
+         }
+         n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+         n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+         n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+         len = sqrtf (n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+         if (0.0f < len) for (k=0; k<3; k++) n[k] /= len;
+
+         for (k=0; k<3; k++) put_f32 (w, n[k]);
+         for (j=0; j<3; j++) {
+            for (k=0; k<3; k++) put_f32 (w, v[3*idx[i+j] + k]);
+         }
+         w.buf.push_back (0);
+         w.buf.push_back (0);
+      }
+      if (!flush (w)) return false;
+   }
+   return flush (w);
+}
+
+static bool
+write_meshes (const std::string &name, Format format,
+              const std::vector<const CgleMesh *> &meshes,
+              const std::vector<size_t> &numbers)
+{
+   Writer w;
+   bool ok = false;
+
+   w.file = fopen (name.c_str (), "wb");
+   if (!w.file) {
+      perror (name.c_str ());
+      return false;
+   }
+   switch (format) {
+      case FORMAT_PLY: ok = write_ply (w, meshes); break;
+      case FORMAT_OBJ: ok = write_obj (w, meshes, numbers); break;
+      case FORMAT_STL: ok = write_stl (w, meshes); break;
+      case FORMAT_NONE: break;
+   }
+   if ((EOF == fclose (w.file)) || !ok) {
+      fprintf (stderr, "%s: could not be written\n", name.c_str ());
+      return false;
+   }
+   return true;
+}
+
+/* Writes all the meshes into the one file, or, if the name has a %d
+ * in it, each into a file of its own. */
+static bool
+write_all (const std::string &name, Format format, const std::vector<Result> &results)
+{
+   std::vector<const CgleMesh *> meshes;
+   std::vector<size_t> numbers;
+   size_t split = name.find ("%d");
+   char number[32];
+
+   for (size_t i=0; i<results.size (); i++) {
+      if (!results[i].error.empty ()) continue;
+      meshes.push_back (&results[i].mesh);
+      numbers.push_back (i);
+
+      if (std::string::npos != split) {
+         snprintf (number, sizeof (number), "%lu", (unsigned long) i);
+         if (!write_meshes (std::string (name).replace (split, 2, number), format, meshes, numbers)) {
+            return false;
+         }
+         meshes.clear ();
+         numbers.clear ();
+      }
+   }
+   if (std::string::npos != split) return true;
+   return write_meshes (name, format, meshes, numbers);
+}
+
+static Format
+format_named (const std::string &name)
+{
+   std::string ext = name.substr (name.find_last_of ('.') + 1);
+
+   if (!strcasecmp (ext.c_str (), "ply")) return FORMAT_PLY;
+   if (!strcasecmp (ext.c_str (), "obj")) return FORMAT_OBJ;
+   if (!strcasecmp (ext.c_str (), "stl")) return FORMAT_STL;
+   return FORMAT_NONE;
+}
+
+/* ============================================================ */
+
+static void
+usage (void)
+{
+   fprintf (stderr, "usage: gle-batch [-j threads] [-f ply|obj|stl] [-o output] [-v] scene\n");
+   exit (2);
+}
+
+int
+main (int argc, char * argv[])
+{
+   int threads = 0, verbose = 0, failed = 0;
+   const char *scene_name = 0x0;
+   std::string output;
+   Format format = FORMAT_NONE;
+   std::vector<Primitive> scene;
+   std::vector<Result> results;
+   double wall, busy = 0.0;
+   double kind_seconds[NUM_KINDS], kind_worst[NUM_KINDS];
+   long kind_count[NUM_KINDS], kind_triangles[NUM_KINDS];
+   long triangles = 0;
+   bool normals_ignored = false;
+   int i, k;
+
+   for (i=1; i<argc; i++) {
+      if (!strcmp (argv[i], "-j") && (i+1 < argc)) {
+         threads = atoi (argv[++i]);
+         if (1 > threads) usage ();
+      } else if (!strcmp (argv[i], "-f") && (i+1 < argc)) {
+         format = format_named (std::string (".") + argv[++i]);
+         if (FORMAT_NONE == format) usage ();
+      } else if (!strcmp (argv[i], "-o") && (i+1 < argc)) {
+         output = argv[++i];
+      } else if (!strcmp (argv[i], "-v")) {
+         verbose = 1;
+      } else if (('-' == argv[i][0]) || scene_name) {
+         usage ();
+      } else {
+         scene_name = argv[i];
+      }
+   }
+   if (!scene_name) usage ();
+
+   if (!output.empty () && (FORMAT_NONE == format)) {
+      format = format_named (output);
+      if (FORMAT_NONE == format) {
+         fprintf (stderr, "%s: give the format with -f\n", output.c_str ());
+         return 2;
+      }
+   }
+
+   if (!load (scene_name, scene)) return 1;
+   for (i=0; i<(int) scene.size (); i++) normals_ignored |= scene[i].has_normals;
+   if (normals_ignored) {
+      fprintf (stderr, "%s: contour normals are computed from the contours; "
+                       "those given are not used\n", scene_name);
+   }
+
+   wall = extrude_all (scene, results, threads);
+
+   for (k=0; k<NUM_KINDS; k++) {
+      kind_seconds[k] = kind_worst[k] = 0.0;
+      kind_count[k] = kind_triangles[k] = 0;
+   }
+
+   if (verbose) {
+      printf ("%6s %-16s %6s %10s %10s %10s\n", "number", "primitive", "at",
+              "vertices", "triangles", "ms");
+   }
+   for (i=0; i<(int) scene.size (); i++) {
+      const Result &r = results[i];
+      long tris = r.mesh.GetIndexCount () / 3;
+
+      k = scene[i].kind - FIRST_KIND;
+      if (!r.error.empty ()) {
+         fprintf (stderr, "%s:%d: %s: %s\n", scene_name, scene[i].where,
+                  kind_name[k], r.error.c_str ());
+         failed ++;
+         continue;
+      }
+      kind_count[k] ++;
+      kind_triangles[k] += tris;
+      kind_seconds[k] += r.seconds;
+      if (kind_worst[k] < r.seconds) kind_worst[k] = r.seconds;
+      triangles += tris;
+      busy += r.seconds;
+
+      if (verbose) {
+         printf ("%6d %-16s %6d %10d %10ld %10.3f\n", i, kind_name[k], scene[i].where,
+                 r.mesh.GetVertexCount (), tris, 1.0e3 * r.seconds);
+      }
+   }
+
+   printf ("%-16s %8s %12s %10s %10s\n", "primitive", "count", "triangles", "mean ms", "worst ms");
+   for (k=0; k<NUM_KINDS; k++) {
+      if (0 == kind_count[k]) continue;
+      printf ("%-16s %8ld %12ld %10.3f %10.3f\n", kind_name[k], kind_count[k],
+              kind_triangles[k], 1.0e3 * kind_seconds[k] / (double) kind_count[k],
+              1.0e3 * kind_worst[k]);
+   }
+
+   if (0.0 >= wall) wall = 1.0e-6;
+   if (0 == threads) threads = CgleThreadPool::GetDefault ().GetThreadCount ();
+   printf ("\n%lu primitives, %ld triangles in %.3f s on %d thread%s: "
+           "%.0f primitives/s, %.0f triangles/s (%.2fx parallel)\n",
+           (unsigned long) scene.size (), triangles, wall, threads, (1 == threads) ? "" : "s",
+           (double) scene.size () / wall, (double) triangles / wall, busy / wall);
+
+   if (!output.empty () && !write_all (output, format, results)) return 1;
+   return failed ? 1 : 0;
+}
+
+/* ===================== END OF FILE ======================== */